@@ -8,7 +8,7 @@
 // Dependencies:
 // - AVFoundation (Latest) - Core audio functionality
 // - Accelerate (Latest) - SIMD-optimized DSP operations
-// - DSPKernel (Internal) - Base DSP functionality
+// - TALDDSPKernel (Internal) - Shared C++ DSP core via DSPKernelBridge
 
 import AVFoundation
 import Accelerate
@@ -26,7 +26,6 @@ public class DSPProcessor: NSObject {
     private let kFFTSetupLength: Int = 11
     private let kMaxLatencyMs: Double = 10.0
     private let kMinPowerEfficiency: Double = 0.90
-    private let kPerformanceMonitoringInterval: TimeInterval = 1.0
     
     // MARK: - Error Types
     
@@ -41,7 +40,7 @@ public class DSPProcessor: NSObject {
     
     // MARK: - Properties
     
-    private let dspKernel: DSPKernel
+    private let dspKernel: TALDDSPKernel
     private var fftSetup: vDSP_DFT_Setup?
     private var bufferSize: Int
     private var sampleRate: Int
@@ -49,7 +48,6 @@ public class DSPProcessor: NSObject {
     private var isProcessing: Bool = false
     
     private var fftBuffer: UnsafeMutablePointer<Float>?
-    private let performanceMonitor: PerformanceMonitor
     private let powerTracker: PowerEfficiencyTracker
     
     public private(set) var metrics: ProcessingMetrics
@@ -73,16 +71,19 @@ public class DSPProcessor: NSObject {
         self.channelCount = channelCount
         
         // Initialize performance monitoring
-        self.performanceMonitor = PerformanceMonitor(
-            monitoringInterval: kPerformanceMonitoringInterval
-        )
         self.powerTracker = PowerEfficiencyTracker(
             targetEfficiency: kMinPowerEfficiency
         )
         self.metrics = ProcessingMetrics()
         
         // Initialize DSP kernel
-        self.dspKernel = try DSPKernel()
+        let kernel = try TALDDSPKernel(sampleRate: Double(sampleRate), channels: channelCount)
+        
+        // Size kernel scratch to the configured block rather than the kernel maximum
+        try kernel.prepare(withMaximumFrames: bufferSize,
+                           channels: channelCount,
+                           sampleRate: Double(sampleRate))
+        self.dspKernel = kernel
         
         super.init()
         
@@ -107,9 +108,6 @@ public class DSPProcessor: NSObject {
         isProcessing = true
         defer { isProcessing = false }
         
-        // Start performance monitoring
-        performanceMonitor.startProcessingCycle()
-        
         do {
             // Verify SIMD alignment
             let inputAlignment = Int(bitPattern: inputBuffer) % kSIMDAlignment
@@ -121,15 +119,7 @@ public class DSPProcessor: NSObject {
             // Process audio through DSP chain
             try autoreleasepool {
                 // Apply SIMD-optimized processing
-                vDSP_mmul(inputBuffer,
-                         1,
-                         dspKernel.processingBuffer,
-                         1,
-                         outputBuffer,
-                         1,
-                         vDSP_Length(channelCount),
-                         vDSP_Length(frameCount),
-                         vDSP_Length(channelCount))
+                dspKernel.processInterleaved(inputBuffer, output: outputBuffer, frameCount: frameCount)
                 
                 // Perform FFT analysis if needed
                 if let fftBuffer = fftBuffer {
@@ -141,12 +131,11 @@ public class DSPProcessor: NSObject {
                 }
             }
             
-            // Update performance metrics
-            metrics.updateWithCurrentCycle(
-                processingTime: performanceMonitor.currentProcessingTime,
-                powerEfficiency: powerTracker.currentEfficiency,
-                bufferUnderruns: performanceMonitor.bufferUnderrunCount
-            )
+            // Last-block values are single atomic loads; histogram snapshots stay off the
+            // render thread in monitorPerformance()
+            metrics.recordBlock(latencyMs: dspKernel.lastBlockLatency,
+                                load: dspKernel.processingLoad,
+                                powerEfficiency: powerTracker.currentEfficiency)
             
             return metrics
             
@@ -155,6 +144,17 @@ public class DSPProcessor: NSObject {
         }
     }
     
+    /// Block time and load statistics from the shared kernel; call off the render thread
+    public func monitorPerformance() -> ProcessingMetrics {
+        return ProcessingMetrics(snapshot: dspKernel.metrics,
+                                 powerEfficiency: powerTracker.currentEfficiency)
+    }
+    
+    /// Forwards an audio session overload to the kernel's xrun counter
+    public func reportXrun() {
+        dspKernel.reportXrun()
+    }
+    
     // MARK: - Private Methods
     
     @inlinable
@@ -198,11 +198,6 @@ public class DSPProcessor: NSObject {
         fftBuffer = UnsafeMutablePointer<Float>.allocate(
             capacity: fftBufferSize
         )
-        
-        // Initialize DSP kernel
-        guard dspKernel.initialize(Double(sampleRate), channelCount) else {
-            throw DSPProcessorError.initializationError(description: "Failed to initialize DSP kernel")
-        }
     }
     
     private func cleanup() {
@@ -215,42 +210,37 @@ public class DSPProcessor: NSObject {
             vDSP_DFT_DestroySetup(fftSetup)
             self.fftSetup = nil
         }
-        
-        dspKernel.cleanup()
     }
 }
 
 // MARK: - Supporting Types
 
 private struct ProcessingMetrics {
-    var processingTime: TimeInterval = 0
+    var processingTime: TimeInterval = 0      // Most recent block
+    var lastBlockLoad: Double = 0             // Most recent block's fraction of its budget
+    var p99ProcessingTime: TimeInterval = 0
+    var peakProcessingTime: TimeInterval = 0
+    var processingLoad: Double = 0            // p99 fraction of the real-time budget
     var powerEfficiency: Double = 0
-    var bufferUnderruns: Int = 0
+    var bufferUnderruns: Int = 0              // Kernel overruns plus reported xruns
     
-    mutating func updateWithCurrentCycle(processingTime: TimeInterval,
-                                       powerEfficiency: Double,
-                                       bufferUnderruns: Int) {
-        self.processingTime = processingTime
-        self.powerEfficiency = powerEfficiency
-        self.bufferUnderruns = bufferUnderruns
-    }
-}
-
-private class PerformanceMonitor {
-    private let monitoringInterval: TimeInterval
-    private var cycleStartTime: TimeInterval = 0
-    private(set) var bufferUnderrunCount: Int = 0
+    init() {}
     
-    init(monitoringInterval: TimeInterval) {
-        self.monitoringInterval = monitoringInterval
-    }
-    
-    var currentProcessingTime: TimeInterval {
-        return CACurrentMediaTime() - cycleStartTime
+    init(snapshot: TALDDSPMetrics, powerEfficiency: Double) {
+        self.processingTime = TimeInterval(snapshot.lastBlockMs) / 1000.0
+        self.lastBlockLoad = Double(snapshot.lastLoad)
+        self.p99ProcessingTime = TimeInterval(snapshot.p99BlockMs) / 1000.0
+        self.peakProcessingTime = TimeInterval(snapshot.maxBlockMs) / 1000.0
+        self.processingLoad = Double(snapshot.p99Load)
+        self.powerEfficiency = powerEfficiency
+        self.bufferUnderruns = Int(snapshot.overrunCount + snapshot.xrunCount)
     }
     
-    func startProcessingCycle() {
-        cycleStartTime = CACurrentMediaTime()
+    /// Updates the most recent block only; the statistics keep their last snapshot
+    mutating func recordBlock(latencyMs: Float, load: Float, powerEfficiency: Double) {
+        self.processingTime = TimeInterval(latencyMs) / 1000.0
+        self.lastBlockLoad = Double(load)
+        self.powerEfficiency = powerEfficiency
     }
 }
 
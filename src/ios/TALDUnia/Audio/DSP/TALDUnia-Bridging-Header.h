@@ -0,0 +1,8 @@
+//
+// TALDUnia-Bridging-Header.h
+// TALD UNIA
+//
+// Exposes the shared C++ DSP core to Swift through its Objective-C++ bridge
+//
+
+#import "DSPKernelBridge.h"
@@ -20,18 +20,37 @@ private let kMaxLatencyMs: Double = 10.0
 
 // MARK: - Processing Metrics
 
+/// Kernel block statistics in seconds, read from the shared C++ metrics without locking
 private struct ProcessingMetrics {
-    var averageLatency: Double = 0.0
+    var processingTime: Double = 0.0    // Most recent block
+    var lastBlockLoad: Double = 0.0     // Most recent block's fraction of its budget
+    var averageLatency: Double = 0.0    // Median block time
+    var p99Latency: Double = 0.0
     var peakLatency: Double = 0.0
-    var processingLoad: Double = 0.0
-    var bufferUtilization: Double = 0.0
+    var processingLoad: Double = 0.0    // p99 fraction of the real-time budget
+    var peakLoad: Double = 0.0
+    var overruns: UInt64 = 0
+    var xruns: UInt64 = 0
     var timestamp: Date = Date()
     
-    mutating func update(latency: Double, load: Double) {
-        averageLatency = (averageLatency + latency) / 2.0
-        peakLatency = max(peakLatency, latency)
-        processingLoad = load
-        timestamp = Date()
+    init() {}
+    
+    init(_ snapshot: TALDDSPMetrics) {
+        processingTime = Double(snapshot.lastBlockMs) / 1000.0
+        lastBlockLoad = Double(snapshot.lastLoad)
+        averageLatency = Double(snapshot.medianBlockMs) / 1000.0
+        p99Latency = Double(snapshot.p99BlockMs) / 1000.0
+        peakLatency = Double(snapshot.maxBlockMs) / 1000.0
+        processingLoad = Double(snapshot.p99Load)
+        peakLoad = Double(snapshot.maxLoad)
+        overruns = snapshot.overrunCount
+        xruns = snapshot.xrunCount
+    }
+    
+    /// The most recent block alone, from the kernel's render-thread-safe accessors
+    init(lastBlockMs: Float, load: Float) {
+        processingTime = Double(lastBlockMs) / 1000.0
+        lastBlockLoad = Double(load)
     }
 }
 
@@ -45,33 +64,6 @@ private struct DSPConfiguration {
     let useHardwareAcceleration: Bool
 }
 
-// MARK: - Atomic Operations
-
-private class AtomicInteger {
-    private let lock = NSLock()
-    private var value: Int = 0
-    
-    func increment() -> Int {
-        lock.lock()
-        defer { lock.unlock() }
-        value += 1
-        return value
-    }
-    
-    func decrement() -> Int {
-        lock.lock()
-        defer { lock.unlock() }
-        value -= 1
-        return value
-    }
-    
-    func get() -> Int {
-        lock.lock()
-        defer { lock.unlock() }
-        return value
-    }
-}
-
 // MARK: - Buffer Validation
 
 @inline(__always)
@@ -112,15 +104,13 @@ public func validateBufferConfiguration(bufferSize: Int, channels: Int) -> Resul
 public class DSPProcessor {
     // MARK: - Properties
     
-    private let kernel: DSPKernel
+    private let kernel: TALDDSPKernel
     private let vectorDSP: VectorDSP
     private let processingQueue: DispatchQueue
     private let bufferSize: Int
     private let channels: Int
     private let sampleRate: Double
     private var isProcessing: Bool = false
-    private var metrics: ProcessingMetrics = ProcessingMetrics()
-    private let activeBuffers: AtomicInteger = AtomicInteger()
     private let configuration: DSPConfiguration
     
     // MARK: - Initialization
@@ -151,14 +141,17 @@ public class DSPProcessor {
         self.sampleRate = config.sampleRate
         
         // Initialize processing components
-        self.kernel = try DSPKernel(sampleRate: sampleRate, channels: channels)
+        let kernel = try TALDDSPKernel(sampleRate: sampleRate, channels: channels)
+        
+        // Size kernel scratch to the configured block rather than the kernel maximum
+        try kernel.prepare(withMaximumFrames: bufferSize, channels: channels, sampleRate: sampleRate)
+        self.kernel = kernel
         self.vectorDSP = VectorDSP(size: bufferSize, enableOptimization: config.isOptimized)
         
-        // Configure processing queue
+        // Configure processing queue (serial: the kernel parameter queue is single-producer)
         self.processingQueue = DispatchQueue(
             label: "com.tald.unia.dsp.processor",
-            qos: kProcessingQueueQoS,
-            attributes: .concurrent
+            qos: kProcessingQueueQoS
         )
     }
     
@@ -169,10 +162,6 @@ public class DSPProcessor {
         _ output: UnsafeMutablePointer<Float>,
         frameCount: Int
     ) -> Result<ProcessingMetrics, TALDError> {
-        let startTime = Date()
-        let activeCount = activeBuffers.increment()
-        defer { activeBuffers.decrement() }
-        
         // Validate buffer alignment
         guard input.alignedPointer(to: Float.self, alignment: kSIMDAlignment) != nil,
               output.alignedPointer(to: Float.self, alignment: kSIMDAlignment) != nil else {
@@ -201,17 +190,11 @@ public class DSPProcessor {
             ))
         }
         
-        // Process through DSP kernel
-        kernel.process(input, output, frameCount)
-        
-        // Update metrics
-        let processingTime = Date().timeIntervalSince(startTime)
-        metrics.update(
-            latency: processingTime,
-            load: Double(activeCount) / Double(kMaxChannels)
-        )
+        // Process through DSP kernel (it times itself into its lock-free metrics)
+        kernel.processPlanar(input, output: output, frameCount: frameCount)
         
         // Validate latency requirement
+        let processingTime = Double(kernel.lastBlockLatency) / 1000.0
         if processingTime > kMaxLatencyMs / 1000.0 {
             return .failure(TALDError.audioProcessingError(
                 code: "EXCESSIVE_LATENCY",
@@ -227,14 +210,27 @@ public class DSPProcessor {
             ))
         }
         
-        return .success(metrics)
+        // Last-block values only: histogram snapshots stay off the render thread
+        return .success(ProcessingMetrics(lastBlockMs: kernel.lastBlockLatency, load: kernel.processingLoad))
+    }
+    
+    // MARK: - Performance Monitoring
+    
+    /// Block time and load statistics; call from a monitoring thread, not the render thread
+    public func monitorPerformance() -> ProcessingMetrics {
+        return ProcessingMetrics(kernel.metrics)
+    }
+    
+    /// Forwards a device overload notification to the kernel's xrun counter
+    public func reportXrun() {
+        kernel.reportXrun()
     }
     
     // MARK: - Parameter Control
     
     public func setParameter(_ parameter: Int, value: Float) -> Result<Void, TALDError> {
         processingQueue.async {
-            self.kernel.setParameter(parameter, value)
+            self.kernel.setParameter(parameter, value: value)
         }
         return .success(())
     }
@@ -244,7 +240,7 @@ public class DSPProcessor {
     public func reset() {
         processingQueue.async {
             self.kernel.reset()
-            self.metrics = ProcessingMetrics()
+            self.kernel.resetMetrics()
             self.isProcessing = false
         }
     }
@@ -157,10 +157,10 @@ public class SignalProcessor {
         // Check processing result
         switch result {
         case .success(let processingMetrics):
-            metrics.update(latency: processingMetrics.averageLatency)
+            metrics.update(latency: processingMetrics.processingTime)
             
             // Verify latency requirement
-            if processingMetrics.averageLatency > kMaxProcessingLatency {
+            if processingMetrics.processingTime > kMaxProcessingLatency {
                 return .failure(SignalProcessingError.processingLatencyExceeded)
             }
             
@@ -0,0 +1,244 @@
+//
+// BiquadCascadeKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the multi-channel biquad cascade
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "../../shared/DSP/BiquadCascadeKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const size_t kTestFrames = 256;
+static const int kTestBands = 10;
+static const float kTestFrequencies[kTestBands] = { 31.5f, 63.0f, 125.0f, 250.0f, 500.0f,
+                                                    1000.0f, 2000.0f, 4000.0f, 8000.0f, 16000.0f };
+
+static BiquadBand makeBand(int index) {
+    BiquadBand band;
+    band.frequency = kTestFrequencies[index];
+    band.gainDB = (index % 2 == 0) ? 6.0f : -4.5f;
+    band.q = 0.7f + 0.3f * static_cast<float>(index);
+    return band;
+}
+
+static std::vector<float> makeNoise(size_t samples) {
+    std::vector<float> signal(samples);
+    uint32_t seed = 12345;
+    for (float& sample : signal) {
+        seed = seed * 1664525u + 1013904223u;
+        sample = static_cast<float>(seed >> 8) / 8388608.0f - 1.0f;
+    }
+    return signal;
+}
+
+/**
+ * Double-precision cascade over one channel of an interleaved signal, using the
+ * same single-precision coefficients as the kernel
+ */
+static std::vector<double> referenceCascade(const std::vector<float>& input, int channels, int channel,
+                                            const std::vector<BiquadCoefficients>& coefficients) {
+    const size_t frames = input.size() / static_cast<size_t>(channels);
+    std::vector<double> output(frames);
+    std::vector<double> state1(coefficients.size(), 0.0);
+    std::vector<double> state2(coefficients.size(), 0.0);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        double x = input[frame * channels + channel];
+        for (size_t band = 0; band < coefficients.size(); ++band) {
+            const BiquadCoefficients& c = coefficients[band];
+            const double y = c.b0 * x + state1[band];
+            state1[band] = c.b1 * x - c.a1 * y + state2[band];
+            state2[band] = c.b2 * x - c.a2 * y;
+            x = y;
+        }
+        output[frame] = x;
+    }
+    return output;
+}
+
+static float cascadeError(int channels, bool planar) {
+    BiquadCascadeKernel kernel(kTestSampleRate, channels, kTestBands, DenormalMode::HardwareFTZ, kTestFrames);
+    std::vector<BiquadCoefficients> coefficients;
+    for (int band = 0; band < kTestBands; ++band) {
+        kernel.setBand(band, makeBand(band));
+        coefficients.push_back(BiquadCoefficients::peaking(makeBand(band), kTestSampleRate));
+    }
+    // Picks the bands up without a ramp, as a freshly constructed kernel would
+    auto prepared = kernel.fork();
+
+    const size_t blocks = 16;
+    const std::vector<float> input = makeNoise(blocks * kTestFrames * channels);
+    std::vector<float> output(input.size(), 0.0f);
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t offset = block * kTestFrames * channels;
+        if (planar) {
+            std::vector<float> planarInput(kTestFrames * channels);
+            for (size_t frame = 0; frame < kTestFrames; ++frame) {
+                for (int channel = 0; channel < channels; ++channel) {
+                    planarInput[channel * kTestFrames + frame] = input[offset + frame * channels + channel];
+                }
+            }
+            std::vector<float> planarOutput(planarInput.size());
+            prepared->process(planarInput.data(), planarOutput.data(), kTestFrames);
+            for (size_t frame = 0; frame < kTestFrames; ++frame) {
+                for (int channel = 0; channel < channels; ++channel) {
+                    output[offset + frame * channels + channel] = planarOutput[channel * kTestFrames + frame];
+                }
+            }
+        }
+        else {
+            prepared->processInterleaved(input.data() + offset, output.data() + offset, kTestFrames);
+        }
+    }
+
+    float maxError = 0.0f;
+    for (int channel = 0; channel < channels; ++channel) {
+        const std::vector<double> expected = referenceCascade(input, channels, channel, coefficients);
+        for (size_t frame = 0; frame < expected.size(); ++frame) {
+            maxError = std::max(maxError, static_cast<float>(std::fabs(output[frame * channels + channel] - expected[frame])));
+        }
+    }
+    return maxError;
+}
+
+static double sineGain(BiquadCascadeKernel& kernel, double frequency, size_t blocks) {
+    const int channels = kernel.channelCount();
+    std::vector<float> buffer(kTestFrames * channels);
+    double peak = 0.0;
+    size_t position = 0;
+    for (size_t block = 0; block < blocks; ++block) {
+        for (size_t frame = 0; frame < kTestFrames; ++frame, ++position) {
+            const float sample = static_cast<float>(
+                std::sin(2.0 * std::numbers::pi * frequency * position / kTestSampleRate));
+            for (int channel = 0; channel < channels; ++channel) {
+                buffer[frame * channels + channel] = sample;
+            }
+        }
+        kernel.processInterleaved(buffer.data(), buffer.data(), kTestFrames);
+        if (block + 4 >= blocks) {
+            for (float sample : buffer) {
+                peak = std::max(peak, static_cast<double>(std::fabs(sample)));
+            }
+        }
+    }
+    return peak;
+}
+
+@interface BiquadCascadeKernelTests : XCTestCase
+@end
+
+@implementation BiquadCascadeKernelTests
+
+// MARK: - Configuration Tests
+
+- (void)testInvalidBandCountsThrow {
+    XCTAssertThrows(BiquadCascadeKernel(kTestSampleRate, 2, 0));
+    XCTAssertThrows(BiquadCascadeKernel(kTestSampleRate, 2, MAX_BIQUAD_BANDS + 1));
+
+    BiquadCascadeKernel kernel(kTestSampleRate, 2, kTestBands);
+    XCTAssertFalse(kernel.setBand(kTestBands, makeBand(0)));
+    XCTAssertFalse(kernel.setBand(-1, makeBand(0)));
+}
+
+- (void)testFlatBandsAreTransparent {
+    BiquadCascadeKernel kernel(kTestSampleRate, 8, MAX_BIQUAD_BANDS, DenormalMode::HardwareFTZ, kTestFrames);
+    const std::vector<float> input = makeNoise(kTestFrames * 8);
+    std::vector<float> output(input.size(), 0.0f);
+    kernel.processInterleaved(input.data(), output.data(), kTestFrames);
+    for (size_t i = 0; i < input.size(); ++i) {
+        XCTAssertEqual(output[i], input[i]);
+    }
+}
+
+// MARK: - Filter Tests
+
+- (void)testCascadeMatchesReferenceForEveryLaneWidth {
+    // Single-precision rounding in the 31.5 Hz band dominates the remaining error
+    XCTAssertLessThan(cascadeError(1, false), 1.0e-3f);
+    XCTAssertLessThan(cascadeError(2, true), 1.0e-3f);
+    XCTAssertLessThan(cascadeError(6, false), 1.0e-3f);
+    XCTAssertLessThan(cascadeError(8, false), 1.0e-3f);
+    XCTAssertLessThan(cascadeError(8, true), 1.0e-3f);
+}
+
+- (void)testPeakingBandReachesItsGainAtTheCentre {
+    BiquadCascadeKernel kernel(kTestSampleRate, 2, 1, DenormalMode::HardwareFTZ, kTestFrames);
+    BiquadBand band;
+    band.frequency = 1000.0f;
+    band.gainDB = 9.0f;
+    band.q = 2.0f;
+    kernel.setBand(0, band);
+    XCTAssertEqualWithAccuracy(sineGain(kernel, 1000.0, 40), std::pow(10.0, 9.0 / 20.0), 0.01);
+
+    // Far from the centre the band is nearly flat
+    BiquadCascadeKernel flat(kTestSampleRate, 2, 1, DenormalMode::HardwareFTZ, kTestFrames);
+    flat.setBand(0, band);
+    XCTAssertEqualWithAccuracy(sineGain(flat, 12000.0, 40), 1.0, 0.02);
+}
+
+// MARK: - Update Tests
+
+- (void)testBandUpdatesGlideWithoutSteps {
+    // A slow sine at the band centre; its second difference stays tiny unless the gain jumps
+    const double frequency = 100.0;
+    const float amplitude = 0.5f;
+    BiquadCascadeKernel kernel(kTestSampleRate, 1, 1, DenormalMode::HardwareFTZ, kTestFrames);
+    std::vector<float> buffer(kTestFrames);
+    std::vector<float> history;
+    size_t position = 0;
+    const auto render = [&](int blocks) {
+        for (int block = 0; block < blocks; ++block) {
+            for (float& sample : buffer) {
+                sample = amplitude * static_cast<float>(
+                    std::sin(2.0 * std::numbers::pi * frequency * position++ / kTestSampleRate));
+            }
+            kernel.process(buffer.data(), buffer.data(), kTestFrames);
+            history.insert(history.end(), buffer.begin(), buffer.end());
+        }
+    };
+    render(4);
+
+    BiquadBand band;
+    band.frequency = static_cast<float>(frequency);
+    band.gainDB = -MAX_BIQUAD_GAIN_DB;
+    band.q = 1.0f;
+    kernel.setBand(0, band);
+    const size_t updateFrame = history.size();
+    render(60);
+
+    float largestCurvature = 0.0f;
+    for (size_t i = updateFrame; i + 1 < history.size(); ++i) {
+        largestCurvature = std::max(largestCurvature, std::fabs(history[i + 1] - 2.0f * history[i] + history[i - 1]));
+    }
+    XCTAssertLessThan(largestCurvature, 1.0e-3f);
+
+    float finalPeak = 0.0f;
+    for (size_t i = history.size() - 2 * kTestFrames; i < history.size(); ++i) {
+        finalPeak = std::max(finalPeak, std::fabs(history[i]));
+    }
+    XCTAssertEqualWithAccuracy(finalPeak, amplitude * std::pow(10.0f, -MAX_BIQUAD_GAIN_DB / 20.0f), 0.01f);
+}
+
+- (void)testForkStartsOnLatestBands {
+    BiquadCascadeKernel kernel(kTestSampleRate, 2, kTestBands);
+    for (int band = 0; band < kTestBands; ++band) {
+        kernel.setBand(band, makeBand(band));
+    }
+    auto fork = kernel.fork();
+    const BiquadCascadeKernel& cascade = static_cast<const BiquadCascadeKernel&>(*fork);
+    XCTAssertEqual(cascade.bandCount(), kTestBands);
+    XCTAssertEqual(cascade.bandSettings(3).gainDB, makeBand(3).gainDB);
+    XCTAssertEqual(cascade.bandSettings(3).frequency, makeBand(3).frequency);
+}
+
+@end
@@ -0,0 +1,309 @@
+//
+// ConvolutionKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the partitioned FFT convolution kernel
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../shared/DSP/ConvolutionKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestImpulseLength = 3000;   // Spans many 256-frame partitions
+static const size_t kTestSignalLength = 4096;
+static const float kTestTolerance = 1.0e-4f;
+
+static std::vector<float> randomSignal(size_t length, unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> signal(length);
+    for (float& sample : signal) {
+        sample = distribution(generator);
+    }
+    return signal;
+}
+
+static std::vector<float> directConvolution(const std::vector<float>& signal, const std::vector<float>& impulse) {
+    std::vector<float> result(signal.size(), 0.0f);
+    for (size_t n = 0; n < signal.size(); ++n) {
+        double sum = 0.0;
+        for (size_t k = 0; k < impulse.size() && k <= n; ++k) {
+            sum += static_cast<double>(impulse[k]) * signal[n - k];
+        }
+        result[n] = static_cast<float>(sum);
+    }
+    return result;
+}
+
+/**
+ * Runs both channels through the kernel in host blocks of varying size and returns planar output.
+ */
+static std::vector<float> renderPlanar(ConvolutionKernel& kernel, const std::vector<float>& left,
+                                       const std::vector<float>& right, const std::vector<size_t>& blockSizes) {
+    std::vector<float> result(kTestSignalLength * kTestChannels);
+    size_t position = 0;
+    size_t blockIndex = 0;
+    while (position < kTestSignalLength) {
+        const size_t frames = std::min(blockSizes[blockIndex++ % blockSizes.size()], kTestSignalLength - position);
+        const float* inputs[kTestChannels] = { left.data() + position, right.data() + position };
+        float* outputs[kTestChannels] = { result.data() + position, result.data() + kTestSignalLength + position };
+        kernel.processPlanar(inputs, outputs, frames);
+        position += frames;
+    }
+    return result;
+}
+
+@interface ConvolutionKernelTests : XCTestCase
+@end
+
+@implementation ConvolutionKernelTests {
+    std::vector<float> _left;
+    std::vector<float> _right;
+    std::vector<float> _leftImpulse;
+    std::vector<float> _rightImpulse;
+}
+
+// MARK: - Test Lifecycle
+
+- (void)setUp {
+    [super setUp];
+    _left = randomSignal(kTestSignalLength, 1);
+    _right = randomSignal(kTestSignalLength, 2);
+    _leftImpulse = randomSignal(kTestImpulseLength, 3);
+    _rightImpulse = randomSignal(kTestImpulseLength, 4);
+    for (size_t i = 0; i < kTestImpulseLength; ++i) {
+        // Decaying tail keeps the output in a realistic range
+        const float decay = std::exp(-static_cast<float>(i) / 600.0f) * 0.1f;
+        _leftImpulse[i] *= decay;
+        _rightImpulse[i] *= decay;
+    }
+}
+
+// MARK: - Convolution Tests
+
+- (void)testMatchesDirectConvolutionAtPartitionSize {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+
+    const std::vector<float> result = renderPlanar(kernel, _left, _right, { DEFAULT_CONVOLUTION_BLOCK_SIZE });
+    const std::vector<float> expectedLeft = directConvolution(_left, _leftImpulse);
+    const std::vector<float> expectedRight = directConvolution(_right, _rightImpulse);
+
+    for (size_t i = 0; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(result[i], expectedLeft[i], kTestTolerance);
+        XCTAssertEqualWithAccuracy(result[kTestSignalLength + i], expectedRight[i], kTestTolerance);
+    }
+}
+
+- (void)testIrregularHostBlocksAddNoLatency {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+    XCTAssertEqual(kernel.latencyFrames(), 0u);
+
+    const std::vector<float> result = renderPlanar(kernel, _left, _right, { 100, 37, 512, 1, 256, 300 });
+    const std::vector<float> expectedLeft = directConvolution(_left, _leftImpulse);
+
+    for (size_t i = 0; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(result[i], expectedLeft[i], kTestTolerance);
+    }
+}
+
+- (void)testMonoSourceRoutesToBothEarFilters {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 0 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+
+    const std::vector<float> result = renderPlanar(kernel, _left, _right, { DEFAULT_CONVOLUTION_BLOCK_SIZE });
+    const std::vector<float> expectedRight = directConvolution(_left, _rightImpulse);
+
+    for (size_t i = 0; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(result[kTestSignalLength + i], expectedRight[i], kTestTolerance);
+    }
+}
+
+- (void)testPassesThroughUntilFiltersLoaded {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const std::vector<float> result = renderPlanar(kernel, _left, _right, { DEFAULT_CONVOLUTION_BLOCK_SIZE });
+
+    for (size_t i = 0; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(result[i], _left[i], kTestTolerance);
+    }
+}
+
+- (void)testSecondLoadWaitsForRenderThread {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+    XCTAssertFalse(kernel.setImpulseResponses(responses, kTestChannels));
+
+    std::vector<float> block(DEFAULT_CONVOLUTION_BLOCK_SIZE * kTestChannels, 0.0f);
+    kernel.process(block.data(), block.data(), DEFAULT_CONVOLUTION_BLOCK_SIZE);
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+}
+
+- (void)testResetClearsTailAtNextBlock {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+
+    std::vector<float> block(DEFAULT_CONVOLUTION_BLOCK_SIZE * kTestChannels, 1.0f);
+    kernel.process(block.data(), block.data(), DEFAULT_CONVOLUTION_BLOCK_SIZE);
+
+    // Without the reset, silence in would still ring out through the 3000-tap tail
+    kernel.reset();
+    std::fill(block.begin(), block.end(), 0.0f);
+    kernel.process(block.data(), block.data(), DEFAULT_CONVOLUTION_BLOCK_SIZE);
+    for (float sample : block) {
+        XCTAssertEqual(sample, 0.0f);
+    }
+}
+
+- (void)testForkSharesFilterSetAndRendersIndependently {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+
+    std::unique_ptr<DSPKernel> fork = kernel.fork();
+    auto& convolver = static_cast<ConvolutionKernel&>(*fork);
+    XCTAssertEqual(convolver.filter().get(), kernel.filter().get());
+
+    // Render the original first; the fork's history must be untouched by it
+    const std::vector<float> original = renderPlanar(kernel, _left, _right, { DEFAULT_CONVOLUTION_BLOCK_SIZE });
+    const std::vector<float> forked = renderPlanar(convolver, _left, _right, { 100, 37, 512 });
+    const std::vector<float> expectedLeft = directConvolution(_left, _leftImpulse);
+    for (size_t i = 0; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(original[i], expectedLeft[i], kTestTolerance);
+        XCTAssertEqualWithAccuracy(forked[i], expectedLeft[i], kTestTolerance);
+    }
+}
+
+- (void)testPrepareKeepsFiltersUnlessChannelCountChanges {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+    const PartitionedFilter* loaded = kernel.filter().get();
+
+    kernel.prepare(DEFAULT_CONVOLUTION_BLOCK_SIZE, kTestChannels, 96000.0);
+    XCTAssertEqual(kernel.filter().get(), loaded);
+    XCTAssertEqual(kernel.maximumFramesPerBlock(), DEFAULT_CONVOLUTION_BLOCK_SIZE);
+    XCTAssertEqual(kernel.currentSampleRate(), 96000.0);
+
+    // A mono host format starts over as pass-through
+    kernel.prepare(DEFAULT_CONVOLUTION_BLOCK_SIZE, 1, kTestSampleRate);
+    XCTAssertEqual(kernel.channelCount(), 1);
+    std::vector<float> block(_left.begin(), _left.begin() + DEFAULT_CONVOLUTION_BLOCK_SIZE);
+    kernel.process(block.data(), block.data(), DEFAULT_CONVOLUTION_BLOCK_SIZE);
+    for (size_t i = 0; i < block.size(); ++i) {
+        XCTAssertEqualWithAccuracy(block[i], _left[i], kTestTolerance);
+    }
+}
+
+// MARK: - Filter Switching Tests
+
+- (void)testSwitchCrossfadesOverOnePartition {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const ImpulseResponse first[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    const ImpulseResponse second[kTestChannels] = {
+        { _rightImpulse.data(), kTestImpulseLength, 0 },
+        { _leftImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(first, kTestChannels));
+
+    const size_t partition = DEFAULT_CONVOLUTION_BLOCK_SIZE;
+    const size_t switchFrame = 8 * partition;
+    std::vector<float> result(kTestSignalLength);
+    for (size_t position = 0; position < kTestSignalLength; position += 100) {
+        // The switch lands on the first partition boundary after it is published
+        if (position == switchFrame - 48) {
+            XCTAssertTrue(kernel.setImpulseResponses(second, kTestChannels));
+        }
+        const size_t frames = std::min<size_t>(100, kTestSignalLength - position);
+        std::vector<float> right(frames, 0.0f);
+        const float* inputs[kTestChannels] = { _left.data() + position, right.data() };
+        float* outputs[kTestChannels] = { result.data() + position, right.data() };
+        kernel.processPlanar(inputs, outputs, frames);
+
+        // Busy until the fade partition completes
+        if (position + frames > switchFrame && position + frames < switchFrame + partition) {
+            XCTAssertFalse(kernel.setImpulseResponses(second, kTestChannels));
+        }
+    }
+
+    const std::vector<float> before = directConvolution(_left, _leftImpulse);
+    const std::vector<float> after = directConvolution(_left, _rightImpulse);
+    for (size_t i = 0; i < switchFrame; ++i) {
+        XCTAssertEqualWithAccuracy(result[i], before[i], kTestTolerance);
+    }
+    // The fade starts on the old filter's output and ends on the new one's
+    XCTAssertEqualWithAccuracy(result[switchFrame], before[switchFrame], 0.01f);
+    XCTAssertEqualWithAccuracy(result[switchFrame + partition - 1], after[switchFrame + partition - 1], 0.01f);
+    for (size_t i = switchFrame + partition; i < kTestSignalLength; ++i) {
+        XCTAssertEqualWithAccuracy(result[i], after[i], kTestTolerance);
+    }
+}
+
+- (void)testSetFilterRejectsMismatchedSets {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, kTestImpulseLength);
+    const SharedFFTSetup setup = acquireFFTSetup(KERNEL_FFT_LOG2N);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertThrows(kernel.setFilter(nullptr));
+    XCTAssertThrows(kernel.setFilter(PartitionedFilter::create(setup.get(), 128, responses, kTestChannels)));
+    XCTAssertThrows(kernel.setFilter(PartitionedFilter::create(setup.get(), DEFAULT_CONVOLUTION_BLOCK_SIZE,
+                                                               responses, 1)));
+
+    const auto shared = PartitionedFilter::create(setup.get(), DEFAULT_CONVOLUTION_BLOCK_SIZE, responses,
+                                                  kTestChannels);
+    XCTAssertTrue(kernel.setFilter(shared));
+    XCTAssertEqual(kernel.filter().get(), shared.get());
+}
+
+- (void)testRejectsImpulseLongerThanCapacity {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, 512);
+    const ImpulseResponse responses[kTestChannels] = {
+        { _leftImpulse.data(), kTestImpulseLength, 0 },
+        { _rightImpulse.data(), kTestImpulseLength, 1 }
+    };
+    XCTAssertThrows(kernel.setImpulseResponses(responses, kTestChannels));
+    XCTAssertThrows(ConvolutionKernel(kTestSampleRate, kTestChannels, 512, 100));
+}
+
+@end
@@ -0,0 +1,131 @@
+//
+// DSPBatchTests.mm
+// TALD UNIA
+//
+// Unit tests for batched kernel processing and the parallel stream renderer
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+#include "../../shared/DSP/DSPBatch.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestFrames = 256;
+static const size_t kTestStreams = 300;        // More than MAX_DSP_TASKS
+static const size_t kTestStreamFrames = 1000;  // Not a multiple of the block size
+
+static std::vector<float> makeStream(size_t stream, size_t samples) {
+    std::vector<float> signal(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        signal[i] = std::sin(0.01f * static_cast<float>(i) + static_cast<float>(stream));
+    }
+    return signal;
+}
+
+@interface DSPBatchTests : XCTestCase
+@end
+
+@implementation DSPBatchTests
+
+// MARK: - processBatch Tests
+
+- (void)testBatchMatchesConsecutiveProcessCalls {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -12.0f;
+    event.rampFrames = 600;   // Ramps across three blocks
+    event.shape = RampShape::Linear;
+
+    auto batched = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, kTestFrames);
+    auto single = batched->fork();
+    batched->scheduleParameter(event);
+    single->scheduleParameter(event);
+
+    const size_t blocks = 4;
+    const std::vector<float> input = makeStream(0, blocks * kTestFrames * kTestChannels);
+    std::vector<float> batchOutput(input.size(), 0.0f);
+    std::vector<float> singleOutput(input.size(), 0.0f);
+
+    std::vector<DSPBatchItem> items(blocks);
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t offset = block * kTestFrames * kTestChannels;
+        items[block].input = AudioBufferView::makeInterleaved(const_cast<float*>(input.data()) + offset,
+                                                              kTestChannels, kTestFrames);
+        items[block].output = AudioBufferView::makeInterleaved(batchOutput.data() + offset,
+                                                               kTestChannels, kTestFrames);
+        single->processInterleaved(input.data() + offset, singleOutput.data() + offset, kTestFrames);
+    }
+    batched->processBatch(items.data(), items.size());
+
+    for (size_t i = 0; i < input.size(); ++i) {
+        XCTAssertEqual(batchOutput[i], singleOutput[i]);
+    }
+    DSPMetricsSnapshot snapshot;
+    XCTAssertTrue(batched->metrics().snapshot(snapshot));
+    XCTAssertEqual(snapshot.blocks, 1u);
+}
+
+// MARK: - Renderer Tests
+
+- (void)testRendererIsIndependentOfThreadAssignment {
+    auto prototype = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, kTestFrames);
+    prototype->setParameter(kParameterGain, -6.0f);
+
+    const size_t stride = kTestStreamFrames * kTestChannels;
+    std::vector<float> input(kTestStreams * stride);
+    for (size_t stream = 0; stream < kTestStreams; ++stream) {
+        const std::vector<float> signal = makeStream(stream, stride);
+        std::copy(signal.begin(), signal.end(), input.begin() + stream * stride);
+    }
+
+    std::vector<float> serial(input.size(), 0.0f);
+    DSPBatchRenderer serialRenderer(*prototype);
+    XCTAssertEqual(serialRenderer.participantCount(), 1);
+    serialRenderer.renderInterleaved(input.data(), serial.data(), kTestStreams, kTestStreamFrames, stride);
+
+    DSPWorkerPool pool(3);
+    DSPBatchRenderer parallelRenderer(*prototype, &pool);
+    XCTAssertEqual(parallelRenderer.participantCount(), 4);
+    std::vector<float> parallel(input.size(), 0.0f);
+    parallelRenderer.renderInterleaved(input.data(), parallel.data(), kTestStreams, kTestStreamFrames, stride);
+
+    // Every stream starts exactly on the prototype's gain, whichever fork rendered it
+    XCTAssertEqual(std::memcmp(parallel.data(), serial.data(), serial.size() * sizeof(float)), 0);
+    const float gain = std::pow(10.0f, -6.0f / 20.0f);
+    float maxError = 0.0f;
+    for (size_t i = 0; i < input.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(serial[i] - input[i] * gain));
+    }
+    XCTAssertLessThan(maxError, 1.0e-5f);
+}
+
+- (void)testRendererRestartsStreamsFromPrototypeState {
+    auto prototype = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, kTestFrames);
+    prototype->setParameter(kParameterGain, -6.0f);
+    DSPBatchRenderer renderer(*prototype);
+
+    std::vector<float> first(kTestFrames * kTestChannels, 1.0f);
+    std::vector<float> second(kTestFrames * kTestChannels, 1.0f);
+    const DSPBatchItem firstItem{ AudioBufferView::makeInterleaved(first.data(), kTestChannels, kTestFrames),
+                                  AudioBufferView::makeInterleaved(first.data(), kTestChannels, kTestFrames) };
+    const DSPBatchItem secondItem{ AudioBufferView::makeInterleaved(second.data(), kTestChannels, kTestFrames),
+                                   AudioBufferView::makeInterleaved(second.data(), kTestChannels, kTestFrames) };
+    const DSPBatchStream streams[] = { { &firstItem, 1 }, { &secondItem, 1 } };
+
+    renderer.render(streams, 2);
+    for (size_t i = 0; i < first.size(); ++i) {
+        XCTAssertEqual(first[i], second[i]);
+    }
+}
+
+@end
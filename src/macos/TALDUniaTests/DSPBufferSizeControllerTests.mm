@@ -0,0 +1,190 @@
+//
+// DSPBufferSizeControllerTests.mm
+// TALD UNIA
+//
+// Unit tests for the adaptive HAL buffer size controller
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <functional>
+#include "../../shared/DSP/DSPBufferSizeController.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const uint64_t kTestSettleBlocks = 200;
+
+static BufferSizePolicy makePolicy() {
+    BufferSizePolicy policy;
+    policy.settleBlocks = kTestSettleBlocks;
+    policy.retrySeconds = 1.0;
+    return policy;
+}
+
+// Render blocks at the controller's current size, each taking `load` of its budget
+static void renderBlocks(DSPBlockMetrics& metrics, const BufferSizeController& controller, uint64_t blocks,
+                         const std::function<double(size_t)>& load) {
+    const double budget = static_cast<double>(controller.bufferFrames()) / kTestSampleRate * 1.0e9;
+    for (uint64_t block = 0; block < blocks; ++block) {
+        metrics.record(static_cast<uint64_t>(load(controller.bufferFrames()) * budget), budget);
+    }
+}
+
+@interface DSPBufferSizeControllerTests : XCTestCase
+@end
+
+@implementation DSPBufferSizeControllerTests {
+    DSPBlockMetrics _metrics;
+}
+
+// MARK: - Configuration Tests
+
+- (void)testInvalidPoliciesThrow {
+    BufferSizePolicy policy = makePolicy();
+    policy.minimumFrames = 96;
+    XCTAssertThrows(BufferSizeController(_metrics, kTestSampleRate, 256, policy));
+
+    policy = makePolicy();
+    policy.minimumFrames = 32;
+    XCTAssertThrows(BufferSizeController(_metrics, kTestSampleRate, 256, policy));
+
+    policy = makePolicy();
+    policy.maximumFrames = 2 * MAX_BUFFER_SIZE;
+    XCTAssertThrows(BufferSizeController(_metrics, kTestSampleRate, 256, policy));
+
+    policy = makePolicy();
+    policy.targetLoad = 0.0f;
+    XCTAssertThrows(BufferSizeController(_metrics, kTestSampleRate, 256, policy));
+    XCTAssertThrows(BufferSizeController(_metrics, 1000.0, 256, makePolicy()));
+}
+
+- (void)testInitialSizeIsRoundedIntoLimits {
+    XCTAssertEqual(BufferSizeController(_metrics, kTestSampleRate, 300, makePolicy()).bufferFrames(), 512u);
+    XCTAssertEqual(BufferSizeController(_metrics, kTestSampleRate, 16, makePolicy()).bufferFrames(), 64u);
+    XCTAssertEqual(BufferSizeController(_metrics, kTestSampleRate, 8192, makePolicy()).bufferFrames(), 1024u);
+}
+
+// MARK: - Control Tests
+
+- (void)testLightLoadWalksDownToMinimum {
+    BufferSizeController controller(_metrics, kTestSampleRate, 1024, makePolicy());
+    const auto light = [](size_t) { return 0.1; };
+
+    int steps = 0;
+    for (int round = 0; round < 20 && controller.bufferFrames() > 64; ++round) {
+        renderBlocks(_metrics, controller, kTestSettleBlocks, light);
+        if (controller.update() == BufferSizeDecision::StepDown) {
+            ++steps;
+        }
+    }
+    XCTAssertEqual(controller.bufferFrames(), 64u);
+    XCTAssertEqual(steps, 4);
+
+    renderBlocks(_metrics, controller, kTestSettleBlocks, light);
+    XCTAssertEqual(controller.update(), BufferSizeDecision::Hold);
+    XCTAssertEqual(controller.backoffCount(), 0u);
+}
+
+- (void)testStepsDownOnlyAfterSettling {
+    BufferSizeController controller(_metrics, kTestSampleRate, 512, makePolicy());
+    renderBlocks(_metrics, controller, kTestSettleBlocks / 2, [](size_t) { return 0.1; });
+    XCTAssertEqual(controller.update(), BufferSizeDecision::Settling);
+    XCTAssertEqual(controller.bufferFrames(), 512u);
+}
+
+- (void)testDecisionsWaitForTheClearToReachTheRenderThread {
+    BufferSizeController controller(_metrics, kTestSampleRate, 512, makePolicy());
+    renderBlocks(_metrics, controller, kTestSettleBlocks, [](size_t) { return 0.1; });
+    XCTAssertEqual(controller.update(), BufferSizeDecision::StepDown);
+
+    // No block rendered since: the snapshot still holds the old size's statistics
+    XCTAssertEqual(controller.update(), BufferSizeDecision::Settling);
+    _metrics.reportXrun();
+    XCTAssertEqual(controller.update(), BufferSizeDecision::Settling);
+    XCTAssertEqual(controller.bufferFrames(), 256u);
+
+    // The xrun counts against the new size once its statistics start
+    renderBlocks(_metrics, controller, 1, [](size_t) { return 0.1; });
+    XCTAssertEqual(controller.update(), BufferSizeDecision::BackOff);
+    XCTAssertEqual(controller.bufferFrames(), 512u);
+}
+
+- (void)testSettlesAtLowestSustainableSize {
+    BufferSizePolicy policy = makePolicy();
+    policy.retrySeconds = 60.0;
+    BufferSizeController controller(_metrics, kTestSampleRate, 1024, policy);
+
+    // Fixed per-block overhead: 256 -> 0.23, 128 -> 0.35, 64 -> 0.6
+    const auto overhead = [](size_t frames) { return 0.1 + 32.0 / static_cast<double>(frames); };
+    BufferSizeDecision decision = BufferSizeDecision::Settling;
+    for (int round = 0; round < 8; ++round) {
+        renderBlocks(_metrics, controller, kTestSettleBlocks, overhead);
+        decision = controller.update();
+    }
+    XCTAssertEqual(controller.bufferFrames(), 128u);
+    XCTAssertEqual(decision, BufferSizeDecision::Hold);
+    XCTAssertEqual(controller.backoffCount(), 1u);
+    XCTAssertFalse(controller.isAllowed(64));
+}
+
+- (void)testXrunBacksOffImmediately {
+    BufferSizeController controller(_metrics, kTestSampleRate, 128, makePolicy());
+    renderBlocks(_metrics, controller, 10, [](size_t) { return 0.1; });
+    _metrics.reportXrun();
+    XCTAssertEqual(controller.update(), BufferSizeDecision::BackOff);
+    XCTAssertEqual(controller.bufferFrames(), 256u);
+    XCTAssertFalse(controller.isAllowed(128));
+    XCTAssertEqual(controller.backoffCount(), 1u);
+}
+
+- (void)testFailedSizeIsRetriedWithGrowingHold {
+    BufferSizeController controller(_metrics, kTestSampleRate, 128, makePolicy());
+    const auto overhead = [](size_t frames) { return 0.1 + 32.0 / static_cast<double>(frames); };
+
+    // Fail at 64 once and time how long until it is probed again
+    auto holdAfterFailure = [&]() {
+        while (controller.bufferFrames() != 64) {
+            renderBlocks(_metrics, controller, kTestSettleBlocks, overhead);
+            controller.update();
+        }
+        renderBlocks(_metrics, controller, kTestSettleBlocks, overhead);
+        XCTAssertEqual(controller.update(), BufferSizeDecision::StepUp);
+        const double failedAt = controller.renderedSeconds();
+        while (controller.bufferFrames() != 64) {
+            renderBlocks(_metrics, controller, kTestSettleBlocks, overhead);
+            controller.update();
+        }
+        return controller.renderedSeconds() - failedAt;
+    };
+
+    const double firstHold = holdAfterFailure();
+    const double secondHold = holdAfterFailure();
+    XCTAssertGreaterThanOrEqual(firstHold, 1.0);
+    XCTAssertGreaterThanOrEqual(secondHold, 2.0);
+    XCTAssertLessThan(firstHold, 2.0);
+    XCTAssertEqual(controller.backoffCount(), 2u);
+}
+
+- (void)testHighLoadAtMaximumHolds {
+    BufferSizeController controller(_metrics, kTestSampleRate, 1024, makePolicy());
+    renderBlocks(_metrics, controller, kTestSettleBlocks, [](size_t) { return 0.9; });
+    XCTAssertEqual(controller.update(), BufferSizeDecision::Hold);
+    XCTAssertEqual(controller.bufferFrames(), 1024u);
+
+    // Repeated overload and xruns at the top are not failures: nothing changed size
+    for (int round = 0; round < 5; ++round) {
+        renderBlocks(_metrics, controller, 10, [](size_t) { return 0.9; });
+        _metrics.reportXrun();
+        XCTAssertEqual(controller.update(), BufferSizeDecision::Hold);
+        XCTAssertEqual(controller.update(), BufferSizeDecision::Hold);
+    }
+    XCTAssertEqual(controller.bufferFrames(), 1024u);
+    XCTAssertEqual(controller.backoffCount(), 0u);
+    XCTAssertTrue(controller.isAllowed(1024));
+}
+
+@end
@@ -0,0 +1,149 @@
+//
+// DSPGraphTests.mm
+// TALD UNIA
+//
+// Unit tests for the DSP graph and its work-stealing worker pool
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <vector>
+#include "../../shared/DSP/DSPGraph.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestFrames = 256;
+static const int kTestSources = 32;
+static const float kTestTolerance = 1.0e-4f;
+
+static std::unique_ptr<DSPKernel> gainKernel(float gainDB) {
+    auto kernel = createDSPKernel(kTestSampleRate, kTestChannels);
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = gainDB;
+    event.rampFrames = 1;
+    kernel->scheduleParameter(event);
+    return kernel;
+}
+
+static float sourceGainDB(int source) {
+    return -static_cast<float>(source % 7);
+}
+
+/**
+ * Sources, each through its own gain chain, summed at a mix bus and a master stage.
+ */
+static void buildSpatialGraph(DSPGraph& graph, DSPWorkerPool* pool) {
+    std::vector<DSPNodeID> chains;
+    for (int source = 0; source < kTestSources; ++source) {
+        const DSPNodeID input = graph.addSource(gainKernel(sourceGainDB(source)));
+        const DSPNodeID chainInputs[] = { input };
+        chains.push_back(graph.addNode(gainKernel(-1.0f), chainInputs));
+    }
+    const DSPNodeID bus[] = { graph.addMixBus(chains) };
+    graph.compile(graph.addNode(gainKernel(-6.0f), bus), pool);
+}
+
+@interface DSPGraphTests : XCTestCase
+@end
+
+@implementation DSPGraphTests {
+    std::vector<std::vector<float>> _sources;
+    std::vector<AudioBufferView> _sourceViews;
+}
+
+// MARK: - Test Lifecycle
+
+- (void)setUp {
+    [super setUp];
+    _sources.assign(kTestSources, std::vector<float>(kTestFrames * kTestChannels));
+    _sourceViews.clear();
+    for (int source = 0; source < kTestSources; ++source) {
+        for (size_t i = 0; i < kTestFrames * kTestChannels; ++i) {
+            _sources[source][i] = std::sin(0.01f * i + source);
+        }
+        _sourceViews.push_back(AudioBufferView::makeInterleaved(_sources[source].data(), kTestChannels,
+                                                                kTestFrames));
+    }
+}
+
+// MARK: - Rendering Tests
+
+- (void)testSerialGraphSumsSourceChainsAtMixBus {
+    DSPGraph graph(kTestChannels, kTestFrames);
+    buildSpatialGraph(graph, nullptr);
+    XCTAssertEqual(graph.sourceCount(), kTestSources);
+
+    std::vector<float> output(kTestFrames * kTestChannels);
+    graph.process(_sourceViews, AudioBufferView::makeInterleaved(output.data(), kTestChannels, kTestFrames));
+
+    for (size_t i = 0; i < output.size(); ++i) {
+        double expected = 0.0;
+        for (int source = 0; source < kTestSources; ++source) {
+            expected += _sources[source][i] * std::pow(10.0, (sourceGainDB(source) - 7.0) / 20.0);
+        }
+        XCTAssertEqualWithAccuracy(output[i], expected, kTestTolerance);
+    }
+}
+
+- (void)testWorkerPoolMatchesSerialRenderExactly {
+    DSPGraph serial(kTestChannels, kTestFrames);
+    buildSpatialGraph(serial, nullptr);
+
+    DSPWorkerPool pool(std::max(DSPWorkerPool::recommendedWorkerCount(), 3));
+    DSPGraph parallel(kTestChannels, kTestFrames);
+    buildSpatialGraph(parallel, &pool);
+
+    // Many blocks so every stealing pattern has a chance to show up
+    std::vector<float> expected(kTestFrames * kTestChannels);
+    std::vector<float> actual(kTestFrames * kTestChannels);
+    for (int block = 0; block < 500; ++block) {
+        serial.process(_sourceViews, AudioBufferView::makeInterleaved(expected.data(), kTestChannels, kTestFrames));
+        parallel.process(_sourceViews, AudioBufferView::makeInterleaved(actual.data(), kTestChannels, kTestFrames));
+        XCTAssertTrue(actual == expected, @"Block %d differs", block);
+    }
+}
+
+- (void)testKernelParametersAreReachableThroughGraph {
+    DSPGraph graph(kTestChannels, kTestFrames);
+    const DSPNodeID source = graph.addSource(createDSPKernel(kTestSampleRate, kTestChannels));
+    graph.compile(source);
+
+    graph.kernel(source)->setBypassed(true);
+    std::vector<float> output(kTestFrames * kTestChannels);
+    graph.process({ &_sourceViews[0], 1 },
+                  AudioBufferView::makeInterleaved(output.data(), kTestChannels, kTestFrames));
+    XCTAssertTrue(output == _sources[0]);
+}
+
+// MARK: - Validation Tests
+
+- (void)testRejectsInvalidTopologies {
+    DSPGraph dangling(kTestChannels, kTestFrames);
+    const DSPNodeID first = dangling.addSource(nullptr);
+    dangling.addSource(nullptr);
+    XCTAssertThrows(dangling.compile(first));
+
+    DSPGraph mismatched(kTestChannels, kTestFrames);
+    XCTAssertThrows(mismatched.addSource(createDSPKernel(kTestSampleRate, 4)));
+
+    const DSPNodeID missing[] = { 3 };
+    XCTAssertThrows(mismatched.addNode(nullptr, missing));
+}
+
+- (void)testIgnoresBlocksThatDoNotMatchGraph {
+    DSPGraph graph(kTestChannels, kTestFrames);
+    graph.compile(graph.addSource(nullptr));
+
+    std::vector<float> output(kTestFrames * kTestChannels, -1.0f);
+    graph.process({}, AudioBufferView::makeInterleaved(output.data(), kTestChannels, kTestFrames));
+    XCTAssertEqual(output[0], -1.0f);
+}
+
+@end
@@ -0,0 +1,207 @@
+//
+// DSPKernelBenchmarks.mm
+// TALD UNIA
+//
+// Performance benchmarks for the C++ DSP kernel hot path
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+#import <Accelerate/Accelerate.h>
+
+#include <cmath>
+#include <set>
+#include <string>
+#include <vector>
+#include "../../shared/DSP/DSPBenchmark.hpp"
+#include "../../shared/DSP/DSPKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Benchmark Constants
+
+static const double kBenchmarkSampleRate = MAX_SAMPLE_RATE;
+static const int kBenchmarkChannels = MAX_CHANNELS;
+static const size_t kBenchmarkFrames = MAX_BUFFER_SIZE;
+static const int kBenchmarkIterations = 64;
+
+// Memory traffic per sample: each full pass reads and writes one float
+static const size_t kBytesPerPass = 2 * sizeof(float);
+static const size_t kLegacyPasses = 5;  // mmov in, channel gain, block gain, denormals, mmov out
+
+// Sweep timing kept short so the whole axis sweep fits in a normal test run
+static const double kSweepSecondsPerRepetition = 0.002;
+static const int kSweepRepetitions = 3;
+
+/**
+ * Reproduces the original five-pass process() sequence so both paths are timed on
+ * identical data and hardware.
+ */
+static void processLegacyReference(const float* input, float* output, float* inputStage,
+                                   float* outputStage, size_t frameCount, int channels, float gain) {
+    const float threshold = 1.0e-15f;
+    vDSP_mmov(input, inputStage, frameCount, channels, frameCount, frameCount);
+    for (int channel = 0; channel < channels; ++channel) {
+        vDSP_vsmul(inputStage + channel * frameCount, 1, &gain,
+                   outputStage + channel * frameCount, 1, frameCount);
+    }
+    vDSP_vsmul(outputStage, 1, &gain, outputStage, 1, frameCount * channels);
+    for (size_t i = 0; i < frameCount * channels; i += SIMD_VECTOR_SIZE) {
+        vDSP_vthres(outputStage + i, 1, &threshold, outputStage + i, 1, SIMD_VECTOR_SIZE);
+    }
+    vDSP_mmov(outputStage, output, frameCount, channels, frameCount, frameCount);
+}
+
+@interface DSPKernelBenchmarks : XCTestCase
+@end
+
+@implementation DSPKernelBenchmarks {
+    std::vector<float> _input;
+    std::vector<float> _output;
+    std::vector<float> _inputStage;
+    std::vector<float> _outputStage;
+}
+
+// MARK: - Test Lifecycle
+
+- (void)setUp {
+    [super setUp];
+    const size_t sampleCount = kBenchmarkFrames * kBenchmarkChannels;
+    _input.resize(sampleCount);
+    _output.assign(sampleCount, 0.0f);
+    _inputStage.assign(sampleCount, 0.0f);
+    _outputStage.assign(sampleCount, 0.0f);
+
+    for (size_t i = 0; i < sampleCount; ++i) {
+        _input[i] = static_cast<float>(std::sin(2.0 * M_PI * 1000.0 * static_cast<double>(i) / kBenchmarkSampleRate));
+    }
+}
+
+// MARK: - Memory Traffic
+
+- (void)testBytesTouchedPerFrame {
+    BenchmarkCase testCase;
+    testCase.frames = kBenchmarkFrames;
+    testCase.channels = kBenchmarkChannels;
+    testCase.sampleRate = kBenchmarkSampleRate;
+    testCase.mode = BenchmarkMode::Gain;
+
+    BenchmarkOptions options;
+    options.minSecondsPerRepetition = kSweepSecondsPerRepetition;
+    options.repetitions = 1;
+    const BenchmarkResult result = runKernelBenchmark(testCase, options);
+
+    const double legacyBytes = static_cast<double>(kLegacyPasses * kBytesPerPass * kBenchmarkChannels);
+    const double fusedBytes = result.bytesPerSample * kBenchmarkChannels;
+    const double bytesPerSecondSaved = (legacyBytes - fusedBytes) * kBenchmarkSampleRate;
+
+    NSLog(@"DSPKernel bytes/frame (%d ch): legacy=%.0f fused=%.0f, saves %.1f MB/s at %.0f Hz",
+          kBenchmarkChannels, legacyBytes, fusedBytes, bytesPerSecondSaved / 1.0e6, kBenchmarkSampleRate);
+
+    // The fused kernel reads the host input and writes the host output once, no staging
+    XCTAssertEqualWithAccuracy(result.bytesPerSample, static_cast<double>(kBytesPerPass), 1.0e-9);
+    XCTAssertLessThan(fusedBytes, legacyBytes);
+}
+
+// MARK: - Throughput
+
+- (void)testLegacyReferenceThroughput {
+    const float gain = std::pow(10.0f, -6.0f / 40.0f); // Legacy path applied gain twice
+    [self measureBlock:^{
+        for (int i = 0; i < kBenchmarkIterations; ++i) {
+            processLegacyReference(_input.data(), _output.data(), _inputStage.data(), _outputStage.data(),
+                                   kBenchmarkFrames, kBenchmarkChannels, gain);
+        }
+    }];
+}
+
+- (void)testFusedKernelThroughput {
+    auto kernel = createDSPKernel(kBenchmarkSampleRate, kBenchmarkChannels);
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.rampFrames = 1;
+    kernel->scheduleParameter(event);
+    kernel->process(_input.data(), _output.data(), kBenchmarkFrames);
+
+    DSPKernel* kernelPtr = kernel.get();
+    [self measureBlock:^{
+        for (int i = 0; i < kBenchmarkIterations; ++i) {
+            kernelPtr->process(_input.data(), _output.data(), kBenchmarkFrames);
+        }
+    }];
+}
+
+- (void)testFusedKernelMatchesReference {
+    auto kernel = createDSPKernel(kBenchmarkSampleRate, kBenchmarkChannels);
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.rampFrames = 1;
+    kernel->scheduleParameter(event);
+    kernel->process(_input.data(), _output.data(), kBenchmarkFrames);
+
+    std::vector<float> reference(_output.size());
+    const float gain = std::pow(10.0f, -6.0f / 20.0f);
+    for (size_t i = 0; i < reference.size(); ++i) {
+        const float sample = _input[i] * gain;
+        reference[i] = (std::fabs(sample) < 1.0e-15f) ? 0.0f : sample;
+    }
+
+    for (size_t i = 0; i < reference.size(); ++i) {
+        XCTAssertEqualWithAccuracy(_output[i], reference[i], 1.0e-5f);
+    }
+}
+
+// MARK: - Parameter Sweep
+
+- (void)testSweepCaseNamesAreUnique {
+    const std::vector<BenchmarkCase> cases = BenchmarkSweep::full().cartesian();
+    std::set<std::string> names;
+    for (const BenchmarkCase& testCase : cases) {
+        names.insert(testCase.name());
+    }
+    XCTAssertEqual(names.size(), cases.size());
+    XCTAssertLessThan(BenchmarkSweep::full().axes().size(), cases.size());
+}
+
+/**
+ * Runs every sweep dimension around the default case and writes Google Benchmark
+ * JSON to $TALD_BENCHMARK_OUTPUT (or the temporary directory) for comparison tools.
+ */
+- (void)testKernelSweepWritesBenchmarkJSON {
+    BenchmarkOptions options;
+    options.minSecondsPerRepetition = kSweepSecondsPerRepetition;
+    options.repetitions = kSweepRepetitions;
+
+    std::vector<BenchmarkResult> results;
+    for (const BenchmarkCase& testCase : BenchmarkSweep::full().axes()) {
+        results.push_back(runKernelBenchmark(testCase, options));
+    }
+
+    for (const BenchmarkResult& result : results) {
+        XCTAssertGreaterThan(result.iterations, 0u);
+        XCTAssertTrue(std::isfinite(result.nsPerSample) && result.nsPerSample > 0.0,
+                      @"%s", result.testCase.name().c_str());
+        XCTAssertGreaterThan(result.realtimeFactor, 0.0);
+        XCTAssertGreaterThanOrEqual(result.bytesPerSample, static_cast<double>(kBytesPerPass));
+    }
+
+    NSString* json = [NSString stringWithUTF8String:benchmarkResultsJSON(results).c_str()];
+    NSData* data = [json dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertNotNil([NSJSONSerialization JSONObjectWithData:data options:0 error:nil]);
+
+    NSString* path = NSProcessInfo.processInfo.environment[@"TALD_BENCHMARK_OUTPUT"];
+    if (path.length == 0) {
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"DSPKernelBenchmarks.json"];
+    }
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+
+    XCTAttachment* attachment = [XCTAttachment attachmentWithData:data uniformTypeIdentifier:@"public.json"];
+    attachment.name = @"DSPKernelBenchmarks.json";
+    attachment.lifetime = XCTAttachmentLifetimeKeepAlways;
+    [self addAttachment:attachment];
+    NSLog(@"DSPKernel sweep: %zu cases written to %@", results.size(), path);
+}
+
+@end
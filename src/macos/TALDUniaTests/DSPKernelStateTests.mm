@@ -0,0 +1,356 @@
+//
+// DSPKernelStateTests.mm
+// TALD UNIA
+//
+// Unit tests for kernel state serialization and crossfaded hot swaps
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <thread>
+#include <vector>
+#include "../../shared/DSP/BiquadCascadeKernel.hpp"
+#include "../../shared/DSP/ConvolutionKernel.hpp"
+#include "../../shared/DSP/DynamicsKernel.hpp"
+#include "../../shared/DSP/HotSwapKernel.hpp"
+#include "../../shared/DSP/SpectrumAnalyzerKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestBlockSize = 128;
+
+// Interleaved stereo test signal with different content per channel
+static std::vector<float> makeSignal(size_t frames) {
+    std::vector<float> samples(frames * kTestChannels);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const double time = static_cast<double>(frame) / kTestSampleRate;
+        samples[frame * kTestChannels] = 0.5f * static_cast<float>(std::sin(2.0 * std::numbers::pi * 440.0 * time));
+        samples[frame * kTestChannels + 1] = 0.3f * static_cast<float>(std::sin(2.0 * std::numbers::pi * 3100.0 * time));
+    }
+    return samples;
+}
+
+// Render a copy of a signal block by block
+static std::vector<float> render(DSPKernel& kernel, const std::vector<float>& source) {
+    std::vector<float> samples = source;
+    const size_t frames = samples.size() / kTestChannels;
+    for (size_t offset = 0; offset < frames; offset += kTestBlockSize) {
+        const size_t count = std::min(kTestBlockSize, frames - offset);
+        const AudioBufferView view = AudioBufferView::makeInterleaved(samples.data() + offset * kTestChannels,
+                                                                      kTestChannels, count);
+        kernel.process(view, view);
+    }
+    return samples;
+}
+
+static std::unique_ptr<DSPKernel> restore(const std::vector<uint8_t>& state) {
+    return DSPKernel::restoreState(state.data(), state.size());
+}
+
+static std::unique_ptr<DSPKernel> makeGainKernel(float gainDB) {
+    std::unique_ptr<DSPKernel> kernel = createDSPKernel(kTestSampleRate, kTestChannels);
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = gainDB;
+    event.rampFrames = 1;
+    kernel->scheduleParameter(event);
+    return kernel;
+}
+
+@interface DSPKernelStateTests : XCTestCase
+@end
+
+@implementation DSPKernelStateTests
+
+// MARK: - Serialization Tests
+
+- (void)testGainKernelRoundTripsConfigurationAndParameters {
+    std::unique_ptr<DSPKernel> kernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::Off, 256);
+    kernel->setParameter(kParameterGain, -9.0f);
+    kernel->setBypassed(true);
+
+    std::unique_ptr<DSPKernel> restored = restore(kernel->serializeState());
+    XCTAssertEqual(restored->currentSampleRate(), kTestSampleRate);
+    XCTAssertEqual(restored->channelCount(), kTestChannels);
+    XCTAssertEqual(restored->maximumFramesPerBlock(), 256u);
+    XCTAssertTrue(restored->denormalMode() == DenormalMode::Off);
+    XCTAssertTrue(restored->isBypassed());
+
+    // The saved values come back as the latest control state
+    XCTAssertEqual(restored->serializeState(), kernel->serializeState());
+
+    kernel->setBypassed(false);
+    restored->setBypassed(false);
+    const std::vector<float> signal = makeSignal(2048);
+    XCTAssertEqual(render(*restored, signal), render(*kernel->fork(), signal));
+}
+
+- (void)testBiquadCascadeRestoresOnItsCoefficients {
+    BiquadCascadeKernel kernel(kTestSampleRate, kTestChannels, 4);
+    kernel.setBand(0, BiquadBand{ 120.0f, 6.0f, 0.7f, true });
+    kernel.setBand(1, BiquadBand{ 900.0f, -4.5f, 2.0f, true });
+    kernel.setBand(3, BiquadBand{ 8000.0f, 3.0f, 1.0f, false });
+
+    std::unique_ptr<DSPKernel> restored = restore(kernel.serializeState());
+    auto& cascade = static_cast<BiquadCascadeKernel&>(*restored);
+    XCTAssertEqual(cascade.bandCount(), 4);
+    XCTAssertEqual(cascade.bandSettings(1).frequency, 900.0f);
+    XCTAssertEqual(cascade.bandSettings(1).gainDB, -4.5f);
+    XCTAssertFalse(cascade.bandSettings(3).enabled);
+
+    // No ramp from flat: the first block already matches a fork
+    const std::vector<float> signal = makeSignal(4096);
+    XCTAssertEqual(render(*restored, signal), render(*kernel.fork(), signal));
+}
+
+- (void)testConvolutionRestoresItsSpectraWithoutTransforming {
+    ConvolutionKernel kernel(kTestSampleRate, kTestChannels, 3000, 256);
+    std::vector<float> left(3000);
+    std::vector<float> right(1500);
+    for (size_t tap = 0; tap < left.size(); ++tap) {
+        left[tap] = std::exp(-static_cast<float>(tap) / 400.0f) * std::cos(0.37f * static_cast<float>(tap));
+    }
+    for (size_t tap = 0; tap < right.size(); ++tap) {
+        right[tap] = std::exp(-static_cast<float>(tap) / 200.0f) * std::sin(0.11f * static_cast<float>(tap + 1));
+    }
+    // Both outputs read the left input
+    const ImpulseResponse responses[kTestChannels] = {
+        { left.data(), left.size(), 0 },
+        { right.data(), right.size(), 0 }
+    };
+    XCTAssertTrue(kernel.setImpulseResponses(responses, kTestChannels));
+
+    std::unique_ptr<DSPKernel> restored = restore(kernel.serializeState());
+    auto& convolution = static_cast<ConvolutionKernel&>(*restored);
+    XCTAssertEqual(convolution.partitionSize(), 256u);
+    XCTAssertEqual(convolution.maxPartitionCount(), kernel.maxPartitionCount());
+    XCTAssertEqual(convolution.filter()->partitionCount(0), 12u);
+    XCTAssertEqual(convolution.filter()->inputChannel(1), 0);
+    XCTAssertEqual(convolution.filter()->inputMask(), 1u);
+
+    const std::vector<float> signal = makeSignal(8192);
+    XCTAssertEqual(render(*restored, signal), render(*kernel.fork(), signal));
+}
+
+- (void)testDynamicsRestoresDetectorLookAheadAndControls {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels, DynamicsDetector::RMS, 0.002);
+    kernel.setParameter(kParameterThreshold, -24.0f);
+    kernel.setParameter(kParameterRatio, 6.0f);
+    kernel.setParameter(kParameterGain, 3.0f);
+
+    std::unique_ptr<DSPKernel> restored = restore(kernel.serializeState());
+    auto& dynamics = static_cast<DynamicsKernel&>(*restored);
+    XCTAssertTrue(dynamics.detectorMode() == DynamicsDetector::RMS);
+    XCTAssertEqual(dynamics.latencyFrames(), kernel.latencyFrames());
+
+    const std::vector<float> signal = makeSignal(4096);
+    XCTAssertEqual(render(*restored, signal), render(*kernel.fork(), signal));
+}
+
+- (void)testKernelsWithoutAFormatRefuseToSerialize {
+    SpectrumAnalyzerKernel analyzer(kTestSampleRate, kTestChannels);
+    XCTAssertThrowsSpecific(analyzer.serializeState(), std::invalid_argument);
+}
+
+- (void)testDamagedStatesAreRejected {
+    BiquadCascadeKernel kernel(kTestSampleRate, kTestChannels, 3);
+    kernel.setParameter(kParameterGain, -3.0f);
+    const std::vector<uint8_t> state = kernel.serializeState();
+
+    // Every truncation is caught by the bounds checks
+    for (size_t length = 0; length < state.size(); ++length) {
+        XCTAssertThrowsSpecific(DSPKernel::restoreState(state.data(), length), std::runtime_error);
+    }
+    XCTAssertThrowsSpecific(DSPKernel::restoreState(nullptr, 0), std::runtime_error);
+
+    std::vector<uint8_t> damaged = state;
+    damaged[0] ^= 0xFF;
+    XCTAssertThrowsSpecific(restore(damaged), std::runtime_error);
+
+    damaged = state;
+    damaged[4] += 1;   // Version
+    XCTAssertThrowsSpecific(restore(damaged), std::runtime_error);
+
+    damaged = state;
+    damaged[6] = 0x7F; // Kernel type
+    XCTAssertThrowsSpecific(restore(damaged), std::runtime_error);
+
+    damaged = state;
+    damaged[16] = 0x40; // Channel count
+    XCTAssertThrowsSpecific(restore(damaged), std::runtime_error);
+
+    damaged = state;
+    damaged.push_back(0);
+    XCTAssertThrowsSpecific(restore(damaged), std::runtime_error);
+}
+
+// MARK: - Hot Swap Tests
+
+- (void)testSwapCrossfadesWithoutAStep {
+    HotSwapKernel swap(makeGainKernel(0.0f), 0.01);
+    const size_t fadeFrames = 480;
+    std::vector<float> ones(4 * kTestBlockSize * kTestChannels, 1.0f);
+    std::vector<float> before = render(swap, ones);
+    XCTAssertEqualWithAccuracy(before.back(), 1.0f, 1e-6f);
+
+    std::unique_ptr<DSPKernel> quieter = restore(makeGainKernel(-20.0f * std::log10(2.0f))->serializeState());
+    XCTAssertTrue(swap.swapTo(quieter));
+    XCTAssertTrue(quieter == nullptr);
+    XCTAssertTrue(swap.isSwapInProgress());
+
+    std::vector<float> after = render(swap, std::vector<float>(8 * kTestBlockSize * kTestChannels, 1.0f));
+    float previous = 1.0f;
+    bool smooth = true;
+    for (size_t frame = 0; frame < after.size() / kTestChannels; ++frame) {
+        const float sample = after[frame * kTestChannels];
+        smooth = smooth && sample <= previous + 1e-6f && previous - sample <= 0.5f / fadeFrames + 1e-5f;
+        previous = sample;
+    }
+    XCTAssertTrue(smooth);
+    XCTAssertEqualWithAccuracy(after[(fadeFrames / 2) * kTestChannels], 0.75f, 0.01f);
+    XCTAssertEqualWithAccuracy(after[fadeFrames * kTestChannels], 0.5f, 1e-5f);
+    XCTAssertEqualWithAccuracy(after.back(), 0.5f, 1e-5f);
+    XCTAssertFalse(swap.isSwapInProgress());
+}
+
+- (void)testSwapWaitsForThePreviousFade {
+    HotSwapKernel swap(makeGainKernel(0.0f), 0.01);
+    std::vector<float> block(kTestBlockSize * kTestChannels, 1.0f);
+    render(swap, block);
+
+    std::unique_ptr<DSPKernel> first = makeGainKernel(-6.0f);
+    std::unique_ptr<DSPKernel> second = makeGainKernel(-12.0f);
+    XCTAssertTrue(swap.swapTo(first));
+    XCTAssertFalse(swap.swapTo(second));
+    XCTAssertTrue(second != nullptr);
+
+    // 480 fade frames take four 128-frame blocks
+    for (int i = 0; i < 3; ++i) {
+        render(swap, block);
+        XCTAssertTrue(swap.isSwapInProgress());
+        XCTAssertFalse(swap.swapTo(second));
+    }
+    render(swap, block);
+    XCTAssertFalse(swap.isSwapInProgress());
+    XCTAssertTrue(swap.swapTo(second));
+}
+
+- (void)testFirstBlockAndZeroFadeCutCleanly {
+    HotSwapKernel swap(makeGainKernel(0.0f), 0.0);
+    std::unique_ptr<DSPKernel> quieter = makeGainKernel(-20.0f * std::log10(2.0f));
+    XCTAssertTrue(swap.swapTo(quieter));
+
+    // Nothing rendered yet, so the incoming kernel plays from the first frame
+    std::vector<float> output = render(swap, std::vector<float>(kTestBlockSize * kTestChannels, 1.0f));
+    XCTAssertEqualWithAccuracy(output.front(), 0.5f, 1e-5f);
+    XCTAssertFalse(swap.isSwapInProgress());
+
+    std::unique_ptr<DSPKernel> louder = makeGainKernel(0.0f);
+    XCTAssertTrue(swap.swapTo(louder));
+    output = render(swap, std::vector<float>(kTestBlockSize * kTestChannels, 1.0f));
+    XCTAssertEqualWithAccuracy(output.front(), 1.0f, 1e-5f);
+}
+
+- (void)testMismatchedReplacementsThrow {
+    HotSwapKernel swap(makeGainKernel(0.0f));
+    std::unique_ptr<DSPKernel> none;
+    XCTAssertThrowsSpecific(swap.swapTo(none), std::invalid_argument);
+    std::unique_ptr<DSPKernel> otherRate = createDSPKernel(44100.0, kTestChannels);
+    XCTAssertThrowsSpecific(swap.swapTo(otherRate), std::invalid_argument);
+    std::unique_ptr<DSPKernel> mono = createDSPKernel(kTestSampleRate, 1);
+    XCTAssertThrowsSpecific(swap.swapTo(mono), std::invalid_argument);
+    XCTAssertTrue(otherRate != nullptr);
+
+    XCTAssertThrows(HotSwapKernel(nullptr));
+    XCTAssertThrows(HotSwapKernel(makeGainKernel(0.0f), -0.1));
+    XCTAssertThrows(HotSwapKernel(makeGainKernel(0.0f), MAX_KERNEL_SWAP_CROSSFADE_SECONDS * 2.0));
+}
+
+- (void)testPlanarInPlaceCrossfadeMatchesInterleaved {
+    HotSwapKernel interleaved(makeGainKernel(0.0f));
+    HotSwapKernel planar(makeGainKernel(0.0f));
+    const std::vector<float> signal = makeSignal(kTestBlockSize);
+    render(interleaved, signal);
+    std::vector<float> left(kTestBlockSize);
+    std::vector<float> right(kTestBlockSize);
+    float* planes[] = { left.data(), right.data() };
+    const AudioBufferView view = AudioBufferView::makePlanar(planes, kTestChannels, kTestBlockSize);
+    planar.process(view, view);
+
+    std::unique_ptr<DSPKernel> first = makeGainKernel(-10.0f);
+    std::unique_ptr<DSPKernel> second = makeGainKernel(-10.0f);
+    XCTAssertTrue(interleaved.swapTo(first));
+    XCTAssertTrue(planar.swapTo(second));
+
+    const std::vector<float> expected = render(interleaved, signal);
+    for (size_t frame = 0; frame < kTestBlockSize; ++frame) {
+        left[frame] = signal[frame * kTestChannels];
+        right[frame] = signal[frame * kTestChannels + 1];
+    }
+    planar.process(view, view);
+    for (size_t frame = 0; frame < kTestBlockSize; ++frame) {
+        XCTAssertEqual(left[frame], expected[frame * kTestChannels]);
+        XCTAssertEqual(right[frame], expected[frame * kTestChannels + 1]);
+    }
+}
+
+- (void)testProfilesSwapWhileRendering {
+    // Two saved profiles, restored off the render thread and swapped in repeatedly
+    BiquadCascadeKernel warm(kTestSampleRate, kTestChannels, 2);
+    warm.setBand(0, BiquadBand{ 150.0f, 5.0f, 0.8f, true });
+    BiquadCascadeKernel bright(kTestSampleRate, kTestChannels, 2);
+    bright.setBand(1, BiquadBand{ 6000.0f, 5.0f, 0.8f, true });
+    const std::vector<uint8_t> profiles[] = { warm.serializeState(), bright.serializeState() };
+
+    HotSwapKernel swap(restore(profiles[0]), 0.005);
+    std::atomic<bool> done{false};
+    std::atomic<int> swaps{0};
+    std::thread control([&] {
+        for (int i = 1; i <= 40; ++i) {
+            std::unique_ptr<DSPKernel> next = restore(profiles[i % 2]);
+            while (!swap.swapTo(next)) {
+                std::this_thread::yield();
+            }
+            ++swaps;
+        }
+        done = true;
+    });
+
+    const std::vector<float> signal = makeSignal(kTestBlockSize);
+    bool bounded = true;
+    size_t blocks = 0;
+    while (!done.load() || swap.isSwapInProgress()) {
+        const std::vector<float> output = render(swap, signal);
+        for (float sample : output) {
+            bounded = bounded && std::isfinite(sample) && std::fabs(sample) < 2.0f;
+        }
+        ++blocks;
+    }
+    control.join();
+    XCTAssertTrue(bounded);
+    XCTAssertEqual(swaps.load(), 40);
+    XCTAssertGreaterThan(blocks, 40u);
+}
+
+- (void)testForkWrapsTheActiveKernel {
+    HotSwapKernel swap(makeGainKernel(0.0f), 0.01);
+    std::unique_ptr<DSPKernel> quieter = makeGainKernel(-20.0f * std::log10(2.0f));
+    XCTAssertTrue(swap.swapTo(quieter));
+
+    std::unique_ptr<DSPKernel> fork = swap.fork();
+    auto& forked = static_cast<HotSwapKernel&>(*fork);
+    XCTAssertEqual(forked.crossfadeSeconds(), 0.01);
+    XCTAssertFalse(forked.isSwapInProgress());
+    const std::vector<float> output = render(forked, std::vector<float>(kTestBlockSize * kTestChannels, 1.0f));
+    XCTAssertEqualWithAccuracy(output.front(), 0.5f, 1e-5f);
+}
+
+@end
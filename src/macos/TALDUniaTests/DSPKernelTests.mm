@@ -0,0 +1,523 @@
+//
+// DSPKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the C++ DSP kernel core
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+#import <Accelerate/Accelerate.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+#include "../../shared/DSP/DSPKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestFrames = 256;
+static const float kTestTolerance = 1.0e-5f;
+
+@interface DSPKernelTests : XCTestCase
+@end
+
+@implementation DSPKernelTests {
+    std::unique_ptr<DSPKernel> _kernel;
+    std::vector<float> _input;
+    std::vector<float> _output;
+}
+
+// MARK: - Test Lifecycle
+
+- (void)setUp {
+    [super setUp];
+    _kernel = createDSPKernel(kTestSampleRate, kTestChannels);
+    _input.assign(kTestFrames * kTestChannels, 1.0f);
+    _output.assign(kTestFrames * kTestChannels, 0.0f);
+}
+
+- (void)tearDown {
+    _kernel.reset();
+    [super tearDown];
+}
+
+// MARK: - Parameter Tests
+
+- (void)testGainRampIsSampleAccurateAndMonotonic {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.sampleOffset = 64;
+    event.rampFrames = 128;
+    event.shape = RampShape::Linear;
+    _kernel->scheduleParameter(event);
+
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+
+    const float target = std::pow(10.0f, -6.0f / 20.0f);
+    for (int channel = 0; channel < kTestChannels; ++channel) {
+        const float* samples = _output.data() + channel * kTestFrames;
+
+        // Unity gain until the event offset
+        for (size_t i = 0; i < 64; ++i) {
+            XCTAssertEqualWithAccuracy(samples[i], 1.0f, kTestTolerance);
+        }
+
+        // Strictly decreasing ramp without steps
+        for (size_t i = 65; i < 192; ++i) {
+            XCTAssertLessThan(samples[i], samples[i - 1]);
+        }
+
+        // Target reached exactly at the end of the ramp
+        for (size_t i = 191; i < kTestFrames; ++i) {
+            XCTAssertEqualWithAccuracy(samples[i], target, kTestTolerance);
+        }
+    }
+}
+
+- (void)testEventOffsetBeyondBlockCarriesOver {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -120.0f;
+    event.sampleOffset = kTestFrames + 16;
+    event.rampFrames = 1;
+    _kernel->scheduleParameter(event);
+
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqualWithAccuracy(_output[kTestFrames - 1], 1.0f, kTestTolerance);
+
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqualWithAccuracy(_output[15], 1.0f, kTestTolerance);
+    XCTAssertLessThan(_output[17], 1.0e-5f);
+}
+
+- (void)testQueueOverflowKeepsLatestValue {
+    // Far more updates than the queue holds, all between two render calls
+    for (size_t i = 0; i < PARAMETER_QUEUE_CAPACITY * 4; ++i) {
+        _kernel->setParameter(kParameterGain, (i % 2 == 0) ? 0.0f : -12.0f);
+    }
+    _kernel->setParameter(kParameterGain, -20.0f);
+
+    // Let the default ramp settle
+    for (int block = 0; block < 8; ++block) {
+        _kernel->process(_input.data(), _output.data(), kTestFrames);
+    }
+
+    XCTAssertEqualWithAccuracy(_output[kTestFrames - 1], 0.1f, kTestTolerance);
+}
+
+- (void)testBypassPassesAudioThroughAndReportsTiming {
+    _kernel->setParameter(kParameterGain, -12.0f);
+    _kernel->setBypassed(true);
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqual(_output[kTestFrames - 1], 1.0f);
+
+    _kernel->setBypassed(false);
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertLessThan(_output[kTestFrames - 1], 1.0f);
+    XCTAssertGreaterThanOrEqual(_kernel->lastBlockLatencyMs(), 0.0f);
+}
+
+- (void)testResetIsAppliedAtNextBlock {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -12.0f;
+    event.rampFrames = 1;
+    _kernel->scheduleParameter(event);
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertLessThan(_output[kTestFrames - 1], 0.5f);
+
+    // Returns immediately; nothing changes until the render thread's next block
+    _kernel->reset();
+    XCTAssertTrue(_kernel->isResetPending());
+
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertFalse(_kernel->isResetPending());
+    XCTAssertEqualWithAccuracy(_output[0], 1.0f, kTestTolerance);
+    XCTAssertEqualWithAccuracy(_output[kTestFrames - 1], 1.0f, kTestTolerance);
+}
+
+// MARK: - Metrics Tests
+
+- (void)testMetricsHistogramReportsPercentilesAndOverruns {
+    DSPBlockMetrics metrics;
+    const double budgetNs = 5.0e6;
+    for (int block = 0; block < 98; ++block) {
+        metrics.record(1000000, budgetNs);
+    }
+    metrics.record(10000000, budgetNs);
+    metrics.record(10000000, budgetNs);
+    metrics.reportXrun();
+
+    DSPMetricsSnapshot snapshot;
+    XCTAssertTrue(metrics.snapshot(snapshot));
+    XCTAssertEqual(snapshot.blocks, 100u);
+    XCTAssertEqual(snapshot.overruns, 2u);
+    XCTAssertEqual(snapshot.xruns, 1u);
+    XCTAssertEqualWithAccuracy(snapshot.p50BlockMs, 1.0f, 0.25f);
+    XCTAssertEqualWithAccuracy(snapshot.p99BlockMs, 10.0f, 2.5f);
+    XCTAssertEqualWithAccuracy(snapshot.maxBlockMs, 10.0f, 1.0e-3f);
+    XCTAssertEqualWithAccuracy(snapshot.p50Load, 0.2f, 1.0f / 32.0f);
+    XCTAssertEqualWithAccuracy(snapshot.maxLoad, 2.0f, 1.0e-3f);
+}
+
+- (void)testMetricsClearIsAppliedAtNextBlock {
+    for (int block = 0; block < 4; ++block) {
+        _kernel->process(_input.data(), _output.data(), kTestFrames);
+    }
+    DSPMetricsSnapshot snapshot;
+    XCTAssertTrue(_kernel->metrics().snapshot(snapshot));
+    XCTAssertEqual(snapshot.blocks, 4u);
+    XCTAssertGreaterThan(snapshot.maxBlockMs, 0.0f);
+
+    _kernel->metrics().clear();
+    XCTAssertTrue(_kernel->metrics().snapshot(snapshot));
+    XCTAssertEqual(snapshot.blocks, 4u);
+
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertTrue(_kernel->metrics().snapshot(snapshot));
+    XCTAssertEqual(snapshot.blocks, 1u);
+}
+
+- (void)testMetricsSnapshotsStayConsistentWhileRendering {
+    std::atomic<bool> rendering{true};
+    std::thread renderThread([&] {
+        while (rendering.load(std::memory_order_relaxed)) {
+            _kernel->process(_input.data(), _output.data(), kTestFrames);
+        }
+    });
+
+    // Every snapshot is internally consistent: percentiles ordered and bounded by the maximum
+    for (int i = 0; i < 1000; ++i) {
+        DSPMetricsSnapshot snapshot;
+        if (_kernel->metrics().snapshot(snapshot) && snapshot.blocks > 0) {
+            XCTAssertLessThanOrEqual(snapshot.p50BlockMs, snapshot.p99BlockMs);
+            XCTAssertLessThanOrEqual(snapshot.p99BlockMs, snapshot.maxBlockMs);
+            XCTAssertLessThanOrEqual(snapshot.overruns, snapshot.blocks);
+        }
+    }
+
+    rendering.store(false, std::memory_order_relaxed);
+    renderThread.join();
+}
+
+// MARK: - FFT Setup Cache Tests
+
+- (void)testKernelsShareCachedFFTSetup {
+    const size_t baseline = fftSetupUseCount(KERNEL_FFT_LOG2N);
+    XCTAssertGreaterThan(baseline, 0u); // Held by _kernel
+
+    {
+        auto first = createDSPKernel(kTestSampleRate, kTestChannels);
+        auto second = createDSPKernel(kTestSampleRate, 8);
+        XCTAssertEqual(fftSetupUseCount(KERNEL_FFT_LOG2N), baseline + 2);
+
+        first->reset();
+        second->reset();
+        XCTAssertEqual(fftSetupUseCount(KERNEL_FFT_LOG2N), baseline + 2);
+    }
+
+    XCTAssertEqual(fftSetupUseCount(KERNEL_FFT_LOG2N), baseline);
+    XCTAssertEqual(acquireFFTSetup(KERNEL_FFT_LOG2N).get(), acquireFFTSetup(KERNEL_FFT_LOG2N).get());
+}
+
+- (void)testReleasedFFTSetupIsDestroyed {
+    const vDSP_Length unusedLog2n = 5;
+    {
+        SharedFFTSetup setup = acquireFFTSetup(unusedLog2n, kFFTRadix3);
+        XCTAssertTrue(static_cast<bool>(setup));
+        XCTAssertEqual(fftSetupUseCount(unusedLog2n, kFFTRadix3), 1u);
+        XCTAssertEqual(fftSetupUseCount(unusedLog2n, kFFTRadix2), 0u);
+    }
+    XCTAssertEqual(fftSetupUseCount(unusedLog2n, kFFTRadix3), 0u);
+}
+
+// MARK: - Scratch Pool Tests
+
+- (void)testKernelCreationReusesPooledScratch {
+    // Warm up the classes this configuration uses
+    createDSPKernel(kTestSampleRate, 8, DenormalMode::HardwareFTZ, kTestFrames).reset();
+    const ScratchPoolStats warm = scratchPoolStats();
+
+    for (int i = 0; i < 100; ++i) {
+        auto kernel = createDSPKernel(kTestSampleRate, 8, DenormalMode::HardwareFTZ, kTestFrames);
+    }
+    const ScratchPoolStats after = scratchPoolStats();
+    XCTAssertEqual(after.systemAllocations, warm.systemAllocations);
+    XCTAssertEqual(after.cachedBlocks, warm.cachedBlocks);
+}
+
+- (void)testScratchIsSizedToMaxFrames {
+    const size_t maxFrames = 128;
+    ScratchBlock block = acquireScratch(maxFrames);
+    XCTAssertGreaterThanOrEqual(block.capacity(), maxFrames);
+    XCTAssertLessThan(block.capacity(), 2 * maxFrames);
+    XCTAssertEqual(reinterpret_cast<std::uintptr_t>(block.data()) % CACHE_LINE_SIZE, 0u);
+
+    XCTAssertThrows(createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, 0));
+    XCTAssertThrows(createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ,
+                                    MAX_BUFFER_SIZE + 1));
+
+    // Blocks longer than maxFrames are rejected and leave the output untouched
+    auto kernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, maxFrames);
+    std::vector<float> output(kTestFrames * kTestChannels, -1.0f);
+    kernel->process(_input.data(), output.data(), kTestFrames);
+    XCTAssertEqual(output[0], -1.0f);
+    kernel->process(_input.data(), output.data(), maxFrames);
+    XCTAssertEqual(output[0], _input[0]);
+}
+
+- (void)testPrepareResizesAndKeepsParameters {
+    _kernel->setParameter(kParameterGain, -6.0f);
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+
+    _kernel->prepare(kTestFrames / 2, 4, 96000.0);
+    XCTAssertEqual(_kernel->maximumFramesPerBlock(), kTestFrames / 2);
+    XCTAssertEqual(_kernel->channelCount(), 4);
+    XCTAssertEqual(_kernel->currentSampleRate(), 96000.0);
+
+    // The gain is back at its target from the first sample at the new format
+    std::vector<float> input(kTestFrames / 2 * 4, 1.0f);
+    std::vector<float> output(input.size(), 0.0f);
+    _kernel->process(input.data(), output.data(), kTestFrames / 2);
+    const float gain = std::pow(10.0f, -6.0f / 20.0f);
+    XCTAssertEqualWithAccuracy(output.front(), gain, kTestTolerance);
+    XCTAssertEqualWithAccuracy(output.back(), gain, kTestTolerance);
+
+    // Blocks past the prepared size are ignored
+    std::vector<float> longInput(kTestFrames * 4, 1.0f);
+    std::vector<float> longOutput(longInput.size(), -1.0f);
+    _kernel->process(longInput.data(), longOutput.data(), kTestFrames);
+    XCTAssertEqual(longOutput[0], -1.0f);
+}
+
+- (void)testFailedPrepareKeepsPreviousConfiguration {
+    XCTAssertThrows(_kernel->prepare(kTestFrames, MAX_CHANNELS + 1, kTestSampleRate));
+    XCTAssertThrows(_kernel->prepare(MAX_BUFFER_SIZE + 1, kTestChannels, kTestSampleRate));
+    XCTAssertThrows(_kernel->prepare(kTestFrames, kTestChannels, 1000.0));
+
+    XCTAssertEqual(_kernel->channelCount(), kTestChannels);
+    XCTAssertEqual(_kernel->maximumFramesPerBlock(), MAX_BUFFER_SIZE);
+    _kernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqualWithAccuracy(_output[0], 1.0f, kTestTolerance);
+}
+
+- (void)testForkKeepsPreparedSize {
+    _kernel->prepare(kTestFrames, kTestChannels, kTestSampleRate);
+    XCTAssertEqual(_kernel->fork()->maximumFramesPerBlock(), kTestFrames);
+}
+
+- (void)testFixedBlockKernelMatchesGenericPath {
+    XCTAssertFalse(_kernel->hasFixedBlockKernel());
+    auto fixed = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold, kTestFrames);
+    auto generic = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold);
+    XCTAssertTrue(fixed->hasFixedBlockKernel());
+    XCTAssertTrue(fixed->fork()->hasFixedBlockKernel());
+    XCTAssertFalse(generic->hasFixedBlockKernel());
+
+    for (size_t i = 0; i < _input.size(); ++i) {
+        _input[i] = std::sin(0.1f * i) * ((i % 7 == 0) ? 1.0e-20f : 1.0f);
+    }
+    fixed->setParameter(kParameterGain, -6.0f);
+    generic->setParameter(kParameterGain, -6.0f);
+
+    // Ramping, constant and short blocks all agree sample for sample
+    for (size_t frames : { kTestFrames, kTestFrames, kTestFrames - 3 }) {
+        std::vector<float> expected(kTestFrames * kTestChannels, 0.0f);
+        fixed->process(_input.data(), _output.data(), frames);
+        generic->process(_input.data(), expected.data(), frames);
+        for (size_t i = 0; i < frames; ++i) {
+            XCTAssertEqual(_output[i], expected[i]);
+        }
+    }
+
+    // Preparing for another format drops the specialization
+    fixed->prepare(kTestFrames + 16, kTestChannels, kTestSampleRate);
+    XCTAssertFalse(fixed->hasFixedBlockKernel());
+}
+
+- (void)testRecycledScratchDoesNotLeakIntoOutput {
+    // Leave garbage in the pooled blocks a new kernel will pick up
+    {
+        ScratchBlock dirty = acquireScratch(4 * kTestFrames * kTestChannels);
+        std::fill(dirty.data(), dirty.data() + dirty.capacity(), 1.0e30f);
+    }
+
+    auto kernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, kTestFrames);
+    std::vector<float> host(kTestFrames * kTestChannels + 1, 0.5f);
+    kernel->setParameter(kParameterGain, -6.0f);
+    kernel->process(host.data() + 1, host.data() + 1, kTestFrames);
+    for (size_t i = 1; i < host.size(); ++i) {
+        XCTAssertLessThanOrEqual(std::fabs(host[i]), 0.5f);
+    }
+}
+
+// MARK: - Fork Tests
+
+- (void)testForkStartsFromCurrentParametersAndSharesFFTSetup {
+    _kernel->setParameter(kParameterGain, -6.0f);
+    _kernel->setBypassed(true);
+    const size_t baseline = fftSetupUseCount(KERNEL_FFT_LOG2N);
+
+    auto fork = _kernel->fork();
+    XCTAssertEqual(fftSetupUseCount(KERNEL_FFT_LOG2N), baseline + 1);
+    XCTAssertTrue(fork->isBypassed());
+    XCTAssertEqual(fork->channelCount(), _kernel->channelCount());
+
+    // The fork is at the target from its first sample, without the control ramp
+    fork->setBypassed(false);
+    fork->process(_input.data(), _output.data(), kTestFrames);
+    const float gain = std::pow(10.0f, -6.0f / 20.0f);
+    XCTAssertEqualWithAccuracy(_output[0], gain, kTestTolerance);
+    XCTAssertEqualWithAccuracy(_output[kTestFrames - 1], gain, kTestTolerance);
+}
+
+- (void)testForkedKernelsRenderIdenticallyOnSeparateThreads {
+    static const int kBlocks = 64;
+    _kernel->setParameter(kParameterGain, -3.0f);
+
+    std::vector<std::unique_ptr<DSPKernel>> kernels;
+    for (int i = 0; i < 4; ++i) {
+        kernels.push_back(_kernel->fork());
+    }
+
+    // Every render context owns its kernel, so no block is ever skipped
+    std::vector<std::vector<float>> results(kernels.size(),
+                                            std::vector<float>(kBlocks * kTestFrames * kTestChannels));
+    std::vector<std::thread> threads;
+    for (size_t k = 0; k < kernels.size(); ++k) {
+        threads.emplace_back([&, k] {
+            for (int block = 0; block < kBlocks; ++block) {
+                kernels[k]->process(_input.data(), results[k].data() + block * kTestFrames * kTestChannels,
+                                    kTestFrames);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const float gain = std::pow(10.0f, -3.0f / 20.0f);
+    for (size_t k = 0; k < kernels.size(); ++k) {
+        XCTAssertTrue(results[k] == results[0]);
+        XCTAssertEqualWithAccuracy(results[k].back(), gain, kTestTolerance);
+    }
+}
+
+// MARK: - Denormal Tests
+
+- (void)testDenormalModeIsReported {
+    XCTAssertEqual(_kernel->denormalMode(), resolveDenormalMode(DenormalMode::HardwareFTZ));
+
+    auto thresholdKernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold);
+    XCTAssertEqual(thresholdKernel->denormalMode(), DenormalMode::VectorThreshold);
+
+    auto offKernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::Off);
+    XCTAssertEqual(offKernel->denormalMode(), DenormalMode::Off);
+}
+
+- (void)testThresholdModeFlushesTinySamples {
+    auto thresholdKernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold);
+    auto offKernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::Off);
+
+    _input.assign(kTestFrames * kTestChannels, 1.0e-20f);
+    _input[0] = -0.5f;
+
+    thresholdKernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqual(_output[0], -0.5f);
+    XCTAssertEqual(_output[1], 0.0f);
+
+    offKernel->process(_input.data(), _output.data(), kTestFrames);
+    XCTAssertEqual(_output[0], -0.5f);
+    XCTAssertEqual(_output[1], 1.0e-20f);
+}
+
+// MARK: - Buffer Handling Tests
+
+- (void)testInPlaceAndMisalignedProcessingMatch {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.rampFrames = 1;
+    _kernel->scheduleParameter(event);
+
+    const float gain = std::pow(10.0f, -6.0f / 20.0f);
+
+    // In place on an aligned host buffer
+    _kernel->process(_input.data(), _input.data(), kTestFrames);
+    XCTAssertEqualWithAccuracy(_input[kTestFrames], gain, kTestTolerance);
+
+    // Misaligned host buffers fall back to staging
+    std::vector<float> host(kTestFrames * kTestChannels + 1, 1.0f);
+    _kernel->process(host.data() + 1, host.data() + 1, kTestFrames);
+    XCTAssertEqual(host[0], 1.0f);
+    XCTAssertEqualWithAccuracy(host[kTestFrames], gain, kTestTolerance);
+}
+
+- (void)testAllLayoutPairsProduceIdenticalSamples {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.rampFrames = 100;
+    event.shape = RampShape::Linear;
+
+    std::vector<float> planar(kTestFrames * kTestChannels);
+    std::vector<float> interleaved(kTestFrames * kTestChannels);
+    for (int channel = 0; channel < kTestChannels; ++channel) {
+        for (size_t frame = 0; frame < kTestFrames; ++frame) {
+            const float value = std::sin(0.05f * frame + channel);
+            planar[channel * kTestFrames + frame] = value;
+            interleaved[frame * kTestChannels + channel] = value;
+        }
+    }
+
+    float* inputPlanes[kTestChannels];
+    for (int channel = 0; channel < kTestChannels; ++channel) {
+        inputPlanes[channel] = planar.data() + channel * kTestFrames;
+    }
+    const AudioBufferView planarInput = AudioBufferView::makePlanar(inputPlanes, kTestChannels, kTestFrames);
+    const AudioBufferView interleavedInput = AudioBufferView::makeInterleaved(interleaved.data(), kTestChannels,
+                                                                              kTestFrames);
+
+    for (BufferLayout inputLayout : { BufferLayout::Planar, BufferLayout::Interleaved }) {
+        for (BufferLayout outputLayout : { BufferLayout::Planar, BufferLayout::Interleaved }) {
+            auto kernel = createDSPKernel(kTestSampleRate, kTestChannels);
+            kernel->scheduleParameter(event);
+
+            std::vector<float> result(kTestFrames * kTestChannels, 0.0f);
+            float* outputPlanes[kTestChannels];
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                outputPlanes[channel] = result.data() + channel * kTestFrames;
+            }
+            const AudioBufferView output = (outputLayout == BufferLayout::Planar)
+                ? AudioBufferView::makePlanar(outputPlanes, kTestChannels, kTestFrames)
+                : AudioBufferView::makeInterleaved(result.data(), kTestChannels, kTestFrames);
+
+            kernel->process(inputLayout == BufferLayout::Planar ? planarInput : interleavedInput, output);
+
+            // Compare against a planar reference run
+            auto reference = createDSPKernel(kTestSampleRate, kTestChannels);
+            reference->scheduleParameter(event);
+            std::vector<float> expected(kTestFrames * kTestChannels, 0.0f);
+            reference->process(planar.data(), expected.data(), kTestFrames);
+
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                for (size_t frame = 0; frame < kTestFrames; ++frame) {
+                    const size_t index = (outputLayout == BufferLayout::Planar)
+                        ? channel * kTestFrames + frame
+                        : frame * kTestChannels + channel;
+                    XCTAssertEqualWithAccuracy(result[index], expected[channel * kTestFrames + frame],
+                                               kTestTolerance);
+                }
+            }
+        }
+    }
+}
+
+@end
@@ -0,0 +1,375 @@
+//
+// DSPOfflineRenderTests.mm
+// TALD UNIA
+//
+// Unit tests for memory-mapped WAV files and the chunk-parallel offline renderer
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../../shared/DSP/DSPOfflineRender.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestBlockFrames = 512;
+static const size_t kTestFrames = 200000;      // Not a multiple of any chunk or block size
+static const size_t kTestFilterTaps = 64;
+
+/**
+ * Stateless gain
+ */
+class TestGainKernel final : public DSPKernel {
+public:
+    TestGainKernel(double sampleRate, int channels, size_t maxFrames, float gain)
+        : DSPKernel(sampleRate, channels, DenormalMode::HardwareFTZ, maxFrames), gain(gain) {}
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override {
+        for (size_t i = 0; i < input.frames * static_cast<size_t>(numChannels); ++i) {
+            output.interleaved[i] = gain * input.interleaved[i];
+        }
+    }
+
+    std::unique_ptr<DSPKernel> fork() const override {
+        return std::make_unique<TestGainKernel>(sampleRate, numChannels, maximumFramesPerBlock(), gain);
+    }
+
+private:
+    const float gain;
+
+    void resetState() noexcept override {}
+};
+
+/**
+ * Moving average over kTestFilterTaps frames: history that warm-up has to rebuild
+ */
+class TestAverageKernel final : public DSPKernel {
+public:
+    TestAverageKernel(double sampleRate, int channels, size_t maxFrames)
+        : DSPKernel(sampleRate, channels, DenormalMode::HardwareFTZ, maxFrames)
+        , history(kTestFilterTaps * static_cast<size_t>(channels), 0.0f) {}
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override {
+        for (size_t frame = 0; frame < input.frames; ++frame) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const size_t index = frame * static_cast<size_t>(numChannels) + static_cast<size_t>(channel);
+                float& slot = history[head * static_cast<size_t>(numChannels) + static_cast<size_t>(channel)];
+                sums[channel] += input.interleaved[index] - slot;
+                slot = input.interleaved[index];
+                output.interleaved[index] = static_cast<float>(sums[channel] / kTestFilterTaps);
+            }
+            head = (head + 1) % kTestFilterTaps;
+        }
+    }
+
+    std::unique_ptr<DSPKernel> fork() const override {
+        return std::make_unique<TestAverageKernel>(sampleRate, numChannels, maximumFramesPerBlock());
+    }
+
+private:
+    std::vector<float> history;
+    double sums[MAX_CHANNELS] = {};
+    size_t head = 0;
+
+    void resetState() noexcept override {
+        std::fill(history.begin(), history.end(), 0.0f);
+        std::fill(sums, sums + MAX_CHANNELS, 0.0);
+        head = 0;
+    }
+};
+
+static std::vector<float> makeSignal(size_t frames) {
+    std::vector<float> samples(frames * kTestChannels);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        samples[i] = 0.5f * std::sin(0.001f * static_cast<float>(i)) + 0.25f * std::sin(0.37f * static_cast<float>(i));
+    }
+    return samples;
+}
+
+static std::string temporaryPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static void appendLE(std::vector<uint8_t>& bytes, uint32_t value, int byteCount) {
+    for (int i = 0; i < byteCount; ++i) {
+        bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+// PCM or float WAV with one odd-sized chunk before the data; extensible headers for PCM24
+static void writeWave(const std::string& path, uint16_t formatTag, int bits, const std::vector<int32_t>& samples) {
+    const bool extensible = bits == 24;
+    std::vector<uint8_t> bytes;
+    bytes.insert(bytes.end(), { 'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ' });
+    appendLE(bytes, extensible ? 40 : 16, 4);
+    appendLE(bytes, extensible ? 0xFFFE : formatTag, 2);
+    appendLE(bytes, kTestChannels, 2);
+    appendLE(bytes, static_cast<uint32_t>(kTestSampleRate), 4);
+    appendLE(bytes, static_cast<uint32_t>(kTestSampleRate) * kTestChannels * bits / 8, 4);
+    appendLE(bytes, kTestChannels * bits / 8, 2);
+    appendLE(bytes, static_cast<uint32_t>(bits), 2);
+    if (extensible) {
+        appendLE(bytes, 22, 2);
+        appendLE(bytes, static_cast<uint32_t>(bits), 2);
+        appendLE(bytes, 3, 4);
+        appendLE(bytes, formatTag, 2);
+        bytes.insert(bytes.end(), 14, 0);
+    }
+    bytes.insert(bytes.end(), { 'L', 'I', 'S', 'T', 3, 0, 0, 0, 'a', 'b', 'c', 0 });
+    bytes.insert(bytes.end(), { 'd', 'a', 't', 'a' });
+    appendLE(bytes, static_cast<uint32_t>(samples.size() * bits / 8), 4);
+    for (int32_t sample : samples) {
+        appendLE(bytes, static_cast<uint32_t>(sample), bits / 8);
+    }
+    const uint32_t riffSize = static_cast<uint32_t>(bytes.size() - 8);
+    std::memcpy(bytes.data() + 4, &riffSize, 4);
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+@interface DSPOfflineRenderTests : XCTestCase
+@end
+
+@implementation DSPOfflineRenderTests
+
+// MARK: - Mapped File Tests
+
+- (void)testReadsPCMAndFloatWaves {
+    const std::vector<int32_t> pcm16 = { 0, 16384, -32768, 32767 };
+    const std::string path16 = temporaryPath("tald_offline_16.wav");
+    writeWave(path16, 1, 16, pcm16);
+    MappedAudioFile file16(path16);
+    XCTAssertEqual(file16.format(), AudioSampleFormat::PCM16);
+    XCTAssertEqual(file16.channelCount(), kTestChannels);
+    XCTAssertEqual(file16.sampleRate(), kTestSampleRate);
+    XCTAssertEqual(file16.frameCount(), 2u);
+
+    // Frames past the end read as silence
+    float samples[6];
+    file16.readFrames(0, 3, samples);
+    XCTAssertEqual(samples[0], 0.0f);
+    XCTAssertEqual(samples[1], 0.5f);
+    XCTAssertEqual(samples[2], -1.0f);
+    XCTAssertEqualWithAccuracy(samples[3], 1.0f, 1e-4f);
+    XCTAssertEqual(samples[4], 0.0f);
+    XCTAssertEqual(samples[5], 0.0f);
+
+    const std::vector<int32_t> pcm24 = { -8388608, 4194304, -1, 8388607 };
+    const std::string path24 = temporaryPath("tald_offline_24.wav");
+    writeWave(path24, 1, 24, pcm24);
+    MappedAudioFile file24(path24);
+    XCTAssertEqual(file24.format(), AudioSampleFormat::PCM24);
+    file24.readFrames(0, 2, samples);
+    XCTAssertEqual(samples[0], -1.0f);
+    XCTAssertEqual(samples[1], 0.5f);
+    XCTAssertEqual(samples[2], -1.0f / 8388608.0f);
+
+    const float values[] = { 0.25f, -0.75f };
+    std::vector<int32_t> floats(2);
+    std::memcpy(floats.data(), values, sizeof(values));
+    const std::string pathFloat = temporaryPath("tald_offline_float.wav");
+    writeWave(pathFloat, 3, 32, floats);
+    MappedAudioFile fileFloat(pathFloat);
+    XCTAssertEqual(fileFloat.format(), AudioSampleFormat::Float32);
+    XCTAssertTrue(fileFloat.writableSamples() == nullptr);
+    fileFloat.readFrames(0, 1, samples);
+    XCTAssertEqual(samples[0], 0.25f);
+    XCTAssertEqual(samples[1], -0.75f);
+
+    std::filesystem::remove(path16);
+    std::filesystem::remove(path24);
+    std::filesystem::remove(pathFloat);
+}
+
+- (void)testRejectsMissingAndMalformedFiles {
+    XCTAssertThrows(MappedAudioFile(temporaryPath("tald_offline_missing.wav")));
+
+    const std::string path = temporaryPath("tald_offline_bad.wav");
+    FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("RIFX----WAVEnot a wave file", file);
+    std::fclose(file);
+    XCTAssertThrows(MappedAudioFile(path));
+
+    writeWave(path, 1, 8, { 0, 0 });   // 8-bit PCM is not supported
+    XCTAssertThrows(MappedAudioFile(path));
+    std::filesystem::remove(path);
+
+    XCTAssertThrows(MappedAudioFile(path, 0, kTestSampleRate, 10));
+    XCTAssertThrows(MappedAudioFile(path, kTestChannels, 1000.0, 10));
+}
+
+- (void)testWrittenFilesReadBackAligned {
+    const std::string path = temporaryPath("tald_offline_written.wav");
+    const std::vector<float> signal = makeSignal(1000);
+    {
+        MappedAudioFile output(path, kTestChannels, kTestSampleRate, 1000);
+        float* samples = output.writableSamples();
+        XCTAssertTrue(samples != nullptr);
+        XCTAssertEqual(reinterpret_cast<uintptr_t>(samples) % CACHE_LINE_SIZE, 0u);
+        std::memcpy(samples, signal.data(), signal.size() * sizeof(float));
+        XCTAssertTrue(output.flush());
+    }
+
+    MappedAudioFile input(path);
+    XCTAssertEqual(input.format(), AudioSampleFormat::Float32);
+    XCTAssertEqual(input.frameCount(), 1000u);
+    std::vector<float> readBack(signal.size());
+    input.readFrames(0, 1000, readBack.data());
+    XCTAssertEqual(readBack, signal);
+    std::filesystem::remove(path);
+}
+
+// MARK: - Renderer Tests
+
+- (void)testStagesMustShareFormat {
+    TestGainKernel stereo(kTestSampleRate, kTestChannels, kTestBlockFrames, 0.5f);
+    TestGainKernel mono(kTestSampleRate, 1, kTestBlockFrames, 0.5f);
+    TestGainKernel otherRate(96000.0, kTestChannels, kTestBlockFrames, 0.5f);
+    const DSPKernel* mixedChannels[] = { &stereo, &mono };
+    const DSPKernel* mixedRates[] = { &stereo, &otherRate };
+    XCTAssertThrows(OfflineRenderer(mixedChannels, 2));
+    XCTAssertThrows(OfflineRenderer(mixedRates, 2));
+    XCTAssertThrows(OfflineRenderer(mixedRates, 0));
+
+    // The chain uses the smallest block every stage accepts
+    TestGainKernel large(kTestSampleRate, kTestChannels, 4 * kTestBlockFrames, 0.5f);
+    const DSPKernel* chain[] = { &large, &stereo };
+    XCTAssertEqual(OfflineRenderer(chain, 2).blockFrames(), kTestBlockFrames);
+}
+
+- (void)testSerialRenderRunsTheChainInOrder {
+    TestGainKernel gain(kTestSampleRate, kTestChannels, kTestBlockFrames, 2.0f);
+    TestAverageKernel average(kTestSampleRate, kTestChannels, kTestBlockFrames);
+    const DSPKernel* stages[] = { &gain, &average };
+    OfflineRenderer renderer(stages, 2);
+    XCTAssertEqual(renderer.participantCount(), 1);
+
+    const std::vector<float> input = makeSignal(kTestFrames);
+    std::vector<float> output(input.size());
+    const OfflineRenderReport report = renderer.render(input.data(), output.data(), kTestFrames);
+    XCTAssertEqual(report.frames, kTestFrames);
+    XCTAssertEqual(report.chunks, 1u);
+    XCTAssertEqual(report.participants, 1);
+    XCTAssertEqualWithAccuracy(report.audioSeconds, kTestFrames / kTestSampleRate, 1e-9);
+    XCTAssertGreaterThan(report.realtimeFactor, 1.0);
+
+    // Same as driving fresh kernels block by block
+    TestAverageKernel reference(kTestSampleRate, kTestChannels, kTestBlockFrames);
+    std::vector<float> expected(input.size());
+    for (size_t i = 0; i < input.size(); ++i) {
+        expected[i] = 2.0f * input[i];
+    }
+    for (size_t frame = 0; frame < kTestFrames; frame += kTestBlockFrames) {
+        const size_t count = std::min(kTestBlockFrames, kTestFrames - frame);
+        const AudioBufferView view = AudioBufferView::makeInterleaved(expected.data() + frame * kTestChannels,
+                                                                      kTestChannels, count);
+        reference.process(view, view);
+    }
+    XCTAssertEqual(output, expected);
+}
+
+- (void)testParallelChunksMatchASinglePass {
+    TestAverageKernel average(kTestSampleRate, kTestChannels, kTestBlockFrames);
+    const DSPKernel* stages[] = { &average };
+    const std::vector<float> input = makeSignal(kTestFrames);
+
+    OfflineRenderOptions serialOptions;
+    serialOptions.parallel = false;
+    std::vector<float> serial(input.size());
+    OfflineRenderer(stages, 1, nullptr, serialOptions).render(input.data(), serial.data(), kTestFrames);
+
+    DSPWorkerPool pool(3);
+    OfflineRenderOptions options;
+    options.chunkFrames = 10000;       // 20 chunks
+    options.warmupFrames = 2 * kTestFilterTaps;
+    OfflineRenderer renderer(stages, 1, &pool, options);
+    XCTAssertEqual(renderer.participantCount(), 4);
+
+    std::vector<float> parallel(input.size(), 0.0f);
+    const OfflineRenderReport report = renderer.render(input.data(), parallel.data(), kTestFrames);
+    XCTAssertEqual(report.chunks, 20u);
+    XCTAssertEqual(report.participants, 4);
+
+    // The moving average only has a few frames of float rounding to forget
+    float largest = 0.0f;
+    for (size_t i = 0; i < serial.size(); ++i) {
+        largest = std::max(largest, std::fabs(parallel[i] - serial[i]));
+    }
+    XCTAssertLessThan(largest, 1e-5f);
+
+    // Without warm-up each chunk starts from silence and its first frames differ
+    options.warmupFrames = 0;
+    OfflineRenderer cold(stages, 1, &pool, options);
+    cold.render(input.data(), parallel.data(), kTestFrames);
+    XCTAssertGreaterThan(std::fabs(parallel[10000 * kTestChannels] - serial[10000 * kTestChannels]), 1e-3f);
+}
+
+- (void)testAutomaticChunksCoverTheFile {
+    TestGainKernel gain(kTestSampleRate, kTestChannels, kTestBlockFrames, 0.5f);
+    const DSPKernel* stages[] = { &gain };
+    DSPWorkerPool pool(2);
+    OfflineRenderer renderer(stages, 1, &pool);
+
+    const std::vector<float> input = makeSignal(kTestFrames);
+    std::vector<float> output(input.size(), 1.0f);
+    const OfflineRenderReport report = renderer.render(input.data(), output.data(), kTestFrames);
+    XCTAssertGreaterThanOrEqual(report.chunks, 3u);
+    XCTAssertLessThanOrEqual(report.chunks, 3 * OFFLINE_CHUNKS_PER_PARTICIPANT);
+    for (size_t i = 0; i < input.size(); ++i) {
+        XCTAssertEqual(output[i], 0.5f * input[i]);
+    }
+
+    // In place renders as one stream
+    std::vector<float> inPlace = input;
+    XCTAssertEqual(renderer.render(inPlace.data(), inPlace.data(), kTestFrames).chunks, 1u);
+    XCTAssertEqual(inPlace, output);
+}
+
+- (void)testRendersFileToFile {
+    const std::string inputPath = temporaryPath("tald_offline_in.wav");
+    const std::string outputPath = temporaryPath("tald_offline_out.wav");
+    std::vector<int32_t> pcm(2 * 30000);
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        pcm[i] = static_cast<int32_t>(16000.0 * std::sin(0.01 * static_cast<double>(i)));
+    }
+    writeWave(inputPath, 1, 16, pcm);
+
+    TestGainKernel gain(kTestSampleRate, kTestChannels, kTestBlockFrames, 2.0f);
+    const DSPKernel* stages[] = { &gain };
+    DSPWorkerPool pool(3);
+    OfflineRenderer renderer(stages, 1, &pool);
+
+    MappedAudioFile input(inputPath);
+    MappedAudioFile shortOutput(outputPath, kTestChannels, kTestSampleRate, 100);
+    XCTAssertThrows(renderer.render(input, shortOutput));
+
+    MappedAudioFile output(outputPath, kTestChannels, kTestSampleRate, input.frameCount());
+    const OfflineRenderReport report = renderer.render(input, output);
+    XCTAssertEqual(report.frames, 30000u);
+    XCTAssertTrue(output.flush());
+    const float* samples = output.writableSamples();
+    for (size_t i = 0; i < pcm.size(); ++i) {
+        XCTAssertEqual(samples[i], 2.0f * static_cast<float>(pcm[i]) / 32768.0f);
+    }
+
+    std::filesystem::remove(inputPath);
+    std::filesystem::remove(outputPath);
+}
+
+@end
@@ -0,0 +1,415 @@
+//
+// DSPPrecisionTests.mm
+// TALD UNIA
+//
+// Reduced-precision and fixed-point gain kernels against the float32 reference
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <vector>
+#include "../../shared/DSP/DSPBackend.hpp"
+#include "../../shared/DSP/DSPKernel.hpp"
+#include "../../shared/DSP/DSPPrecision.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestBlockSize = 256;
+static const size_t kTestFrames = 4096;
+
+static const ProcessingPrecision kReducedPrecisions[] = {
+    ProcessingPrecision::Float16, ProcessingPrecision::Q31, ProcessingPrecision::Q15
+};
+
+// Odd lengths exercise every vector body and tail
+static const size_t kTestLengths[] = { 0, 1, 3, 7, 8, 9, 15, 16, 17, 33, 127, 1023 };
+
+// Interleaved stereo with a different tone and level per channel
+static std::vector<float> makeSignal(size_t frames) {
+    std::vector<float> samples(frames * kTestChannels);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const double time = static_cast<double>(frame) / kTestSampleRate;
+        samples[frame * kTestChannels] = 0.5f * static_cast<float>(std::sin(2.0 * std::numbers::pi * 440.0 * time));
+        samples[frame * kTestChannels + 1] = 0.3f * static_cast<float>(std::sin(2.0 * std::numbers::pi * 3100.0 * time));
+    }
+    return samples;
+}
+
+// Full-scale overshoot, tiny values and exact halfway cases for every format
+static std::vector<float> makeEdgeSignal(size_t count) {
+    std::vector<float> signal(count);
+    for (size_t i = 0; i < count; ++i) {
+        signal[i] = 1.7f * std::sin(0.37f * static_cast<float>(i)) * ((i % 7 == 0) ? 1.0e-6f : 1.0f);
+    }
+    const float specials[] = { 1.0f, -1.0f, 2.5f, -2.5f, 0.5f / 32768.0f, 1.5f / 32768.0f, 1.0f + 1.0f / 2048.0f,
+                               5.9604645e-08f, -0.0f, 70000.0f };
+    for (size_t i = 0; i < count && i < std::size(specials); ++i) {
+        signal[count - 1 - i] = specials[i];
+    }
+    return signal;
+}
+
+static bool bitIdentical(const std::vector<float>& a, const std::vector<float>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+}
+
+static void scheduleGain(DSPKernel& kernel, float gainDB, uint32_t rampFrames, uint32_t sampleOffset = 0) {
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = gainDB;
+    event.rampFrames = rampFrames;
+    event.sampleOffset = sampleOffset;
+    kernel.scheduleParameter(event);
+}
+
+// Render a copy of an interleaved signal block by block, in either layout
+static std::vector<float> render(DSPKernel& kernel, const std::vector<float>& source, BufferLayout layout) {
+    std::vector<float> samples = source;
+    const size_t frames = samples.size() / kTestChannels;
+    std::vector<float> planar(samples.size());
+    for (size_t offset = 0; offset < frames; offset += kTestBlockSize) {
+        const size_t count = std::min(kTestBlockSize, frames - offset);
+        float* interleaved = samples.data() + offset * kTestChannels;
+        if (layout == BufferLayout::Interleaved) {
+            const AudioBufferView view = AudioBufferView::makeInterleaved(interleaved, kTestChannels, count);
+            kernel.process(view, view);
+            continue;
+        }
+
+        float* planes[kTestChannels] = { planar.data(), planar.data() + count };
+        for (size_t frame = 0; frame < count; ++frame) {
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                planes[channel][frame] = interleaved[frame * kTestChannels + channel];
+            }
+        }
+        const AudioBufferView view = AudioBufferView::makePlanar(planes, kTestChannels, count);
+        kernel.process(view, view);
+        for (size_t frame = 0; frame < count; ++frame) {
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                interleaved[frame * kTestChannels + channel] = planes[channel][frame];
+            }
+        }
+    }
+    return samples;
+}
+
+// Per-sample bound against the float32 output for a gain of at most 1
+static double errorBound(ProcessingPrecision precision, float input, float reference) {
+    const double in = std::fabs(input);
+    const double ref = std::fabs(reference);
+    switch (precision) {
+        case ProcessingPrecision::Float16:
+            // Three roundings at 2^-11 relative, plus the subnormal spacing
+            return 3.01 * std::ldexp(ref, -11) + std::ldexp(1.0, -23);
+        case ProcessingPrecision::Q15:
+            // Input and product at half of 2^-15, gain at half of 2^-13
+            return std::ldexp(1.0, -15) + std::ldexp(in, -14) + std::ldexp(ref, -23);
+        case ProcessingPrecision::Q31:
+            return std::ldexp(1.0, -31) + std::ldexp(in, -30) + std::ldexp(ref, -22);
+        case ProcessingPrecision::Float32:
+            break;
+    }
+    return 0.0;
+}
+
+static double signalToErrorDB(const std::vector<float>& reference, const std::vector<float>& actual) {
+    double signal = 0.0;
+    double error = 0.0;
+    for (size_t i = 0; i < reference.size(); ++i) {
+        signal += static_cast<double>(reference[i]) * reference[i];
+        const double difference = static_cast<double>(actual[i]) - reference[i];
+        error += difference * difference;
+    }
+    return 10.0 * std::log10(signal / std::max(error, 1.0e-300));
+}
+
+static double minimumSignalToErrorDB(ProcessingPrecision precision) {
+    switch (precision) {
+        case ProcessingPrecision::Float16: return 65.0;
+        case ProcessingPrecision::Q15: return 78.0;
+        case ProcessingPrecision::Q31: return 150.0;
+        case ProcessingPrecision::Float32: break;
+    }
+    return 0.0;
+}
+
+@interface DSPPrecisionTests : XCTestCase
+@end
+
+@implementation DSPPrecisionTests
+
+// MARK: - Reference Conversion Tests
+
+- (void)testFloat16RoundsToNearestEven {
+    XCTAssertEqual(roundToFloat16(1.0f + std::ldexp(1.0f, -11)), 1.0f);
+    XCTAssertEqual(roundToFloat16(1.0f + 3.0f * std::ldexp(1.0f, -11)), 1.0f + std::ldexp(1.0f, -9));
+    XCTAssertEqual(roundToFloat16(0.1f), 0.0999755859375f);
+    XCTAssertEqual(roundToFloat16(FLOAT16_MAX), FLOAT16_MAX);
+    XCTAssertEqual(roundToFloat16(65519.0f), FLOAT16_MAX);
+    XCTAssertTrue(std::isinf(roundToFloat16(65520.0f)));
+    XCTAssertTrue(std::isinf(roundToFloat16(-std::numeric_limits<float>::infinity())));
+    XCTAssertTrue(std::isnan(roundToFloat16(std::numeric_limits<float>::quiet_NaN())));
+
+    // Subnormals are kept down to 2^-24, then round to even
+    XCTAssertEqual(roundToFloat16(std::ldexp(1.0f, -24)), std::ldexp(1.0f, -24));
+    XCTAssertEqual(roundToFloat16(std::ldexp(1.0f, -25)), 0.0f);
+    XCTAssertEqual(roundToFloat16(3.0f * std::ldexp(1.0f, -25)), std::ldexp(1.0f, -23));
+    XCTAssertTrue(std::signbit(roundToFloat16(-1.0e-9f)));
+}
+
+- (void)testFixedPointConversionsRoundAndSaturate {
+    XCTAssertEqual(toQ15(0.5f), 16384);
+    XCTAssertEqual(toQ15(1.0f), INT16_MAX);
+    XCTAssertEqual(toQ15(-1.0f), INT16_MIN);
+    XCTAssertEqual(toQ15(-3.0f), INT16_MIN);
+    XCTAssertEqual(toQ15(0.5f / 32768.0f), 0);
+    XCTAssertEqual(toQ15(1.5f / 32768.0f), 2);
+    XCTAssertEqual(toQ15(std::numeric_limits<float>::quiet_NaN()), 0);
+    XCTAssertEqual(q15Gain(1.0f), 8192);
+    XCTAssertEqual(fromQ15(INT16_MIN), -1.0f);
+
+    XCTAssertEqual(toQ31(0.25f), 1 << 29);
+    XCTAssertEqual(toQ31(1.0f), INT32_MAX);
+    XCTAssertEqual(toQ31(-1.0f), INT32_MIN);
+    XCTAssertEqual(toQ31(std::numeric_limits<float>::infinity()), INT32_MAX);
+    XCTAssertEqual(toQ31(std::numeric_limits<float>::quiet_NaN()), 0);
+    XCTAssertEqual(q31Gain(1.0f), 1 << 29);
+
+    // Rounding right shifts, saturating the headroom a +12 dB gain can reach
+    XCTAssertEqual(multiplyQ15(16384, q15Gain(0.5f)), 8192);
+    XCTAssertEqual(multiplyQ15(3, 4096), 2);
+    XCTAssertEqual(multiplyQ15(16384, q15Gain(3.9f)), INT16_MAX);
+    XCTAssertEqual(multiplyQ15(INT16_MIN, q15Gain(3.9f)), INT16_MIN);
+    XCTAssertEqual(multiplyQ31(1 << 30, q31Gain(0.5f)), 1 << 29);
+    XCTAssertEqual(multiplyQ31(1 << 30, q31Gain(3.9f)), INT32_MAX);
+    XCTAssertEqual(multiplyQ31(INT32_MIN, q31Gain(3.9f)), INT32_MIN);
+}
+
+// MARK: - Backend Tests
+
+- (void)testBackendsExistForEveryReducedPrecision {
+    XCTAssertTrue(activeReducedPrecisionBackend(ProcessingPrecision::Float32) == nullptr);
+    XCTAssertTrue(availableReducedPrecisionBackends(ProcessingPrecision::Float32).empty());
+
+    for (ProcessingPrecision precision : kReducedPrecisions) {
+        const ReducedPrecisionBackend* active = activeReducedPrecisionBackend(precision);
+        XCTAssertTrue(active != nullptr);
+        XCTAssertEqual(active->precision, precision);
+
+        const auto backends = availableReducedPrecisionBackends(precision);
+        XCTAssertFalse(backends.empty());
+        XCTAssertEqual(backends.front()->kind, DSPBackendKind::Scalar);
+        XCTAssertEqual(findReducedPrecisionBackend(precision, active->kind), active);
+        XCTAssertTrue(findReducedPrecisionBackend(precision, DSPBackendKind::AVX2) == nullptr);
+    }
+
+    // 16-bit formats fit twice the samples of binary32 in a NEON register
+    if (const DSPBackend* neon = findDSPBackend(DSPBackendKind::NEON)) {
+        const ReducedPrecisionBackend* q15 = findReducedPrecisionBackend(ProcessingPrecision::Q15, DSPBackendKind::NEON);
+        XCTAssertEqual(q15->lanes, 2 * neon->lanes);
+        XCTAssertEqual(activeReducedPrecisionBackend(ProcessingPrecision::Q15), q15);
+    }
+}
+
+- (void)testAllBackendsMatchScalarReference {
+    for (ProcessingPrecision precision : kReducedPrecisions) {
+        const ReducedPrecisionBackend& scalar = *findReducedPrecisionBackend(precision, DSPBackendKind::Scalar);
+
+        for (const ReducedPrecisionBackend* backend : availableReducedPrecisionBackends(precision)) {
+            for (size_t length : kTestLengths) {
+                const std::vector<float> input = makeEdgeSignal(length);
+                std::vector<float> ramp(length);
+                for (size_t i = 0; i < length; ++i) {
+                    ramp[i] = 3.9f - 0.0037f * static_cast<float>(i);
+                }
+                std::vector<float> expected(length);
+                std::vector<float> actual(length);
+
+                scalar.gain(input.data(), expected.data(), length, 0.70794576f);
+                backend->gain(input.data(), actual.data(), length, 0.70794576f);
+                XCTAssertTrue(bitIdentical(expected, actual), @"%s %s gain length %zu",
+                              processingPrecisionName(precision), backend->name, length);
+
+                scalar.ramp(input.data(), expected.data(), ramp.data(), length);
+                backend->ramp(input.data(), actual.data(), ramp.data(), length);
+                XCTAssertTrue(bitIdentical(expected, actual), @"%s %s ramp length %zu",
+                              processingPrecisionName(precision), backend->name, length);
+
+                // In place
+                actual = input;
+                backend->ramp(actual.data(), actual.data(), ramp.data(), length);
+                XCTAssertTrue(bitIdentical(expected, actual), @"%s %s in-place ramp length %zu",
+                              processingPrecisionName(precision), backend->name, length);
+            }
+        }
+    }
+}
+
+// MARK: - Accuracy Tests
+
+- (void)testReducedKernelsStayWithinBoundsOfFloat32Reference {
+    const std::vector<float> input = makeSignal(kTestFrames);
+
+    for (BufferLayout layout : { BufferLayout::Interleaved, BufferLayout::Planar }) {
+        for (ProcessingPrecision precision : kReducedPrecisions) {
+            auto reference = createDSPKernel(kTestSampleRate, kTestChannels);
+            auto reduced = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ,
+                                           MAX_BUFFER_SIZE, precision);
+            XCTAssertEqual(reduced->processingPrecision(), precision);
+
+            // Constant gain, then a ramp down crossing block boundaries, then unity ramping back
+            for (DSPKernel* kernel : { reference.get(), reduced.get() }) {
+                scheduleGain(*kernel, -6.0f, 1);
+                scheduleGain(*kernel, -12.0f, 700, 1000);
+                scheduleGain(*kernel, 0.0f, 300, 2500);
+            }
+            const std::vector<float> expected = render(*reference, input, layout);
+            const std::vector<float> actual = render(*reduced, input, layout);
+
+            size_t violations = 0;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                if (std::fabs(static_cast<double>(actual[i]) - expected[i]) > errorBound(precision, input[i], expected[i])) {
+                    ++violations;
+                }
+            }
+            XCTAssertEqual(violations, 0u, @"%s", processingPrecisionName(precision));
+            XCTAssertGreaterThan(signalToErrorDB(expected, actual), minimumSignalToErrorDB(precision),
+                                 @"%s", processingPrecisionName(precision));
+            XCTAssertFalse(bitIdentical(expected, actual), @"%s must actually quantize",
+                           processingPrecisionName(precision));
+        }
+    }
+}
+
+- (void)testLayoutDoesNotChangeReducedResults {
+    const std::vector<float> input = makeSignal(kTestFrames);
+
+    for (ProcessingPrecision precision : kReducedPrecisions) {
+        auto interleaved = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold,
+                                           MAX_BUFFER_SIZE, precision);
+        auto planar = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold,
+                                      MAX_BUFFER_SIZE, precision);
+        auto converting = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::VectorThreshold,
+                                          MAX_BUFFER_SIZE, precision);
+        for (DSPKernel* kernel : { interleaved.get(), planar.get(), converting.get() }) {
+            scheduleGain(*kernel, -3.0f, 900, 100);
+        }
+
+        const std::vector<float> expected = render(*interleaved, input, BufferLayout::Interleaved);
+        XCTAssertTrue(bitIdentical(expected, render(*planar, input, BufferLayout::Planar)),
+                      @"%s", processingPrecisionName(precision));
+
+        // Planar in, interleaved out
+        std::vector<float> left(kTestFrames);
+        std::vector<float> right(kTestFrames);
+        for (size_t frame = 0; frame < kTestFrames; ++frame) {
+            left[frame] = input[frame * kTestChannels];
+            right[frame] = input[frame * kTestChannels + 1];
+        }
+        std::vector<float> actual(input.size());
+        for (size_t offset = 0; offset < kTestFrames; offset += kTestBlockSize) {
+            float* planes[kTestChannels] = { left.data() + offset, right.data() + offset };
+            converting->process(AudioBufferView::makePlanar(planes, kTestChannels, kTestBlockSize),
+                                AudioBufferView::makeInterleaved(actual.data() + offset * kTestChannels,
+                                                                 kTestChannels, kTestBlockSize));
+        }
+        XCTAssertTrue(bitIdentical(expected, actual), @"%s planar to interleaved", processingPrecisionName(precision));
+    }
+}
+
+- (void)testUnityGainStillQuantizes {
+    std::vector<float> samples = { 1.0f + std::ldexp(1.0f, -12), 0.1f, -0.3f, 1.0e-9f };
+    const std::vector<float> original = samples;
+
+    auto float16 = createDSPKernel(kTestSampleRate, 1, DenormalMode::HardwareFTZ, MAX_BUFFER_SIZE,
+                                   ProcessingPrecision::Float16);
+    float16->process(samples.data(), samples.data(), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        XCTAssertEqual(samples[i], roundToFloat16(original[i]));
+    }
+
+    samples = original;
+    auto q15 = createDSPKernel(kTestSampleRate, 1, DenormalMode::HardwareFTZ, MAX_BUFFER_SIZE,
+                               ProcessingPrecision::Q15);
+    q15->process(samples.data(), samples.data(), samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        XCTAssertEqual(samples[i], fromQ15(toQ15(original[i])));
+    }
+}
+
+- (void)testFixedPointClipsAtFullScaleWhileFloatKeepsHeadroom {
+    for (ProcessingPrecision precision : kReducedPrecisions) {
+        auto kernel = createDSPKernel(kTestSampleRate, 1, DenormalMode::HardwareFTZ, MAX_BUFFER_SIZE, precision);
+        scheduleGain(*kernel, 12.0f, 1);
+
+        std::vector<float> samples = { 0.5f, -0.5f, 0.01f };
+        kernel->process(samples.data(), samples.data(), samples.size());
+
+        if (precision == ProcessingPrecision::Float16) {
+            XCTAssertEqualWithAccuracy(samples[0], 1.9905f, 2.0e-3);
+            XCTAssertEqualWithAccuracy(samples[1], -1.9905f, 2.0e-3);
+        }
+        else {
+            XCTAssertLessThanOrEqual(samples[0], 1.0f, @"%s", processingPrecisionName(precision));
+            XCTAssertGreaterThan(samples[0], 0.9999f, @"%s", processingPrecisionName(precision));
+            XCTAssertEqual(samples[1], -1.0f, @"%s", processingPrecisionName(precision));
+        }
+        XCTAssertEqualWithAccuracy(samples[2], 0.0398f, 2.0e-4);
+    }
+}
+
+// MARK: - Configuration Tests
+
+- (void)testFloat32RemainsTheDefault {
+    auto kernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, 128);
+    XCTAssertEqual(kernel->processingPrecision(), ProcessingPrecision::Float32);
+    XCTAssertTrue(kernel->hasFixedBlockKernel());
+
+    // Reduced precisions leave the float32 fixed-block loops alone
+    auto reduced = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, 128,
+                                   ProcessingPrecision::Q15);
+    XCTAssertFalse(reduced->hasFixedBlockKernel());
+
+    XCTAssertThrowsSpecific(createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ,
+                                            MAX_BUFFER_SIZE, static_cast<ProcessingPrecision>(9)),
+                            std::invalid_argument);
+}
+
+- (void)testPrecisionSurvivesForkPrepareAndSerialization {
+    const std::vector<float> input = makeSignal(1024);
+
+    auto kernel = createDSPKernel(kTestSampleRate, kTestChannels, DenormalMode::HardwareFTZ, MAX_BUFFER_SIZE,
+                                  ProcessingPrecision::Q15);
+    scheduleGain(*kernel, -4.5f, 1);
+    const std::vector<float> expected = render(*kernel, input, BufferLayout::Interleaved);
+
+    std::unique_ptr<DSPKernel> forked = kernel->fork();
+    XCTAssertEqual(forked->processingPrecision(), ProcessingPrecision::Q15);
+    XCTAssertTrue(bitIdentical(expected, render(*forked, input, BufferLayout::Interleaved)));
+
+    const std::vector<uint8_t> state = kernel->serializeState();
+    std::unique_ptr<DSPKernel> restored = DSPKernel::restoreState(state.data(), state.size());
+    XCTAssertEqual(restored->processingPrecision(), ProcessingPrecision::Q15);
+    XCTAssertTrue(bitIdentical(expected, render(*restored, input, BufferLayout::Interleaved)));
+
+    restored->prepare(kTestBlockSize, kTestChannels, kTestSampleRate);
+    restored->reset();
+    XCTAssertEqual(restored->processingPrecision(), ProcessingPrecision::Q15);
+    XCTAssertTrue(bitIdentical(expected, render(*restored, input, BufferLayout::Interleaved)));
+
+    // The precision is the last byte of a gain kernel's state
+    std::vector<uint8_t> damaged = state;
+    damaged.back() = 9;
+    XCTAssertThrowsSpecific(DSPKernel::restoreState(damaged.data(), damaged.size()), std::runtime_error);
+}
+
+@end
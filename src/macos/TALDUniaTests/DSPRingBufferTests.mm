@@ -0,0 +1,249 @@
+//
+// DSPRingBufferTests.mm
+// TALD UNIA
+//
+// Unit tests for the SPSC audio ring buffer and kernel ring handoff
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "../../shared/DSP/DSPKernel.hpp"
+#include "../../shared/DSP/DSPRingBuffer.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const int kTestChannels = 2;
+static const size_t kTestCapacity = 1024;
+static const float kTestGain = 0.5f;
+
+/**
+ * Fixed gain, checking every call gets one contiguous interleaved region
+ */
+class TestGainKernel final : public DSPKernel {
+public:
+    TestGainKernel(double sampleRate, int channels, size_t maxFrames)
+        : DSPKernel(sampleRate, channels, DenormalMode::HardwareFTZ, maxFrames) {}
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override {
+        ++calls;
+        interleavedOnly = interleavedOnly && input.layout == BufferLayout::Interleaved &&
+                          output.layout == BufferLayout::Interleaved;
+        for (size_t i = 0; i < input.frames * static_cast<size_t>(numChannels); ++i) {
+            output.interleaved[i] = kTestGain * input.interleaved[i];
+        }
+    }
+
+    std::unique_ptr<DSPKernel> fork() const override {
+        return std::make_unique<TestGainKernel>(sampleRate, numChannels, maximumFramesPerBlock());
+    }
+
+    int calls = 0;
+    bool interleavedOnly = true;
+
+private:
+    void resetState() noexcept override {}
+};
+
+// Interleaved frames whose samples encode their frame index and channel
+static std::vector<float> makeFrames(size_t first, size_t frames, int channels) {
+    std::vector<float> samples(frames * static_cast<size_t>(channels));
+    for (size_t frame = 0; frame < frames; ++frame) {
+        for (int channel = 0; channel < channels; ++channel) {
+            samples[frame * channels + channel] = static_cast<float>((first + frame) * 8 + channel);
+        }
+    }
+    return samples;
+}
+
+@interface DSPRingBufferTests : XCTestCase
+@end
+
+@implementation DSPRingBufferTests
+
+// MARK: - Configuration Tests
+
+- (void)testInvalidConfigurationsThrow {
+    XCTAssertThrows(AudioRingBuffer(0, kTestCapacity));
+    XCTAssertThrows(AudioRingBuffer(MAX_CHANNELS + 1, kTestCapacity));
+    XCTAssertThrows(AudioRingBuffer(kTestChannels, 0));
+    XCTAssertThrows(AudioRingBuffer(kTestChannels, MAX_RING_BUFFER_FRAMES + 1));
+}
+
+- (void)testCapacityRoundsUpToPowerOfTwo {
+    AudioRingBuffer ring(kTestChannels, 1000);
+    XCTAssertEqual(ring.capacity(), 1024u);
+    XCTAssertEqual(ring.channelCount(), kTestChannels);
+    XCTAssertEqual(ring.mapping(), RingMapping::Flat);
+    XCTAssertEqual(ring.availableToRead(), 0u);
+    XCTAssertEqual(ring.availableToWrite(), 1024u);
+}
+
+// MARK: - Flat Mapping Tests
+
+- (void)testCopiesWrapAroundInOrder {
+    AudioRingBuffer ring(kTestChannels, kTestCapacity);
+    size_t written = 0;
+    size_t read = 0;
+    std::vector<float> output(300 * kTestChannels);
+    for (int round = 0; round < 20; ++round) {
+        const std::vector<float> input = makeFrames(written, 300, kTestChannels);
+        XCTAssertEqual(ring.write(input.data(), 300), 300u);
+        written += 300;
+        XCTAssertEqual(ring.read(output.data(), 300), 300u);
+        XCTAssertEqual(output, makeFrames(read, 300, kTestChannels));
+        read += 300;
+    }
+}
+
+- (void)testFullAndEmptyRingsLimitTransfers {
+    AudioRingBuffer ring(kTestChannels, kTestCapacity);
+    const std::vector<float> input = makeFrames(0, 1500, kTestChannels);
+    XCTAssertEqual(ring.write(input.data(), 1500), kTestCapacity);
+    XCTAssertEqual(ring.availableToWrite(), 0u);
+    XCTAssertEqual(ring.acquireWrite(16).frames, 0u);
+
+    std::vector<float> output(1500 * kTestChannels);
+    XCTAssertEqual(ring.read(output.data(), 1500), kTestCapacity);
+    XCTAssertEqual(ring.acquireRead(16).frames, 0u);
+    XCTAssertTrue(std::equal(output.begin(), output.begin() + kTestCapacity * kTestChannels, input.begin()));
+}
+
+- (void)testFlatRegionsStopAtTheEndOfStorage {
+    AudioRingBuffer ring(kTestChannels, kTestCapacity);
+    std::vector<float> scratch(1000 * kTestChannels);
+    ring.write(scratch.data(), 1000);
+    ring.read(scratch.data(), 1000);
+
+    // 24 frames left before the end, then the rest from the start
+    AudioBufferView region = ring.acquireWrite(100);
+    XCTAssertEqual(region.layout, BufferLayout::Interleaved);
+    XCTAssertEqual(region.frames, 24u);
+    ring.commitWrite(region.frames);
+    const AudioBufferView wrapped = ring.acquireWrite(76);
+    XCTAssertEqual(wrapped.frames, 76u);
+    XCTAssertTrue(wrapped.interleaved < region.interleaved);
+}
+
+// MARK: - Mirrored Mapping Tests
+
+- (void)testMirroredRegionsStayContiguousAcrossTheWrap {
+    AudioRingBuffer ring(kTestChannels, kTestCapacity, RingMapping::Mirrored);
+    if (ring.mapping() != RingMapping::Mirrored) {
+        return; // Platform without mirrored mappings; nothing more to check
+    }
+    XCTAssertGreaterThanOrEqual(ring.capacity(), kTestCapacity);
+
+    const size_t lead = ring.capacity() - 24;
+    std::vector<float> scratch(lead * kTestChannels);
+    ring.write(scratch.data(), lead);
+    ring.read(scratch.data(), lead);
+
+    // One region straddling the end, written in place
+    AudioBufferView region = ring.acquireWrite(100);
+    XCTAssertEqual(region.frames, 100u);
+    const std::vector<float> input = makeFrames(0, 100, kTestChannels);
+    std::copy(input.begin(), input.end(), region.interleaved);
+    ring.commitWrite(100);
+
+    const AudioBufferView readable = ring.acquireRead(100);
+    XCTAssertEqual(readable.frames, 100u);
+    XCTAssertEqual(readable.interleaved, region.interleaved);
+    XCTAssertTrue(std::equal(input.begin(), input.end(), readable.interleaved));
+    ring.commitRead(100);
+
+    // The 76 frames past the end are the same pages as the start of the storage
+    const float* start = readable.interleaved + 24 * kTestChannels -
+                         ring.capacity() * static_cast<size_t>(kTestChannels);
+    XCTAssertTrue(std::equal(input.begin() + 24 * kTestChannels, input.end(), start));
+    XCTAssertEqual(ring.availableToRead(), 0u);
+}
+
+// MARK: - Threading Tests
+
+- (void)testProducerAndConsumerThreadsStreamInOrder {
+    for (RingMapping mapping : { RingMapping::Flat, RingMapping::Mirrored }) {
+        AudioRingBuffer ring(kTestChannels, 256, mapping);
+        const size_t total = 200000;
+        std::atomic<bool> ordered{true};
+
+        std::thread producer([&] {
+            size_t next = 0;
+            while (next < total) {
+                const AudioBufferView region = ring.acquireWrite(std::min<size_t>(61, total - next));
+                for (size_t frame = 0; frame < region.frames; ++frame) {
+                    for (int channel = 0; channel < kTestChannels; ++channel) {
+                        region.interleaved[frame * kTestChannels + channel] =
+                            static_cast<float>((next + frame) % 65536 * 8 + channel);
+                    }
+                }
+                ring.commitWrite(region.frames);
+                next += region.frames;
+            }
+        });
+
+        size_t received = 0;
+        while (received < total) {
+            const AudioBufferView region = ring.acquireRead(37);
+            for (size_t frame = 0; frame < region.frames; ++frame) {
+                for (int channel = 0; channel < kTestChannels; ++channel) {
+                    if (region.interleaved[frame * kTestChannels + channel] !=
+                        static_cast<float>((received + frame) % 65536 * 8 + channel)) {
+                        ordered = false;
+                    }
+                }
+            }
+            ring.commitRead(region.frames);
+            received += region.frames;
+        }
+        producer.join();
+        XCTAssertTrue(ordered.load());
+        XCTAssertEqual(ring.availableToRead(), 0u);
+    }
+}
+
+// MARK: - Kernel Handoff Tests
+
+- (void)testKernelRendersBetweenRingsInPlace {
+    TestGainKernel kernel(48000.0, kTestChannels, 128);
+    AudioRingBuffer input(kTestChannels, kTestCapacity);
+    AudioRingBuffer output(kTestChannels, kTestCapacity);
+
+    // Move the flat rings near their ends so the handoff has to wrap
+    std::vector<float> scratch(1000 * kTestChannels);
+    input.write(scratch.data(), 1000);
+    input.read(scratch.data(), 1000);
+    output.write(scratch.data(), 990);
+    output.read(scratch.data(), 990);
+
+    const std::vector<float> source = makeFrames(0, 400, kTestChannels);
+    input.write(source.data(), 400);
+    XCTAssertEqual(processRingBuffers(kernel, input, output, 1000), 400u);
+    XCTAssertTrue(kernel.interleavedOnly);
+    XCTAssertGreaterThan(kernel.calls, 3);   // Blocks of at most 128, split at both wraps
+
+    std::vector<float> rendered(400 * kTestChannels);
+    XCTAssertEqual(output.read(rendered.data(), 400), 400u);
+    for (size_t i = 0; i < rendered.size(); ++i) {
+        XCTAssertEqual(rendered[i], kTestGain * source[i]);
+    }
+
+    // Output room limits the handoff, and a channel mismatch renders nothing
+    input.write(source.data(), 400);
+    XCTAssertEqual(processRingBuffers(kernel, input, output, 1000), 400u);
+    input.write(source.data(), 400);
+    XCTAssertEqual(processRingBuffers(kernel, input, output, 1000), 400u);
+    input.write(source.data(), 400);
+    XCTAssertEqual(processRingBuffers(kernel, input, output, 1000), kTestCapacity - 800);
+    AudioRingBuffer mono(1, kTestCapacity);
+    XCTAssertEqual(processRingBuffers(kernel, mono, output, 100), 0u);
+}
+
+@end
@@ -0,0 +1,234 @@
+//
+// DynamicsKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the look-ahead compressor/limiter
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "../../shared/DSP/DynamicsKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestFrames = 512;
+
+static std::vector<float> makeSine(double frequency, float amplitude, size_t frames, int channels) {
+    std::vector<float> signal(frames * static_cast<size_t>(channels));
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const float sample = amplitude * static_cast<float>(
+            std::sin(2.0 * std::numbers::pi * frequency * frame / kTestSampleRate));
+        for (int channel = 0; channel < channels; ++channel) {
+            signal[frame * channels + channel] = sample;
+        }
+    }
+    return signal;
+}
+
+static std::vector<float> renderInterleaved(DSPKernel& kernel, const std::vector<float>& input, size_t blockFrames) {
+    const size_t channels = static_cast<size_t>(kernel.channelCount());
+    const size_t frames = input.size() / channels;
+    std::vector<float> output(input.size(), 0.0f);
+    for (size_t frame = 0; frame < frames; frame += blockFrames) {
+        const size_t count = std::min(blockFrames, frames - frame);
+        kernel.processInterleaved(input.data() + frame * channels, output.data() + frame * channels, count);
+    }
+    return output;
+}
+
+static void setControls(DSPKernel& kernel, float threshold, float ratio, float knee) {
+    kernel.setParameter(kParameterThreshold, threshold);
+    kernel.setParameter(kParameterRatio, ratio);
+    kernel.setParameter(kParameterKnee, knee);
+}
+
+static float peakOf(const std::vector<float>& signal, size_t begin) {
+    float peak = 0.0f;
+    for (size_t i = begin; i < signal.size(); ++i) {
+        peak = std::max(peak, std::fabs(signal[i]));
+    }
+    return peak;
+}
+
+static float decibels(float gain) {
+    return 20.0f * std::log10(gain);
+}
+
+@interface DynamicsKernelTests : XCTestCase
+@end
+
+@implementation DynamicsKernelTests
+
+// MARK: - Configuration Tests
+
+- (void)testLookAheadSetsLatency {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels);
+    XCTAssertEqual(kernel.latencyFrames(), 240u);
+    XCTAssertEqual(kernel.detectorMode(), DynamicsDetector::Peak);
+
+    DynamicsKernel direct(kTestSampleRate, kTestChannels, DynamicsDetector::RMS, 0.0);
+    XCTAssertEqual(direct.latencyFrames(), 0u);
+
+    XCTAssertThrows(DynamicsKernel(kTestSampleRate, kTestChannels, DynamicsDetector::Peak, -0.001));
+    XCTAssertThrows(DynamicsKernel(kTestSampleRate, kTestChannels, DynamicsDetector::Peak,
+                                   MAX_DYNAMICS_LOOKAHEAD_SECONDS * 2.0));
+}
+
+- (void)testQuietSignalsPassDelayed {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels);
+    const std::vector<float> input = makeSine(1000.0, 0.01f, 8192, kTestChannels);
+    const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+
+    const size_t latency = kernel.latencyFrames() * kTestChannels;
+    for (size_t i = 0; i < latency; ++i) {
+        XCTAssertEqual(output[i], 0.0f);
+    }
+    float maxError = 0.0f;
+    for (size_t i = latency; i < output.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(output[i] - input[i - latency]));
+    }
+    XCTAssertLessThan(maxError, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(kernel.gainReductionDB(), 0.0f, 1.0e-6f);
+}
+
+// MARK: - Gain Computer Tests
+
+- (void)testStaticCurveMatchesHardAndSoftKnee {
+    struct Case { float levelDB; float knee; float expectedReduction; };
+    const Case cases[] = {
+        // 14 dB over a -20 dB threshold at 4:1 removes three quarters of the overshoot
+        { -6.0f, 0.0f, 10.5f },
+        // Inside a 12 dB knee: 3/4 * (over + 6)^2 / 24
+        { -24.0f, 12.0f, 0.125f },
+        { -30.0f, 12.0f, 0.0f },
+    };
+    for (const Case& test : cases) {
+        for (DynamicsDetector detector : { DynamicsDetector::Peak, DynamicsDetector::RMS }) {
+            DynamicsKernel kernel(kTestSampleRate, kTestChannels, detector);
+            setControls(kernel, -20.0f, 4.0f, test.knee);
+            // Constant input: peak and RMS levels coincide once the detector settles
+            const float level = std::pow(10.0f, test.levelDB / 20.0f);
+            const std::vector<float> input(kTestFrames * kTestChannels * 40, level);
+            const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+
+            XCTAssertEqualWithAccuracy(decibels(output.back() / level), -test.expectedReduction, 2.0e-3f);
+            XCTAssertEqualWithAccuracy(kernel.gainReductionDB(), test.expectedReduction, 2.0e-3f);
+        }
+    }
+}
+
+- (void)testSidechainIsLinkedAcrossChannels {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels);
+    setControls(kernel, -20.0f, 4.0f, 0.0f);
+    std::vector<float> input(kTestFrames * kTestChannels * 40);
+    for (size_t frame = 0; frame < input.size() / kTestChannels; ++frame) {
+        input[frame * kTestChannels] = 0.5f;
+        input[frame * kTestChannels + 1] = 0.01f;
+    }
+    const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+
+    // The quiet channel is reduced by the loud one's gain, keeping the balance
+    const float loudGain = output[output.size() - 2] / 0.5f;
+    const float quietGain = output[output.size() - 1] / 0.01f;
+    XCTAssertLessThan(loudGain, 0.5f);
+    XCTAssertEqualWithAccuracy(quietGain, loudGain, 1.0e-4f);
+}
+
+// MARK: - Limiter Tests
+
+- (void)testLookAheadCatchesTransients {
+    const float thresholdDB = -6.0f;
+    const float limit = std::pow(10.0f, thresholdDB / 20.0f);
+    const auto burstPeak = [&](double lookAhead) {
+        DynamicsKernel kernel(kTestSampleRate, 1, DynamicsDetector::Peak, lookAhead);
+        setControls(kernel, thresholdDB, MAX_DYNAMICS_RATIO, 0.0f);
+        kernel.setParameter(kParameterAttack, 0.0001f);
+        kernel.setParameter(kParameterRelease, 0.1f);
+
+        // Silence, then a full-scale burst
+        std::vector<float> input(9600, 0.0f);
+        const std::vector<float> burst = makeSine(1000.0, 1.0f, 9600, 1);
+        input.insert(input.end(), burst.begin(), burst.end());
+        return peakOf(renderInterleaved(kernel, input, kTestFrames), 0);
+    };
+
+    XCTAssertLessThan(burstPeak(DEFAULT_DYNAMICS_LOOKAHEAD_SECONDS), limit * 1.02f);
+    XCTAssertGreaterThan(burstPeak(0.0), limit * 1.2f);
+}
+
+// MARK: - Control Tests
+
+- (void)testMakeupGainRampsInDecibels {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels);
+    kernel.setParameter(kParameterGain, 6.0f);
+    const std::vector<float> input(kTestFrames * kTestChannels * 8, 0.01f);
+    const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+
+    // After the look-ahead silence the gain rises smoothly, about 1.4e-5 per frame here
+    const size_t latency = kernel.latencyFrames() * kTestChannels;
+    XCTAssertEqual(output[latency - 1], 0.0f);
+    for (size_t i = latency + kTestChannels; i < output.size(); ++i) {
+        XCTAssertGreaterThanOrEqual(output[i], output[i - kTestChannels]);
+        XCTAssertLessThan(output[i] - output[i - kTestChannels], 5.0e-5f);
+    }
+    XCTAssertEqualWithAccuracy(output.back(), 0.01f * std::pow(10.0f, 6.0f / 20.0f), 1.0e-6f);
+}
+
+- (void)testBlockSizeDoesNotChangeOutput {
+    DynamicsKernel whole(kTestSampleRate, kTestChannels, DynamicsDetector::RMS);
+    DynamicsKernel pieces(kTestSampleRate, kTestChannels, DynamicsDetector::RMS);
+    setControls(whole, -30.0f, 8.0f, 6.0f);
+    setControls(pieces, -30.0f, 8.0f, 6.0f);
+
+    const std::vector<float> input = makeSine(440.0, 0.8f, 16384, kTestChannels);
+    const std::vector<float> a = renderInterleaved(whole, input, kTestFrames);
+    const std::vector<float> b = renderInterleaved(pieces, input, 37);
+    for (size_t i = 0; i < a.size(); ++i) {
+        XCTAssertEqual(a[i], b[i]);
+    }
+}
+
+- (void)testParameterEventsApplyAtTheirOffsets {
+    DynamicsKernel kernel(kTestSampleRate, 1, DynamicsDetector::Peak, 0.0);
+    setControls(kernel, 0.0f, 4.0f, 0.0f);
+    kernel.setParameter(kParameterAttack, 0.0001f);
+
+    ParameterEvent event;
+    event.parameterID = kParameterThreshold;
+    event.value = -40.0f;
+    event.sampleOffset = 300;
+    kernel.scheduleParameter(event);
+
+    const std::vector<float> input(kTestFrames, 0.5f);
+    const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+    XCTAssertEqualWithAccuracy(output[299], 0.5f, 1.0e-5f);
+    XCTAssertLessThan(output[320], 0.5f * std::pow(10.0f, -20.0f / 20.0f));
+}
+
+- (void)testForkKeepsControls {
+    DynamicsKernel kernel(kTestSampleRate, kTestChannels, DynamicsDetector::RMS, 0.002);
+    setControls(kernel, -30.0f, 8.0f, 3.0f);
+    kernel.setParameter(kParameterGain, 3.0f);
+    auto fork = kernel.fork();
+    const DynamicsKernel& forked = static_cast<const DynamicsKernel&>(*fork);
+    XCTAssertEqual(forked.latencyFrames(), kernel.latencyFrames());
+    XCTAssertEqual(forked.detectorMode(), DynamicsDetector::RMS);
+
+    const std::vector<float> input = makeSine(200.0, 0.7f, 8192, kTestChannels);
+    const std::vector<float> a = renderInterleaved(kernel, input, kTestFrames);
+    const std::vector<float> b = renderInterleaved(*fork, input, kTestFrames);
+    for (size_t i = kTestFrames * kTestChannels; i < a.size(); ++i) {
+        XCTAssertEqualWithAccuracy(a[i], b[i], 1.0e-6f);
+    }
+}
+
+@end
@@ -0,0 +1,198 @@
+//
+// HRTFStoreTests.mm
+// TALD UNIA
+//
+// Unit tests for the HRTF store and interpolated filter cache
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../shared/DSP/HRTFStore.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const size_t kTestBlockSize = 64;
+static const size_t kTestIRLength = 200;     // Four partitions, the last one partial
+static const float kTestTolerance = 1.0e-6f;
+
+static HRTFGrid makeGrid() {
+    HRTFGrid grid;
+    grid.azimuthCount = 8;           // Every 45 degrees
+    grid.elevationCount = 3;         // -45, 0, +45
+    grid.minElevationDegrees = -45.0f;
+    grid.maxElevationDegrees = 45.0f;
+    return grid;
+}
+
+// Decaying noise, different for every measurement and ear
+static std::vector<float> makeHRIRs(const HRTFGrid& grid) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<float> hrirs(static_cast<size_t>(grid.azimuthCount * grid.elevationCount) * 2 * kTestIRLength);
+    for (size_t i = 0; i < hrirs.size(); ++i) {
+        hrirs[i] = distribution(generator) * std::exp(-static_cast<float>(i % kTestIRLength) / 40.0f);
+    }
+    return hrirs;
+}
+
+static const float* hrirAt(const std::vector<float>& hrirs, const HRTFGrid& grid, int elevation, int azimuth, int ear) {
+    return hrirs.data() + ((static_cast<size_t>(elevation) * grid.azimuthCount + azimuth) * 2 + ear) * kTestIRLength;
+}
+
+static float maxSpectrumDifference(const PartitionedFilter& a, const PartitionedFilter& b) {
+    float difference = 0.0f;
+    for (int channel = 0; channel < 2; ++channel) {
+        for (size_t partition = 0; partition < a.partitionCount(channel); ++partition) {
+            for (size_t i = 0; i < 2 * kTestBlockSize; ++i) {
+                difference = std::max(difference, std::fabs(a.spectrum(channel, partition)[i] -
+                                                            b.spectrum(channel, partition)[i]));
+            }
+        }
+    }
+    return difference;
+}
+
+@interface HRTFStoreTests : XCTestCase
+@end
+
+@implementation HRTFStoreTests {
+    HRTFGrid _grid;
+    std::vector<float> _hrirs;
+    std::shared_ptr<const HRTFStore> _store;
+}
+
+// MARK: - Test Lifecycle
+
+- (void)setUp {
+    [super setUp];
+    _grid = makeGrid();
+    _hrirs = makeHRIRs(_grid);
+    _store = HRTFStore::create(kTestBlockSize, _grid, _hrirs.data(), kTestIRLength);
+}
+
+// MARK: - Store Tests
+
+- (void)testInvalidStoresThrow {
+    HRTFGrid empty;
+    XCTAssertThrows(HRTFStore::create(kTestBlockSize, empty, _hrirs.data(), kTestIRLength));
+    XCTAssertThrows(HRTFStore::create(100, _grid, _hrirs.data(), kTestIRLength));
+    XCTAssertThrows(HRTFStore::create(kTestBlockSize, _grid, nullptr, kTestIRLength));
+    XCTAssertThrows(HRTFFilterCache(_store, 0));
+    XCTAssertThrows(HRTFFilterCache(_store, 16, 90.0f));
+    XCTAssertThrows(HRTFFilterCache(_store, 16, 0.0f));
+    XCTAssertThrows(HRTFFilterCache(_store, 16, -5.0f));
+    XCTAssertThrows(HRTFFilterCache(_store, 16, std::nanf("")));
+}
+
+- (void)testGridPointMatchesDirectlyPartitionedHRIR {
+    XCTAssertEqual(_store->partitionCount(), 4u);
+
+    // 90 degrees right, +45 elevation: column 2 of the top row
+    const SharedFFTSetup setup = acquireFFTSetup(KERNEL_FFT_LOG2N);
+    const ImpulseResponse responses[2] = {
+        { hrirAt(_hrirs, _grid, 2, 2, 0), kTestIRLength, 0 },
+        { hrirAt(_hrirs, _grid, 2, 2, 1), kTestIRLength, 0 }
+    };
+    const auto expected = PartitionedFilter::create(setup.get(), kTestBlockSize, responses, 2);
+    const auto filter = _store->interpolate(90.0f, 45.0f);
+
+    XCTAssertEqual(filter->channelCount(), 2);
+    XCTAssertEqual(filter->inputMask(), 1u);
+    XCTAssertEqual(filter->inputChannel(1), 0);
+    XCTAssertLessThan(maxSpectrumDifference(*filter, *expected), kTestTolerance);
+}
+
+- (void)testInterpolationBlendsNeighboursAndWraps {
+    const SharedFFTSetup setup = acquireFFTSetup(KERNEL_FFT_LOG2N);
+
+    // Halfway between 315 and 0 degrees, a quarter of the way from 0 up to +45
+    std::vector<float> blended(2 * kTestIRLength);
+    for (int ear = 0; ear < 2; ++ear) {
+        for (size_t tap = 0; tap < kTestIRLength; ++tap) {
+            const float lower = 0.5f * (hrirAt(_hrirs, _grid, 1, 7, ear)[tap] + hrirAt(_hrirs, _grid, 1, 0, ear)[tap]);
+            const float upper = 0.5f * (hrirAt(_hrirs, _grid, 2, 7, ear)[tap] + hrirAt(_hrirs, _grid, 2, 0, ear)[tap]);
+            blended[ear * kTestIRLength + tap] = 0.75f * lower + 0.25f * upper;
+        }
+    }
+    const ImpulseResponse responses[2] = {
+        { blended.data(), kTestIRLength, 0 },
+        { blended.data() + kTestIRLength, kTestIRLength, 0 }
+    };
+    const auto expected = PartitionedFilter::create(setup.get(), kTestBlockSize, responses, 2);
+    XCTAssertLessThan(maxSpectrumDifference(*_store->interpolate(337.5f, 11.25f), *expected), 1.0e-5f);
+    XCTAssertLessThan(maxSpectrumDifference(*_store->interpolate(-22.5f, 11.25f), *expected), 1.0e-5f);
+
+    // Beyond the grid the nearest row is used
+    XCTAssertLessThan(maxSpectrumDifference(*_store->interpolate(90.0f, 80.0f), *_store->interpolate(90.0f, 45.0f)),
+                      kTestTolerance);
+}
+
+// MARK: - Cache Tests
+
+- (void)testCacheSharesFiltersWithinACell {
+    HRTFFilterCache cache(_store);
+    const auto first = cache.filterFor(30.2f, 10.1f);
+    const auto second = cache.filterFor(29.8f, 9.9f);
+    const auto around = cache.filterFor(30.0f - 360.0f, 10.0f);
+    XCTAssertEqual(first.get(), second.get());
+    XCTAssertEqual(first.get(), around.get());
+    XCTAssertNotEqual(first.get(), cache.filterFor(31.0f, 10.0f).get());
+
+    XCTAssertEqual(cache.misses(), 2u);
+    XCTAssertEqual(cache.hits(), 2u);
+    XCTAssertEqualWithAccuracy(cache.hitRate(), 0.5, 1.0e-12);
+    XCTAssertLessThan(maxSpectrumDifference(*first, *_store->interpolate(30.0f, 10.0f)), kTestTolerance);
+}
+
+- (void)testCacheEvictsLeastRecentlyUsed {
+    HRTFFilterCache cache(_store, 2);
+    const auto a = cache.filterFor(0.0f, 0.0f);
+    const auto b = cache.filterFor(10.0f, 0.0f);
+    XCTAssertEqual(cache.filterFor(0.0f, 0.0f).get(), a.get());
+
+    // Inserting a third direction drops b, the least recently used
+    cache.filterFor(20.0f, 0.0f);
+    XCTAssertEqual(cache.size(), 2u);
+    XCTAssertEqual(cache.filterFor(0.0f, 0.0f).get(), a.get());
+    const uint64_t missesBefore = cache.misses();
+    XCTAssertNotEqual(cache.filterFor(10.0f, 0.0f).get(), b.get());
+    XCTAssertEqual(cache.misses(), missesBefore + 1);
+
+    cache.clear();
+    XCTAssertEqual(cache.size(), 0u);
+}
+
+// MARK: - Rendering Tests
+
+- (void)testMovingSourceRendersThroughConvolver {
+    ConvolutionKernel kernel(kTestSampleRate, 2, kTestIRLength, kTestBlockSize);
+    HRTFFilterCache cache(_store);
+
+    // Sweep the source around the listener, one cell per partition
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
+    std::vector<float> block(kTestBlockSize * 2);
+    for (int step = 0; step < 720; ++step) {
+        kernel.setFilter(cache.filterFor(static_cast<float>(step), 0.0f));
+        for (size_t frame = 0; frame < kTestBlockSize; ++frame) {
+            block[2 * frame] = distribution(generator);
+            block[2 * frame + 1] = 0.0f;
+        }
+        kernel.processInterleaved(block.data(), block.data(), kTestBlockSize);
+        for (float sample : block) {
+            XCTAssertTrue(std::isfinite(sample));
+        }
+    }
+    // The second lap reuses the first lap's filters
+    XCTAssertEqual(cache.misses(), 360u);
+    XCTAssertEqualWithAccuracy(cache.hitRate(), 0.5, 1.0e-12);
+}
+
+@end
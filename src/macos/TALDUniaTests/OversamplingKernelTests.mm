@@ -0,0 +1,208 @@
+//
+// OversamplingKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the half-band oversampling wrapper
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "../../shared/DSP/OversamplingKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestFrames = 512;
+static const float kClipLevel = 0.15f;
+
+/**
+ * Hard clipper standing in for a saturation stage
+ */
+class TestClipKernel final : public DSPKernel {
+public:
+    TestClipKernel(double sampleRate, int channels)
+        : DSPKernel(sampleRate, channels) {}
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override {
+        if (input.layout == BufferLayout::Interleaved) {
+            for (size_t i = 0; i < input.frames * static_cast<size_t>(numChannels); ++i) {
+                output.interleaved[i] = std::clamp(input.interleaved[i], -kClipLevel, kClipLevel);
+            }
+            return;
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            for (size_t frame = 0; frame < input.frames; ++frame) {
+                output.planes[channel][frame] = std::clamp(input.planes[channel][frame], -kClipLevel, kClipLevel);
+            }
+        }
+    }
+
+    std::unique_ptr<DSPKernel> fork() const override {
+        return std::make_unique<TestClipKernel>(sampleRate, numChannels);
+    }
+
+private:
+    void resetState() noexcept override {}
+};
+
+static std::vector<float> makeSine(double frequency, size_t frames, int channels) {
+    std::vector<float> signal(frames * static_cast<size_t>(channels));
+    for (size_t frame = 0; frame < frames; ++frame) {
+        for (int channel = 0; channel < channels; ++channel) {
+            signal[frame * channels + channel] = static_cast<float>(
+                0.5 * std::sin(2.0 * std::numbers::pi * frequency * frame / kTestSampleRate + channel));
+        }
+    }
+    return signal;
+}
+
+static std::vector<float> renderInterleaved(DSPKernel& kernel, const std::vector<float>& input, size_t blockFrames) {
+    const size_t channels = static_cast<size_t>(kernel.channelCount());
+    const size_t frames = input.size() / channels;
+    std::vector<float> output(input.size(), 0.0f);
+    for (size_t frame = 0; frame < frames; frame += blockFrames) {
+        const size_t count = std::min(blockFrames, frames - frame);
+        kernel.processInterleaved(input.data() + frame * channels, output.data() + frame * channels, count);
+    }
+    return output;
+}
+
+// Amplitude of one frequency in a mono signal, skipping the filter start-up
+static double toneAmplitude(const std::vector<float>& signal, size_t start, double frequency) {
+    double real = 0.0;
+    double imaginary = 0.0;
+    const size_t count = signal.size() - start;
+    for (size_t i = 0; i < count; ++i) {
+        const double phase = 2.0 * std::numbers::pi * frequency * i / kTestSampleRate;
+        real += signal[start + i] * std::cos(phase);
+        imaginary += signal[start + i] * std::sin(phase);
+    }
+    return 2.0 * std::sqrt(real * real + imaginary * imaginary) / count;
+}
+
+@interface OversamplingKernelTests : XCTestCase
+@end
+
+@implementation OversamplingKernelTests
+
+// MARK: - Configuration Tests
+
+- (void)testInnerKernelRunsAtTheOversampledRate {
+    OversamplingKernel kernel(kTestSampleRate, createDSPKernel(kTestSampleRate, kTestChannels),
+                              OversamplingFactor::Four, kTestFrames);
+    XCTAssertEqual(kernel.innerKernel().currentSampleRate(), 4.0 * kTestSampleRate);
+    XCTAssertEqual(kernel.innerKernel().maximumFramesPerBlock(), 4 * kTestFrames);
+    XCTAssertEqual(kernel.channelCount(), kTestChannels);
+}
+
+- (void)testInvalidConfigurationsThrow {
+    XCTAssertThrows(OversamplingKernel(kTestSampleRate, nullptr, OversamplingFactor::Two));
+    XCTAssertThrows(OversamplingKernel(96000.0, createDSPKernel(96000.0, kTestChannels), OversamplingFactor::Eight));
+}
+
+// MARK: - Filter Tests
+
+- (void)testImpulseArrivesAfterWholeFrameLatency {
+    for (OversamplingFactor factor : { OversamplingFactor::Two, OversamplingFactor::Four, OversamplingFactor::Eight }) {
+        OversamplingKernel kernel(kTestSampleRate, createDSPKernel(kTestSampleRate, 1), factor, kTestFrames);
+        std::vector<float> impulse(kTestFrames, 0.0f);
+        impulse[0] = 1.0f;
+        std::vector<float> response(kTestFrames, 0.0f);
+        kernel.process(impulse.data(), response.data(), kTestFrames);
+
+        const auto peak = std::max_element(response.begin(), response.end(),
+                                           [](float a, float b) { return std::fabs(a) < std::fabs(b); });
+        XCTAssertEqual(static_cast<size_t>(peak - response.begin()), kernel.latencyFrames());
+
+        double dcGain = 0.0;
+        for (float sample : response) {
+            dcGain += sample;
+        }
+        XCTAssertEqualWithAccuracy(dcGain, 1.0, 1.0e-4);
+    }
+}
+
+- (void)testPassbandIsTransparent {
+    for (OversamplingFactor factor : { OversamplingFactor::Two, OversamplingFactor::Four, OversamplingFactor::Eight }) {
+        for (double frequency : { 1000.0, 16000.0 }) {
+            OversamplingKernel kernel(kTestSampleRate, createDSPKernel(kTestSampleRate, kTestChannels), factor,
+                                      kTestFrames);
+            const std::vector<float> input = makeSine(frequency, 8192, kTestChannels);
+            const std::vector<float> output = renderInterleaved(kernel, input, 333);
+
+            const size_t latency = kernel.latencyFrames();
+            float maxError = 0.0f;
+            for (size_t i = (latency + 64) * kTestChannels; i < output.size(); ++i) {
+                maxError = std::max(maxError, std::fabs(output[i] - input[i - latency * kTestChannels]));
+            }
+            XCTAssertLessThan(maxError, 1.0e-3f);
+        }
+    }
+}
+
+- (void)testLongBlocksAreSplitAcrossInnerCalls {
+    OversamplingKernel chunked(kTestSampleRate, createDSPKernel(kTestSampleRate, kTestChannels),
+                               OversamplingFactor::Eight, MAX_BUFFER_SIZE);
+    OversamplingKernel reference(kTestSampleRate, createDSPKernel(kTestSampleRate, kTestChannels),
+                                 OversamplingFactor::Eight, 256);
+    XCTAssertLessThanOrEqual(chunked.innerKernel().maximumFramesPerBlock(), MAX_BUFFER_SIZE);
+
+    const std::vector<float> input = makeSine(1000.0, MAX_BUFFER_SIZE, kTestChannels);
+    const std::vector<float> whole = renderInterleaved(chunked, input, MAX_BUFFER_SIZE);
+    const std::vector<float> blocks = renderInterleaved(reference, input, 256);
+    float maxError = 0.0f;
+    for (size_t i = 0; i < whole.size(); ++i) {
+        maxError = std::max(maxError, std::fabs(whole[i] - blocks[i]));
+    }
+    XCTAssertLessThan(maxError, 1.0e-6f);
+}
+
+// MARK: - Nonlinear Stage Tests
+
+- (void)testOversamplingSuppressesClippingAliases {
+    // The fifth harmonic of 7 kHz lands at 35 kHz and folds to 13 kHz at the host rate
+    const size_t frames = 48000;
+    const std::vector<float> input = makeSine(7000.0, frames, 1);
+
+    TestClipKernel baseRate(kTestSampleRate, 1);
+    OversamplingKernel oversampled(kTestSampleRate, std::make_unique<TestClipKernel>(kTestSampleRate, 1),
+                                   OversamplingFactor::Four, kTestFrames);
+    const std::vector<float> aliased = renderInterleaved(baseRate, input, kTestFrames);
+    const std::vector<float> filtered = renderInterleaved(oversampled, input, kTestFrames);
+
+    const double aliasedLevel = toneAmplitude(aliased, 2048, 13000.0);
+    const double filteredLevel = toneAmplitude(filtered, 2048, 13000.0);
+    XCTAssertLessThan(filteredLevel, aliasedLevel * 0.01);
+
+    // The in-band third harmonic survives both
+    XCTAssertEqualWithAccuracy(toneAmplitude(filtered, 2048, 21000.0), toneAmplitude(aliased, 2048, 21000.0), 0.01);
+}
+
+// MARK: - Control Tests
+
+- (void)testParametersAndForksReachInnerKernel {
+    OversamplingKernel kernel(kTestSampleRate, createDSPKernel(kTestSampleRate, kTestChannels),
+                              OversamplingFactor::Two, kTestFrames);
+    kernel.setParameter(kParameterGain, -6.0f);
+    auto fork = kernel.fork();
+
+    const std::vector<float> input(kTestFrames * kTestChannels * 20, 0.25f);
+    const std::vector<float> output = renderInterleaved(kernel, input, kTestFrames);
+    const std::vector<float> forked = renderInterleaved(*fork, input, kTestFrames);
+
+    const float expected = 0.25f * std::pow(10.0f, -6.0f / 20.0f);
+    XCTAssertEqualWithAccuracy(output.back(), expected, 1.0e-5f);
+    XCTAssertEqualWithAccuracy(forked.back(), expected, 1.0e-5f);
+}
+
+@end
@@ -0,0 +1,168 @@
+//
+// ResamplerKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the polyphase sample-rate converter
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+#include "../../shared/DSP/ResamplerKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const int kTestChannels = 2;
+static const double kTestToneHz = 1000.0;
+static const double kTestSeconds = 0.2;
+
+/**
+ * Streams a per-channel sine through a converter and returns the largest deviation
+ * from the ideal resampled sine, skipping the filter's start-up.
+ */
+static double resampledSineError(ResamplerKernel& resampler, size_t blockFrames, bool pull) {
+    const double inputRate = resampler.currentSampleRate();
+    const double outputRate = resampler.outputSampleRate();
+    const size_t totalOutput = static_cast<size_t>(outputRate * kTestSeconds);
+    const auto tone = [&](double inputTime, int channel) {
+        return std::sin(2.0 * std::numbers::pi * kTestToneHz * inputTime / inputRate + channel);
+    };
+
+    std::vector<float> input(resampler.maximumFramesPerBlock() * kTestChannels);
+    std::vector<float> output;
+    size_t inputPosition = 0;
+    size_t outputPosition = 0;
+    double maxError = 0.0;
+    const double latency = static_cast<double>(resampler.latencyFrames());
+    const size_t settleFrames = static_cast<size_t>(8.0 * latency * outputRate / inputRate) + 64;
+
+    while (outputPosition < totalOutput) {
+        const size_t inputFrames = pull ? resampler.inputFramesFor(blockFrames) : blockFrames;
+        const size_t outputFrames = pull ? blockFrames : resampler.outputFramesFor(blockFrames);
+        if (inputFrames > resampler.maximumFramesPerBlock()) {
+            return INFINITY;
+        }
+        for (size_t frame = 0; frame < inputFrames; ++frame) {
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                input[frame * kTestChannels + channel] =
+                    static_cast<float>(tone(static_cast<double>(inputPosition + frame), channel));
+            }
+        }
+        inputPosition += inputFrames;
+
+        output.assign(outputFrames * kTestChannels, 0.0f);
+        const size_t produced = resampler.resample(
+            AudioBufferView::makeInterleaved(input.data(), kTestChannels, inputFrames),
+            AudioBufferView::makeInterleaved(output.data(), kTestChannels, outputFrames));
+        if (produced != outputFrames) {
+            return INFINITY;
+        }
+
+        for (size_t frame = 0; frame < produced; ++frame, ++outputPosition) {
+            if (outputPosition < settleFrames) {
+                continue;
+            }
+            const double inputTime = static_cast<double>(outputPosition) * inputRate / outputRate - latency;
+            for (int channel = 0; channel < kTestChannels; ++channel) {
+                const double error = std::fabs(output[frame * kTestChannels + channel] - tone(inputTime, channel));
+                maxError = std::max(maxError, error);
+            }
+        }
+    }
+    return maxError;
+}
+
+@interface ResamplerKernelTests : XCTestCase
+@end
+
+@implementation ResamplerKernelTests
+
+// MARK: - Filter Bank Tests
+
+- (void)testFilterBanksAreSharedPerRatioAndQuality {
+    ResamplerKernel first(48000.0, 192000.0, kTestChannels);
+    ResamplerKernel second(96000.0, 384000.0, kTestChannels);
+    ResamplerKernel mastering(48000.0, 192000.0, kTestChannels, ResamplerQuality::Mastering);
+
+    XCTAssertEqual(first.filterBank(), second.filterBank());
+    XCTAssertNotEqual(first.filterBank(), mastering.filterBank());
+    XCTAssertEqual(first.filterBank()->upFactor(), 4u);
+    XCTAssertEqual(first.filterBank()->downFactor(), 1u);
+
+    auto fork = first.fork();
+    XCTAssertEqual(static_cast<ResamplerKernel&>(*fork).filterBank(), first.filterBank());
+}
+
+- (void)testRationalRatiosUseExactPhases {
+    ResamplerKernel cd(44100.0, 384000.0, kTestChannels);
+    XCTAssertFalse(cd.filterBank()->isInterpolated());
+    XCTAssertEqual(cd.filterBank()->upFactor(), 1280u);
+
+    ResamplerKernel odd(44100.0, 96001.0, kTestChannels);
+    XCTAssertTrue(odd.filterBank()->isInterpolated());
+}
+
+- (void)testInvalidRatesThrow {
+    XCTAssertThrows(ResamplerKernel(48000.0, 8000.0, kTestChannels));
+    XCTAssertThrows(ResamplerKernel(48000.0, 768000.0, kTestChannels));
+}
+
+// MARK: - Conversion Tests
+
+- (void)testPushModeUpsamplesAccurately {
+    ResamplerKernel resampler(48000.0, 192000.0, kTestChannels);
+    XCTAssertLessThan(resampledSineError(resampler, 256, false), 1.0e-3);
+}
+
+- (void)testPullModeDeliversExactBlocks {
+    ResamplerKernel resampler(44100.0, 192000.0, kTestChannels, ResamplerQuality::Standard, 1024);
+    XCTAssertLessThan(resampledSineError(resampler, 512, true), 1.0e-3);
+}
+
+- (void)testDownsamplingRejectsImages {
+    ResamplerKernel resampler(192000.0, 44100.0, kTestChannels);
+    XCTAssertLessThan(resampledSineError(resampler, 1024, false), 2.0e-3);
+}
+
+- (void)testQualityPresetsTradeLatencyForAccuracy {
+    ResamplerKernel low(44100.0, 48000.0, kTestChannels, ResamplerQuality::LowLatency);
+    ResamplerKernel mastering(44100.0, 48000.0, kTestChannels, ResamplerQuality::Mastering);
+    XCTAssertLessThan(low.latencyFrames(), mastering.latencyFrames());
+
+    const double lowError = resampledSineError(low, 100, false);
+    const double masteringError = resampledSineError(mastering, 256, true);
+    XCTAssertLessThan(lowError, 2.0e-2);
+    XCTAssertLessThan(masteringError, 1.0e-4);
+    XCTAssertLessThan(masteringError, lowError);
+}
+
+- (void)testInterpolatedRatioConvertsAccurately {
+    ResamplerKernel resampler(44100.0, 96001.0, kTestChannels);
+    XCTAssertLessThan(resampledSineError(resampler, 333, false), 1.0e-3);
+}
+
+- (void)testPrepareRebuildsForNewInputRate {
+    ResamplerKernel resampler(48000.0, 192000.0, kTestChannels);
+    resampler.prepare(512, 1, 96000.0);
+    XCTAssertEqual(resampler.filterBank()->upFactor(), 2u);
+    XCTAssertEqual(resampler.channelCount(), 1);
+
+    // A constant input comes through at unity gain once the window fills
+    std::vector<float> input(512, 0.5f);
+    std::vector<float> output(resampler.outputFramesFor(input.size()));
+    float* inputPlanes[] = { input.data() };
+    float* outputPlanes[] = { output.data() };
+    const size_t produced = resampler.resample(AudioBufferView::makePlanar(inputPlanes, 1, input.size()),
+                                               AudioBufferView::makePlanar(outputPlanes, 1, output.size()));
+    XCTAssertEqual(produced, output.size());
+    for (size_t frame = 4 * resampler.latencyFrames(); frame < produced; ++frame) {
+        XCTAssertEqualWithAccuracy(output[frame], 0.5f, 1.0e-5f);
+    }
+}
+
+@end
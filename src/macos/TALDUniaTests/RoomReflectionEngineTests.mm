@@ -0,0 +1,358 @@
+//
+// RoomReflectionEngineTests.mm
+// TALD UNIA
+//
+// Unit tests for the shared early-reflection and late-tail room engine
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../shared/DSP/RoomReflectionEngine.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const size_t kTestBlockSize = 512;
+static const int kTestSources = 4;
+static const float kTestTolerance = 1.0e-6f;
+
+// Frames rendered after setReflections() so the fade from the previous taps is over
+static const size_t kSettleFrames = 512;
+
+static SourceReflections makeReflections(std::initializer_list<ReflectionTap> taps, float send = 0.0f) {
+    SourceReflections reflections;
+    for (const ReflectionTap& tap : taps) {
+        reflections.taps[reflections.tapCount++] = tap;
+    }
+    reflections.reverbSend = send;
+    return reflections;
+}
+
+static ReflectionTap tapAt(double delayFrames, float gainLeft, float gainRight) {
+    ReflectionTap tap;
+    tap.delaySeconds = static_cast<float>(delayFrames / kTestSampleRate);
+    tap.gainLeft = gainLeft;
+    tap.gainRight = gainRight;
+    return tap;
+}
+
+// Render planar sources through the engine in blocks of blockSize frames
+static void render(RoomReflectionEngine& engine, const std::vector<std::vector<float>>& sources,
+                   std::vector<float>& left, std::vector<float>& right, size_t blockSize) {
+    const size_t frames = sources.empty() ? left.size() : sources[0].size();
+    left.assign(frames, 0.0f);
+    right.assign(frames, 0.0f);
+    for (size_t offset = 0; offset < frames; offset += blockSize) {
+        const size_t block = std::min(blockSize, frames - offset);
+        const float* pointers[MAX_ROOM_SOURCES] = {};
+        for (size_t s = 0; s < sources.size(); ++s) {
+            pointers[s] = sources[s].data() + offset;
+        }
+        engine.process(pointers, static_cast<int>(sources.size()), left.data() + offset, right.data() + offset, block);
+    }
+}
+
+static void settle(RoomReflectionEngine& engine) {
+    std::vector<float> left(kSettleFrames), right(kSettleFrames);
+    render(engine, {}, left, right, kSettleFrames);
+}
+
+static double windowEnergy(const std::vector<float>& signal, size_t begin, size_t end) {
+    double energy = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+        energy += static_cast<double>(signal[i]) * signal[i];
+    }
+    return energy;
+}
+
+@interface RoomReflectionEngineTests : XCTestCase
+@end
+
+@implementation RoomReflectionEngineTests
+
+// MARK: - Configuration Tests
+
+- (void)testInvalidConfigurationsThrowAndBadTapsAreRejected {
+    XCTAssertThrows(RoomReflectionEngine(1000.0));
+    XCTAssertThrows(RoomReflectionEngine(kTestSampleRate, 0));
+    XCTAssertThrows(RoomReflectionEngine(kTestSampleRate, MAX_ROOM_SOURCES + 1));
+    XCTAssertThrows(RoomReflectionEngine(kTestSampleRate, kTestSources, 0));
+
+    RoomReflectionEngine engine(kTestSampleRate, kTestSources, kTestBlockSize);
+    XCTAssertEqual(engine.sourceCapacity(), kTestSources);
+    XCTAssertFalse(engine.setReflections(kTestSources, makeReflections({ tapAt(10.0, 1.0f, 1.0f) })));
+    XCTAssertFalse(engine.setReflections(0, makeReflections({ tapAt(kTestSampleRate, 1.0f, 1.0f) })));
+    XCTAssertFalse(engine.setReflections(0, makeReflections({}, -1.0f)));
+    XCTAssertFalse(engine.setLateReverb(0.0f, 0.5f, 1.0f));
+    XCTAssertFalse(engine.setLateReverb(1.0f, 2.0f, 1.0f));
+    XCTAssertTrue(engine.setReflections(0, makeReflections({ tapAt(10.0, 1.0f, 1.0f) }, 0.5f)));
+    XCTAssertTrue(engine.setLateReverb(2.0f, 0.5f, 0.1f));
+}
+
+// MARK: - Early Reflection Tests
+
+- (void)testWholeFrameTapDelaysAndPansImpulse {
+    RoomReflectionEngine engine(kTestSampleRate, kTestSources, kTestBlockSize);
+    engine.setReflections(1, makeReflections({ tapAt(100.0, 0.5f, 0.25f), tapAt(333.0, -0.125f, 0.75f) }));
+    settle(engine);
+
+    std::vector<std::vector<float>> sources(2, std::vector<float>(2048, 0.0f));
+    sources[1][7] = 1.0f;
+    std::vector<float> left, right;
+    render(engine, sources, left, right, kTestBlockSize);
+
+    for (size_t i = 0; i < left.size(); ++i) {
+        const float expectedLeft = (i == 107) ? 0.5f : (i == 340) ? -0.125f : 0.0f;
+        const float expectedRight = (i == 107) ? 0.25f : (i == 340) ? 0.75f : 0.0f;
+        XCTAssertEqualWithAccuracy(left[i], expectedLeft, kTestTolerance);
+        XCTAssertEqualWithAccuracy(right[i], expectedRight, kTestTolerance);
+    }
+    XCTAssertEqual(engine.activeTapCount(), 2);
+}
+
+- (void)testFractionalTapInterpolatesSine {
+    RoomReflectionEngine engine(kTestSampleRate, 1, kTestBlockSize);
+    const double delay = 20.25;
+    engine.setReflections(0, makeReflections({ tapAt(delay, 1.0f, 1.0f) }));
+
+    const double omega = 2.0 * M_PI * 1000.0 / kTestSampleRate;
+    std::vector<std::vector<float>> sources(1, std::vector<float>(4096));
+    for (size_t i = 0; i < sources[0].size(); ++i) {
+        sources[0][i] = static_cast<float>(std::sin(omega * static_cast<double>(i)));
+    }
+    std::vector<float> left, right;
+    render(engine, sources, left, right, kTestBlockSize);
+
+    float maxError = 0.0f;
+    for (size_t i = 1024; i < left.size(); ++i) {
+        const float expected = static_cast<float>(std::sin(omega * (static_cast<double>(i) - delay)));
+        maxError = std::max(maxError, std::fabs(left[i] - expected));
+    }
+    XCTAssertLessThan(maxError, 1.0e-4f);
+}
+
+- (void)testSourcesRenderedTogetherSumIndependentRenders {
+    const SourceReflections reflections[kTestSources] = {
+        makeReflections({ tapAt(12.5, 0.3f, 0.1f), tapAt(480.0, 0.2f, 0.4f) }),
+        makeReflections({ tapAt(3.75, -0.5f, 0.5f) }),
+        makeReflections({ tapAt(200.1, 0.1f, 0.0f), tapAt(201.9, 0.0f, 0.1f), tapAt(4000.0, 0.05f, 0.05f) }),
+        makeReflections({}),
+    };
+
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<std::vector<float>> sources(kTestSources, std::vector<float>(6000));
+    for (auto& source : sources) {
+        for (float& sample : source) {
+            sample = distribution(generator);
+        }
+    }
+
+    RoomReflectionEngine shared(kTestSampleRate, kTestSources, kTestBlockSize);
+    for (int s = 0; s < kTestSources; ++s) {
+        shared.setReflections(s, reflections[s]);
+    }
+    std::vector<float> left, right;
+    render(shared, sources, left, right, kTestBlockSize);
+
+    std::vector<float> sumLeft(left.size(), 0.0f), sumRight(right.size(), 0.0f);
+    for (int s = 0; s < kTestSources; ++s) {
+        RoomReflectionEngine alone(kTestSampleRate, 1, kTestBlockSize);
+        alone.setReflections(0, reflections[s]);
+        std::vector<float> soloLeft, soloRight;
+        render(alone, { sources[s] }, soloLeft, soloRight, kTestBlockSize);
+        for (size_t i = 0; i < left.size(); ++i) {
+            sumLeft[i] += soloLeft[i];
+            sumRight[i] += soloRight[i];
+        }
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        XCTAssertEqualWithAccuracy(left[i], sumLeft[i], 1.0e-5f);
+        XCTAssertEqualWithAccuracy(right[i], sumRight[i], 1.0e-5f);
+    }
+}
+
+- (void)testMovedTapCrossfadesWithoutClick {
+    RoomReflectionEngine engine(kTestSampleRate, 1, kTestBlockSize);
+    engine.setReflections(0, makeReflections({ tapAt(10.0, 1.0f, 1.0f) }));
+
+    const double omega = 2.0 * M_PI * 500.0 / kTestSampleRate;
+    std::vector<std::vector<float>> sources(1, std::vector<float>(2048));
+    size_t position = 0;
+    auto next = [&]() {
+        for (float& sample : sources[0]) {
+            sample = static_cast<float>(std::sin(omega * static_cast<double>(position++)));
+        }
+    };
+
+    std::vector<float> left, right, history;
+    next();
+    render(engine, sources, left, right, kTestBlockSize);
+    history.insert(history.end(), left.begin(), left.end());
+
+    // Jump the image by 190 frames, about two thirds of a period out of phase
+    engine.setReflections(0, makeReflections({ tapAt(200.0, 1.0f, 1.0f) }));
+    next();
+    render(engine, sources, left, right, kTestBlockSize);
+    history.insert(history.end(), left.begin(), left.end());
+
+    // A sine this slow moves at most omega per frame; a hard switch would jump by about 1.7
+    float maxStep = 0.0f;
+    for (size_t i = 1024; i < history.size(); ++i) {
+        maxStep = std::max(maxStep, std::fabs(history[i] - history[i - 1]));
+    }
+    XCTAssertLessThan(maxStep, 0.1f);
+
+    // Once the fade is over only the new path is heard
+    for (size_t i = 2048 + 512; i < history.size(); ++i) {
+        const float expected = static_cast<float>(std::sin(omega * (static_cast<double>(i) - 200.0)));
+        XCTAssertEqualWithAccuracy(history[i], expected, 1.0e-4f);
+    }
+}
+
+- (void)testBlockSizeDoesNotChangeOutput {
+    std::mt19937 generator(5);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    std::vector<std::vector<float>> sources(2, std::vector<float>(8000));
+    for (auto& source : sources) {
+        for (float& sample : source) {
+            sample = distribution(generator);
+        }
+    }
+
+    std::vector<float> outputs[2][2];
+    const size_t blockSizes[2] = { 512, 37 };
+    for (int run = 0; run < 2; ++run) {
+        RoomReflectionEngine engine(kTestSampleRate, 2, kTestBlockSize);
+        engine.setReflections(0, makeReflections({ tapAt(31.3, 0.5f, 0.2f), tapAt(700.7, 0.1f, 0.3f) }, 0.5f));
+        engine.setReflections(1, makeReflections({ tapAt(5.5, 0.25f, 0.25f) }, 0.25f));
+        render(engine, sources, outputs[run][0], outputs[run][1], blockSizes[run]);
+    }
+    for (int ear = 0; ear < 2; ++ear) {
+        for (size_t i = 0; i < outputs[0][ear].size(); ++i) {
+            XCTAssertEqualWithAccuracy(outputs[0][ear][i], outputs[1][ear][i], kTestTolerance);
+        }
+    }
+}
+
+// MARK: - Late Tail Tests
+
+- (void)testLateTailDecaysAtRT60AndIsDecorrelated {
+    RoomReflectionEngine engine(kTestSampleRate, 1, kTestBlockSize);
+    const float decay = 1.0f;
+    engine.setLateReverb(decay, 1.0f, 1.0f);
+    engine.setReflections(0, makeReflections({}, 1.0f));
+    settle(engine);
+
+    std::vector<std::vector<float>> sources(1, std::vector<float>(static_cast<size_t>(kTestSampleRate), 0.0f));
+    sources[0][0] = 1.0f;
+    std::vector<float> left, right;
+    render(engine, sources, left, right, kTestBlockSize);
+
+    for (size_t i = 0; i < left.size(); ++i) {
+        XCTAssertTrue(std::isfinite(left[i]) && std::isfinite(right[i]));
+    }
+
+    // 0.4 s apart the tail should be 60 * 0.4 / decay = 24 dB down
+    const size_t window = static_cast<size_t>(0.1 * kTestSampleRate);
+    const size_t early = static_cast<size_t>(0.15 * kTestSampleRate);
+    const size_t late = static_cast<size_t>(0.55 * kTestSampleRate);
+    const double earlyEnergy = windowEnergy(left, early, early + window) + windowEnergy(right, early, early + window);
+    const double lateEnergy = windowEnergy(left, late, late + window) + windowEnergy(right, late, late + window);
+    XCTAssertGreaterThan(lateEnergy, 0.0);
+    XCTAssertEqualWithAccuracy(10.0 * std::log10(earlyEnergy / lateEnergy), 24.0, 3.0);
+
+    double cross = 0.0;
+    for (size_t i = early; i < left.size(); ++i) {
+        cross += static_cast<double>(left[i]) * right[i];
+    }
+    const double normalized = cross / std::sqrt(windowEnergy(left, early, left.size()) *
+                                                windowEnergy(right, early, right.size()));
+    XCTAssertLessThan(std::fabs(normalized), 0.3);
+}
+
+- (void)testDampingShortensHighFrequencyDecay {
+    std::vector<float> tails[2];
+    const float ratios[2] = { 1.0f, 0.25f };
+    for (int run = 0; run < 2; ++run) {
+        RoomReflectionEngine engine(kTestSampleRate, 1, kTestBlockSize);
+        engine.setLateReverb(1.0f, ratios[run], 1.0f);
+        engine.setReflections(0, makeReflections({}, 1.0f));
+        settle(engine);
+
+        std::vector<std::vector<float>> sources(1, std::vector<float>(24000, 0.0f));
+        sources[0][0] = 1.0f;
+        std::vector<float> right;
+        render(engine, sources, tails[run], right, kTestBlockSize);
+    }
+
+    // First differences weight the top of the spectrum
+    auto highEnergy = [](const std::vector<float>& signal) {
+        double energy = 0.0;
+        for (size_t i = 12001; i < signal.size(); ++i) {
+            const double difference = signal[i] - signal[i - 1];
+            energy += difference * difference;
+        }
+        return energy;
+    };
+    XCTAssertLessThan(highEnergy(tails[1]), 0.1 * highEnergy(tails[0]));
+}
+
+- (void)testResetSilencesTailButKeepsTaps {
+    RoomReflectionEngine engine(kTestSampleRate, 1, kTestBlockSize);
+    engine.setReflections(0, makeReflections({ tapAt(64.0, 1.0f, 1.0f) }, 1.0f));
+    std::vector<std::vector<float>> sources(1, std::vector<float>(kTestBlockSize, 1.0f));
+    std::vector<float> left, right;
+    render(engine, sources, left, right, kTestBlockSize);
+    render(engine, sources, left, right, kTestBlockSize);
+
+    engine.reset();
+    std::vector<std::vector<float>> silence(1, std::vector<float>(kTestBlockSize, 0.0f));
+    render(engine, silence, left, right, kTestBlockSize);
+    for (size_t i = 0; i < left.size(); ++i) {
+        XCTAssertEqual(left[i], 0.0f);
+        XCTAssertEqual(right[i], 0.0f);
+    }
+
+    silence[0][0] = 1.0f;
+    render(engine, silence, left, right, kTestBlockSize);
+    XCTAssertEqualWithAccuracy(left[64], 1.0f, kTestTolerance);
+}
+
+// MARK: - Image Source Tests
+
+- (void)testShoeboxReflectionsFollowImageGeometry {
+    const float room[3] = { 10.0f, 3.0f, 8.0f };
+    const float listener[3] = { 5.0f, 1.5f, 4.0f };
+    const float source[3] = { 5.0f, 1.5f, 2.0f };
+    SourceReflections reflections;
+    computeShoeboxReflections(room, listener, source, 0.0f, reflections);
+    XCTAssertEqual(reflections.tapCount, 6);
+
+    // Wall z = 0: image at z = -2, 6 m straight ahead
+    const ReflectionTap& front = reflections.taps[4];
+    XCTAssertEqualWithAccuracy(front.delaySeconds, 6.0f / ROOM_SPEED_OF_SOUND, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(front.gainLeft, std::sqrt(0.5f) / 6.0f, 1.0e-6f);
+    XCTAssertEqualWithAccuracy(front.gainRight, front.gainLeft, 1.0e-6f);
+
+    // Wall x = 0 is heard on the left, wall x = 10 on the right
+    XCTAssertGreaterThan(reflections.taps[0].gainLeft, reflections.taps[0].gainRight);
+    XCTAssertGreaterThan(reflections.taps[1].gainRight, reflections.taps[1].gainLeft);
+    XCTAssertEqualWithAccuracy(reflections.taps[0].delaySeconds, std::sqrt(104.0f) / ROOM_SPEED_OF_SOUND, 1.0e-6f);
+
+    // Absorbing walls scale every image by the amplitude reflection coefficient
+    SourceReflections absorbed;
+    computeShoeboxReflections(room, listener, source, 0.75f, absorbed);
+    XCTAssertEqualWithAccuracy(absorbed.taps[4].gainLeft, 0.5f * front.gainLeft, 1.0e-6f);
+
+    RoomReflectionEngine engine(kTestSampleRate);
+    XCTAssertTrue(engine.setReflections(0, reflections));
+}
+
+@end
@@ -0,0 +1,274 @@
+//
+// SpectrumAnalyzerKernelTests.mm
+// TALD UNIA
+//
+// Unit tests for the STFT spectrum analyzer and its triple-buffered publishing
+// Version: 1.0.0
+//
+
+#import <XCTest/XCTest.h>
+
+#include <atomic>
+#include <cmath>
+#include <numbers>
+#include <thread>
+#include <vector>
+#include "../../shared/DSP/SpectrumAnalyzerKernel.hpp"
+
+using namespace tald::dsp;
+
+// MARK: - Test Constants
+
+static const double kTestSampleRate = 48000.0;
+static const int kTestChannels = 2;
+static const size_t kTestBlockSize = 512;
+
+// Interleaved stereo sine, the same on both channels
+static std::vector<float> makeSine(double frequency, float amplitude, size_t frames, size_t start = 0) {
+    std::vector<float> samples(frames * kTestChannels);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const double phase = 2.0 * std::numbers::pi * frequency * static_cast<double>(start + frame) / kTestSampleRate;
+        const float value = amplitude * static_cast<float>(std::sin(phase));
+        samples[frame * kTestChannels] = value;
+        samples[frame * kTestChannels + 1] = value;
+    }
+    return samples;
+}
+
+// Render a signal in place, block by block
+static void render(SpectrumAnalyzerKernel& kernel, std::vector<float>& samples) {
+    const size_t frames = samples.size() / kTestChannels;
+    for (size_t offset = 0; offset < frames; offset += kTestBlockSize) {
+        const size_t count = std::min(kTestBlockSize, frames - offset);
+        const AudioBufferView view = AudioBufferView::makeInterleaved(samples.data() + offset * kTestChannels,
+                                                                      kTestChannels, count);
+        kernel.process(view, view);
+    }
+}
+
+static size_t loudestBin(const SpectrumFrame& frame) {
+    return static_cast<size_t>(std::max_element(frame.magnitudes, frame.magnitudes + frame.binCount) - frame.magnitudes);
+}
+
+@interface SpectrumAnalyzerKernelTests : XCTestCase
+@end
+
+@implementation SpectrumAnalyzerKernelTests
+
+// MARK: - Configuration Tests
+
+- (void)testInvalidConfigurationsThrow {
+    SpectrumAnalyzerConfig config;
+    config.fftSize = 1000;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+    config.fftSize = MAX_ANALYSIS_FFT_SIZE * 2;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+
+    config = SpectrumAnalyzerConfig{};
+    config.hopSize = 0;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+    config.hopSize = config.fftSize + 1;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+
+    config = SpectrumAnalyzerConfig{};
+    config.binCount = MAX_SPECTRUM_BINS + 1;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+
+    config = SpectrumAnalyzerConfig{};
+    config.minFrequency = 30000.0;
+    config.maxFrequency = 40000.0;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+
+    config = SpectrumAnalyzerConfig{};
+    config.publishRate = 0.0;
+    XCTAssertThrows(SpectrumAnalyzerKernel(kTestSampleRate, kTestChannels, config));
+}
+
+- (void)testBinEdgesSpanTheRangeUpToNyquist {
+    SpectrumAnalyzerConfig config;
+    config.maxFrequency = 30000.0;
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels, config);
+    XCTAssertEqualWithAccuracy(kernel.binEdgeFrequency(0), 20.0, 1e-9);
+    XCTAssertEqualWithAccuracy(kernel.binEdgeFrequency(config.binCount), kTestSampleRate / 2.0, 1e-6);
+    for (size_t bin = 0; bin < config.binCount; ++bin) {
+        XCTAssertLessThan(kernel.binEdgeFrequency(bin), kernel.binEdgeFrequency(bin + 1));
+    }
+}
+
+// MARK: - Triple Buffer Tests
+
+- (void)testTripleBufferHandsOverTheNewestValue {
+    TripleBuffer<int> buffer;
+    XCTAssertFalse(buffer.update());
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+    XCTAssertTrue(buffer.update());
+    XCTAssertEqual(buffer.readBuffer(), 2);
+    XCTAssertFalse(buffer.update());
+    XCTAssertEqual(buffer.readBuffer(), 2);
+}
+
+- (void)testTripleBufferReaderNeverSeesTornValues {
+    struct Pair {
+        uint64_t first = 0;
+        uint64_t second = 0;
+    };
+    TripleBuffer<Pair> buffer;
+    const uint64_t total = 200000;
+    std::atomic<bool> done{false};
+
+    std::thread writer([&] {
+        for (uint64_t value = 1; value <= total; ++value) {
+            Pair& slot = buffer.writeBuffer();
+            slot.first = value;
+            slot.second = value;
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    bool consistent = true;
+    uint64_t last = 0;
+    while (!done.load() || buffer.update()) {
+        buffer.update();
+        const Pair& value = buffer.readBuffer();
+        consistent = consistent && value.first == value.second && value.first >= last;
+        last = value.first;
+    }
+    writer.join();
+    buffer.update();
+    XCTAssertTrue(consistent);
+    XCTAssertEqual(buffer.readBuffer().first, total);
+}
+
+// MARK: - Analysis Tests
+
+- (void)testSineReadsItsLevelInItsBin {
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels);
+    XCTAssertEqual(kernel.latestSpectrum().sequence, 0u);
+
+    std::vector<float> samples = makeSine(1000.0, 0.5f, 24000);
+    render(kernel, samples);
+    const SpectrumFrame& frame = kernel.latestSpectrum();
+    XCTAssertGreaterThan(frame.sequence, 0u);
+    XCTAssertEqual(frame.binCount, DEFAULT_SPECTRUM_BINS);
+
+    // -6 dBFS within the Hann window's scalloping loss
+    const size_t peak = loudestBin(frame);
+    XCTAssertLessThanOrEqual(kernel.binEdgeFrequency(peak), 1000.0 * 1.06);
+    XCTAssertGreaterThanOrEqual(kernel.binEdgeFrequency(peak + 1), 1000.0 / 1.06);
+    XCTAssertEqualWithAccuracy(frame.magnitudes[peak], -6.02f, 1.5f);
+
+    // Sidelobes of the window are far down an octave away
+    for (size_t bin = 0; bin < frame.binCount; ++bin) {
+        if (kernel.binEdgeFrequency(bin + 1) < 500.0 || kernel.binEdgeFrequency(bin) > 2000.0) {
+            XCTAssertLessThan(frame.magnitudes[bin], -60.0f);
+        }
+    }
+}
+
+- (void)testSilenceReadsTheFloorInEveryBin {
+    // Small frames make the lowest bins narrower than one FFT bin
+    SpectrumAnalyzerConfig config;
+    config.fftSize = 256;
+    config.hopSize = 64;
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels, config);
+    std::vector<float> samples(4800 * kTestChannels, 0.0f);
+    render(kernel, samples);
+
+    const SpectrumFrame& frame = kernel.latestSpectrum();
+    XCTAssertGreaterThan(frame.sequence, 0u);
+    for (size_t bin = 0; bin < frame.binCount; ++bin) {
+        XCTAssertEqualWithAccuracy(frame.magnitudes[bin], SPECTRUM_FLOOR_DB, 1e-3f);
+    }
+}
+
+- (void)testNarrowBinsInterpolateLowTones {
+    SpectrumAnalyzerConfig config;
+    config.fftSize = 256;
+    config.hopSize = 128;
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels, config);
+    std::vector<float> samples = makeSine(375.0, 1.0f, 9600);   // On FFT bin 2
+    render(kernel, samples);
+
+    // Every bin around the tone is finite and rises smoothly towards it
+    const SpectrumFrame& frame = kernel.latestSpectrum();
+    const size_t peak = loudestBin(frame);
+    XCTAssertEqualWithAccuracy(frame.magnitudes[peak], 0.0f, 0.5f);
+    for (size_t bin = 1; bin <= peak; ++bin) {
+        XCTAssertTrue(std::isfinite(frame.magnitudes[bin]));
+        if (kernel.binEdgeFrequency(bin) > 190.0) {
+            XCTAssertGreaterThanOrEqual(frame.magnitudes[bin], frame.magnitudes[bin - 1] - 1e-3f);
+        }
+    }
+}
+
+// MARK: - Publishing Tests
+
+- (void)testPublishRateIsIndependentOfTheHop {
+    for (size_t hop : { size_t(128), size_t(1024), size_t(2048) }) {
+        SpectrumAnalyzerConfig config;
+        config.hopSize = hop;
+        config.publishRate = 20.0;
+        SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels, config);
+
+        std::vector<float> samples = makeSine(440.0, 0.25f, 48000);
+        render(kernel, samples);
+        const SpectrumFrame& frame = kernel.latestSpectrum();
+
+        // One second: 20 spectra, less the first frame's fill time
+        XCTAssertGreaterThanOrEqual(frame.sequence, 18u);
+        XCTAssertLessThanOrEqual(frame.sequence, 20u);
+        XCTAssertGreaterThanOrEqual(frame.analysisFrames, 1u);
+        XCTAssertEqual((frame.streamPosition - config.fftSize) % hop, 0u);
+    }
+}
+
+- (void)testSlowReaderSkipsToTheNewestSpectrum {
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels);
+    std::vector<float> samples = makeSine(440.0, 0.25f, 48000);
+    render(kernel, samples);
+    const uint64_t first = kernel.latestSpectrum().sequence;
+
+    std::vector<float> more = makeSine(440.0, 0.25f, 24000, 48000);
+    render(kernel, more);
+    const SpectrumFrame& frame = kernel.latestSpectrum();
+    XCTAssertGreaterThan(frame.sequence, first + 10);
+    XCTAssertEqual(kernel.latestSpectrum().sequence, frame.sequence);
+}
+
+// MARK: - Render Tests
+
+- (void)testAudioPassesThroughUnchanged {
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels);
+    const std::vector<float> source = makeSine(440.0, 0.5f, kTestBlockSize);
+    std::vector<float> output(source.size(), 0.0f);
+    const AudioBufferView in = AudioBufferView::makeInterleaved(const_cast<float*>(source.data()), kTestChannels,
+                                                                kTestBlockSize);
+    kernel.process(in, AudioBufferView::makeInterleaved(output.data(), kTestChannels, kTestBlockSize));
+    XCTAssertEqual(output, source);
+
+    std::vector<float> left(kTestBlockSize, 0.25f);
+    std::vector<float> right(kTestBlockSize, -0.25f);
+    float* planes[] = { left.data(), right.data() };
+    const AudioBufferView planar = AudioBufferView::makePlanar(planes, kTestChannels, kTestBlockSize);
+    kernel.process(planar, planar);
+    XCTAssertEqual(left, std::vector<float>(kTestBlockSize, 0.25f));
+    XCTAssertEqual(right, std::vector<float>(kTestBlockSize, -0.25f));
+}
+
+- (void)testForkPublishesItsOwnSpectra {
+    SpectrumAnalyzerKernel kernel(kTestSampleRate, kTestChannels);
+    std::unique_ptr<DSPKernel> fork = kernel.fork();
+    auto& analyzer = static_cast<SpectrumAnalyzerKernel&>(*fork);
+    XCTAssertEqual(analyzer.configuration().fftSize, kernel.configuration().fftSize);
+
+    std::vector<float> samples = makeSine(440.0, 0.25f, 24000);
+    render(analyzer, samples);
+    XCTAssertGreaterThan(analyzer.latestSpectrum().sequence, 0u);
+    XCTAssertEqual(kernel.latestSpectrum().sequence, 0u);
+}
+
+@end
@@ -0,0 +1,363 @@
+#include "BiquadCascadeKernel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Coefficient rows of the SoA tables
+    enum : int { kB0, kB1, kB2, kA1, kA2, kCoefficientCount };
+
+    // One frame of every channel; clang and GCC lower these to native registers
+    typedef float LaneVector4 __attribute__((vector_size(4 * sizeof(float))));
+    typedef float LaneVector8 __attribute__((vector_size(8 * sizeof(float))));
+
+    template <size_t Lanes> struct LaneVectorFor;
+    template <> struct LaneVectorFor<4> { using Type = LaneVector4; };
+    template <> struct LaneVectorFor<8> { using Type = LaneVector8; };
+
+    /**
+     * @brief Run frames [begin, end) of a frame-major block through the whole cascade
+     *
+     * Bands run in order within a frame, so each frame's vector stays in a register
+     * from the first band to the last while the states stream through L1.
+     */
+    template <typename Vector, bool Ramping>
+    void runCascade(float* work, size_t begin, size_t end, int bands, Vector* state1, Vector* state2,
+                    float (*coefficients)[MAX_BIQUAD_BANDS], const float (*step)[MAX_BIQUAD_BANDS]) noexcept {
+        constexpr size_t lanes = sizeof(Vector) / sizeof(float);
+        for (size_t frame = begin; frame < end; ++frame) {
+            Vector x;
+            std::memcpy(&x, work + frame * lanes, sizeof(Vector));
+            for (int band = 0; band < bands; ++band) {
+                if constexpr (Ramping) {
+                    for (int k = 0; k < kCoefficientCount; ++k) {
+                        coefficients[k][band] += step[k][band];
+                    }
+                }
+                const Vector y = coefficients[kB0][band] * x + state1[band];
+                state1[band] = coefficients[kB1][band] * x - coefficients[kA1][band] * y + state2[band];
+                state2[band] = coefficients[kB2][band] * x - coefficients[kA2][band] * y;
+                x = y;
+            }
+            std::memcpy(work + frame * lanes, &x, sizeof(Vector));
+        }
+    }
+
+    inline float readSample(const AudioBufferView& view, int channel, size_t frame) noexcept {
+        return (view.layout == BufferLayout::Planar)
+            ? view.planes[channel][frame]
+            : view.interleaved[frame * static_cast<size_t>(view.channels) + channel];
+    }
+
+    inline void writeSample(const AudioBufferView& view, int channel, size_t frame, float sample) noexcept {
+        if (view.layout == BufferLayout::Planar) {
+            view.planes[channel][frame] = sample;
+        }
+        else {
+            view.interleaved[frame * static_cast<size_t>(view.channels) + channel] = sample;
+        }
+    }
+
+    size_t laneCountFor(int channels) noexcept {
+        return (channels <= 4) ? 4 : 8;
+    }
+}
+
+// MARK: - BiquadCoefficients
+
+BiquadCoefficients BiquadCoefficients::peaking(const BiquadBand& band, double sampleRate) noexcept {
+    const double gain = std::clamp(band.gainDB, -MAX_BIQUAD_GAIN_DB, MAX_BIQUAD_GAIN_DB);
+    if (!band.enabled || gain == 0.0) {
+        return BiquadCoefficients{};
+    }
+    const double frequency = std::clamp(band.frequency, MIN_BIQUAD_FREQUENCY, MAX_BIQUAD_FREQUENCY);
+    const double q = std::clamp(band.q, MIN_BIQUAD_Q, MAX_BIQUAD_Q);
+
+    const double omega = 2.0 * std::numbers::pi * frequency / sampleRate;
+    const double alpha = std::sin(omega) / (2.0 * q);
+    const double cosOmega = std::cos(omega);
+    const double a = std::pow(10.0, gain / 40.0);
+    const double a0 = 1.0 + alpha / a;
+
+    BiquadCoefficients coefficients;
+    coefficients.b0 = static_cast<float>((1.0 + alpha * a) / a0);
+    coefficients.b1 = static_cast<float>(-2.0 * cosOmega / a0);
+    coefficients.b2 = static_cast<float>((1.0 - alpha * a) / a0);
+    coefficients.a1 = coefficients.b1;
+    coefficients.a2 = static_cast<float>((1.0 - alpha / a) / a0);
+    return coefficients;
+}
+
+// MARK: - BiquadCascadeKernel
+
+BiquadCascadeKernel::BiquadCascadeKernel(double sampleRate, int channels, int bandCount,
+                                         DenormalMode denormalMode, size_t maxFrames)
+    : DSPKernel(sampleRate, channels, denormalMode, maxFrames)
+    , bands(bandCount)
+    , rampRemaining(0)
+    , work(nullptr)
+{
+    if (bandCount <= 0 || bandCount > MAX_BIQUAD_BANDS) {
+        throw std::invalid_argument("Invalid biquad band count");
+    }
+    prepareResources(maxFrames, channels, sampleRate);
+    resetState();
+}
+
+void BiquadCascadeKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    (void)channels;
+    // Sized for eight lanes so prepare() may change the channel count freely
+    ScratchBlock newScratch = acquireScratch(maxFramesPerBlock * MAX_CHANNELS);
+
+    // Nothing below throws
+    scratch = std::move(newScratch);
+    work = scratch.data();
+
+    designTargets(sampleRate);
+}
+
+void BiquadCascadeKernel::designTargets(double sampleRate) noexcept {
+    // Updates still in flight were designed for the old rate
+    pendingBands.store(0, std::memory_order_relaxed);
+    for (int band = 0; band < bands; ++band) {
+        const BiquadCoefficients coefficients = BiquadCoefficients::peaking(controlBands[band], sampleRate);
+        target[kB0][band] = coefficients.b0;
+        target[kB1][band] = coefficients.b1;
+        target[kB2][band] = coefficients.b2;
+        target[kA1][band] = coefficients.a1;
+        target[kA2][band] = coefficients.a2;
+    }
+}
+
+void BiquadCascadeKernel::resetState() noexcept {
+    std::memset(state1, 0, sizeof(state1));
+    std::memset(state2, 0, sizeof(state2));
+    std::memcpy(current, target, sizeof(current));
+    std::memset(step, 0, sizeof(step));
+    rampRemaining = 0;
+
+    // Unused lanes must hold zeros so their state never leaves zero
+    std::memset(work, 0, maxFrames * MAX_CHANNELS * sizeof(float));
+}
+
+bool BiquadCascadeKernel::setBand(int band, const BiquadBand& settings) noexcept {
+    if (band < 0 || band >= bands) {
+        return false;
+    }
+    controlBands[band] = settings;
+    const BiquadCoefficients coefficients = BiquadCoefficients::peaking(settings, sampleRate);
+
+    CoefficientSlot& slot = slots[band];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.values[kB0].store(coefficients.b0, std::memory_order_relaxed);
+    slot.values[kB1].store(coefficients.b1, std::memory_order_relaxed);
+    slot.values[kB2].store(coefficients.b2, std::memory_order_relaxed);
+    slot.values[kA1].store(coefficients.a1, std::memory_order_relaxed);
+    slot.values[kA2].store(coefficients.a2, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    pendingBands.fetch_or(1u << band, std::memory_order_release);
+    return true;
+}
+
+void BiquadCascadeKernel::pullBandUpdates() noexcept {
+    uint32_t pending = pendingBands.exchange(0, std::memory_order_acquire);
+    if (pending == 0) {
+        return;
+    }
+
+    uint32_t retry = 0;
+    bool changed = false;
+    while (pending) {
+        const int band = std::countr_zero(pending);
+        pending &= pending - 1;
+
+        // A slot caught mid-write is taken at the next block instead
+        const CoefficientSlot& slot = slots[band];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        float values[kCoefficientCount];
+        for (int k = 0; k < kCoefficientCount; ++k) {
+            values[k] = slot.values[k].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((before & 1u) || slot.sequence.load(std::memory_order_relaxed) != before) {
+            retry |= 1u << band;
+            continue;
+        }
+        for (int k = 0; k < kCoefficientCount; ++k) {
+            target[k][band] = values[k];
+        }
+        changed = true;
+    }
+    if (retry) {
+        pendingBands.fetch_or(retry, std::memory_order_relaxed);
+    }
+
+    // Every band glides from where it is now, so an update mid-ramp never jumps
+    if (changed) {
+        rampRemaining = std::max<uint32_t>(1, defaultRampFrames());
+        const float scale = 1.0f / static_cast<float>(rampRemaining);
+        for (int k = 0; k < kCoefficientCount; ++k) {
+            for (int band = 0; band < bands; ++band) {
+                step[k][band] = (target[k][band] - current[k][band]) * scale;
+            }
+        }
+    }
+}
+
+template <size_t Lanes>
+void BiquadCascadeKernel::renderLanes(size_t frames) noexcept {
+    using Vector = typename LaneVectorFor<Lanes>::Type;
+    Vector laneState1[MAX_BIQUAD_BANDS];
+    Vector laneState2[MAX_BIQUAD_BANDS];
+    for (int band = 0; band < bands; ++band) {
+        std::memcpy(&laneState1[band], state1[band], sizeof(Vector));
+        std::memcpy(&laneState2[band], state2[band], sizeof(Vector));
+    }
+
+    size_t frame = 0;
+    if (rampRemaining > 0) {
+        const size_t ramped = std::min<size_t>(rampRemaining, frames);
+        runCascade<Vector, true>(work, 0, ramped, bands, laneState1, laneState2, current, step);
+        rampRemaining -= static_cast<uint32_t>(ramped);
+        if (rampRemaining == 0) {
+            std::memcpy(current, target, sizeof(current));
+        }
+        frame = ramped;
+    }
+    runCascade<Vector, false>(work, frame, frames, bands, laneState1, laneState2, current, step);
+
+    for (int band = 0; band < bands; ++band) {
+        std::memcpy(state1[band], &laneState1[band], sizeof(Vector));
+        std::memcpy(state2[band], &laneState2[band], sizeof(Vector));
+    }
+}
+
+void BiquadCascadeKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    if (!input.isValid() || !output.isValid() || output.frames != input.frames ||
+        input.channels != numChannels || output.channels != numChannels || input.frames > maxFrames) {
+        return;
+    }
+    if (isBypassed()) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+    pullBandUpdates();
+
+    const size_t frames = input.frames;
+    const size_t lanes = laneCountFor(numChannels);
+    if (input.layout == BufferLayout::Interleaved && static_cast<size_t>(numChannels) == lanes) {
+        std::memcpy(work, input.interleaved, frames * lanes * sizeof(float));
+    }
+    else {
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                work[frame * lanes + channel] = readSample(input, channel, frame);
+            }
+        }
+    }
+
+    if (lanes == 4) {
+        renderLanes<4>(frames);
+    }
+    else {
+        renderLanes<8>(frames);
+    }
+
+    if (activeDenormalMode == DenormalMode::VectorThreshold) {
+        flushDenormals(&state1[0][0], static_cast<size_t>(bands) * MAX_CHANNELS);
+        flushDenormals(&state2[0][0], static_cast<size_t>(bands) * MAX_CHANNELS);
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float sample = work[frame * lanes + channel];
+                writeSample(output, channel, frame, (std::fabs(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample);
+            }
+        }
+    }
+    else if (output.layout == BufferLayout::Interleaved && static_cast<size_t>(numChannels) == lanes) {
+        std::memcpy(output.interleaved, work, frames * lanes * sizeof(float));
+    }
+    else {
+        for (size_t frame = 0; frame < frames; ++frame) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                writeSample(output, channel, frame, work[frame * lanes + channel]);
+            }
+        }
+    }
+
+    recordBlockTiming(startTicks, mach_absolute_time(), frames);
+}
+
+std::unique_ptr<DSPKernel> BiquadCascadeKernel::fork() const {
+    auto clone = std::make_unique<BiquadCascadeKernel>(sampleRate, numChannels, bands, activeDenormalMode,
+                                                       maxFrames);
+    std::copy(controlBands, controlBands + bands, clone->controlBands);
+    clone->designTargets(sampleRate);
+    clone->resetState();
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+void BiquadCascadeKernel::writeState(KernelStateWriter& writer) const {
+    writer.write(static_cast<uint32_t>(bands));
+    for (int band = 0; band < bands; ++band) {
+        const BiquadBand& settings = controlBands[band];
+        writer.write(settings.frequency);
+        writer.write(settings.gainDB);
+        writer.write(settings.q);
+        writer.write(static_cast<uint8_t>(settings.enabled));
+        writer.write(BiquadCoefficients::peaking(settings, sampleRate));
+    }
+}
+
+std::unique_ptr<DSPKernel> BiquadCascadeKernel::fromState(const KernelStateHeader& header,
+                                                          KernelStateReader& reader) {
+    const uint32_t bandCount = reader.read<uint32_t>();
+    if (bandCount == 0 || bandCount > MAX_BIQUAD_BANDS) {
+        throw std::runtime_error("Invalid biquad band count in kernel state");
+    }
+    auto kernel = std::make_unique<BiquadCascadeKernel>(header.sampleRate, header.channels,
+                                                        static_cast<int>(bandCount), header.denormalMode,
+                                                        header.maxFrames);
+
+    // Coefficients were designed for this rate, so they are loaded as the targets
+    for (int band = 0; band < kernel->bands; ++band) {
+        BiquadBand& settings = kernel->controlBands[band];
+        settings.frequency = reader.read<float>();
+        settings.gainDB = reader.read<float>();
+        settings.q = reader.read<float>();
+        settings.enabled = reader.read<uint8_t>() != 0;
+        const BiquadCoefficients coefficients = reader.read<BiquadCoefficients>();
+        const float values[kCoefficientCount] = {
+            coefficients.b0, coefficients.b1, coefficients.b2, coefficients.a1, coefficients.a2
+        };
+        for (int k = 0; k < kCoefficientCount; ++k) {
+            if (!std::isfinite(values[k])) {
+                throw std::runtime_error("Corrupt biquad coefficients in kernel state");
+            }
+            kernel->target[k][band] = values[k];
+        }
+    }
+    kernel->resetState();
+    return kernel;
+}
+
+} // namespace dsp
+} // namespace tald
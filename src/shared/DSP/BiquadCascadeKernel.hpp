@@ -0,0 +1,166 @@
+//
+// BiquadCascadeKernel.hpp
+// TALD UNIA Audio System
+//
+// Multi-band parametric EQ as one cascade of biquads, rendering every band of every
+// channel in a single pass with the channels packed into SIMD lanes.
+//
+
+#ifndef TALD_UNIA_BIQUAD_CASCADE_KERNEL_HPP
+#define TALD_UNIA_BIQUAD_CASCADE_KERNEL_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Bands per cascade, matching the Swift equalizer's limit
+constexpr int MAX_BIQUAD_BANDS = 31;
+
+// Clamping ranges for band settings, matching the Swift equalizer
+constexpr float MIN_BIQUAD_FREQUENCY = 20.0f;
+constexpr float MAX_BIQUAD_FREQUENCY = 20000.0f;
+constexpr float MAX_BIQUAD_GAIN_DB = 12.0f;
+constexpr float MIN_BIQUAD_Q = 0.1f;
+constexpr float MAX_BIQUAD_Q = 10.0f;
+
+/**
+ * @brief Settings of one peaking band
+ */
+struct BiquadBand {
+    float frequency = 1000.0f;  // Centre frequency (Hz)
+    float gainDB = 0.0f;        // Boost or cut at the centre
+    float q = 1.4f;             // Bandwidth
+    bool enabled = true;        // Disabled bands pass audio unchanged
+};
+
+/**
+ * @brief Normalized transposed direct form II coefficients (a0 == 1)
+ */
+struct BiquadCoefficients {
+    float b0 = 1.0f;
+    float b1 = 0.0f;
+    float b2 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+
+    /**
+     * @brief RBJ peaking filter, designed in double precision after clamping the settings
+     *
+     * A disabled band, or one at 0 dB, yields the identity filter.
+     */
+    static BiquadCoefficients peaking(const BiquadBand& band, double sampleRate) noexcept;
+};
+
+/**
+ * @brief Cascade of up to MAX_BIQUAD_BANDS peaking filters over all channels at once
+ *
+ * Each block is transposed into a frame-major scratch buffer, one SIMD vector per
+ * frame with a lane per channel: four lanes for up to four channels, eight beyond
+ * (one AVX2 register, two NEON registers). Every band then costs one vector update
+ * per frame regardless of the channel count. The filter state stays in a small SoA
+ * block in the kernel, so a 10-band 7.1 cascade touches a few kilobytes.
+ *
+ * Band changes come from a single control thread through setBand(). Coefficients
+ * are designed there and published per band through a wait-free latest-value slot;
+ * the render thread picks them up at the next block and ramps every coefficient
+ * linearly over the default ramp time, which keeps the filter stable and free of
+ * zipper noise. Parameter events do not apply.
+ */
+class BiquadCascadeKernel final : public DSPKernel {
+public:
+    /**
+     * @param sampleRate Audio sample rate (Hz)
+     * @param channels Number of audio channels
+     * @param bandCount Number of bands in the cascade, all initially flat
+     * @param denormalMode Requested denormal handling
+     * @param maxFrames Largest block process() accepts
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    BiquadCascadeKernel(double sampleRate, int channels, int bandCount,
+                        DenormalMode denormalMode = DenormalMode::HardwareFTZ,
+                        size_t maxFrames = MAX_BUFFER_SIZE);
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief Change one band (control thread, wait-free)
+     * @return false if band is out of range
+     *
+     * Band settings bypass the ParameterEvent queue, whose MAX_PARAMETERS IDs cannot
+     * address MAX_BIQUAD_BANDS bands of three values each. An update therefore has
+     * no sample offset: it takes effect at the start of the next block, unordered
+     * with that block's parameter events, and then ramps in.
+     */
+    bool setBand(int band, const BiquadBand& settings) noexcept;
+
+    /**
+     * @brief Latest settings sent for a band (control thread)
+     */
+    [[nodiscard]]
+    BiquadBand bandSettings(int band) const noexcept {
+        return controlBands[band];
+    }
+
+    [[nodiscard]]
+    int bandCount() const noexcept {
+        return bands;
+    }
+
+    /**
+     * @brief New cascade with the same bands, starting exactly on their coefficients
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+private:
+    // One published coefficient set per band, guarded by a sequence lock
+    struct CoefficientSlot {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<float> values[5];
+    };
+
+    const int bands;
+    BiquadBand controlBands[MAX_BIQUAD_BANDS];   // Control thread only
+    CoefficientSlot slots[MAX_BIQUAD_BANDS];
+    alignas(PARAMETER_CACHE_LINE_SIZE) std::atomic<uint32_t> pendingBands{0};
+
+    // Render thread state, SoA: coefficient k of band b at [k][b], state lane c of band b at [b][c]
+    alignas(CACHE_LINE_SIZE) float current[5][MAX_BIQUAD_BANDS];
+    float step[5][MAX_BIQUAD_BANDS];
+    float target[5][MAX_BIQUAD_BANDS];
+    alignas(CACHE_LINE_SIZE) float state1[MAX_BIQUAD_BANDS][MAX_CHANNELS];
+    float state2[MAX_BIQUAD_BANDS][MAX_CHANNELS];
+    uint32_t rampRemaining;
+
+    float* work;    // Frame-major transposed block, maxFrames * lane count, from scratch
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+
+    // State format: band settings and their designed coefficients
+    friend class DSPKernel;
+    KernelStateType stateType() const noexcept override {
+        return KernelStateType::BiquadCascade;
+    }
+    void writeState(KernelStateWriter& writer) const override;
+    static std::unique_ptr<DSPKernel> fromState(const KernelStateHeader& header, KernelStateReader& reader);
+
+    void designTargets(double sampleRate) noexcept;
+    void pullBandUpdates() noexcept;
+
+    template <size_t Lanes>
+    void renderLanes(size_t frames) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_BIQUAD_CASCADE_KERNEL_HPP
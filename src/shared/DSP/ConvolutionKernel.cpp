@@ -0,0 +1,546 @@
+#include "ConvolutionKernel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    /**
+     * @brief out = a * b + acc for vDSP packed real spectra
+     *
+     * vDSP_fft_zrip packs the purely real DC and Nyquist bins into element 0, so
+     * they are multiplied as two real products rather than one complex one.
+     */
+    inline void multiplyAccumulatePacked(const DSPSplitComplex& a, const DSPSplitComplex& b,
+                                         const DSPSplitComplex& accumulator, const DSPSplitComplex& out,
+                                         size_t bins) noexcept {
+        const float dc = accumulator.realp[0] + a.realp[0] * b.realp[0];
+        const float nyquist = accumulator.imagp[0] + a.imagp[0] * b.imagp[0];
+        vDSP_zvma(&a, 1, &b, 1, &accumulator, 1, &out, 1, bins);
+        out.realp[0] = dc;
+        out.imagp[0] = nyquist;
+    }
+
+    inline void readChannel(const AudioBufferView& view, int channel, size_t offset, size_t length,
+                            float* destination) noexcept {
+        if (view.layout == BufferLayout::Planar) {
+            std::memcpy(destination, view.planes[channel] + offset, length * sizeof(float));
+            return;
+        }
+        const size_t stride = static_cast<size_t>(view.channels);
+        const float* source = view.interleaved + offset * stride + channel;
+        for (size_t i = 0; i < length; ++i) {
+            destination[i] = source[i * stride];
+        }
+    }
+
+    inline void writeChannel(const AudioBufferView& view, int channel, size_t offset, size_t length,
+                             const float* source) noexcept {
+        if (view.layout == BufferLayout::Planar) {
+            std::memcpy(view.planes[channel] + offset, source, length * sizeof(float));
+            return;
+        }
+        const size_t stride = static_cast<size_t>(view.channels);
+        float* destination = view.interleaved + offset * stride + channel;
+        for (size_t i = 0; i < length; ++i) {
+            destination[i * stride] = source[i];
+        }
+    }
+
+    inline void clearChannel(const AudioBufferView& view, int channel, size_t offset, size_t length) noexcept {
+        if (view.layout == BufferLayout::Planar) {
+            vDSP_vclr(view.planes[channel] + offset, 1, length);
+            return;
+        }
+        const size_t stride = static_cast<size_t>(view.channels);
+        float* destination = view.interleaved + offset * stride + channel;
+        for (size_t i = 0; i < length; ++i) {
+            destination[i * stride] = 0.0f;
+        }
+    }
+
+    size_t validatedBlockSize(size_t blockSize) {
+        if (blockSize < MIN_BUFFER_SIZE || blockSize > MAX_BUFFER_SIZE || !std::has_single_bit(blockSize)) {
+            throw std::invalid_argument("Convolution block size must be a power of two within buffer limits");
+        }
+        return blockSize;
+    }
+}
+
+std::shared_ptr<const PartitionedFilter> PartitionedFilter::create(FFTSetup setup, size_t blockSize,
+                                                                  const ImpulseResponse* responses, int channels) {
+    const size_t fftSize = 2 * blockSize;
+
+    std::shared_ptr<PartitionedFilter> filter(new PartitionedFilter());
+    filter->blockSize = blockSize;
+    filter->channels = channels;
+
+    size_t totalPartitions = 0;
+    for (int channel = 0; channel < channels; ++channel) {
+        const ImpulseResponse& response = responses[channel];
+        filter->partitions[channel] = (response.length + blockSize - 1) / blockSize;
+        filter->inputs[channel] = response.inputChannel;
+        if (filter->partitions[channel] > 0) {
+            filter->mask |= 1u << response.inputChannel;
+        }
+        totalPartitions += filter->partitions[channel];
+    }
+
+    if (totalPartitions > 0) {
+        filter->storage = static_cast<float*>(alignedMalloc(totalPartitions * fftSize * sizeof(float),
+                                                            CACHE_LINE_SIZE));
+        if (!filter->storage) {
+            throw std::runtime_error("Failed to allocate convolution filter");
+        }
+    }
+
+    std::vector<float> time(fftSize);
+    float* cursor = filter->storage;
+    for (int channel = 0; channel < channels; ++channel) {
+        const ImpulseResponse& response = responses[channel];
+        filter->spectra[channel] = cursor;
+        transformPartitions(setup, blockSize, response.samples, response.length, time.data(), cursor);
+        cursor += filter->partitions[channel] * fftSize;
+    }
+
+    return filter;
+}
+
+void PartitionedFilter::transformPartitions(FFTSetup setup, size_t blockSize, const float* samples, size_t length,
+                                            float* time, float* destination) noexcept {
+    const size_t fftSize = 2 * blockSize;
+    const vDSP_Length log2FFTSize = static_cast<vDSP_Length>(std::countr_zero(fftSize));
+
+    // Fold the 2x forward scaling of both spectra and the N inverse scaling into the filter
+    const float scale = 1.0f / (4.0f * static_cast<float>(fftSize));
+    for (size_t first = 0; first < length; first += blockSize) {
+        const size_t taps = std::min(blockSize, length - first);
+
+        vDSP_vclr(time, 1, fftSize);
+        vDSP_vsmul(samples + first, 1, &scale, time, 1, taps);
+
+        DSPSplitComplex spectrum{ destination, destination + blockSize };
+        vDSP_ctoz(reinterpret_cast<const DSPComplex*>(time), 2, &spectrum, 1, blockSize);
+        vDSP_fft_zrip(setup, &spectrum, 1, log2FFTSize, kFFTDirection_Forward);
+        destination += fftSize;
+    }
+}
+
+PartitionedFilter::~PartitionedFilter() {
+    alignedFree(storage);
+}
+
+ConvolutionKernel::ConvolutionKernel(double sampleRate, int channels, size_t maxImpulseLength,
+                                     size_t blockSize, DenormalMode denormalMode)
+    : DSPKernel(sampleRate, channels, denormalMode)
+    , blockSize(validatedBlockSize(blockSize))
+    , fftSize(2 * blockSize)
+    , log2FFTSize(static_cast<vDSP_Length>(std::countr_zero(2 * blockSize)))
+    , maxPartitions((maxImpulseLength + blockSize - 1) / blockSize)
+    , pendingFilter(nullptr)
+    , renderFilter(nullptr)
+    , fadeFilter(nullptr)
+    , delayLineHead(0)
+    , segmentFill(0)
+    , hasHistory(false)
+{
+    if (maxImpulseLength == 0 || maxImpulseLength > MAX_IMPULSE_LENGTH) {
+        throw std::invalid_argument("Impulse length out of valid range");
+    }
+
+    prepareResources(maxFrames, channels, sampleRate);
+    resetState();
+}
+
+void ConvolutionKernel::prepareResources(size_t maxFramesPerBlock, int channels, double) {
+    // Host blocks are cut into partitions, so only the channel count sizes the state
+    (void)maxFramesPerBlock;
+    if (scratch && channels == numChannels) {
+        return;
+    }
+
+    // Start as a per-channel unit impulse so the kernel passes audio through
+    const float unitImpulse = 1.0f;
+    ImpulseResponse identity[MAX_CHANNELS];
+    for (int channel = 0; channel < channels; ++channel) {
+        identity[channel].samples = &unitImpulse;
+        identity[channel].length = 1;
+        identity[channel].inputChannel = channel;
+    }
+    std::shared_ptr<const PartitionedFilter> passThroughFilter =
+        PartitionedFilter::create(fftSetup, blockSize, identity, channels);
+
+    // Spectra and time blocks are fftSize floats, so every region stays cache-line aligned
+    const size_t channelCount = static_cast<size_t>(channels);
+    const size_t perInput = fftSize * (2 + maxPartitions);
+    const size_t perOutput = 2 * fftSize + blockSize;
+    const size_t totalFloats = channelCount * (perInput + perOutput) + 3 * fftSize + blockSize;
+
+    // Pooled, so recycled contents are cleared by the resetState() that follows
+    scratch = acquireScratch(totalFloats);
+
+    float* cursor = scratch.data();
+    auto carve = [&cursor](size_t count) {
+        float* region = cursor;
+        cursor += count;
+        return region;
+    };
+
+    for (int channel = 0; channel < channels; ++channel) {
+        segmentTime[channel] = carve(fftSize);
+        segmentSpectrum[channel] = carve(fftSize);
+        delayLine[channel] = carve(maxPartitions * fftSize);
+        tailSpectrum[channel] = carve(fftSize);
+        fadeTailSpectrum[channel] = carve(fftSize);
+        overlap[channel] = carve(blockSize);
+    }
+    mixSpectrum = carve(fftSize);
+    resultTime = carve(fftSize);
+    fadeResultTime = carve(fftSize);
+    fadeRamp = carve(blockSize);
+    for (size_t frame = 0; frame < blockSize; ++frame) {
+        fadeRamp[frame] = (static_cast<float>(frame) + 0.5f) / static_cast<float>(blockSize);
+    }
+
+    // Filters for the old channel count no longer apply; rendering is stopped
+    currentFilter = std::move(passThroughFilter);
+    retiredFilter.reset();
+    pendingFilter.store(nullptr, std::memory_order_relaxed);
+    renderFilter = currentFilter.get();
+    fadeFilter = nullptr;
+}
+
+ConvolutionKernel::~ConvolutionKernel() = default;
+
+std::unique_ptr<DSPKernel> ConvolutionKernel::fork() const {
+    auto clone = std::make_unique<ConvolutionKernel>(sampleRate, numChannels, maxPartitions * blockSize,
+                                                     blockSize, activeDenormalMode);
+
+    // Share the published set; the clone's render thread has not started yet
+    clone->currentFilter = currentFilter;
+    clone->renderFilter = currentFilter.get();
+    clone->maxFrames = maxFrames;
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+void ConvolutionKernel::writeState(KernelStateWriter& writer) const {
+    const PartitionedFilter& source = *currentFilter;
+    writer.write(static_cast<uint32_t>(blockSize));
+    writer.write(static_cast<uint32_t>(maxPartitions));
+    for (int channel = 0; channel < numChannels; ++channel) {
+        writer.write(static_cast<uint32_t>(source.inputChannel(channel)));
+        writer.write(static_cast<uint32_t>(source.partitionCount(channel)));
+    }
+    for (int channel = 0; channel < numChannels; ++channel) {
+        writer.writeArray(source.spectra[channel], source.partitionCount(channel) * fftSize);
+    }
+}
+
+std::unique_ptr<DSPKernel> ConvolutionKernel::fromState(const KernelStateHeader& header, KernelStateReader& reader) {
+    const size_t partitionSize = reader.read<uint32_t>();
+    const size_t partitionLimit = reader.read<uint32_t>();
+    if (partitionLimit == 0 || partitionLimit > MAX_IMPULSE_LENGTH) {
+        throw std::runtime_error("Invalid convolution capacity in kernel state");
+    }
+    auto kernel = std::make_unique<ConvolutionKernel>(header.sampleRate, header.channels,
+                                                      partitionLimit * partitionSize, partitionSize,
+                                                      header.denormalMode);
+
+    // The spectra are copied as saved, skipping the forward transforms
+    std::shared_ptr<PartitionedFilter> restored(new PartitionedFilter());
+    restored->blockSize = partitionSize;
+    restored->channels = header.channels;
+    size_t totalPartitions = 0;
+    for (int channel = 0; channel < header.channels; ++channel) {
+        const uint32_t input = reader.read<uint32_t>();
+        const uint32_t partitions = reader.read<uint32_t>();
+        if (input >= static_cast<uint32_t>(header.channels) || partitions > kernel->maxPartitions) {
+            throw std::runtime_error("Invalid convolution routing in kernel state");
+        }
+        restored->inputs[channel] = static_cast<int>(input);
+        restored->partitions[channel] = partitions;
+        if (partitions > 0) {
+            restored->mask |= 1u << input;
+        }
+        totalPartitions += partitions;
+    }
+
+    const size_t fftSize = 2 * partitionSize;
+    if (totalPartitions > 0) {
+        restored->storage = static_cast<float*>(alignedMalloc(totalPartitions * fftSize * sizeof(float),
+                                                              CACHE_LINE_SIZE));
+        if (!restored->storage) {
+            throw std::runtime_error("Failed to allocate convolution filter");
+        }
+    }
+    float* cursor = restored->storage;
+    for (int channel = 0; channel < header.channels; ++channel) {
+        restored->spectra[channel] = cursor;
+        reader.readArray(cursor, restored->partitions[channel] * fftSize);
+        cursor += restored->partitions[channel] * fftSize;
+    }
+
+    // As in fork(), the new kernel has not rendered yet
+    kernel->currentFilter = std::move(restored);
+    kernel->renderFilter = kernel->currentFilter.get();
+    kernel->maxFrames = header.maxFrames;
+    return kernel;
+}
+
+bool ConvolutionKernel::setImpulseResponses(const ImpulseResponse* responses, int count) {
+    if (!responses || count != numChannels) {
+        throw std::invalid_argument("One impulse response per output channel required");
+    }
+    for (int channel = 0; channel < count; ++channel) {
+        const ImpulseResponse& response = responses[channel];
+        if (response.inputChannel < 0 || response.inputChannel >= numChannels) {
+            throw std::invalid_argument("Impulse response input channel out of range");
+        }
+        if (response.length > maxPartitions * blockSize || (response.length > 0 && !response.samples)) {
+            throw std::invalid_argument("Impulse response length exceeds kernel capacity");
+        }
+    }
+
+    // The render thread has not switched to the last set yet
+    if (pendingFilter.load(std::memory_order_acquire) != nullptr) {
+        return false;
+    }
+
+    publishFilter(PartitionedFilter::create(fftSetup, blockSize, responses, count));
+    return true;
+}
+
+bool ConvolutionKernel::setFilter(std::shared_ptr<const PartitionedFilter> newFilter) {
+    if (!newFilter) {
+        throw std::invalid_argument("Filter set required");
+    }
+    validateFilter(*newFilter);
+    if (pendingFilter.load(std::memory_order_acquire) != nullptr) {
+        return false;
+    }
+    publishFilter(std::move(newFilter));
+    return true;
+}
+
+void ConvolutionKernel::validateFilter(const PartitionedFilter& candidate) const {
+    if (candidate.partitionSize() != blockSize || candidate.channelCount() != numChannels) {
+        throw std::invalid_argument("Filter set does not match the kernel's partition size and channels");
+    }
+    for (int channel = 0; channel < numChannels; ++channel) {
+        if (candidate.inputChannel(channel) < 0 || candidate.inputChannel(channel) >= numChannels) {
+            throw std::invalid_argument("Filter set input channel out of range");
+        }
+        if (candidate.partitionCount(channel) > maxPartitions) {
+            throw std::invalid_argument("Filter set length exceeds kernel capacity");
+        }
+    }
+}
+
+void ConvolutionKernel::publishFilter(std::shared_ptr<const PartitionedFilter> newFilter) noexcept {
+    // The render thread has finished with the retired set once nothing is pending
+    retiredFilter = std::move(currentFilter);
+    currentFilter = std::move(newFilter);
+    pendingFilter.store(currentFilter.get(), std::memory_order_release);
+}
+
+void ConvolutionKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    const size_t frameCount = input.frames;
+    if (!input.isValid() || !output.isValid() || output.frames != frameCount ||
+        input.channels != numChannels || output.channels != numChannels ||
+        frameCount > maxFrames) {
+        return;
+    }
+
+    if (bypass.load(std::memory_order_relaxed)) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+
+    // Host blocks are cut at partition boundaries; each piece is convolved immediately
+    size_t offset = 0;
+    while (offset < frameCount) {
+        if (segmentFill == 0) {
+            beginSegment();
+        }
+        const size_t length = std::min(blockSize - segmentFill, frameCount - offset);
+        convolveChunk(input, output, offset, length);
+        offset += length;
+    }
+
+    hasHistory = true;
+    recordBlockTiming(startTicks, mach_absolute_time(), frameCount);
+}
+
+void ConvolutionKernel::beginSegment() noexcept {
+    // Filter sets change only here, so one block never mixes more than two sets
+    const PartitionedFilter* pending = pendingFilter.load(std::memory_order_acquire);
+    if (pending && pending != renderFilter) {
+        const uint32_t previousMask = renderFilter->inputMask();
+
+        // Silence so far leaves nothing to fade from
+        fadeFilter = hasHistory ? renderFilter : nullptr;
+        renderFilter = pending;
+        if (!fadeFilter) {
+            pendingFilter.store(nullptr, std::memory_order_release);
+        }
+
+        // Inputs that were not being convolved have no valid history
+        uint32_t newInputs = pending->inputMask() & ~previousMask;
+        while (newInputs) {
+            const int channel = std::countr_zero(newInputs);
+            newInputs &= newInputs - 1;
+            vDSP_vclr(delayLine[channel], 1, maxPartitions * fftSize);
+            vDSP_vclr(segmentTime[channel], 1, fftSize);
+        }
+    }
+
+    // Older partitions only see complete past blocks: accumulate them once per block
+    for (int channel = 0; channel < numChannels; ++channel) {
+        accumulateTail(*renderFilter, channel, tailSpectrum[channel]);
+        if (fadeFilter) {
+            accumulateTail(*fadeFilter, channel, fadeTailSpectrum[channel]);
+        }
+    }
+}
+
+void ConvolutionKernel::accumulateTail(const PartitionedFilter& source, int channel, float* tail) const noexcept {
+    DSPSplitComplex sum = splitSpectrum(tail);
+    vDSP_vclr(tail, 1, fftSize);
+
+    const float* history = delayLine[source.inputChannel(channel)];
+    for (size_t partition = 1; partition < source.partitionCount(channel); ++partition) {
+        const size_t slot = (delayLineHead + maxPartitions - partition) % maxPartitions;
+        const DSPSplitComplex past = splitSpectrum(history + slot * fftSize);
+        const DSPSplitComplex coefficients = splitSpectrum(source.spectrum(channel, partition));
+        multiplyAccumulatePacked(past, coefficients, sum, sum, blockSize);
+    }
+}
+
+void ConvolutionKernel::renderPartition(const PartitionedFilter& source, int channel, const float* tail,
+                                        float* destination) noexcept {
+    if (source.partitionCount(channel) == 0) {
+        vDSP_vclr(destination, 1, fftSize);
+        return;
+    }
+
+    // Current block against partition 0, plus the precomputed tail
+    const DSPSplitComplex current = splitSpectrum(segmentSpectrum[source.inputChannel(channel)]);
+    const DSPSplitComplex coefficients = splitSpectrum(source.spectrum(channel, 0));
+    DSPSplitComplex mix = splitSpectrum(mixSpectrum);
+    multiplyAccumulatePacked(current, coefficients, splitSpectrum(tail), mix, blockSize);
+
+    vDSP_fft_zrip(fftSetup, &mix, 1, log2FFTSize, kFFTDirection_Inverse);
+    vDSP_ztoc(&mix, 1, reinterpret_cast<DSPComplex*>(destination), 2, blockSize);
+}
+
+void ConvolutionKernel::convolveChunk(const AudioBufferView& input, const AudioBufferView& output,
+                                      size_t offset, size_t length) noexcept {
+    const PartitionedFilter& filter = *renderFilter;
+    const size_t position = segmentFill;
+    const bool completesSegment = (position + length == blockSize);
+    const uint32_t activeInputs = filter.inputMask() | (fadeFilter ? fadeFilter->inputMask() : 0u);
+
+    // Read every routed input before writing any output so in-place processing is safe
+    uint32_t inputs = activeInputs;
+    while (inputs) {
+        const int channel = std::countr_zero(inputs);
+        inputs &= inputs - 1;
+
+        float* time = segmentTime[channel];
+        readChannel(input, channel, offset, length, time + position);
+
+        DSPSplitComplex spectrum = splitSpectrum(segmentSpectrum[channel]);
+        vDSP_ctoz(reinterpret_cast<const DSPComplex*>(time), 2, &spectrum, 1, blockSize);
+        vDSP_fft_zrip(fftSetup, &spectrum, 1, log2FFTSize, kFFTDirection_Forward);
+    }
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        const bool fading = fadeFilter && fadeFilter->partitionCount(channel) > 0;
+        if (filter.partitionCount(channel) == 0 && !fading) {
+            clearChannel(output, channel, offset, length);
+            if (completesSegment) {
+                vDSP_vclr(overlap[channel], 1, blockSize);
+            }
+            continue;
+        }
+
+        renderPartition(filter, channel, tailSpectrum[channel], resultTime);
+
+        // The old set's overlap carries on, so crossfading only the new halves is
+        // continuous at both ends of the partition
+        if (fadeFilter) {
+            renderPartition(*fadeFilter, channel, fadeTailSpectrum[channel], fadeResultTime);
+            float* incoming = resultTime + position;
+            const float* outgoing = fadeResultTime + position;
+            vDSP_vsub(outgoing, 1, incoming, 1, incoming, 1, length);
+            vDSP_vma(incoming, 1, fadeRamp + position, 1, outgoing, 1, incoming, 1, length);
+        }
+
+        // Overlap-add the previous block's second half
+        vDSP_vadd(resultTime + position, 1, overlap[channel] + position, 1, resultTime + position, 1, length);
+        writeChannel(output, channel, offset, length, resultTime + position);
+
+        if (completesSegment) {
+            std::memcpy(overlap[channel], resultTime + blockSize, blockSize * sizeof(float));
+            flushDenormalsIfNeeded(overlap[channel], blockSize);
+        }
+    }
+
+    if (completesSegment) {
+        // The finished block's spectrum enters the frequency-domain delay line
+        inputs = activeInputs;
+        while (inputs) {
+            const int channel = std::countr_zero(inputs);
+            inputs &= inputs - 1;
+            std::memcpy(delayLine[channel] + delayLineHead * fftSize, segmentSpectrum[channel],
+                        fftSize * sizeof(float));
+            vDSP_vclr(segmentTime[channel], 1, blockSize);
+        }
+        delayLineHead = (delayLineHead + 1) % maxPartitions;
+        segmentFill = 0;
+
+        // Fade complete: the control thread may now release the old set
+        if (fadeFilter) {
+            fadeFilter = nullptr;
+            pendingFilter.store(nullptr, std::memory_order_release);
+        }
+    }
+    else {
+        segmentFill = position + length;
+    }
+}
+
+void ConvolutionKernel::resetState() noexcept {
+    // Clear signal history; loaded filters are kept
+    for (int channel = 0; channel < numChannels; ++channel) {
+        vDSP_vclr(segmentTime[channel], 1, fftSize);
+        vDSP_vclr(delayLine[channel], 1, maxPartitions * fftSize);
+        vDSP_vclr(overlap[channel], 1, blockSize);
+    }
+    delayLineHead = 0;
+    segmentFill = 0;
+    hasHistory = false;
+
+    // With no history left, a fade in progress ends on the new set
+    if (fadeFilter) {
+        fadeFilter = nullptr;
+        pendingFilter.store(nullptr, std::memory_order_release);
+    }
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,285 @@
+//
+// ConvolutionKernel.hpp
+// TALD UNIA Audio System
+//
+// Uniformly partitioned FFT convolution for room correction FIRs and per-ear HRIRs,
+// built on the FFT setup owned by DSPKernel.
+//
+// External Dependencies:
+// - Accelerate (macOS 13.0+ / iOS 13.0+) - vDSP real FFT and complex multiply-accumulate
+
+#ifndef TALD_UNIA_CONVOLUTION_KERNEL_HPP
+#define TALD_UNIA_CONVOLUTION_KERNEL_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Partition (and render sub-block) size used when none is requested
+constexpr size_t DEFAULT_CONVOLUTION_BLOCK_SIZE = 256;
+
+// Longest impulse response accepted, about 5.5 s at 48 kHz
+constexpr size_t MAX_IMPULSE_LENGTH = 262144;
+
+/**
+ * @brief One output channel's filter and the input channel it reads
+ *
+ * Room correction routes every channel to itself; binaural rendering routes a
+ * mono source to two outputs with the left and right HRIRs.
+ */
+struct ImpulseResponse {
+    const float* samples = nullptr;
+    size_t length = 0;
+    int inputChannel = 0;
+};
+
+/**
+ * @brief Immutable partitioned filter spectra for every output channel
+ *
+ * Built once on the control thread and then only read, so any number of kernels
+ * (including forks rendering on other threads) can share one instance.
+ */
+class PartitionedFilter {
+public:
+    /**
+     * @brief Partition and transform one impulse response per output channel
+     * @param setup FFT setup supporting 2 * blockSize point transforms
+     * @param blockSize Partition size (power of two)
+     * @param responses One entry per output channel
+     * @param channels Number of entries
+     * @throws std::runtime_error if allocation fails
+     */
+    static std::shared_ptr<const PartitionedFilter> create(FFTSetup setup, size_t blockSize,
+                                                           const ImpulseResponse* responses, int channels);
+
+    ~PartitionedFilter();
+
+    PartitionedFilter(const PartitionedFilter&) = delete;
+    PartitionedFilter& operator=(const PartitionedFilter&) = delete;
+
+    /**
+     * @brief Packed spectrum of one partition, pre-scaled for vDSP round trips
+     */
+    [[nodiscard]]
+    const float* spectrum(int channel, size_t partition) const noexcept {
+        return spectra[channel] + partition * 2 * blockSize;
+    }
+
+    [[nodiscard]]
+    size_t partitionCount(int channel) const noexcept {
+        return partitions[channel];
+    }
+
+    [[nodiscard]]
+    int inputChannel(int channel) const noexcept {
+        return inputs[channel];
+    }
+
+    /**
+     * @brief Bit per input channel read by at least one output
+     */
+    [[nodiscard]]
+    uint32_t inputMask() const noexcept {
+        return mask;
+    }
+
+    [[nodiscard]]
+    int channelCount() const noexcept {
+        return channels;
+    }
+
+    [[nodiscard]]
+    size_t partitionSize() const noexcept {
+        return blockSize;
+    }
+
+private:
+    friend class HRTFStore;
+    friend class ConvolutionKernel;
+
+    PartitionedFilter() = default;
+
+    /**
+     * @brief Write the pre-scaled packed spectra of every partition of one response
+     * @param time Scratch of 2 * blockSize floats
+     * @param destination ceil(length / blockSize) * 2 * blockSize floats
+     */
+    static void transformPartitions(FFTSetup setup, size_t blockSize, const float* samples, size_t length,
+                                    float* time, float* destination) noexcept;
+
+    size_t blockSize = 0;
+    int channels = 0;
+    float* storage = nullptr;                 // Single aligned allocation for all spectra
+    const float* spectra[MAX_CHANNELS] = {};
+    size_t partitions[MAX_CHANNELS] = {};
+    int inputs[MAX_CHANNELS] = {};
+    uint32_t mask = 0;
+};
+
+/**
+ * @brief Uniformly partitioned overlap-add convolution kernel
+ *
+ * Filters are split into blockSize partitions whose spectra are multiplied against
+ * a frequency-domain delay line of past input blocks, so per-block cost grows with
+ * the partition count rather than the tap count and is the same for every block.
+ * Host blocks shorter than the partition size are handled without added latency by
+ * transforming the partially filled input block on each call; the tail of older
+ * partitions is accumulated once per partition. Signal state is one pooled scratch
+ * block taken at construction; filters are immutable PartitionedFilter sets shared with forks and
+ * swapped at partition boundaries without locking. Both sets read the same spectral
+ * delay line, so a swap renders the old and new sets side by side for one partition
+ * and crossfades between them.
+ */
+class ConvolutionKernel final : public DSPKernel {
+public:
+    /**
+     * @brief Constructs a convolution kernel, initially passing every channel through
+     * @param sampleRate Audio sample rate (Hz)
+     * @param channels Number of input and output channels
+     * @param maxImpulseLength Longest filter setImpulseResponses() will accept (taps)
+     * @param blockSize Partition size, a power of two between MIN_BUFFER_SIZE and MAX_BUFFER_SIZE
+     * @param denormalMode Requested denormal handling
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    ConvolutionKernel(double sampleRate, int channels, size_t maxImpulseLength,
+                      size_t blockSize = DEFAULT_CONVOLUTION_BLOCK_SIZE,
+                      DenormalMode denormalMode = DenormalMode::HardwareFTZ);
+
+    ~ConvolutionKernel() override;
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief New kernel sharing this kernel's current filter set and FFT setup
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+    /**
+     * @brief Load one filter per output channel (control thread)
+     * @param responses numChannels entries, indexed by output channel; a zero-length
+     *                  entry silences that output
+     * @param count Number of entries, must equal channelCount()
+     * @return false if the previous set has not reached the render thread yet
+     * @throws std::invalid_argument for a bad count, input channel or length
+     *
+     * Partitions and transforms the filters into a new immutable set; the render
+     * thread switches to it at its next partition boundary. Calls must come from a
+     * single control thread. Forks keep the set they were created with. prepare()
+     * with a different channel count returns every channel to pass-through.
+     */
+    bool setImpulseResponses(const ImpulseResponse* responses, int count);
+
+    /**
+     * @brief Switch to a filter set built elsewhere, such as an interpolated HRTF (control thread)
+     * @return false if the previous set has not reached the render thread yet
+     * @throws std::invalid_argument if the set's partition size, channel count,
+     *         routing or length does not fit this kernel
+     *
+     * Once audio has been rendered, the switch crossfades from the old set to the
+     * new one over one partition, so a moving source never clicks; the old set is
+     * held until the fade is done.
+     */
+    bool setFilter(std::shared_ptr<const PartitionedFilter> newFilter);
+
+    [[nodiscard]]
+    size_t partitionSize() const noexcept {
+        return blockSize;
+    }
+
+    [[nodiscard]]
+    size_t maxPartitionCount() const noexcept {
+        return maxPartitions;
+    }
+
+    /**
+     * @brief Added delay in frames; partial blocks are convolved immediately
+     */
+    [[nodiscard]]
+    size_t latencyFrames() const noexcept {
+        return 0;
+    }
+
+    /**
+     * @brief Filter set most recently loaded (control thread)
+     */
+    [[nodiscard]]
+    const std::shared_ptr<const PartitionedFilter>& filter() const noexcept {
+        return currentFilter;
+    }
+
+private:
+    const size_t blockSize;                 // Partition size B
+    const size_t fftSize;                   // 2B
+    const vDSP_Length log2FFTSize;
+    const size_t maxPartitions;
+
+    // Control thread ownership of filter sets the render thread may be reading
+    std::shared_ptr<const PartitionedFilter> currentFilter;  // Latest published set
+    std::shared_ptr<const PartitionedFilter> retiredFilter;  // Previous set, until the switch is seen
+    std::atomic<const PartitionedFilter*> pendingFilter;     // Published and not yet faded in, or null
+    const PartitionedFilter* renderFilter;                   // Render thread only
+    const PartitionedFilter* fadeFilter;                     // Render thread: set fading out, or null
+
+    // Signal state below is carved from the base class scratch block
+    // Render thread state, per input channel
+    float* segmentTime[MAX_CHANNELS];       // Current input block, zero padded to 2B
+    float* segmentSpectrum[MAX_CHANNELS];   // Spectrum of the (partial) current block
+    float* delayLine[MAX_CHANNELS];         // maxPartitions past block spectra
+    size_t delayLineHead;                   // Slot the current block's spectrum goes to
+    size_t segmentFill;                     // Frames of the current block received so far
+    bool hasHistory;                        // Output rendered since the last reset
+
+    // Render thread state, per output channel
+    float* tailSpectrum[MAX_CHANNELS];      // Sum over partitions >= 1, once per block
+    float* overlap[MAX_CHANNELS];           // Second half of the previous block's result
+    float* fadeTailSpectrum[MAX_CHANNELS];  // Tail of the set fading out
+
+    // Render thread scratch
+    float* mixSpectrum;
+    float* resultTime;
+    float* fadeResultTime;
+    float* fadeRamp;                        // Weight of the incoming set per partition frame
+
+    [[nodiscard]]
+    DSPSplitComplex splitSpectrum(float* packed) const noexcept {
+        return DSPSplitComplex{ packed, packed + blockSize };
+    }
+
+    [[nodiscard]]
+    DSPSplitComplex splitSpectrum(const float* packed) const noexcept {
+        return splitSpectrum(const_cast<float*>(packed));
+    }
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+
+    // State format: partitioning, routing and the filter spectra as rendered
+    friend class DSPKernel;
+    KernelStateType stateType() const noexcept override {
+        return KernelStateType::Convolution;
+    }
+    void writeState(KernelStateWriter& writer) const override;
+    static std::unique_ptr<DSPKernel> fromState(const KernelStateHeader& header, KernelStateReader& reader);
+
+    void validateFilter(const PartitionedFilter& candidate) const;
+    void publishFilter(std::shared_ptr<const PartitionedFilter> newFilter) noexcept;
+    void beginSegment() noexcept;
+    void accumulateTail(const PartitionedFilter& source, int channel, float* tail) const noexcept;
+    void renderPartition(const PartitionedFilter& source, int channel, const float* tail,
+                         float* destination) noexcept;
+    void convolveChunk(const AudioBufferView& input, const AudioBufferView& output,
+                       size_t offset, size_t length) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_CONVOLUTION_KERNEL_HPP
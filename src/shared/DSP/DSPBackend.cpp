@@ -0,0 +1,280 @@
+#include "DSPBackend.hpp"
+#include <cmath>
+#include <cstring>
+#include <Accelerate/Accelerate.h>
+#include "DSPDenormals.hpp"
+
+#if defined(__APPLE__)
+    #include <sys/sysctl.h>
+#endif
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // MARK: Scalar reference
+
+    inline float flushSample(float sample) noexcept {
+        return (std::fabs(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+    }
+
+    void scalarFlush(const float* in, float* out, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = flushSample(in[i]);
+        }
+    }
+
+    void scalarGain(const float* in, float* out, size_t count, float gain) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = in[i] * gain;
+        }
+    }
+
+    void scalarGainFlush(const float* in, float* out, size_t count, float gain) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = flushSample(in[i] * gain);
+        }
+    }
+
+    void scalarRamp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = in[i] * ramp[i];
+        }
+    }
+
+    void scalarRampFlush(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = flushSample(in[i] * ramp[i]);
+        }
+    }
+
+    void scalarAccumulate(const float* in, float* sum, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            sum[i] += in[i];
+        }
+    }
+
+    constexpr DSPBackend kScalarBackend = {
+        DSPBackendKind::Scalar, "Scalar", 1,
+        scalarFlush, scalarGain, scalarGainFlush, scalarRamp, scalarRampFlush, scalarAccumulate
+    };
+
+    // MARK: Scalar reduced precision
+
+    void scalarFloat16Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float gain16 = roundToFloat16(gain);
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = multiplyFloat16(in[i], gain16);
+        }
+    }
+
+    void scalarFloat16Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = multiplyFloat16(in[i], roundToFloat16(ramp[i]));
+        }
+    }
+
+    void scalarQ31Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const int32_t gainQ = q31Gain(gain);
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = fromQ31(multiplyQ31(toQ31(in[i]), gainQ));
+        }
+    }
+
+    void scalarQ31Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = fromQ31(multiplyQ31(toQ31(in[i]), q31Gain(ramp[i])));
+        }
+    }
+
+    void scalarQ15Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const int16_t gainQ = q15Gain(gain);
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = fromQ15(multiplyQ15(toQ15(in[i]), gainQ));
+        }
+    }
+
+    void scalarQ15Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        #pragma clang loop vectorize(disable) interleave(disable)
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = fromQ15(multiplyQ15(toQ15(in[i]), q15Gain(ramp[i])));
+        }
+    }
+
+    constexpr ReducedPrecisionBackend kScalarFloat16Backend = {
+        ProcessingPrecision::Float16, DSPBackendKind::Scalar, "Scalar", 1, scalarFloat16Gain, scalarFloat16Ramp
+    };
+    constexpr ReducedPrecisionBackend kScalarQ31Backend = {
+        ProcessingPrecision::Q31, DSPBackendKind::Scalar, "Scalar", 1, scalarQ31Gain, scalarQ31Ramp
+    };
+    constexpr ReducedPrecisionBackend kScalarQ15Backend = {
+        ProcessingPrecision::Q15, DSPBackendKind::Scalar, "Scalar", 1, scalarQ15Gain, scalarQ15Ramp
+    };
+
+    // MARK: Accelerate (vDSP has no threshold-to-zero, so flushing is a second pass)
+
+    void accelerateFlush(const float* in, float* out, size_t count) noexcept {
+        if (in != out) {
+            std::memcpy(out, in, count * sizeof(float));
+        }
+        flushDenormals(out, count);
+    }
+
+    void accelerateGain(const float* in, float* out, size_t count, float gain) noexcept {
+        vDSP_vsmul(in, 1, &gain, out, 1, count);
+    }
+
+    void accelerateGainFlush(const float* in, float* out, size_t count, float gain) noexcept {
+        vDSP_vsmul(in, 1, &gain, out, 1, count);
+        flushDenormals(out, count);
+    }
+
+    void accelerateRamp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        vDSP_vmul(in, 1, ramp, 1, out, 1, count);
+    }
+
+    void accelerateRampFlush(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        vDSP_vmul(in, 1, ramp, 1, out, 1, count);
+        flushDenormals(out, count);
+    }
+
+    void accelerateAccumulate(const float* in, float* sum, size_t count) noexcept {
+        vDSP_vadd(sum, 1, in, 1, sum, 1, count);
+    }
+
+    constexpr DSPBackend kAccelerateBackend = {
+        DSPBackendKind::Accelerate, "Accelerate", SIMD_VECTOR_SIZE,
+        accelerateFlush, accelerateGain, accelerateGainFlush, accelerateRamp, accelerateRampFlush,
+        accelerateAccumulate
+    };
+
+    // MARK: CPU features
+
+    struct CPUFeatures {
+        bool avx2 = false;
+        bool avx512 = false;
+    };
+
+#if defined(__APPLE__) && defined(__x86_64__)
+    bool sysctlFlag(const char* name) noexcept {
+        int value = 0;
+        size_t size = sizeof(value);
+        return sysctlbyname(name, &value, &size, nullptr, 0) == 0 && value != 0;
+    }
+#endif
+
+    CPUFeatures detectCPUFeatures() noexcept {
+        CPUFeatures features;
+#if defined(__x86_64__)
+    #if defined(__APPLE__)
+        // The kernel enables AVX-512 state lazily, so XCR0 can under-report it; ask sysctl
+        features.avx2 = sysctlFlag("hw.optional.avx2_0");
+        features.avx512 = sysctlFlag("hw.optional.avx512f");
+    #else
+        features.avx2 = __builtin_cpu_supports("avx2");
+        features.avx512 = __builtin_cpu_supports("avx512f");
+    #endif
+#endif
+        return features;
+    }
+
+    const CPUFeatures& cpuFeatures() noexcept {
+        static const CPUFeatures features = detectCPUFeatures();
+        return features;
+    }
+}
+
+const DSPBackend* findDSPBackend(DSPBackendKind kind) noexcept {
+    switch (kind) {
+        case DSPBackendKind::Scalar:
+            return &kScalarBackend;
+        case DSPBackendKind::Accelerate:
+            return &kAccelerateBackend;
+        case DSPBackendKind::NEON:
+            return neonDSPBackend();
+        case DSPBackendKind::AVX2:
+            return cpuFeatures().avx2 ? avx2DSPBackend() : nullptr;
+        case DSPBackendKind::AVX512:
+            return cpuFeatures().avx512 ? avx512DSPBackend() : nullptr;
+    }
+    return nullptr;
+}
+
+const DSPBackend& activeDSPBackend() noexcept {
+    static const DSPBackend& selected = [] () -> const DSPBackend& {
+        for (DSPBackendKind kind : { DSPBackendKind::AVX512, DSPBackendKind::AVX2, DSPBackendKind::NEON }) {
+            if (const DSPBackend* backend = findDSPBackend(kind)) {
+                return *backend;
+            }
+        }
+        return kAccelerateBackend;
+    }();
+    return selected;
+}
+
+const ReducedPrecisionBackend* findReducedPrecisionBackend(ProcessingPrecision precision,
+                                                           DSPBackendKind kind) noexcept {
+    if (kind == DSPBackendKind::NEON) {
+        return neonReducedPrecisionBackend(precision);
+    }
+    if (kind != DSPBackendKind::Scalar) {
+        return nullptr;
+    }
+    switch (precision) {
+        case ProcessingPrecision::Float32:
+            return nullptr;
+        case ProcessingPrecision::Float16:
+            return &kScalarFloat16Backend;
+        case ProcessingPrecision::Q31:
+            return &kScalarQ31Backend;
+        case ProcessingPrecision::Q15:
+            return &kScalarQ15Backend;
+    }
+    return nullptr;
+}
+
+const ReducedPrecisionBackend* activeReducedPrecisionBackend(ProcessingPrecision precision) noexcept {
+    if (const ReducedPrecisionBackend* backend = neonReducedPrecisionBackend(precision)) {
+        return backend;
+    }
+    return findReducedPrecisionBackend(precision, DSPBackendKind::Scalar);
+}
+
+std::vector<const ReducedPrecisionBackend*> availableReducedPrecisionBackends(ProcessingPrecision precision) {
+    std::vector<const ReducedPrecisionBackend*> backends;
+    for (DSPBackendKind kind : { DSPBackendKind::Scalar, DSPBackendKind::NEON }) {
+        if (const ReducedPrecisionBackend* backend = findReducedPrecisionBackend(precision, kind)) {
+            backends.push_back(backend);
+        }
+    }
+    return backends;
+}
+
+std::vector<const DSPBackend*> availableDSPBackends() {
+    std::vector<const DSPBackend*> backends;
+    for (DSPBackendKind kind : { DSPBackendKind::Scalar, DSPBackendKind::Accelerate, DSPBackendKind::NEON,
+                                 DSPBackendKind::AVX2, DSPBackendKind::AVX512 }) {
+        if (const DSPBackend* backend = findDSPBackend(kind)) {
+            backends.push_back(backend);
+        }
+    }
+    return backends;
+}
+
+} // namespace dsp
+} // namespace tald
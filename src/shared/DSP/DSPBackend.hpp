@@ -0,0 +1,133 @@
+//
+// DSPBackend.hpp
+// TALD UNIA Audio System
+//
+// Hand-vectorized implementations of the kernel's inner loops, one table per
+// instruction set, with the best table for the running CPU chosen once per process.
+//
+
+#ifndef TALD_UNIA_DSP_BACKEND_HPP
+#define TALD_UNIA_DSP_BACKEND_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <vector>      // C++20
+#include "DSPConfig.hpp"
+#include "DSPPrecision.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Instruction set a backend table is written for
+ */
+enum class DSPBackendKind : uint8_t {
+    Scalar,      // Portable reference loops, never vectorized
+    Accelerate,  // vDSP calls, one pass per operation
+    NEON,        // arm64 Advanced SIMD, 4 lanes
+    AVX2,        // x86_64 256-bit, 8 lanes
+    AVX512       // x86_64 512-bit with masked tails, 16 lanes
+};
+
+/**
+ * @brief Contiguous-run primitives behind DSPKernel::process()
+ *
+ * Gain, ramp and denormal flush run fused in one pass over each run: every sample is
+ * loaded once, multiplied, optionally zeroed below DENORMAL_THRESHOLD and stored once.
+ * All operations are elementwise multiplies and adds without contraction, so every
+ * backend produces bit-identical results. `in` may equal `out`; otherwise the
+ * ranges must not overlap. No pointer alignment is required.
+ */
+struct DSPBackend {
+    DSPBackendKind kind;
+    const char* name;
+    int lanes;   // Floats per vector register
+
+    // out[i] = flush(in[i])
+    void (*flush)(const float* in, float* out, size_t count) noexcept;
+
+    // out[i] = in[i] * gain, and the same followed by the threshold flush
+    void (*gain)(const float* in, float* out, size_t count, float gain) noexcept;
+    void (*gainFlush)(const float* in, float* out, size_t count, float gain) noexcept;
+
+    // out[i] = in[i] * ramp[i], and the same followed by the threshold flush
+    void (*ramp)(const float* in, float* out, const float* ramp, size_t count) noexcept;
+    void (*rampFlush)(const float* in, float* out, const float* ramp, size_t count) noexcept;
+
+    // sum[i] += in[i]
+    void (*accumulate)(const float* in, float* sum, size_t count) noexcept;
+};
+
+/**
+ * @brief Backend for this process: the widest instruction set the CPU supports
+ *
+ * Detected on first use (cheap sysctl or cpuid queries) and fixed afterwards, so
+ * the first call belongs off the render thread; kernel construction makes it.
+ * Preference: AVX-512, AVX2, NEON, then Accelerate.
+ */
+[[nodiscard]]
+const DSPBackend& activeDSPBackend() noexcept;
+
+/**
+ * @brief A specific backend, or null where it is not compiled in or the CPU lacks it
+ */
+[[nodiscard]]
+const DSPBackend* findDSPBackend(DSPBackendKind kind) noexcept;
+
+/**
+ * @brief Every backend usable on this machine, scalar reference first
+ */
+[[nodiscard]]
+std::vector<const DSPBackend*> availableDSPBackends();
+
+/**
+ * @brief Gain primitives computed in a reduced format, with binary32 at the edges
+ *
+ * Each run converts in[i] (and ramp[i]) into the format, multiplies there and
+ * converts the product back, exactly as the reference conversions in
+ * DSPPrecision.hpp define, so every table is bit-identical to the scalar one. Same
+ * aliasing rules as DSPBackend. Results never fall in the binary32 denormal range
+ * that needs flushing, so there are no flush variants.
+ */
+struct ReducedPrecisionBackend {
+    ProcessingPrecision precision;
+    DSPBackendKind kind;
+    const char* name;
+    int lanes;   // Samples per vector register in the reduced format
+
+    void (*gain)(const float* in, float* out, size_t count, float gain) noexcept;
+    void (*ramp)(const float* in, float* out, const float* ramp, size_t count) noexcept;
+};
+
+/**
+ * @brief Widest table for a reduced precision on this machine, or null for Float32
+ *
+ * NEON where available, otherwise the portable scalar loops.
+ */
+[[nodiscard]]
+const ReducedPrecisionBackend* activeReducedPrecisionBackend(ProcessingPrecision precision) noexcept;
+
+/**
+ * @brief A specific reduced-precision table, or null where it does not exist
+ */
+[[nodiscard]]
+const ReducedPrecisionBackend* findReducedPrecisionBackend(ProcessingPrecision precision,
+                                                           DSPBackendKind kind) noexcept;
+
+/**
+ * @brief Every table for a reduced precision usable on this machine, scalar reference first
+ */
+[[nodiscard]]
+std::vector<const ReducedPrecisionBackend*> availableReducedPrecisionBackends(ProcessingPrecision precision);
+
+// Per instruction set tables, each defined in its own translation unit; null when
+// that translation unit is built for another architecture
+const DSPBackend* neonDSPBackend() noexcept;
+const DSPBackend* avx2DSPBackend() noexcept;
+const DSPBackend* avx512DSPBackend() noexcept;
+const ReducedPrecisionBackend* neonReducedPrecisionBackend(ProcessingPrecision precision) noexcept;
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_BACKEND_HPP
@@ -0,0 +1,292 @@
+#include "DSPBackend.hpp"
+#include "DSPDenormals.hpp"
+
+#if defined(__aarch64__) || defined(__arm64__)
+    #include <arm_neon.h>
+#endif
+
+// Version comments for external dependencies
+// arm64 Advanced SIMD (NEON): every Apple silicon Mac and iOS device
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+#if defined(__aarch64__) || defined(__arm64__)
+
+namespace {
+    constexpr size_t kLanes = 4;
+    constexpr size_t kUnroll = 4;   // Four independent registers hide the multiply latency
+    constexpr size_t kStep = kLanes * kUnroll;
+
+    inline float32x4_t flushVector(float32x4_t value, float32x4_t threshold) noexcept {
+        // |value| < threshold selects lanes to clear
+        const uint32x4_t tiny = vcaltq_f32(value, threshold);
+        return vreinterpretq_f32_u32(vbicq_u32(vreinterpretq_u32_f32(value), tiny));
+    }
+
+    inline float flushSample(float sample) noexcept {
+        return (__builtin_fabsf(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+    }
+
+    /**
+     * @brief Shared loop skeleton: Op maps one input vector (and its offset) to an output vector
+     */
+    template <typename VectorOp, typename ScalarOp>
+    inline void transform(const float* in, float* out, size_t count, VectorOp vectorOp, ScalarOp scalarOp) noexcept {
+        size_t i = 0;
+        for (; i + kStep <= count; i += kStep) {
+            const float32x4_t a = vld1q_f32(in + i);
+            const float32x4_t b = vld1q_f32(in + i + 4);
+            const float32x4_t c = vld1q_f32(in + i + 8);
+            const float32x4_t d = vld1q_f32(in + i + 12);
+            vst1q_f32(out + i, vectorOp(a, i));
+            vst1q_f32(out + i + 4, vectorOp(b, i + 4));
+            vst1q_f32(out + i + 8, vectorOp(c, i + 8));
+            vst1q_f32(out + i + 12, vectorOp(d, i + 12));
+        }
+        for (; i + kLanes <= count; i += kLanes) {
+            vst1q_f32(out + i, vectorOp(vld1q_f32(in + i), i));
+        }
+        for (; i < count; ++i) {
+            out[i] = scalarOp(in[i], i);
+        }
+    }
+
+    void neonFlush(const float* in, float* out, size_t count) noexcept {
+        const float32x4_t threshold = vdupq_n_f32(DENORMAL_THRESHOLD);
+        transform(in, out, count,
+                  [&](float32x4_t x, size_t) { return flushVector(x, threshold); },
+                  [](float x, size_t) { return flushSample(x); });
+    }
+
+    void neonGain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float32x4_t scale = vdupq_n_f32(gain);
+        transform(in, out, count,
+                  [&](float32x4_t x, size_t) { return vmulq_f32(x, scale); },
+                  [=](float x, size_t) { return x * gain; });
+    }
+
+    void neonGainFlush(const float* in, float* out, size_t count, float gain) noexcept {
+        const float32x4_t scale = vdupq_n_f32(gain);
+        const float32x4_t threshold = vdupq_n_f32(DENORMAL_THRESHOLD);
+        transform(in, out, count,
+                  [&](float32x4_t x, size_t) { return flushVector(vmulq_f32(x, scale), threshold); },
+                  [=](float x, size_t) { return flushSample(x * gain); });
+    }
+
+    void neonRamp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        transform(in, out, count,
+                  [=](float32x4_t x, size_t i) { return vmulq_f32(x, vld1q_f32(ramp + i)); },
+                  [=](float x, size_t i) { return x * ramp[i]; });
+    }
+
+    void neonRampFlush(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        const float32x4_t threshold = vdupq_n_f32(DENORMAL_THRESHOLD);
+        transform(in, out, count,
+                  [&](float32x4_t x, size_t i) { return flushVector(vmulq_f32(x, vld1q_f32(ramp + i)), threshold); },
+                  [=](float x, size_t i) { return flushSample(x * ramp[i]); });
+    }
+
+    void neonAccumulate(const float* in, float* sum, size_t count) noexcept {
+        transform(in, sum, count,
+                  [=](float32x4_t x, size_t i) { return vaddq_f32(vld1q_f32(sum + i), x); },
+                  [=](float x, size_t i) { return sum[i] + x; });
+    }
+
+    constexpr DSPBackend kNEONBackend = {
+        DSPBackendKind::NEON, "NEON", static_cast<int>(kLanes),
+        neonFlush, neonGain, neonGainFlush, neonRamp, neonRampFlush, neonAccumulate
+    };
+
+    // MARK: Reduced precision
+
+    /**
+     * @brief Loop skeleton for reduced formats: BlockOp converts, processes and stores Block samples at i
+     */
+    template <size_t Block, typename BlockOp, typename ScalarOp>
+    inline void reducedTransform(const float* in, float* out, size_t count, BlockOp blockOp,
+                                 ScalarOp scalarOp) noexcept {
+        size_t i = 0;
+        for (; i + Block <= count; i += Block) {
+            blockOp(i);
+        }
+        for (; i < count; ++i) {
+            out[i] = scalarOp(in[i], i);
+        }
+    }
+
+    // Q15: eight samples per register, gains in Q2.13
+    constexpr int kQ15GainShift = 15 - FIXED_POINT_GAIN_HEADROOM_BITS;
+
+    inline int16x8_t loadQ15(const float* in, float32x4_t scale) noexcept {
+        // Round to nearest even, then saturate to 16 bits; NaN converts to 0
+        const int32x4_t low = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in), scale));
+        const int32x4_t high = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in + 4), scale));
+        return vcombine_s16(vqmovn_s32(low), vqmovn_s32(high));
+    }
+
+    inline void storeQ15Product(float* out, int16x8_t x, int16x8_t gain) noexcept {
+        const int16x8_t y = vcombine_s16(vqrshrn_n_s32(vmull_s16(vget_low_s16(x), vget_low_s16(gain)), kQ15GainShift),
+                                         vqrshrn_n_s32(vmull_high_s16(x, gain), kQ15GainShift));
+        vst1q_f32(out, vcvtq_n_f32_s32(vmovl_s16(vget_low_s16(y)), 15));
+        vst1q_f32(out + 4, vcvtq_n_f32_s32(vmovl_high_s16(y), 15));
+    }
+
+    void neonQ15Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float32x4_t sampleScale = vdupq_n_f32(32768.0f);
+        const int16_t gainQ = q15Gain(gain);
+        const int16x8_t gainVector = vdupq_n_s16(gainQ);
+        reducedTransform<8>(in, out, count,
+                            [&](size_t i) { storeQ15Product(out + i, loadQ15(in + i, sampleScale), gainVector); },
+                            [=](float x, size_t) { return fromQ15(multiplyQ15(toQ15(x), gainQ)); });
+    }
+
+    void neonQ15Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        const float32x4_t sampleScale = vdupq_n_f32(32768.0f);
+        const float32x4_t gainScale = vdupq_n_f32(static_cast<float>(1 << kQ15GainShift));
+        reducedTransform<8>(in, out, count,
+                            [&](size_t i) {
+                                storeQ15Product(out + i, loadQ15(in + i, sampleScale), loadQ15(ramp + i, gainScale));
+                            },
+                            [=](float x, size_t i) { return fromQ15(multiplyQ15(toQ15(x), q15Gain(ramp[i]))); });
+    }
+
+    // Q31: four samples per register; the products widen to 64 bits
+    constexpr int kQ31GainShift = 31 - FIXED_POINT_GAIN_HEADROOM_BITS;
+
+    inline int32x4_t loadQ31(const float* in, float32x4_t scale) noexcept {
+        // Scaling by a power of two is exact; the conversion rounds to nearest even and saturates
+        return vcvtnq_s32_f32(vmulq_f32(vld1q_f32(in), scale));
+    }
+
+    inline void storeQ31Product(float* out, int32x4_t x, int32x4_t gain) noexcept {
+        const int32x4_t y = vcombine_s32(vqrshrn_n_s64(vmull_s32(vget_low_s32(x), vget_low_s32(gain)), kQ31GainShift),
+                                         vqrshrn_n_s64(vmull_high_s32(x, gain), kQ31GainShift));
+        vst1q_f32(out, vcvtq_n_f32_s32(y, 31));
+    }
+
+    void neonQ31Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float32x4_t sampleScale = vdupq_n_f32(2147483648.0f);
+        const int32_t gainQ = q31Gain(gain);
+        const int32x4_t gainVector = vdupq_n_s32(gainQ);
+        reducedTransform<4>(in, out, count,
+                            [&](size_t i) { storeQ31Product(out + i, loadQ31(in + i, sampleScale), gainVector); },
+                            [=](float x, size_t) { return fromQ31(multiplyQ31(toQ31(x), gainQ)); });
+    }
+
+    void neonQ31Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        const float32x4_t sampleScale = vdupq_n_f32(2147483648.0f);
+        const float32x4_t gainScale = vdupq_n_f32(static_cast<float>(1 << kQ31GainShift));
+        reducedTransform<4>(in, out, count,
+                            [&](size_t i) {
+                                storeQ31Product(out + i, loadQ31(in + i, sampleScale), loadQ31(ramp + i, gainScale));
+                            },
+                            [=](float x, size_t i) { return fromQ31(multiplyQ31(toQ31(x), q31Gain(ramp[i]))); });
+    }
+
+#if defined(__ARM_FEATURE_FP16_VECTOR_ARITHMETIC)
+    // Float16 arithmetic (A11 and later, every Apple silicon Mac): eight samples per register
+    constexpr size_t kFloat16Lanes = 8;
+
+    inline float16x8_t loadFloat16(const float* in) noexcept {
+        return vcombine_f16(vcvt_f16_f32(vld1q_f32(in)), vcvt_f16_f32(vld1q_f32(in + 4)));
+    }
+
+    inline void storeFloat16(float* out, float16x8_t y) noexcept {
+        vst1q_f32(out, vcvt_f32_f16(vget_low_f16(y)));
+        vst1q_f32(out + 4, vcvt_high_f32_f16(y));
+    }
+
+    void neonFloat16Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float16x4_t gain16 = vcvt_f16_f32(vdupq_n_f32(gain));
+        const float16x8_t gainVector = vcombine_f16(gain16, gain16);
+        const float gainRounded = roundToFloat16(gain);
+        reducedTransform<kFloat16Lanes>(
+            in, out, count,
+            [&](size_t i) { storeFloat16(out + i, vmulq_f16(loadFloat16(in + i), gainVector)); },
+            [=](float x, size_t) { return multiplyFloat16(x, gainRounded); });
+    }
+
+    void neonFloat16Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        reducedTransform<kFloat16Lanes>(
+            in, out, count,
+            [&](size_t i) { storeFloat16(out + i, vmulq_f16(loadFloat16(in + i), loadFloat16(ramp + i))); },
+            [=](float x, size_t i) { return multiplyFloat16(x, roundToFloat16(ramp[i])); });
+    }
+#else
+    // Conversions only (earlier cores): round through binary16 around a binary32 multiply,
+    // which is exact for binary16 operands and so gives the same results
+    constexpr size_t kFloat16Lanes = 4;
+
+    inline float32x4_t roundToFloat16x4(float32x4_t value) noexcept {
+        return vcvt_f32_f16(vcvt_f16_f32(value));
+    }
+
+    inline float32x4_t multiplyFloat16x4(float32x4_t x, float32x4_t gain16) noexcept {
+        return roundToFloat16x4(vmulq_f32(roundToFloat16x4(x), gain16));
+    }
+
+    void neonFloat16Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const float gainRounded = roundToFloat16(gain);
+        const float32x4_t gainVector = vdupq_n_f32(gainRounded);
+        reducedTransform<kFloat16Lanes>(
+            in, out, count,
+            [&](size_t i) { vst1q_f32(out + i, multiplyFloat16x4(vld1q_f32(in + i), gainVector)); },
+            [=](float x, size_t) { return multiplyFloat16(x, gainRounded); });
+    }
+
+    void neonFloat16Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        reducedTransform<kFloat16Lanes>(
+            in, out, count,
+            [&](size_t i) {
+                vst1q_f32(out + i, multiplyFloat16x4(vld1q_f32(in + i), roundToFloat16x4(vld1q_f32(ramp + i))));
+            },
+            [=](float x, size_t i) { return multiplyFloat16(x, roundToFloat16(ramp[i])); });
+    }
+#endif
+
+    constexpr ReducedPrecisionBackend kNEONFloat16Backend = {
+        ProcessingPrecision::Float16, DSPBackendKind::NEON, "NEON", static_cast<int>(kFloat16Lanes),
+        neonFloat16Gain, neonFloat16Ramp
+    };
+    constexpr ReducedPrecisionBackend kNEONQ31Backend = {
+        ProcessingPrecision::Q31, DSPBackendKind::NEON, "NEON", 4, neonQ31Gain, neonQ31Ramp
+    };
+    constexpr ReducedPrecisionBackend kNEONQ15Backend = {
+        ProcessingPrecision::Q15, DSPBackendKind::NEON, "NEON", 8, neonQ15Gain, neonQ15Ramp
+    };
+}
+
+const DSPBackend* neonDSPBackend() noexcept {
+    return &kNEONBackend;
+}
+
+const ReducedPrecisionBackend* neonReducedPrecisionBackend(ProcessingPrecision precision) noexcept {
+    switch (precision) {
+        case ProcessingPrecision::Float32:
+            return nullptr;
+        case ProcessingPrecision::Float16:
+            return &kNEONFloat16Backend;
+        case ProcessingPrecision::Q31:
+            return &kNEONQ31Backend;
+        case ProcessingPrecision::Q15:
+            return &kNEONQ15Backend;
+    }
+    return nullptr;
+}
+
+#else
+
+const DSPBackend* neonDSPBackend() noexcept {
+    return nullptr;
+}
+
+const ReducedPrecisionBackend* neonReducedPrecisionBackend(ProcessingPrecision) noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,221 @@
+#include "DSPBackend.hpp"
+#include "DSPDenormals.hpp"
+
+#if defined(__x86_64__)
+    #include <immintrin.h>
+#endif
+
+// Version comments for external dependencies
+// x86_64 AVX2 (Haswell and later Intel Macs) and AVX-512F (Xeon W / Ice Lake Macs)
+// C++20 STL: Apple Clang 15.0+
+
+// Both tables are compiled with per-function target attributes, so this file needs
+// no special build flags and the code only runs after the CPU has been checked.
+
+namespace tald {
+namespace dsp {
+
+#if defined(__x86_64__)
+
+namespace {
+    inline float flushSample(float sample) noexcept {
+        return (__builtin_fabsf(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+    }
+
+    // MARK: AVX2
+
+    #define TALD_AVX2 __attribute__((target("avx2")))
+
+    constexpr size_t kAVX2Lanes = 8;
+    constexpr size_t kAVX2Step = kAVX2Lanes * 4;
+
+    TALD_AVX2 inline __m256 flushAVX2(__m256 value, __m256 threshold, __m256 absMask) noexcept {
+        const __m256 tiny = _mm256_cmp_ps(_mm256_and_ps(value, absMask), threshold, _CMP_LT_OQ);
+        return _mm256_andnot_ps(tiny, value);
+    }
+
+    /**
+     * @brief Loop skeleton: four vectors per iteration, then single vectors, then a scalar tail
+     */
+    template <typename VectorOp, typename ScalarOp>
+    TALD_AVX2 inline void transformAVX2(const float* in, float* out, size_t count,
+                                        VectorOp vectorOp, ScalarOp scalarOp) noexcept {
+        size_t i = 0;
+        for (; i + kAVX2Step <= count; i += kAVX2Step) {
+            const __m256 a = _mm256_loadu_ps(in + i);
+            const __m256 b = _mm256_loadu_ps(in + i + 8);
+            const __m256 c = _mm256_loadu_ps(in + i + 16);
+            const __m256 d = _mm256_loadu_ps(in + i + 24);
+            _mm256_storeu_ps(out + i, vectorOp(a, i));
+            _mm256_storeu_ps(out + i + 8, vectorOp(b, i + 8));
+            _mm256_storeu_ps(out + i + 16, vectorOp(c, i + 16));
+            _mm256_storeu_ps(out + i + 24, vectorOp(d, i + 24));
+        }
+        for (; i + kAVX2Lanes <= count; i += kAVX2Lanes) {
+            _mm256_storeu_ps(out + i, vectorOp(_mm256_loadu_ps(in + i), i));
+        }
+        for (; i < count; ++i) {
+            out[i] = scalarOp(in[i], i);
+        }
+    }
+
+    TALD_AVX2 void avx2Flush(const float* in, float* out, size_t count) noexcept {
+        const __m256 threshold = _mm256_set1_ps(DENORMAL_THRESHOLD);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        transformAVX2(in, out, count,
+                      [&](__m256 x, size_t) TALD_AVX2 { return flushAVX2(x, threshold, absMask); },
+                      [](float x, size_t) { return flushSample(x); });
+    }
+
+    TALD_AVX2 void avx2Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const __m256 scale = _mm256_set1_ps(gain);
+        transformAVX2(in, out, count,
+                      [&](__m256 x, size_t) TALD_AVX2 { return _mm256_mul_ps(x, scale); },
+                      [=](float x, size_t) { return x * gain; });
+    }
+
+    TALD_AVX2 void avx2GainFlush(const float* in, float* out, size_t count, float gain) noexcept {
+        const __m256 scale = _mm256_set1_ps(gain);
+        const __m256 threshold = _mm256_set1_ps(DENORMAL_THRESHOLD);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        transformAVX2(in, out, count,
+                      [&](__m256 x, size_t) TALD_AVX2 { return flushAVX2(_mm256_mul_ps(x, scale), threshold, absMask); },
+                      [=](float x, size_t) { return flushSample(x * gain); });
+    }
+
+    TALD_AVX2 void avx2Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        transformAVX2(in, out, count,
+                      [=](__m256 x, size_t i) TALD_AVX2 { return _mm256_mul_ps(x, _mm256_loadu_ps(ramp + i)); },
+                      [=](float x, size_t i) { return x * ramp[i]; });
+    }
+
+    TALD_AVX2 void avx2RampFlush(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        const __m256 threshold = _mm256_set1_ps(DENORMAL_THRESHOLD);
+        const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+        transformAVX2(in, out, count,
+                      [&](__m256 x, size_t i) TALD_AVX2 {
+                          return flushAVX2(_mm256_mul_ps(x, _mm256_loadu_ps(ramp + i)), threshold, absMask);
+                      },
+                      [=](float x, size_t i) { return flushSample(x * ramp[i]); });
+    }
+
+    TALD_AVX2 void avx2Accumulate(const float* in, float* sum, size_t count) noexcept {
+        transformAVX2(in, sum, count,
+                      [=](__m256 x, size_t i) TALD_AVX2 { return _mm256_add_ps(_mm256_loadu_ps(sum + i), x); },
+                      [=](float x, size_t i) { return sum[i] + x; });
+    }
+
+    constexpr DSPBackend kAVX2Backend = {
+        DSPBackendKind::AVX2, "AVX2", static_cast<int>(kAVX2Lanes),
+        avx2Flush, avx2Gain, avx2GainFlush, avx2Ramp, avx2RampFlush, avx2Accumulate
+    };
+
+    // MARK: AVX-512
+
+    #define TALD_AVX512 __attribute__((target("avx512f")))
+
+    constexpr size_t kAVX512Lanes = 16;
+    constexpr size_t kAVX512Step = kAVX512Lanes * 2;
+
+    TALD_AVX512 inline __m512 flushAVX512(__m512 value, __m512 threshold) noexcept {
+        const __mmask16 tiny = _mm512_cmp_ps_mask(_mm512_abs_ps(value), threshold, _CMP_LT_OQ);
+        return _mm512_maskz_mov_ps(static_cast<__mmask16>(~tiny), value);
+    }
+
+    /**
+     * @brief Loop skeleton: two vectors per iteration, then single vectors, then one masked tail
+     *
+     * Masked loads and stores finish the run without a scalar loop; masked-off lanes
+     * are never read or written. Op receives the tail mask for loads of its own.
+     */
+    template <typename VectorOp>
+    TALD_AVX512 inline void transformAVX512(const float* in, float* out, size_t count, VectorOp vectorOp) noexcept {
+        const __mmask16 all = 0xffff;
+        size_t i = 0;
+        for (; i + kAVX512Step <= count; i += kAVX512Step) {
+            const __m512 a = _mm512_loadu_ps(in + i);
+            const __m512 b = _mm512_loadu_ps(in + i + 16);
+            _mm512_storeu_ps(out + i, vectorOp(a, i, all));
+            _mm512_storeu_ps(out + i + 16, vectorOp(b, i + 16, all));
+        }
+        for (; i + kAVX512Lanes <= count; i += kAVX512Lanes) {
+            _mm512_storeu_ps(out + i, vectorOp(_mm512_loadu_ps(in + i), i, all));
+        }
+        if (i < count) {
+            const __mmask16 tail = static_cast<__mmask16>((1u << (count - i)) - 1u);
+            _mm512_mask_storeu_ps(out + i, tail, vectorOp(_mm512_maskz_loadu_ps(tail, in + i), i, tail));
+        }
+    }
+
+    TALD_AVX512 void avx512Flush(const float* in, float* out, size_t count) noexcept {
+        const __m512 threshold = _mm512_set1_ps(DENORMAL_THRESHOLD);
+        transformAVX512(in, out, count, [&](__m512 x, size_t, __mmask16) TALD_AVX512 {
+            return flushAVX512(x, threshold);
+        });
+    }
+
+    TALD_AVX512 void avx512Gain(const float* in, float* out, size_t count, float gain) noexcept {
+        const __m512 scale = _mm512_set1_ps(gain);
+        transformAVX512(in, out, count, [&](__m512 x, size_t, __mmask16) TALD_AVX512 {
+            return _mm512_mul_ps(x, scale);
+        });
+    }
+
+    TALD_AVX512 void avx512GainFlush(const float* in, float* out, size_t count, float gain) noexcept {
+        const __m512 scale = _mm512_set1_ps(gain);
+        const __m512 threshold = _mm512_set1_ps(DENORMAL_THRESHOLD);
+        transformAVX512(in, out, count, [&](__m512 x, size_t, __mmask16) TALD_AVX512 {
+            return flushAVX512(_mm512_mul_ps(x, scale), threshold);
+        });
+    }
+
+    TALD_AVX512 void avx512Ramp(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        transformAVX512(in, out, count, [=](__m512 x, size_t i, __mmask16 mask) TALD_AVX512 {
+            return _mm512_mul_ps(x, _mm512_maskz_loadu_ps(mask, ramp + i));
+        });
+    }
+
+    TALD_AVX512 void avx512RampFlush(const float* in, float* out, const float* ramp, size_t count) noexcept {
+        const __m512 threshold = _mm512_set1_ps(DENORMAL_THRESHOLD);
+        transformAVX512(in, out, count, [&](__m512 x, size_t i, __mmask16 mask) TALD_AVX512 {
+            return flushAVX512(_mm512_mul_ps(x, _mm512_maskz_loadu_ps(mask, ramp + i)), threshold);
+        });
+    }
+
+    TALD_AVX512 void avx512Accumulate(const float* in, float* sum, size_t count) noexcept {
+        transformAVX512(in, sum, count, [=](__m512 x, size_t i, __mmask16 mask) TALD_AVX512 {
+            return _mm512_add_ps(_mm512_maskz_loadu_ps(mask, sum + i), x);
+        });
+    }
+
+    constexpr DSPBackend kAVX512Backend = {
+        DSPBackendKind::AVX512, "AVX-512", static_cast<int>(kAVX512Lanes),
+        avx512Flush, avx512Gain, avx512GainFlush, avx512Ramp, avx512RampFlush, avx512Accumulate
+    };
+
+    #undef TALD_AVX2
+    #undef TALD_AVX512
+}
+
+const DSPBackend* avx2DSPBackend() noexcept {
+    return &kAVX2Backend;
+}
+
+const DSPBackend* avx512DSPBackend() noexcept {
+    return &kAVX512Backend;
+}
+
+#else
+
+const DSPBackend* avx2DSPBackend() noexcept {
+    return nullptr;
+}
+
+const DSPBackend* avx512DSPBackend() noexcept {
+    return nullptr;
+}
+
+#endif
+
+} // namespace dsp
+} // namespace tald
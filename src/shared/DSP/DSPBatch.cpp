@@ -0,0 +1,132 @@
+#include "DSPBatch.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Blocks handed to processBatch() at once when splitting strided streams
+    constexpr size_t kStridedBatchBlocks = 16;
+}
+
+/**
+ * @brief One task per contiguous range of streams
+ */
+class DSPBatchRenderer::Tasks final : public DSPTaskSet {
+public:
+    explicit Tasks(std::vector<std::unique_ptr<DSPKernel>>& participantKernels) noexcept
+        : kernels(participantKernels) {}
+
+    void runTask(uint32_t task, DSPWorkerContext& context) noexcept override {
+        const size_t begin = static_cast<size_t>(task) * streamsPerTask;
+        renderRange(context.participant(), begin, std::min(begin + streamsPerTask, streamCount));
+    }
+
+    void renderRange(int participant, size_t begin, size_t end) noexcept {
+        DSPKernel& kernel = *kernels[static_cast<size_t>(participant)];
+        for (size_t stream = begin; stream < end; ++stream) {
+            kernel.restartStream();
+            if (streams) {
+                kernel.processBatch(streams[stream].blocks, streams[stream].blockCount);
+            }
+            else {
+                renderStrided(kernel, stream);
+            }
+        }
+    }
+
+    // Either streams or the strided description is set for one render
+    const DSPBatchStream* streams = nullptr;
+    const float* stridedInput = nullptr;
+    float* stridedOutput = nullptr;
+    size_t frameCount = 0;
+    size_t streamStride = 0;
+
+    size_t streamCount = 0;
+    size_t streamsPerTask = 1;
+
+private:
+    std::vector<std::unique_ptr<DSPKernel>>& kernels;
+
+    void renderStrided(DSPKernel& kernel, size_t stream) const noexcept {
+        const int channels = kernel.channelCount();
+        const size_t blockFrames = kernel.maximumFramesPerBlock();
+        float* input = const_cast<float*>(stridedInput) + stream * streamStride;
+        float* output = stridedOutput + stream * streamStride;
+
+        DSPBatchItem items[kStridedBatchBlocks];
+        size_t frame = 0;
+        while (frame < frameCount) {
+            size_t itemCount = 0;
+            for (; itemCount < kStridedBatchBlocks && frame < frameCount; ++itemCount) {
+                const size_t frames = std::min(blockFrames, frameCount - frame);
+                const size_t offset = frame * static_cast<size_t>(channels);
+                items[itemCount].input = AudioBufferView::makeInterleaved(input + offset, channels, frames);
+                items[itemCount].output = AudioBufferView::makeInterleaved(output + offset, channels, frames);
+                frame += frames;
+            }
+            kernel.processBatch(items, itemCount);
+        }
+    }
+};
+
+DSPBatchRenderer::DSPBatchRenderer(const DSPKernel& prototype, DSPWorkerPool* workerPool)
+    : pool(workerPool)
+{
+    const int participants = pool ? pool->workerCount() + 1 : 1;
+    kernels.reserve(static_cast<size_t>(participants));
+    for (int participant = 0; participant < participants; ++participant) {
+        std::unique_ptr<DSPKernel> kernel = prototype.fork();
+        if (!kernel) {
+            throw std::runtime_error("Failed to fork batch kernel");
+        }
+        kernels.push_back(std::move(kernel));
+    }
+    tasks = std::make_unique<Tasks>(kernels);
+    for (size_t task = 0; task < MAX_DSP_TASKS; ++task) {
+        roots[task] = static_cast<uint32_t>(task);
+    }
+}
+
+DSPBatchRenderer::~DSPBatchRenderer() = default;
+
+void DSPBatchRenderer::render(const DSPBatchStream* streams, size_t streamCount) noexcept {
+    if (!streams || streamCount == 0) {
+        return;
+    }
+    tasks->streams = streams;
+    dispatch(streamCount);
+}
+
+void DSPBatchRenderer::renderInterleaved(const float* input, float* output, size_t streamCount,
+                                         size_t frameCount, size_t streamStride) noexcept {
+    if (!input || !output || streamCount == 0 || frameCount == 0) {
+        return;
+    }
+    tasks->streams = nullptr;
+    tasks->stridedInput = input;
+    tasks->stridedOutput = output;
+    tasks->frameCount = frameCount;
+    tasks->streamStride = streamStride;
+    dispatch(streamCount);
+}
+
+void DSPBatchRenderer::dispatch(size_t streamCount) noexcept {
+    tasks->streamCount = streamCount;
+    if (!pool || pool->workerCount() == 0) {
+        tasks->renderRange(0, 0, streamCount);
+        return;
+    }
+
+    // One stream per task up to the deque capacity; beyond that, equal contiguous ranges
+    tasks->streamsPerTask = (streamCount + MAX_DSP_TASKS - 1) / MAX_DSP_TASKS;
+    const size_t taskCount = (streamCount + tasks->streamsPerTask - 1) / tasks->streamsPerTask;
+    pool->run(*tasks, roots, taskCount);
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,92 @@
+//
+// DSPBatch.hpp
+// TALD UNIA Audio System
+//
+// Offline rendering of many independent streams (stems, voices) through one
+// processing chain, optionally spread across a DSPWorkerPool.
+//
+
+#ifndef TALD_UNIA_DSP_BATCH_HPP
+#define TALD_UNIA_DSP_BATCH_HPP
+
+#include <cstddef>     // C++20
+#include <memory>      // C++20
+#include <vector>      // C++20
+#include "DSPKernel.hpp"
+#include "DSPWorkerPool.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief One independent stream: its blocks in order, each no longer than maxFrames
+ */
+struct DSPBatchStream {
+    const DSPBatchItem* blocks;
+    size_t blockCount;
+};
+
+/**
+ * @brief Renders independent streams through forks of a prototype kernel
+ *
+ * Every participant of the pool (the calling thread plus each worker) owns one fork,
+ * created up front, and renders whole streams with processBatch(). Each stream
+ * starts from cleared signal history at the prototype's parameter values, so the
+ * result does not depend on which thread picked it up or on what it rendered before.
+ * Construction and destruction are control-thread work; render() neither allocates
+ * nor locks. Parameters changed on the prototype afterwards are not seen.
+ */
+class DSPBatchRenderer {
+public:
+    /**
+     * @param prototype Kernel whose configuration and current parameters every stream uses
+     * @param pool Worker pool to spread streams across, or null to render on the calling thread
+     * @throws std::runtime_error if a fork cannot be created
+     */
+    explicit DSPBatchRenderer(const DSPKernel& prototype, DSPWorkerPool* pool = nullptr);
+    ~DSPBatchRenderer();
+
+    DSPBatchRenderer(const DSPBatchRenderer&) = delete;
+    DSPBatchRenderer& operator=(const DSPBatchRenderer&) = delete;
+
+    /**
+     * @brief Render every stream; returns when all are finished
+     *
+     * Streams must not share output buffers. Not re-entrant.
+     */
+    void render(const DSPBatchStream* streams, size_t streamCount) noexcept;
+
+    /**
+     * @brief Render equally long interleaved streams laid out at a fixed stride
+     * @param input First sample of stream 0; stream s starts at input + s * streamStride
+     * @param output Same layout as input (may equal input)
+     * @param streamCount Number of streams
+     * @param frameCount Frames per stream, any length; split into maxFrames blocks
+     * @param streamStride Floats between the starts of consecutive streams
+     */
+    void renderInterleaved(const float* input, float* output, size_t streamCount,
+                           size_t frameCount, size_t streamStride) noexcept;
+
+    /**
+     * @brief Threads that render at once, the caller included
+     */
+    [[nodiscard]]
+    int participantCount() const noexcept {
+        return static_cast<int>(kernels.size());
+    }
+
+private:
+    class Tasks;
+
+    DSPWorkerPool* pool;
+    std::vector<std::unique_ptr<DSPKernel>> kernels;   // Indexed by pool participant
+    std::unique_ptr<Tasks> tasks;
+    uint32_t roots[MAX_DSP_TASKS];
+
+    void dispatch(size_t streamCount) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_BATCH_HPP
@@ -0,0 +1,310 @@
+#include "DSPBenchmark.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include "DSPBackend.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    const char* layoutName(BufferLayout layout) noexcept {
+        return layout == BufferLayout::Planar ? "planar" : "interleaved";
+    }
+
+    const char* modeName(BenchmarkMode mode) noexcept {
+        switch (mode) {
+            case BenchmarkMode::Unity: return "unity";
+            case BenchmarkMode::Gain: return "gain";
+            case BenchmarkMode::Ramp: return "ramp";
+            case BenchmarkMode::Bypass: return "bypass";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Bytes the kernel moves per sample in each mode, host buffers included
+     *
+     * Every mode reads the input and writes the output once. Ramps also write one
+     * gain value per frame to the ramp buffer and read it back once per channel.
+     */
+    double modeledBytesPerSample(const BenchmarkCase& testCase) noexcept {
+        const double hostTraffic = 2.0 * sizeof(float);
+        if (testCase.mode != BenchmarkMode::Ramp) {
+            return hostTraffic;
+        }
+        return hostTraffic + sizeof(float) + sizeof(float) / static_cast<double>(testCase.channels);
+    }
+
+    struct AlignedSamples {
+        float* data;
+        explicit AlignedSamples(size_t count)
+            : data(static_cast<float*>(alignedMalloc(count * sizeof(float), CACHE_LINE_SIZE))) {
+            if (!data) {
+                throw std::runtime_error("Failed to allocate benchmark buffers");
+            }
+        }
+        ~AlignedSamples() {
+            alignedFree(data);
+        }
+        AlignedSamples(const AlignedSamples&) = delete;
+        AlignedSamples& operator=(const AlignedSamples&) = delete;
+    };
+
+    void appendNumber(std::string& out, double value) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.6g", std::isfinite(value) ? value : 0.0);
+        out += buffer;
+    }
+
+    void appendField(std::string& out, const char* key, double value, bool last = false) {
+        out += "      \"";
+        out += key;
+        out += "\": ";
+        appendNumber(out, value);
+        out += last ? "\n" : ",\n";
+    }
+
+    void appendField(std::string& out, const char* key, const std::string& value, bool last = false) {
+        out += "      \"";
+        out += key;
+        out += "\": \"";
+        out += value;
+        out += last ? "\"\n" : "\",\n";
+    }
+
+    double measureAddChain() noexcept {
+        constexpr uint64_t kIterations = 1u << 20;
+        constexpr double kAddsPerIteration = 16.0;
+        uint64_t value = 0;
+
+        // Register doubling rather than add-immediate, which newer x86 renamers fold away
+        const uint64_t start = mach_absolute_time();
+        for (uint64_t i = 0; i < kIterations; ++i) {
+#if defined(__aarch64__) || defined(__arm64__)
+            __asm__ __volatile__(".rept 16\n\tadd %0, %0, %0\n\t.endr" : "+r"(value));
+#elif defined(__x86_64__)
+            __asm__ __volatile__(".rept 16\n\taddq %0, %0\n\t.endr" : "+r"(value));
+#else
+            return 0.0;
+#endif
+        }
+        const double elapsedNs = static_cast<double>(mach_absolute_time() - start) * hostTicksToNanoseconds();
+        return elapsedNs > 0.0 ? static_cast<double>(kIterations) * kAddsPerIteration / elapsedNs : 0.0;
+    }
+}
+
+std::string BenchmarkCase::name() const {
+    char buffer[160];
+    std::snprintf(buffer, sizeof(buffer), "DSPKernel/process/frames:%zu/channels:%d/rate:%.0f/layout:%s/mode:%s",
+                  frames, channels, sampleRate, layoutName(layout), modeName(mode));
+    return buffer;
+}
+
+BenchmarkSweep BenchmarkSweep::full() {
+    BenchmarkSweep sweep;
+    for (size_t frames = MIN_BUFFER_SIZE; frames <= MAX_BUFFER_SIZE; frames *= 2) {
+        sweep.frames.push_back(frames);
+    }
+    sweep.channels = { 1, 2, 4, 6, MAX_CHANNELS };
+    sweep.sampleRates = { MIN_SAMPLE_RATE, 48000.0, 96000.0, 192000.0, MAX_SAMPLE_RATE };
+    sweep.layouts = { BufferLayout::Planar, BufferLayout::Interleaved };
+    sweep.modes = { BenchmarkMode::Unity, BenchmarkMode::Gain, BenchmarkMode::Ramp, BenchmarkMode::Bypass };
+    return sweep;
+}
+
+std::vector<BenchmarkCase> BenchmarkSweep::cartesian() const {
+    std::vector<BenchmarkCase> cases;
+    for (size_t frameCount : frames) {
+        for (int channelCount : channels) {
+            for (double rate : sampleRates) {
+                for (BufferLayout layout : layouts) {
+                    for (BenchmarkMode mode : modes) {
+                        cases.push_back({ frameCount, channelCount, rate, layout, mode });
+                    }
+                }
+            }
+        }
+    }
+    return cases;
+}
+
+std::vector<BenchmarkCase> BenchmarkSweep::axes(const BenchmarkCase& baseline) const {
+    std::vector<BenchmarkCase> cases;
+    auto add = [&cases](const BenchmarkCase& testCase) {
+        const bool seen = std::any_of(cases.begin(), cases.end(), [&](const BenchmarkCase& existing) {
+            return existing.frames == testCase.frames && existing.channels == testCase.channels &&
+                existing.sampleRate == testCase.sampleRate && existing.layout == testCase.layout &&
+                existing.mode == testCase.mode;
+        });
+        if (!seen) {
+            cases.push_back(testCase);
+        }
+    };
+
+    for (BufferLayout layout : layouts) {
+        for (BenchmarkMode mode : modes) {
+            BenchmarkCase testCase = baseline;
+            testCase.layout = layout;
+            testCase.mode = mode;
+            add(testCase);
+        }
+    }
+    for (size_t frameCount : frames) {
+        BenchmarkCase testCase = baseline;
+        testCase.frames = frameCount;
+        add(testCase);
+    }
+    for (int channelCount : channels) {
+        BenchmarkCase testCase = baseline;
+        testCase.channels = channelCount;
+        add(testCase);
+    }
+    for (double rate : sampleRates) {
+        BenchmarkCase testCase = baseline;
+        testCase.sampleRate = rate;
+        add(testCase);
+    }
+    return cases;
+}
+
+double estimatedCyclesPerNanosecond() noexcept {
+    // Best of several runs: the first ones may execute before the core has clocked up
+    static const double estimate = [] {
+        double best = 0.0;
+        for (int run = 0; run < 5; ++run) {
+            best = std::max(best, measureAddChain());
+        }
+        return best;
+    }();
+    return estimate;
+}
+
+BenchmarkResult runKernelBenchmark(const BenchmarkCase& testCase, const BenchmarkOptions& options) {
+    auto kernel = createDSPKernel(testCase.sampleRate, testCase.channels);
+    if (testCase.frames == 0 || testCase.frames > MAX_BUFFER_SIZE) {
+        throw std::invalid_argument("Benchmark frame count out of valid range");
+    }
+
+    const size_t samples = testCase.frames * static_cast<size_t>(testCase.channels);
+    AlignedSamples input(samples);
+    AlignedSamples output(samples);
+    for (size_t i = 0; i < samples; ++i) {
+        input.data[i] = static_cast<float>(std::sin(2.0 * M_PI * 1000.0 * static_cast<double>(i) / testCase.sampleRate));
+    }
+
+    float* inputPlanes[MAX_CHANNELS];
+    float* outputPlanes[MAX_CHANNELS];
+    for (int channel = 0; channel < testCase.channels; ++channel) {
+        inputPlanes[channel] = input.data + channel * testCase.frames;
+        outputPlanes[channel] = output.data + channel * testCase.frames;
+    }
+    const bool planar = testCase.layout == BufferLayout::Planar;
+    const AudioBufferView source = planar
+        ? AudioBufferView::makePlanar(inputPlanes, testCase.channels, testCase.frames)
+        : AudioBufferView::makeInterleaved(input.data, testCase.channels, testCase.frames);
+    const AudioBufferView destination = planar
+        ? AudioBufferView::makePlanar(outputPlanes, testCase.channels, testCase.frames)
+        : AudioBufferView::makeInterleaved(output.data, testCase.channels, testCase.frames);
+
+    ParameterEvent event;
+    event.parameterID = kParameterGain;
+    event.value = -6.0f;
+    event.rampFrames = 1;
+    if (testCase.mode == BenchmarkMode::Gain) {
+        kernel->scheduleParameter(event);
+    }
+    else if (testCase.mode == BenchmarkMode::Bypass) {
+        kernel->setBypassed(true);
+    }
+    event.rampFrames = static_cast<uint32_t>(testCase.frames);
+
+    // Ramp mode starts a fresh block-long ramp each block, alternating targets
+    uint64_t block = 0;
+    auto processBlocks = [&](uint64_t count) {
+        const uint64_t start = mach_absolute_time();
+        for (uint64_t i = 0; i < count; ++i, ++block) {
+            if (testCase.mode == BenchmarkMode::Ramp) {
+                event.value = (block & 1u) ? -6.0f : -12.0f;
+                kernel->scheduleParameter(event);
+            }
+            kernel->process(source, destination);
+        }
+        return static_cast<double>(mach_absolute_time() - start) * hostTicksToNanoseconds();
+    };
+
+    // Warm caches and settle the gain, then grow the iteration count to the time budget
+    processBlocks(8);
+    const double minNs = options.minSecondsPerRepetition * 1.0e9;
+    uint64_t iterations = 1;
+    while (processBlocks(iterations) < minNs && iterations < (1u << 24)) {
+        iterations *= 2;
+    }
+
+    std::vector<double> perBlock;
+    for (int repetition = 0; repetition < std::max(options.repetitions, 1); ++repetition) {
+        perBlock.push_back(processBlocks(iterations) / static_cast<double>(iterations));
+    }
+    std::sort(perBlock.begin(), perBlock.end());
+
+    BenchmarkResult result;
+    result.testCase = testCase;
+    result.iterations = iterations;
+    result.nsPerBlock = perBlock[perBlock.size() / 2];
+    result.nsPerSample = result.nsPerBlock / static_cast<double>(samples);
+    result.cyclesPerSample = result.nsPerSample * estimatedCyclesPerNanosecond();
+    result.bytesPerSample = modeledBytesPerSample(testCase);
+    result.realtimeFactor = (static_cast<double>(testCase.frames) * 1.0e9 / testCase.sampleRate) / result.nsPerBlock;
+    return result;
+}
+
+std::string benchmarkResultsJSON(const std::vector<BenchmarkResult>& results) {
+    char date[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", std::localtime(&now));
+
+    std::string out = "{\n  \"context\": {\n";
+    appendField(out, "date", std::string(date));
+    appendField(out, "executable", std::string("TALDUnia DSPKernel"));
+    appendField(out, "dsp_backend", std::string(activeDSPBackend().name));
+    appendField(out, "num_cpus", static_cast<double>(std::thread::hardware_concurrency()));
+    appendField(out, "mhz_per_cpu", estimatedCyclesPerNanosecond() * 1000.0);
+#if defined(NDEBUG)
+    appendField(out, "library_build_type", std::string("release"), true);
+#else
+    appendField(out, "library_build_type", std::string("debug"), true);
+#endif
+    out += "  },\n  \"benchmarks\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        const double samplesPerSecond = result.nsPerSample > 0.0 ? 1.0e9 / result.nsPerSample : 0.0;
+        out += "    {\n";
+        appendField(out, "name", result.testCase.name());
+        appendField(out, "run_type", std::string("iteration"));
+        appendField(out, "iterations", static_cast<double>(result.iterations));
+        appendField(out, "real_time", result.nsPerBlock);
+        appendField(out, "cpu_time", result.nsPerBlock);
+        appendField(out, "time_unit", std::string("ns"));
+        appendField(out, "ns_per_sample", result.nsPerSample);
+        appendField(out, "cycles_per_sample", result.cyclesPerSample);
+        appendField(out, "bytes_per_sample", result.bytesPerSample);
+        appendField(out, "bytes_per_second", result.bytesPerSample * samplesPerSecond);
+        appendField(out, "items_per_second", samplesPerSecond);
+        appendField(out, "realtime_factor", result.realtimeFactor, true);
+        out += (i + 1 < results.size()) ? "    },\n" : "    }\n";
+    }
+    out += "  ]\n}\n";
+    return out;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,127 @@
+//
+// DSPBenchmark.hpp
+// TALD UNIA Audio System
+//
+// Microbenchmark harness for the DSP kernels: parameter sweeps, calibrated timing and
+// Google Benchmark compatible JSON so results can be tracked across changes.
+//
+
+#ifndef TALD_UNIA_DSP_BENCHMARK_HPP
+#define TALD_UNIA_DSP_BENCHMARK_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <string>      // C++20
+#include <vector>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Processing state a benchmark case exercises
+ */
+enum class BenchmarkMode : uint8_t {
+    Unity,   // Gain settled at 0 dB
+    Gain,    // Gain settled at a constant non-unity value
+    Ramp,    // A new gain ramp spanning every block
+    Bypass   // Bypassed copy-through
+};
+
+/**
+ * @brief One point of a benchmark sweep
+ */
+struct BenchmarkCase {
+    size_t frames = 256;
+    int channels = 2;
+    double sampleRate = DEFAULT_SAMPLE_RATE;
+    BufferLayout layout = BufferLayout::Planar;
+    BenchmarkMode mode = BenchmarkMode::Gain;
+
+    /**
+     * @brief Google Benchmark style name, e.g. "DSPKernel/process/frames:256/channels:2/..."
+     */
+    [[nodiscard]]
+    std::string name() const;
+};
+
+/**
+ * @brief Timing for one case, normalized per processed sample (frames x channels)
+ */
+struct BenchmarkResult {
+    BenchmarkCase testCase;
+    uint64_t iterations = 0;        // Blocks timed per repetition
+    double nsPerBlock = 0.0;        // Median over repetitions
+    double nsPerSample = 0.0;
+    double cyclesPerSample = 0.0;   // nsPerSample x estimated core clock
+    double bytesPerSample = 0.0;    // Modeled memory traffic of the kernel for this mode
+    double realtimeFactor = 0.0;    // Block duration / processing time
+};
+
+/**
+ * @brief Values for each swept dimension
+ */
+struct BenchmarkSweep {
+    std::vector<size_t> frames;
+    std::vector<int> channels;
+    std::vector<double> sampleRates;
+    std::vector<BufferLayout> layouts;
+    std::vector<BenchmarkMode> modes;
+
+    /**
+     * @brief Every dimension at every value: 64...MAX_BUFFER_SIZE, 1...MAX_CHANNELS,
+     *        44.1...384 kHz, both layouts, all modes
+     */
+    [[nodiscard]]
+    static BenchmarkSweep full();
+
+    /**
+     * @brief Cartesian product of all dimensions
+     */
+    [[nodiscard]]
+    std::vector<BenchmarkCase> cartesian() const;
+
+    /**
+     * @brief Each dimension varied on its own around baseline, plus every layout and
+     *        mode pair at baseline; covers the sweep at a fraction of the cartesian cost
+     */
+    [[nodiscard]]
+    std::vector<BenchmarkCase> axes(const BenchmarkCase& baseline = BenchmarkCase()) const;
+};
+
+/**
+ * @brief Measurement settings
+ */
+struct BenchmarkOptions {
+    double minSecondsPerRepetition = 0.02;  // Iterations grow until a repetition lasts this long
+    int repetitions = 5;                    // Median is reported
+};
+
+/**
+ * @brief Estimated core cycles per nanosecond, from a chain of dependent adds
+ *
+ * Measured once and cached. Dependent integer adds retire one per cycle on every
+ * supported core, so this tracks the clock the benchmark actually ran at, where
+ * user space has no cycle counter (Apple silicon).
+ */
+[[nodiscard]]
+double estimatedCyclesPerNanosecond() noexcept;
+
+/**
+ * @brief Time createDSPKernel() / process() for one case
+ * @throws std::invalid_argument for cases the kernel rejects
+ */
+[[nodiscard]]
+BenchmarkResult runKernelBenchmark(const BenchmarkCase& testCase,
+                                   const BenchmarkOptions& options = BenchmarkOptions());
+
+/**
+ * @brief Results as Google Benchmark JSON ("context" and "benchmarks" with per-sample counters)
+ */
+[[nodiscard]]
+std::string benchmarkResultsJSON(const std::vector<BenchmarkResult>& results);
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_BENCHMARK_HPP
@@ -0,0 +1,112 @@
+#ifndef TALD_UNIA_DSP_BUFFER_LAYOUT_HPP
+#define TALD_UNIA_DSP_BUFFER_LAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Memory layout of a multi-channel audio buffer
+ */
+enum class BufferLayout : uint8_t {
+    Interleaved,  // L R L R ...: one pointer, frame-major
+    Planar        // LLLL RRRR: one pointer per channel (AudioBufferList style)
+};
+
+/**
+ * @brief Non-owning view of a multi-channel buffer in either layout
+ *
+ * Planar views hold one pointer per channel, which need not be contiguous, so an
+ * AudioBufferList from a non-interleaved render callback maps onto it directly.
+ */
+struct AudioBufferView {
+    BufferLayout layout = BufferLayout::Planar;
+    int channels = 0;
+    size_t frames = 0;
+    float* interleaved = nullptr;     // Interleaved layout only
+    float* const* planes = nullptr;   // Planar layout only, `channels` entries
+
+    [[nodiscard]]
+    static AudioBufferView makeInterleaved(float* data, int channelCount, size_t frameCount) noexcept {
+        AudioBufferView view;
+        view.layout = BufferLayout::Interleaved;
+        view.channels = channelCount;
+        view.frames = frameCount;
+        view.interleaved = data;
+        return view;
+    }
+
+    [[nodiscard]]
+    static AudioBufferView makePlanar(float* const* channelData, int channelCount, size_t frameCount) noexcept {
+        AudioBufferView view;
+        view.layout = BufferLayout::Planar;
+        view.channels = channelCount;
+        view.frames = frameCount;
+        view.planes = channelData;
+        return view;
+    }
+
+    [[nodiscard]]
+    bool isValid() const noexcept {
+        if (channels <= 0 || frames == 0) {
+            return false;
+        }
+        if (layout == BufferLayout::Interleaved) {
+            return interleaved != nullptr;
+        }
+        if (!planes) {
+            return false;
+        }
+        for (int channel = 0; channel < channels; ++channel) {
+            if (!planes[channel]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Whether two views address the same samples in the same layout
+     */
+    [[nodiscard]]
+    bool aliases(const AudioBufferView& other) const noexcept {
+        if (layout != other.layout || channels != other.channels) {
+            return false;
+        }
+        if (layout == BufferLayout::Interleaved) {
+            return interleaved == other.interleaved;
+        }
+        for (int channel = 0; channel < channels; ++channel) {
+            if (planes[channel] != other.planes[channel]) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+/**
+ * @brief Copy samples between two views of the same layout
+ * @param source Source view
+ * @param destination Destination view
+ * @param frameCount Frames to copy
+ */
+inline void copyBufferView(const AudioBufferView& source, const AudioBufferView& destination,
+                           size_t frameCount) noexcept {
+    if (source.layout == BufferLayout::Interleaved) {
+        std::memcpy(destination.interleaved, source.interleaved,
+                    frameCount * static_cast<size_t>(source.channels) * sizeof(float));
+        return;
+    }
+    for (int channel = 0; channel < source.channels; ++channel) {
+        std::memcpy(destination.planes[channel], source.planes[channel], frameCount * sizeof(float));
+    }
+}
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_BUFFER_LAYOUT_HPP
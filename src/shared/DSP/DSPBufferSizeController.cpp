@@ -0,0 +1,116 @@
+#include "DSPBufferSizeController.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+BufferSizeController::BufferSizeController(DSPBlockMetrics& metrics, double sampleRate, size_t initialFrames,
+                                           const BufferSizePolicy& policy)
+    : metrics(metrics)
+    , sampleRate(sampleRate)
+    , limits(policy)
+    , frames(0)
+{
+    if (sampleRate < MIN_SAMPLE_RATE || sampleRate > MAX_SAMPLE_RATE) {
+        throw std::invalid_argument("Sample rate out of valid range");
+    }
+    if (!std::has_single_bit(policy.minimumFrames) || !std::has_single_bit(policy.maximumFrames) ||
+        policy.minimumFrames < MIN_BUFFER_SIZE || policy.maximumFrames > MAX_BUFFER_SIZE ||
+        policy.minimumFrames > policy.maximumFrames) {
+        throw std::invalid_argument("Buffer size limits must be powers of two within buffer limits");
+    }
+    if (!(policy.targetLoad > 0.0f && policy.targetLoad <= 1.0f) || policy.settleBlocks == 0 ||
+        !(policy.retrySeconds >= 0.0 && std::isfinite(policy.retrySeconds))) {
+        throw std::invalid_argument("Invalid buffer size policy");
+    }
+    frames = std::clamp(std::bit_ceil(std::max<size_t>(initialFrames, 1)), policy.minimumFrames,
+                        policy.maximumFrames);
+
+    // Judge the starting size on its own blocks too
+    DSPMetricsSnapshot snapshot;
+    changeSize(frames, metrics.snapshot(snapshot) ? snapshot.generation : 0);
+}
+
+bool BufferSizeController::isAllowed(size_t bufferSize) const noexcept {
+    if (!std::has_single_bit(bufferSize) || bufferSize < limits.minimumFrames || bufferSize > limits.maximumFrames) {
+        return false;
+    }
+    return clock >= retryAt[sizeClass(bufferSize)];
+}
+
+void BufferSizeController::recordFailure(size_t bufferSize) noexcept {
+    const int index = sizeClass(bufferSize);
+    const double hold = limits.retrySeconds * std::ldexp(1.0, static_cast<int>(std::min<uint32_t>(failures[index], 30)));
+    retryAt[index] = clock + std::min(hold, std::max(limits.retrySeconds, MAX_BUFFER_SIZE_RETRY_SECONDS));
+    ++failures[index];
+    ++backoffs;
+}
+
+void BufferSizeController::changeSize(size_t newFrames, uint32_t generation) noexcept {
+    frames = newFrames;
+    metrics.clear();
+    awaitedGeneration = generation + 1;
+    awaitingClear = true;
+    blocksSeen = 0;
+    xrunsSeen = 0;             // clear() resets the xrun count immediately
+}
+
+BufferSizeDecision BufferSizeController::update() noexcept {
+    DSPMetricsSnapshot snapshot;
+    if (!metrics.snapshot(snapshot)) {
+        return BufferSizeDecision::Settling;
+    }
+    if (awaitingClear) {
+        // Wrapping difference: generations only count up
+        if (static_cast<int32_t>(snapshot.generation - awaitedGeneration) < 0) {
+            return BufferSizeDecision::Settling;
+        }
+        awaitingClear = false;
+    }
+
+    if (snapshot.blocks > blocksSeen) {
+        clock += static_cast<double>(snapshot.blocks - blocksSeen) * static_cast<double>(frames) / sampleRate;
+        blocksSeen = snapshot.blocks;
+    }
+
+    // Nothing larger to move to at the maximum, so it holds without counting a failure
+    if (snapshot.xruns > xrunsSeen) {
+        xrunsSeen = snapshot.xruns;
+        if (frames < limits.maximumFrames) {
+            recordFailure(frames);
+            changeSize(frames * 2, snapshot.generation);
+            return BufferSizeDecision::BackOff;
+        }
+        return BufferSizeDecision::Hold;
+    }
+
+    if (snapshot.blocks < limits.settleBlocks) {
+        return BufferSizeDecision::Settling;
+    }
+
+    if (snapshot.p99Load > limits.targetLoad) {
+        if (frames < limits.maximumFrames) {
+            recordFailure(frames);
+            changeSize(frames * 2, snapshot.generation);
+            return BufferSizeDecision::StepUp;
+        }
+        return BufferSizeDecision::Hold;
+    }
+
+    // Sustained under target at this size: a later failure here starts the hold over
+    failures[sizeClass(frames)] = 0;
+
+    if (frames > limits.minimumFrames && isAllowed(frames / 2)) {
+        changeSize(frames / 2, snapshot.generation);
+        return BufferSizeDecision::StepDown;
+    }
+    return BufferSizeDecision::Hold;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,158 @@
+//
+// DSPBufferSizeController.hpp
+// TALD UNIA Audio System
+//
+// Feedback control of the HAL I/O buffer size from a kernel's block load metrics:
+// probes down toward the smallest size the device sustains and backs off on xruns.
+//
+
+#ifndef TALD_UNIA_DSP_BUFFER_SIZE_CONTROLLER_HPP
+#define TALD_UNIA_DSP_BUFFER_SIZE_CONTROLLER_HPP
+
+#include <bit>         // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include "DSPConfig.hpp"
+#include "DSPMetrics.hpp"
+
+// p99 block load the controller keeps the kernel under (fraction of the block's real-time budget)
+constexpr float DEFAULT_TARGET_PROCESSING_LOAD = 0.4f;
+
+// Largest size the controller backs off to by default, the top of BufferManager's optimal sizes
+constexpr size_t DEFAULT_MAX_ADAPTIVE_BUFFER_SIZE = 1024;
+
+// Blocks recorded at a size before its p99 load is trusted
+constexpr uint64_t BUFFER_SIZE_SETTLE_BLOCKS = 1000;
+
+// Audio time a size that failed is avoided before it is probed again; doubles with every
+// further failure at that size, up to the maximum
+constexpr double BUFFER_SIZE_RETRY_SECONDS = 30.0;
+constexpr double MAX_BUFFER_SIZE_RETRY_SECONDS = 960.0;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Limits and thresholds of a BufferSizeController
+ */
+struct BufferSizePolicy {
+    size_t minimumFrames = MIN_BUFFER_SIZE;                 // Power of two
+    size_t maximumFrames = DEFAULT_MAX_ADAPTIVE_BUFFER_SIZE; // Power of two
+    float targetLoad = DEFAULT_TARGET_PROCESSING_LOAD;
+    uint64_t settleBlocks = BUFFER_SIZE_SETTLE_BLOCKS;
+    double retrySeconds = BUFFER_SIZE_RETRY_SECONDS;
+};
+
+/**
+ * @brief Outcome of one BufferSizeController::update()
+ */
+enum class BufferSizeDecision : uint8_t {
+    Settling,   // Not enough blocks at this size yet, or the last clear not yet applied
+    Hold,       // Size kept: the next smaller one failed recently, or this is the minimum, or
+                // the maximum is overloaded and there is nothing larger to back off to
+    StepDown,   // p99 load was under target long enough; halved
+    StepUp,     // p99 load over target; doubled and this size avoided for a while
+    BackOff     // Xrun reported; doubled right away and this size avoided for a while
+};
+
+/**
+ * @brief Chooses the HAL I/O buffer size from a kernel's lock-free block metrics
+ *
+ * Sizes are powers of two between the policy limits. update() is called
+ * periodically from a control thread (BufferManager's monitoring timer, every
+ * 100 ms): once settleBlocks blocks have been recorded at the current size with
+ * no xrun and a p99 load under target, it halves the size; a p99 over target
+ * doubles it, and an xrun doubles it at once. A size that fails is then avoided
+ * for retrySeconds of rendered audio, twice as long after each further failure,
+ * so the controller settles at the lowest size the device sustains but keeps
+ * probing in case conditions improve. Every change clears the kernel's metrics,
+ * and decisions wait until the render thread has applied that clear, so a new
+ * size is only ever judged on its own blocks. After a change the caller
+ * reconfigures the device to bufferFrames().
+ */
+class BufferSizeController {
+public:
+    /**
+     * @param metrics Block metrics of the kernel rendering at the device buffer size
+     * @param sampleRate Device sample rate (Hz)
+     * @param initialFrames Current device buffer size, rounded to a power of two within the limits
+     * @param policy Limits and thresholds
+     * @throws std::invalid_argument if parameters are out of valid range
+     */
+    BufferSizeController(DSPBlockMetrics& metrics, double sampleRate, size_t initialFrames,
+                         const BufferSizePolicy& policy = BufferSizePolicy{});
+
+    /**
+     * @brief Read the metrics and possibly change the size (control thread)
+     */
+    BufferSizeDecision update() noexcept;
+
+    /**
+     * @brief Buffer size the device should run at
+     */
+    [[nodiscard]]
+    size_t bufferFrames() const noexcept {
+        return frames;
+    }
+
+    /**
+     * @brief Whether a size may currently be probed
+     */
+    [[nodiscard]]
+    bool isAllowed(size_t bufferSize) const noexcept;
+
+    /**
+     * @brief Changes caused by xruns or p99 load over target
+     *
+     * Overload at the maximum size changes nothing, so it is not counted.
+     */
+    [[nodiscard]]
+    uint64_t backoffCount() const noexcept {
+        return backoffs;
+    }
+
+    /**
+     * @brief Rendered audio observed so far (s)
+     */
+    [[nodiscard]]
+    double renderedSeconds() const noexcept {
+        return clock;
+    }
+
+    [[nodiscard]]
+    const BufferSizePolicy& policy() const noexcept {
+        return limits;
+    }
+
+private:
+    static constexpr int kSizeClasses = std::bit_width(MAX_BUFFER_SIZE);
+
+    DSPBlockMetrics& metrics;
+    const double sampleRate;
+    const BufferSizePolicy limits;
+
+    size_t frames;
+    double clock = 0.0;              // Audio seconds rendered, advanced from block counts
+    uint64_t blocksSeen = 0;         // Blocks in the current generation already counted
+    uint64_t xrunsSeen = 0;
+    uint32_t awaitedGeneration = 0;
+    bool awaitingClear = false;
+    uint64_t backoffs = 0;
+
+    // Per power-of-two size: failures so far and the audio time it may be probed again
+    uint32_t failures[kSizeClasses] = {};
+    double retryAt[kSizeClasses] = {};
+
+    [[nodiscard]]
+    static int sizeClass(size_t bufferSize) noexcept {
+        return static_cast<int>(std::bit_width(bufferSize)) - 1;
+    }
+
+    void recordFailure(size_t bufferSize) noexcept;
+    void changeSize(size_t newFrames, uint32_t generation) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_BUFFER_SIZE_CONTROLLER_HPP
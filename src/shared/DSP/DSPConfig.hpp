@@ -0,0 +1,50 @@
+#ifndef TALD_UNIA_DSP_CONFIG_HPP
+#define TALD_UNIA_DSP_CONFIG_HPP
+
+#include <cstddef>
+#include <TargetConditionals.h> // Apple SDK
+
+// Compile-time SIMD target for auto-vectorized loops. The kernel's hot loops
+// dispatch at runtime instead (DSPBackend.hpp), so a baseline x86_64 build still
+// runs AVX2 or AVX-512 code on CPUs that have it.
+// - arm64 (Apple Silicon Macs, iOS devices): NEON, with Accelerate for library calls
+// - x86_64 Macs built with AVX2 (macOS 13 minimum hardware): AVX2
+// - anything else: portable scalar code, auto-vectorized where possible
+#if defined(__aarch64__) || defined(__arm64__)
+    #define TALD_DSP_BACKEND_NEON 1
+    #include <arm_neon.h>
+#elif defined(__x86_64__) && defined(__AVX2__)
+    #define TALD_DSP_BACKEND_AVX2 1
+    #include <immintrin.h>
+#else
+    #define TALD_DSP_BACKEND_SCALAR 1
+#endif
+
+// Platform tuning: iOS render slices are capped lower to bound per-kernel memory
+#if TARGET_OS_IPHONE
+    constexpr size_t MAX_BUFFER_SIZE = 4096;
+#else
+    constexpr size_t MAX_BUFFER_SIZE = 8192;
+#endif
+
+// Global constants for DSP configuration
+constexpr int MAX_CHANNELS = 8;
+constexpr int DSP_ALIGNMENT = 16;      // Minimum host pointer alignment processed without staging
+constexpr int CACHE_LINE_SIZE = 64;    // Alignment of every internal allocation
+constexpr size_t MIN_BUFFER_SIZE = 64;
+constexpr double MIN_SAMPLE_RATE = 44100.0;
+constexpr double MAX_SAMPLE_RATE = 384000.0;
+constexpr double DEFAULT_SAMPLE_RATE = 48000.0;
+
+#if defined(TALD_DSP_BACKEND_AVX2)
+    constexpr int SIMD_VECTOR_SIZE = 8;  // 256-bit registers
+    constexpr const char* DSP_BACKEND_NAME = "AVX2";
+#elif defined(TALD_DSP_BACKEND_NEON)
+    constexpr int SIMD_VECTOR_SIZE = 4;  // 128-bit registers
+    constexpr const char* DSP_BACKEND_NAME = "NEON";
+#else
+    constexpr int SIMD_VECTOR_SIZE = 4;
+    constexpr const char* DSP_BACKEND_NAME = "Scalar";
+#endif
+
+#endif // TALD_UNIA_DSP_CONFIG_HPP
@@ -0,0 +1,125 @@
+#ifndef TALD_UNIA_DSP_DENORMALS_HPP
+#define TALD_UNIA_DSP_DENORMALS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <xmmintrin.h>
+#endif
+
+// Magnitude below which samples are flushed to zero in threshold mode
+constexpr float DENORMAL_THRESHOLD = 1.0e-15f;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Strategy used by a kernel to keep denormals off the render path
+ */
+enum class DenormalMode : uint8_t {
+    HardwareFTZ,      // Flush-to-zero in the FP control register (arm64 FPCR.FZ, x86 MXCSR FTZ/DAZ)
+    VectorThreshold,  // Single vectorized pass zeroing |x| < DENORMAL_THRESHOLD
+    Off               // No denormal handling
+};
+
+/**
+ * @brief Human-readable name of a denormal mode
+ */
+[[nodiscard]]
+constexpr const char* denormalModeName(DenormalMode mode) noexcept {
+    switch (mode) {
+        case DenormalMode::HardwareFTZ: return "HardwareFTZ";
+        case DenormalMode::VectorThreshold: return "VectorThreshold";
+        case DenormalMode::Off: return "Off";
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Whether this target can enable flush-to-zero in hardware
+ */
+[[nodiscard]]
+constexpr bool isHardwareFTZSupported() noexcept {
+    #if defined(__aarch64__) || defined(__x86_64__) || defined(__i386__)
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+/**
+ * @brief Resolve a requested mode to one the current target can honour
+ */
+[[nodiscard]]
+constexpr DenormalMode resolveDenormalMode(DenormalMode requested) noexcept {
+    if (requested == DenormalMode::HardwareFTZ && !isHardwareFTZSupported()) {
+        return DenormalMode::VectorThreshold;
+    }
+    return requested;
+}
+
+/**
+ * @brief RAII guard enabling hardware flush-to-zero on the calling thread
+ *
+ * The FP control register is per thread, so the guard is taken on the render
+ * thread for the duration of each process() call and restores the caller's state.
+ */
+class ScopedFlushToZero {
+public:
+    explicit ScopedFlushToZero(bool enable) noexcept
+        : active(enable && isHardwareFTZSupported())
+        , savedState(0) {
+        if (!active) {
+            return;
+        }
+        #if defined(__aarch64__)
+            uint64_t fpcr;
+            __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+            savedState = fpcr;
+            fpcr |= (1ULL << 24); // FPCR.FZ
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+        #elif defined(__x86_64__) || defined(__i386__)
+            const unsigned int csr = _mm_getcsr();
+            savedState = csr;
+            _mm_setcsr(csr | 0x8040u); // MXCSR FTZ | DAZ
+        #endif
+    }
+
+    ~ScopedFlushToZero() {
+        if (!active) {
+            return;
+        }
+        #if defined(__aarch64__)
+            const uint64_t fpcr = savedState;
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+        #elif defined(__x86_64__) || defined(__i386__)
+            _mm_setcsr(static_cast<unsigned int>(savedState));
+        #endif
+    }
+
+    ScopedFlushToZero(const ScopedFlushToZero&) = delete;
+    ScopedFlushToZero& operator=(const ScopedFlushToZero&) = delete;
+
+private:
+    bool active;
+    uint64_t savedState;
+};
+
+/**
+ * @brief Zero every sample below DENORMAL_THRESHOLD in one vectorized pass
+ * @param buffer Samples to flush in place
+ * @param count Number of samples
+ */
+inline void flushDenormals(float* __restrict buffer, size_t count) noexcept {
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (size_t i = 0; i < count; ++i) {
+        buffer[i] = (std::fabs(buffer[i]) < DENORMAL_THRESHOLD) ? 0.0f : buffer[i];
+    }
+}
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_DENORMALS_HPP
@@ -0,0 +1,75 @@
+#include "DSPFFTSetupCache.hpp"
+#include <algorithm>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    struct CacheEntry {
+        vDSP_Length log2n;
+        FFTRadix radix;
+        std::weak_ptr<std::remove_pointer_t<FFTSetup>> setup;
+    };
+
+    // Only a handful of sizes are ever live, so a flat list beats a map
+    struct FFTSetupCache {
+        std::mutex mutex;
+        std::vector<CacheEntry> entries;
+    };
+
+    FFTSetupCache& cache() {
+        static FFTSetupCache instance;
+        return instance;
+    }
+}
+
+SharedFFTSetup acquireFFTSetup(vDSP_Length log2n, FFTRadix radix) {
+    FFTSetupCache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    // Drop entries whose last handle has been released
+    std::erase_if(shared.entries, [](const CacheEntry& entry) { return entry.setup.expired(); });
+
+    for (const CacheEntry& entry : shared.entries) {
+        if (entry.log2n == log2n && entry.radix == radix) {
+            // The last handle may be released concurrently without the lock
+            if (auto existing = entry.setup.lock()) {
+                return SharedFFTSetup(std::move(existing));
+            }
+        }
+    }
+
+    FFTSetup created = vDSP_create_fftsetup(log2n, radix);
+    if (!created) {
+        return SharedFFTSetup();
+    }
+
+    SharedFFTSetup::Storage storage(created, [](FFTSetup setup) { vDSP_destroy_fftsetup(setup); });
+    std::erase_if(shared.entries, [&](const CacheEntry& entry) {
+        return entry.log2n == log2n && entry.radix == radix;
+    });
+    shared.entries.push_back(CacheEntry{ log2n, radix, storage });
+    return SharedFFTSetup(std::move(storage));
+}
+
+size_t fftSetupUseCount(vDSP_Length log2n, FFTRadix radix) {
+    FFTSetupCache& shared = cache();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    for (const CacheEntry& entry : shared.entries) {
+        if (entry.log2n == log2n && entry.radix == radix) {
+            return static_cast<size_t>(entry.setup.use_count());
+        }
+    }
+    return 0;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,64 @@
+#ifndef TALD_UNIA_DSP_FFT_SETUP_CACHE_HPP
+#define TALD_UNIA_DSP_FFT_SETUP_CACHE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <Accelerate/Accelerate.h> // Apple SDK
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Shared, read-only handle to a cached vDSP FFT setup
+ *
+ * Copies share one setup; the twiddle tables are destroyed when the last handle
+ * referencing them goes away. vDSP setups are immutable after creation, so one
+ * setup may be used by any number of kernels and threads concurrently.
+ */
+class SharedFFTSetup {
+public:
+    SharedFFTSetup() noexcept = default;
+
+    [[nodiscard]]
+    FFTSetup get() const noexcept {
+        return setup.get();
+    }
+
+    [[nodiscard]]
+    explicit operator bool() const noexcept {
+        return static_cast<bool>(setup);
+    }
+
+private:
+    friend SharedFFTSetup acquireFFTSetup(vDSP_Length log2n, FFTRadix radix);
+
+    using Storage = std::shared_ptr<std::remove_pointer_t<FFTSetup>>;
+
+    explicit SharedFFTSetup(Storage storage) noexcept
+        : setup(std::move(storage)) {}
+
+    Storage setup;
+};
+
+/**
+ * @brief Get the process-wide setup for a transform size and radix, creating it on first use
+ * @param log2n Base-2 logarithm of the largest transform the setup must support
+ * @param radix vDSP radix (kFFTRadix2, kFFTRadix3 or kFFTRadix5)
+ * @return Shared handle, empty if vDSP could not allocate the setup
+ *
+ * Thread-safe. Takes a lock and may allocate, so call it while constructing or
+ * preparing a kernel, never from the render thread.
+ */
+SharedFFTSetup acquireFFTSetup(vDSP_Length log2n, FFTRadix radix = kFFTRadix2);
+
+/**
+ * @brief Number of live handles to a cached setup (0 if none is cached)
+ */
+size_t fftSetupUseCount(vDSP_Length log2n, FFTRadix radix = kFFTRadix2);
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_FFT_SETUP_CACHE_HPP
@@ -0,0 +1,52 @@
+//
+// DSPFilterDesign.hpp
+// TALD UNIA Audio System
+//
+// FIR design and inner-product helpers shared by the rate-conversion kernels.
+// Internal to the DSP translation units; not part of the kernel interface.
+//
+
+#ifndef TALD_UNIA_DSP_FILTER_DESIGN_HPP
+#define TALD_UNIA_DSP_FILTER_DESIGN_HPP
+
+#include <cstddef>     // C++20
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Zeroth-order modified Bessel function of the first kind, for the Kaiser window
+ */
+[[nodiscard]]
+inline double besselI0(double x) noexcept {
+    double sum = 1.0;
+    double term = 1.0;
+    const double quarterSquare = 0.25 * x * x;
+    for (int k = 1; k < 64 && term > 1.0e-12 * sum; ++k) {
+        term *= quarterSquare / (static_cast<double>(k) * static_cast<double>(k));
+        sum += term;
+    }
+    return sum;
+}
+
+/**
+ * @brief Inner product over a compile-time tap count
+ *
+ * The explicit vectorize hint allows the sum to be split across vector lanes, and
+ * the fixed trip count lets the compiler unroll it completely.
+ */
+template <size_t Taps>
+[[nodiscard]]
+inline float dotProduct(const float* __restrict coefficients, const float* __restrict samples) noexcept {
+    float sum = 0.0f;
+    #pragma clang loop vectorize(enable) interleave(enable)
+    for (size_t k = 0; k < Taps; ++k) {
+        sum += coefficients[k] * samples[k];
+    }
+    return sum;
+}
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_FILTER_DESIGN_HPP
@@ -0,0 +1,234 @@
+#include "DSPGraph.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include "DSPBackend.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Node buffers start on cache-line boundaries
+    constexpr size_t kFloatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+
+    void copyToPlanar(const AudioBufferView& source, float* const* planes, size_t frames) noexcept {
+        if (source.layout == BufferLayout::Planar) {
+            for (int channel = 0; channel < source.channels; ++channel) {
+                std::memcpy(planes[channel], source.planes[channel], frames * sizeof(float));
+            }
+            return;
+        }
+        const size_t stride = static_cast<size_t>(source.channels);
+        for (int channel = 0; channel < source.channels; ++channel) {
+            const float* samples = source.interleaved + channel;
+            for (size_t frame = 0; frame < frames; ++frame) {
+                planes[channel][frame] = samples[frame * stride];
+            }
+        }
+    }
+
+    void copyFromPlanar(float* const* planes, const AudioBufferView& destination, size_t frames) noexcept {
+        if (destination.layout == BufferLayout::Planar) {
+            for (int channel = 0; channel < destination.channels; ++channel) {
+                std::memcpy(destination.planes[channel], planes[channel], frames * sizeof(float));
+            }
+            return;
+        }
+        const size_t stride = static_cast<size_t>(destination.channels);
+        for (int channel = 0; channel < destination.channels; ++channel) {
+            float* samples = destination.interleaved + channel;
+            for (size_t frame = 0; frame < frames; ++frame) {
+                samples[frame * stride] = planes[channel][frame];
+            }
+        }
+    }
+}
+
+DSPGraph::DSPGraph(int channels, size_t maxFrames)
+    : numChannels(channels)
+    , maxFrames(maxFrames)
+{
+    if (channels <= 0 || channels > MAX_CHANNELS) {
+        throw std::invalid_argument("Channel count out of valid range");
+    }
+    if (maxFrames == 0 || maxFrames > MAX_BUFFER_SIZE) {
+        throw std::invalid_argument("Maximum frame count out of valid range");
+    }
+    nodes.reserve(MAX_GRAPH_NODES);
+}
+
+DSPGraph::~DSPGraph() {
+    alignedFree(arena);
+}
+
+DSPNodeID DSPGraph::appendNode(std::unique_ptr<DSPKernel> kernel) {
+    if (compiled) {
+        throw std::invalid_argument("Graph topology is fixed after compile()");
+    }
+    if (nodeCount() >= MAX_GRAPH_NODES) {
+        throw std::invalid_argument("Too many graph nodes");
+    }
+    if (kernel && kernel->channelCount() != numChannels) {
+        throw std::invalid_argument("Kernel channel count does not match the graph");
+    }
+
+    nodes.emplace_back();
+    nodes.back().kernel = std::move(kernel);
+    return nodeCount() - 1;
+}
+
+DSPNodeID DSPGraph::addSource(std::unique_ptr<DSPKernel> kernel) {
+    const DSPNodeID node = appendNode(std::move(kernel));
+    nodes[node].sourceIndex = sources++;
+    return node;
+}
+
+DSPNodeID DSPGraph::addNode(std::unique_ptr<DSPKernel> kernel, std::span<const DSPNodeID> inputs) {
+    if (inputs.empty()) {
+        throw std::invalid_argument("Graph node needs at least one input");
+    }
+    // Inputs must already exist, which keeps the graph acyclic by construction
+    for (DSPNodeID input : inputs) {
+        if (input < 0 || input >= nodeCount()) {
+            throw std::invalid_argument("Graph node input does not exist");
+        }
+    }
+
+    const DSPNodeID node = appendNode(std::move(kernel));
+    nodes[node].inputs.assign(inputs.begin(), inputs.end());
+    for (DSPNodeID input : inputs) {
+        nodes[input].dependents.push_back(static_cast<uint32_t>(node));
+    }
+    return node;
+}
+
+void DSPGraph::compile(DSPNodeID output, DSPWorkerPool* workerPool) {
+    if (compiled) {
+        throw std::invalid_argument("Graph is already compiled");
+    }
+    if (output < 0 || output >= nodeCount()) {
+        throw std::invalid_argument("Graph output node does not exist");
+    }
+    for (DSPNodeID node = 0; node < nodeCount(); ++node) {
+        if (node != output && nodes[node].dependents.empty()) {
+            throw std::invalid_argument("Graph node does not reach the output");
+        }
+    }
+
+    for (Node& node : nodes) {
+        if (node.kernel) {
+            node.kernel->prepare(maxFrames, numChannels, node.kernel->currentSampleRate());
+        }
+    }
+
+    const size_t stride = (maxFrames + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine;
+    const size_t totalFloats = nodes.size() * static_cast<size_t>(numChannels) * stride;
+    arena = static_cast<float*>(alignedMalloc(totalFloats * sizeof(float), CACHE_LINE_SIZE));
+    if (!arena) {
+        throw std::runtime_error("Failed to allocate graph buffers");
+    }
+    std::memset(arena, 0, totalFloats * sizeof(float));
+
+    pending = std::make_unique<PendingInputs[]>(nodes.size());
+    float* cursor = arena;
+    for (DSPNodeID node = 0; node < nodeCount(); ++node) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            nodes[node].planes[channel] = cursor;
+            cursor += stride;
+        }
+        if (nodes[node].inputs.empty()) {
+            roots.push_back(static_cast<uint32_t>(node));
+        }
+    }
+
+    outputNode = output;
+    pool = workerPool;
+    compiled = true;
+}
+
+void DSPGraph::process(std::span<const AudioBufferView> sourceViews, const AudioBufferView& output) noexcept {
+    const size_t frameCount = output.frames;
+    if (!compiled || !output.isValid() || output.channels != numChannels || frameCount > maxFrames ||
+        sourceViews.size() != static_cast<size_t>(sources)) {
+        return;
+    }
+    for (const AudioBufferView& source : sourceViews) {
+        if (!source.isValid() || source.channels != numChannels || source.frames != frameCount) {
+            return;
+        }
+    }
+
+    blockSources = sourceViews.data();
+    blockFrames = frameCount;
+
+    if (pool) {
+        // Counters are published to the workers along with the root tasks
+        for (DSPNodeID node = 0; node < nodeCount(); ++node) {
+            pending[node].remaining.store(static_cast<int>(nodes[node].inputs.size()), std::memory_order_relaxed);
+        }
+        pool->run(*this, roots.data(), roots.size());
+    }
+    else {
+        // Nodes were added in dependency order
+        for (DSPNodeID node = 0; node < nodeCount(); ++node) {
+            renderNode(node);
+        }
+    }
+
+    copyFromPlanar(nodes[outputNode].planes.data(), output, frameCount);
+}
+
+void DSPGraph::runTask(uint32_t task, DSPWorkerContext& context) noexcept {
+    const DSPNodeID node = static_cast<DSPNodeID>(task);
+    renderNode(node);
+
+    // The last input to finish makes a dependent ready; acq_rel hands over the buffers
+    for (uint32_t dependent : nodes[node].dependents) {
+        if (pending[dependent].remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            context.spawn(dependent);
+        }
+    }
+}
+
+void DSPGraph::renderNode(DSPNodeID node) noexcept {
+    const Node& current = nodes[node];
+    const AudioBufferView destination = nodeView(node);
+
+    if (current.sourceIndex >= 0) {
+        const AudioBufferView& source = blockSources[current.sourceIndex];
+        if (current.kernel) {
+            current.kernel->process(source, destination);
+        }
+        else {
+            copyToPlanar(source, destination.planes, blockFrames);
+        }
+        return;
+    }
+
+    // A single upstream buffer is processed straight into this node's buffer
+    if (current.inputs.size() == 1 && current.kernel) {
+        current.kernel->process(nodeView(current.inputs[0]), destination);
+        return;
+    }
+
+    const DSPBackend& backend = activeDSPBackend();
+    const Node& first = nodes[current.inputs[0]];
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* sum = current.planes[channel];
+        std::memcpy(sum, first.planes[channel], blockFrames * sizeof(float));
+        for (size_t input = 1; input < current.inputs.size(); ++input) {
+            backend.accumulate(nodes[current.inputs[input]].planes[channel], sum, blockFrames);
+        }
+    }
+
+    if (current.kernel) {
+        current.kernel->process(destination, destination);
+    }
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,165 @@
+//
+// DSPGraph.hpp
+// TALD UNIA Audio System
+//
+// Directed acyclic graph of DSP kernels connected by aligned buffers, rendered
+// serially or across a DSPWorkerPool so independent sources run in parallel and
+// meet at the mix bus.
+//
+
+#ifndef TALD_UNIA_DSP_GRAPH_HPP
+#define TALD_UNIA_DSP_GRAPH_HPP
+
+#include <array>       // C++20
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include <span>        // C++20
+#include <vector>      // C++20
+#include "DSPKernel.hpp"
+#include "DSPWorkerPool.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Enough for every spatial source (kMaxSources = 32) with per-source chains and buses
+constexpr int MAX_GRAPH_NODES = 128;
+static_assert(MAX_GRAPH_NODES <= static_cast<int>(MAX_DSP_TASKS), "Every node must fit in one deque");
+
+using DSPNodeID = int;
+
+/**
+ * @brief Kernels wired into a fixed render graph
+ *
+ * Nodes are added in dependency order on the control thread: a source reads one
+ * external input, any other node sums the nodes it lists and runs its kernel (if
+ * any) on that sum. Each node renders into its own cache-aligned planar buffer,
+ * which downstream nodes read directly. compile() freezes the topology and
+ * allocates everything; process() then renders a block without allocating, with
+ * a node becoming ready the moment its last input finishes. Kernel parameters stay
+ * controllable through kernel().
+ */
+class DSPGraph final : private DSPTaskSet {
+public:
+    /**
+     * @brief Empty graph
+     * @param channels Channel count of every node, kernel and external buffer
+     * @param maxFrames Largest block process() will be called with
+     * @throws std::invalid_argument if parameters are out of valid range
+     */
+    DSPGraph(int channels, size_t maxFrames = MAX_BUFFER_SIZE);
+
+    ~DSPGraph() override;
+
+    DSPGraph(const DSPGraph&) = delete;
+    DSPGraph& operator=(const DSPGraph&) = delete;
+
+    /**
+     * @brief Node reading the next external input, processed by kernel (or copied if null)
+     * @throws std::invalid_argument after compile(), past MAX_GRAPH_NODES or on a channel mismatch
+     */
+    DSPNodeID addSource(std::unique_ptr<DSPKernel> kernel);
+
+    /**
+     * @brief Node summing earlier nodes and processing the sum with kernel (or passing it on if null)
+     * @throws std::invalid_argument for unknown inputs, no inputs, after compile(),
+     *         past MAX_GRAPH_NODES or on a channel mismatch
+     */
+    DSPNodeID addNode(std::unique_ptr<DSPKernel> kernel, std::span<const DSPNodeID> inputs);
+
+    /**
+     * @brief Summing node without processing, where parallel chains join
+     */
+    DSPNodeID addMixBus(std::span<const DSPNodeID> inputs) {
+        return addNode(nullptr, inputs);
+    }
+
+    /**
+     * @brief Choose the node copied to the host output and freeze the graph
+     * @param output Final node; every other node must feed it
+     * @param pool Workers to spread nodes across, or null to render on the calling thread only
+     *
+     * Every kernel is prepared for the graph's maxFrames, so its scratch matches the
+     * blocks it will actually see.
+     * @throws std::invalid_argument for a bad output or a node that does not reach it
+     * @throws std::runtime_error if allocation fails
+     */
+    void compile(DSPNodeID output, DSPWorkerPool* pool = nullptr);
+
+    /**
+     * @brief Render one block (render thread)
+     * @param sources One view per addSource() call, in order, each `output.frames` long
+     * @param output Host buffer in either layout
+     *
+     * Ignores the call if the graph is not compiled or the buffers do not match it.
+     */
+    void process(std::span<const AudioBufferView> sources, const AudioBufferView& output) noexcept;
+
+    /**
+     * @brief A node's kernel, for parameter changes (null for mix buses and plain sources)
+     */
+    [[nodiscard]]
+    DSPKernel* kernel(DSPNodeID node) const noexcept {
+        return (node >= 0 && node < nodeCount()) ? nodes[node].kernel.get() : nullptr;
+    }
+
+    [[nodiscard]]
+    int nodeCount() const noexcept {
+        return static_cast<int>(nodes.size());
+    }
+
+    [[nodiscard]]
+    int sourceCount() const noexcept {
+        return sources;
+    }
+
+    [[nodiscard]]
+    bool isCompiled() const noexcept {
+        return compiled;
+    }
+
+private:
+    struct Node {
+        std::unique_ptr<DSPKernel> kernel;
+        std::vector<DSPNodeID> inputs;
+        std::vector<uint32_t> dependents;
+        int sourceIndex = -1;                          // External input read by a source node
+        std::array<float*, MAX_CHANNELS> planes = {};  // Output buffer, carved from the arena
+    };
+
+    // One per node, on its own line so parallel chains do not share counters
+    struct alignas(CACHE_LINE_SIZE) PendingInputs {
+        std::atomic<int> remaining{0};
+    };
+
+    const int numChannels;
+    const size_t maxFrames;
+    int sources = 0;
+    bool compiled = false;
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> roots;                     // Nodes with no inputs
+    std::unique_ptr<PendingInputs[]> pending;
+    DSPNodeID outputNode = -1;
+    DSPWorkerPool* pool = nullptr;
+    float* arena = nullptr;
+
+    // Per block, written before tasks start (render thread)
+    const AudioBufferView* blockSources = nullptr;
+    size_t blockFrames = 0;
+
+    DSPNodeID appendNode(std::unique_ptr<DSPKernel> kernel);
+    void renderNode(DSPNodeID node) noexcept;
+    void runTask(uint32_t task, DSPWorkerContext& context) noexcept override;
+
+    [[nodiscard]]
+    AudioBufferView nodeView(DSPNodeID node) const noexcept {
+        return AudioBufferView::makePlanar(nodes[node].planes.data(), numChannels, blockFrames);
+    }
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_GRAPH_HPP
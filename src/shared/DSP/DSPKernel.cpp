@@ -0,0 +1,589 @@
+#include "DSPKernel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <array>
+#include <numbers>
+#include <utility>
+#include "DSPBackend.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    constexpr float MIN_GAIN_DB = -120.0f;
+    constexpr float MAX_GAIN_DB = 12.0f;
+
+    // Gain stage variant selected once per segment
+    enum class GainMode {
+        Unity,     // Pass-through, no multiply
+        Constant,  // Single scalar gain
+        Ramp       // Per-sample gain values
+    };
+
+    template <GainMode Mode, bool FlushDenormals>
+    inline float applyGainStage(float sample, float gain, float rampValue) noexcept {
+        if constexpr (Mode == GainMode::Constant) {
+            sample *= gain;
+        }
+        else if constexpr (Mode == GainMode::Ramp) {
+            sample *= rampValue;
+        }
+        if constexpr (FlushDenormals) {
+            sample = (std::fabs(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+        }
+        return sample;
+    }
+
+    /**
+     * @brief Single-pass gain and optional denormal flush between two buffer layouts
+     *
+     * Each sample is read once and written once, and input may equal output for
+     * in-place processing. Channel count, gain variant, threshold flushing and both
+     * layouts are template parameters so the channel loop is unrolled and the inner
+     * loop carries no branches, letting the compiler vectorize it fully. Matching
+     * layouts walk memory contiguously; differing layouts fold the interleave or
+     * deinterleave into the same pass. FixedFrames, when non-zero, replaces the
+     * runtime length so the trip count is known at compile time.
+     */
+    template <int Channels, GainMode Mode, bool FlushDenormals,
+              BufferLayout InputLayout, BufferLayout OutputLayout, size_t FixedFrames = 0>
+    void fusedGainKernel(const AudioBufferView& input, const AudioBufferView& output,
+                         size_t start, size_t runtimeLength,
+                         float gain, const float* __restrict ramp) noexcept {
+        // A fixed block size turns every trip count into a constant: loops are fully
+        // unrolled with no remainder handling
+        const size_t length = (FixedFrames != 0) ? FixedFrames : runtimeLength;
+
+        if constexpr (InputLayout == BufferLayout::Planar && OutputLayout == BufferLayout::Planar) {
+            for (int channel = 0; channel < Channels; ++channel) {
+                const float* source = input.planes[channel] + start;
+                float* destination = output.planes[channel] + start;
+
+                // Elementwise at equal indices: safe for input == output or disjoint buffers
+                #pragma clang loop vectorize(assume_safety) vectorize_width(SIMD_VECTOR_SIZE) interleave(enable)
+                for (size_t i = 0; i < length; ++i) {
+                    const float rampValue = (Mode == GainMode::Ramp) ? ramp[i] : 1.0f;
+                    destination[i] = applyGainStage<Mode, FlushDenormals>(source[i], gain, rampValue);
+                }
+            }
+        }
+        else if constexpr (InputLayout == BufferLayout::Interleaved && OutputLayout == BufferLayout::Interleaved) {
+            const float* source = input.interleaved + start * Channels;
+            float* destination = output.interleaved + start * Channels;
+
+            if constexpr (Mode == GainMode::Ramp) {
+                // One ramp value per frame, broadcast across the unrolled channel loop
+                #pragma clang loop vectorize(assume_safety) vectorize_width(SIMD_VECTOR_SIZE) interleave(enable)
+                for (size_t frame = 0; frame < length; ++frame) {
+                    for (int channel = 0; channel < Channels; ++channel) {
+                        const size_t index = frame * Channels + channel;
+                        destination[index] = applyGainStage<Mode, FlushDenormals>(source[index], gain, ramp[frame]);
+                    }
+                }
+            }
+            else {
+                // Channel-independent gain: one contiguous run over all samples
+                const size_t sampleCount = length * Channels;
+                #pragma clang loop vectorize(assume_safety) vectorize_width(SIMD_VECTOR_SIZE) interleave(enable)
+                for (size_t i = 0; i < sampleCount; ++i) {
+                    destination[i] = applyGainStage<Mode, FlushDenormals>(source[i], gain, 1.0f);
+                }
+            }
+        }
+        else {
+            // Layouts differ: convert while processing, frame-major with unrolled channels
+            const float* planarSource[Channels];
+            float* planarDestination[Channels];
+            for (int channel = 0; channel < Channels; ++channel) {
+                if constexpr (InputLayout == BufferLayout::Planar) {
+                    planarSource[channel] = input.planes[channel] + start;
+                }
+                if constexpr (OutputLayout == BufferLayout::Planar) {
+                    planarDestination[channel] = output.planes[channel] + start;
+                }
+            }
+            const float* interleavedSource = (InputLayout == BufferLayout::Interleaved)
+                ? input.interleaved + start * Channels : nullptr;
+            float* interleavedDestination = (OutputLayout == BufferLayout::Interleaved)
+                ? output.interleaved + start * Channels : nullptr;
+
+            for (size_t frame = 0; frame < length; ++frame) {
+                const float rampValue = (Mode == GainMode::Ramp) ? ramp[frame] : 1.0f;
+                for (int channel = 0; channel < Channels; ++channel) {
+                    float sample;
+                    if constexpr (InputLayout == BufferLayout::Planar) {
+                        sample = planarSource[channel][frame];
+                    }
+                    else {
+                        sample = interleavedSource[frame * Channels + channel];
+                    }
+
+                    sample = applyGainStage<Mode, FlushDenormals>(sample, gain, rampValue);
+
+                    if constexpr (OutputLayout == BufferLayout::Planar) {
+                        planarDestination[channel][frame] = sample;
+                    }
+                    else {
+                        interleavedDestination[frame * Channels + channel] = sample;
+                    }
+                }
+            }
+        }
+    }
+
+    using FusedKernelFunction = void (*)(const AudioBufferView&, const AudioBufferView&,
+                                         size_t, size_t, float, const float*) noexcept;
+
+    using FusedKernelTable = std::array<FusedKernelFunction, MAX_CHANNELS>;
+
+    template <GainMode Mode, bool FlushDenormals, BufferLayout InputLayout, BufferLayout OutputLayout,
+              size_t... ChannelIndex>
+    constexpr FusedKernelTable makeFusedKernelTable(std::index_sequence<ChannelIndex...>) {
+        return {{ &fusedGainKernel<static_cast<int>(ChannelIndex) + 1, Mode, FlushDenormals,
+                                   InputLayout, OutputLayout>... }};
+    }
+
+    // Compile-time specializations for one denormal strategy and layout pair, indexed by [channels - 1]
+    struct FusedKernelSet {
+        FusedKernelTable unity;
+        FusedKernelTable constant;
+        FusedKernelTable ramp;
+    };
+
+    template <bool FlushDenormals, BufferLayout InputLayout, BufferLayout OutputLayout>
+    constexpr FusedKernelSet makeFusedKernelSet() {
+        constexpr auto channels = std::make_index_sequence<MAX_CHANNELS>{};
+        return {
+            makeFusedKernelTable<GainMode::Unity, FlushDenormals, InputLayout, OutputLayout>(channels),
+            makeFusedKernelTable<GainMode::Constant, FlushDenormals, InputLayout, OutputLayout>(channels),
+            makeFusedKernelTable<GainMode::Ramp, FlushDenormals, InputLayout, OutputLayout>(channels)
+        };
+    }
+
+    // All layout pairs for one denormal strategy, indexed by [input layout][output layout]
+    struct LayoutKernelSets {
+        FusedKernelSet sets[2][2];
+
+        [[nodiscard]]
+        constexpr const FusedKernelSet& select(BufferLayout input, BufferLayout output) const noexcept {
+            return sets[static_cast<size_t>(input)][static_cast<size_t>(output)];
+        }
+    };
+
+    template <bool FlushDenormals>
+    constexpr LayoutKernelSets makeLayoutKernelSets() {
+        return {{
+            { makeFusedKernelSet<FlushDenormals, BufferLayout::Interleaved, BufferLayout::Interleaved>(),
+              makeFusedKernelSet<FlushDenormals, BufferLayout::Interleaved, BufferLayout::Planar>() },
+            { makeFusedKernelSet<FlushDenormals, BufferLayout::Planar, BufferLayout::Interleaved>(),
+              makeFusedKernelSet<FlushDenormals, BufferLayout::Planar, BufferLayout::Planar>() }
+        }};
+    }
+
+    constexpr LayoutKernelSets kThresholdKernels = makeLayoutKernelSets<true>();
+    constexpr LayoutKernelSets kPassThroughKernels = makeLayoutKernelSets<false>();
+
+    // Full-block kernels for one (channels, frames) format, matching layouts only
+    struct FixedBlockKernelSet {
+        FusedKernelFunction unity;
+        FusedKernelFunction constant;
+        FusedKernelFunction ramp;
+    };
+
+    struct FixedBlockKernels {
+        int channels;
+        size_t frames;
+        FixedBlockKernelSet sets[2][2];   // [flush denormals][layout]
+
+        [[nodiscard]]
+        constexpr const FixedBlockKernelSet& select(bool flushDenormals, BufferLayout layout) const noexcept {
+            return sets[flushDenormals ? 1 : 0][static_cast<size_t>(layout)];
+        }
+    };
+
+    template <int Channels, size_t Frames, bool FlushDenormals, BufferLayout Layout>
+    constexpr FixedBlockKernelSet makeFixedBlockKernelSet() {
+        return {
+            &fusedGainKernel<Channels, GainMode::Unity, FlushDenormals, Layout, Layout, Frames>,
+            &fusedGainKernel<Channels, GainMode::Constant, FlushDenormals, Layout, Layout, Frames>,
+            &fusedGainKernel<Channels, GainMode::Ramp, FlushDenormals, Layout, Layout, Frames>
+        };
+    }
+
+    template <int Channels, size_t Frames>
+    constexpr FixedBlockKernels makeFixedBlockKernels() {
+        static_assert(Frames % SIMD_VECTOR_SIZE == 0, "Fixed blocks must be whole vectors");
+        return { Channels, Frames, {
+            { makeFixedBlockKernelSet<Channels, Frames, false, BufferLayout::Interleaved>(),
+              makeFixedBlockKernelSet<Channels, Frames, false, BufferLayout::Planar>() },
+            { makeFixedBlockKernelSet<Channels, Frames, true, BufferLayout::Interleaved>(),
+              makeFixedBlockKernelSet<Channels, Frames, true, BufferLayout::Planar>() }
+        }};
+    }
+
+    // Production formats: mono/stereo host blocks, 5.1 and 7.1 spatial renders
+    constexpr FixedBlockKernels kFixedBlockKernels[] = {
+        makeFixedBlockKernels<1, 256>(),
+        makeFixedBlockKernels<2, 128>(),
+        makeFixedBlockKernels<2, 256>(),
+        makeFixedBlockKernels<2, 512>(),
+        makeFixedBlockKernels<6, 512>(),
+        makeFixedBlockKernels<8, 512>()
+    };
+
+    const FixedBlockKernels* findFixedBlockKernels(int channels, size_t frames) noexcept {
+        for (const FixedBlockKernels& candidate : kFixedBlockKernels) {
+            if (candidate.channels == channels && candidate.frames == frames) {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    ProcessingPrecision validatedPrecision(ProcessingPrecision precision) {
+        if (precision > ProcessingPrecision::Q15) {
+            throw std::invalid_argument("Unknown processing precision");
+        }
+        return precision;
+    }
+}
+
+class DSPKernelImpl final : public DSPKernel {
+public:
+    DSPKernelImpl(double sampleRate, int channels, DenormalMode denormalMode, size_t maxFrames,
+                  ProcessingPrecision precision)
+        : DSPKernel(sampleRate, channels, denormalMode, maxFrames)
+        , kernels(activeDenormalMode == DenormalMode::VectorThreshold ? &kThresholdKernels : &kPassThroughKernels)
+        , backend(&activeDSPBackend())
+        , precision(validatedPrecision(precision))
+        , reduced(activeReducedPrecisionBackend(precision))
+        , fixedBlock(nullptr)
+        , rampBuffer(nullptr)
+        , expandedRamp(nullptr)
+        , gain(1.0f)
+        , hasPendingEvent(false)
+    {
+        prepareResources(maxFrames, channels, sampleRate);
+    }
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override {
+        const DSPBatchItem item{input, output};
+        processBatch(&item, 1);
+    }
+
+    void processBatch(const DSPBatchItem* items, size_t count) noexcept override {
+        if (bypass.load(std::memory_order_relaxed)) {
+            for (size_t i = 0; i < count; ++i) {
+                if (acceptsBlock(items[i].input, items[i].output)) {
+                    passThrough(items[i].input, items[i].output);
+                }
+            }
+            return;
+        }
+
+        // Flush-to-zero is per thread, so it is enabled on the render thread per call
+        const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+        const uint64_t startTicks = mach_absolute_time();
+
+        applyPendingReset();
+
+        size_t renderedFrames = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (acceptsBlock(items[i].input, items[i].output)) {
+                renderBlock(items[i].input, items[i].output);
+                renderedFrames += items[i].input.frames;
+            }
+        }
+
+        if (renderedFrames > 0) {
+            recordBlockTiming(startTicks, mach_absolute_time(), renderedFrames);
+        }
+    }
+
+    std::unique_ptr<DSPKernel> fork() const override {
+        auto clone = std::make_unique<DSPKernelImpl>(sampleRate, numChannels, activeDenormalMode, maxFrames,
+                                                     precision);
+        copyControlStateTo(*clone);
+        return clone;
+    }
+
+    ProcessingPrecision processingPrecision() const noexcept override {
+        return precision;
+    }
+
+protected:
+    // Gain lives in the parameter values, so the header and the precision are the whole state
+    KernelStateType stateType() const noexcept override {
+        return KernelStateType::Gain;
+    }
+
+    void writeState(KernelStateWriter& writer) const override {
+        writer.write(static_cast<uint8_t>(precision));
+    }
+
+private:
+    const LayoutKernelSets* kernels;       // Specializations for the active denormal mode
+    const DSPBackend* backend;             // Contiguous-run loops for this CPU
+    const ProcessingPrecision precision;
+    const ReducedPrecisionBackend* reduced; // Reduced-precision loops, null for Float32
+    const FixedBlockKernels* fixedBlock;   // Full-block specialization for the prepared format, if any
+    float* inputStagePlanes[MAX_CHANNELS];  // Channel pointers into inputBuffer when staging
+    float* outputStagePlanes[MAX_CHANNELS]; // Channel pointers into outputBuffer when staging
+    float* rampBuffer;                     // Per-sample parameter values for the current segment
+    float* expandedRamp;                   // Reduced precision: ramp repeated per channel, interleaved
+    SmoothedParameter gain;                // Linear gain, ramped per sample
+    ParameterEvent pendingEvent;           // Next event not yet due (render thread only)
+    bool hasPendingEvent;
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double) override {
+        // One pooled block for both staging buffers and the ramp, each cache-line aligned.
+        // Every region is written before it is read, so recycled contents are never seen.
+        const size_t stride = alignedFloats(maxFramesPerBlock * static_cast<size_t>(channels));
+        const size_t stagedRegions = reduced ? 3 : 2;
+        scratch = acquireScratch(stagedRegions * stride + alignedFloats(maxFramesPerBlock));
+        inputBuffer = scratch.data();
+        outputBuffer = inputBuffer + stride;
+        expandedRamp = reduced ? outputBuffer + stride : nullptr;
+        rampBuffer = outputBuffer + (stagedRegions - 1) * stride;
+        fixedBlock = reduced ? nullptr : findFixedBlockKernels(channels, maxFramesPerBlock);
+    }
+
+    bool hasFixedBlockKernel() const noexcept override {
+        return fixedBlock != nullptr;
+    }
+
+    static size_t alignedFloats(size_t count) noexcept {
+        constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+        return (count + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    }
+
+    bool acceptsBlock(const AudioBufferView& input, const AudioBufferView& output) const noexcept {
+        return input.isValid() && output.isValid() && output.frames == input.frames &&
+               input.channels == numChannels && output.channels == numChannels &&
+               input.frames <= maxFrames;
+    }
+
+    void renderBlock(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+        const size_t frameCount = input.frames;
+
+        // Work directly on the host buffers; stage only the side that is misaligned
+        AudioBufferView source = input;
+        if (!isBufferAligned(input)) {
+            source = makeStagingView(input.layout, inputBuffer, inputStagePlanes, frameCount);
+            copyBufferView(input, source, frameCount);
+        }
+        const bool stageOutput = !isBufferAligned(output);
+        const AudioBufferView destination = stageOutput
+            ? makeStagingView(output.layout, outputBuffer, outputStagePlanes, frameCount)
+            : output;
+
+        // Render sub-blocks between sample-accurate parameter events
+        size_t position = 0;
+        while (position < frameCount) {
+            applyDueParameterEvents(position);
+
+            const size_t segmentEnd = hasPendingEvent
+                ? std::min(static_cast<size_t>(pendingEvent.sampleOffset), frameCount)
+                : frameCount;
+
+            processSegment(source, destination, position, segmentEnd - position);
+            position = segmentEnd;
+        }
+
+        // Events scheduled past this block carry over to the next one
+        if (hasPendingEvent) {
+            pendingEvent.sampleOffset -= static_cast<uint32_t>(frameCount);
+        }
+
+        if (stageOutput) {
+            copyBufferView(destination, output, frameCount);
+        }
+    }
+
+    void resetState() noexcept override {
+        // Staging buffers are always overwritten before use, so only ramp state is cleared
+        gain.jumpTo(1.0f);
+        hasPendingEvent = false;
+    }
+
+    void applyDueParameterEvents(size_t position) noexcept {
+        // Bounded by queue capacity; never waits on the control thread
+        for (;;) {
+            if (!hasPendingEvent) {
+                if (!parameterEvents.pop(pendingEvent)) {
+                    return;
+                }
+                hasPendingEvent = true;
+            }
+
+            if (pendingEvent.sampleOffset > position) {
+                return;
+            }
+
+            applyParameterEvent(pendingEvent);
+            hasPendingEvent = false;
+        }
+    }
+
+    void applyParameterEvent(const ParameterEvent& event) noexcept {
+        switch (event.parameterID) {
+            case kParameterGain:
+                // Gain ramps are exponential (linear in dB) unless the event says otherwise
+                if (event.rampFrames == 0) {
+                    gain.setTarget(gainFromDecibels(event.value), defaultRampFrames(), RampShape::Exponential);
+                }
+                else {
+                    gain.setTarget(gainFromDecibels(event.value), event.rampFrames, event.shape);
+                }
+                break;
+            // Add additional parameter handlers here
+            default:
+                break;
+        }
+    }
+
+    void processSegment(const AudioBufferView& source, const AudioBufferView& destination,
+                        size_t start, size_t length) noexcept {
+        if (reduced) {
+            processReducedSegment(source, destination, start, length);
+            return;
+        }
+
+        // A whole host block in a production format runs with constant trip counts
+        const bool ramping = gain.isRamping();
+        if (fixedBlock && length == fixedBlock->frames && source.layout == destination.layout) {
+            const FixedBlockKernelSet& fixed =
+                fixedBlock->select(activeDenormalMode == DenormalMode::VectorThreshold, source.layout);
+            if (ramping) {
+                gain.render(rampBuffer, length);
+                fixed.ramp(source, destination, start, length, 1.0f, rampBuffer);
+            }
+            else if (gain.value() == 1.0f) {
+                fixed.unity(source, destination, start, length, 1.0f, nullptr);
+            }
+            else {
+                fixed.constant(source, destination, start, length, gain.value(), nullptr);
+            }
+            return;
+        }
+
+        // Matching layouts reduce to contiguous runs for the hand-vectorized backend; an
+        // interleaved ramp (one value per frame) and layout conversion stay on the fused tables
+        if (source.layout == destination.layout && (source.layout == BufferLayout::Planar || !ramping)) {
+            if (ramping) {
+                gain.render(rampBuffer, length);
+            }
+            if (source.layout == BufferLayout::Planar) {
+                for (int channel = 0; channel < numChannels; ++channel) {
+                    processRun(source.planes[channel] + start, destination.planes[channel] + start, length, ramping);
+                }
+            }
+            else {
+                const size_t offset = start * static_cast<size_t>(numChannels);
+                processRun(source.interleaved + offset, destination.interleaved + offset,
+                           length * static_cast<size_t>(numChannels), ramping);
+            }
+            return;
+        }
+
+        const size_t kernelIndex = static_cast<size_t>(numChannels - 1);
+        const FusedKernelSet& layoutKernels = kernels->select(source.layout, destination.layout);
+
+        if (gain.isRamping()) {
+            // One ramp shared by all channels
+            gain.render(rampBuffer, length);
+            layoutKernels.ramp[kernelIndex](source, destination, start, length, 1.0f, rampBuffer);
+        }
+        else if (gain.value() == 1.0f) {
+            layoutKernels.unity[kernelIndex](source, destination, start, length, 1.0f, nullptr);
+        }
+        else {
+            layoutKernels.constant[kernelIndex](source, destination, start, length, gain.value(), nullptr);
+        }
+    }
+
+    void processRun(const float* in, float* out, size_t count, bool ramping) noexcept {
+        const bool flush = activeDenormalMode == DenormalMode::VectorThreshold;
+        if (ramping) {
+            (flush ? backend->rampFlush : backend->ramp)(in, out, rampBuffer, count);
+        }
+        else if (gain.value() != 1.0f) {
+            (flush ? backend->gainFlush : backend->gain)(in, out, count, gain.value());
+        }
+        else if (flush) {
+            backend->flush(in, out, count);
+        }
+        else if (in != out) {
+            std::memcpy(out, in, count * sizeof(float));
+        }
+    }
+
+    void processReducedSegment(const AudioBufferView& source, const AudioBufferView& destination,
+                               size_t start, size_t length) noexcept {
+        const bool ramping = gain.isRamping();
+        if (ramping) {
+            gain.render(rampBuffer, length);
+        }
+
+        // Layout conversion is exact, so it runs first and the reduced pass works in place
+        const AudioBufferView* in = &source;
+        if (source.layout != destination.layout) {
+            const size_t kernelIndex = static_cast<size_t>(numChannels - 1);
+            kPassThroughKernels.select(source.layout, destination.layout)
+                .unity[kernelIndex](source, destination, start, length, 1.0f, nullptr);
+            in = &destination;
+        }
+
+        if (destination.layout == BufferLayout::Planar) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float* runIn = in->planes[channel] + start;
+                float* runOut = destination.planes[channel] + start;
+                if (ramping) {
+                    reduced->ramp(runIn, runOut, rampBuffer, length);
+                }
+                else {
+                    reduced->gain(runIn, runOut, length, gain.value());
+                }
+            }
+            return;
+        }
+
+        const size_t offset = start * static_cast<size_t>(numChannels);
+        const size_t count = length * static_cast<size_t>(numChannels);
+        if (!ramping) {
+            reduced->gain(in->interleaved + offset, destination.interleaved + offset, count, gain.value());
+            return;
+        }
+
+        // One ramp value per frame, repeated across the channels so the run stays contiguous
+        for (size_t frame = 0; frame < length; ++frame) {
+            std::fill_n(expandedRamp + frame * static_cast<size_t>(numChannels), numChannels, rampBuffer[frame]);
+        }
+        reduced->ramp(in->interleaved + offset, destination.interleaved + offset, expandedRamp, count);
+    }
+
+    static float gainFromDecibels(float gainDB) noexcept {
+        // Clamp gain to valid range
+        gainDB = std::clamp(gainDB, MIN_GAIN_DB, MAX_GAIN_DB);
+        
+        // Convert dB to linear gain with denormal protection
+        const float minGain = std::pow(10.0f, MIN_GAIN_DB / 20.0f);
+        return std::max(minGain, std::pow(10.0f, gainDB / 20.0f));
+    }
+};
+
+// Factory function implementation
+std::unique_ptr<DSPKernel> createDSPKernel(double sampleRate, int channels, DenormalMode denormalMode,
+                                           size_t maxFrames, ProcessingPrecision precision) {
+    return std::make_unique<DSPKernelImpl>(sampleRate, channels, denormalMode, maxFrames, precision);
+}
+
+} // namespace dsp
+} // namespace tald
\ No newline at end of file
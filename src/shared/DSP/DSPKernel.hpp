@@ -0,0 +1,699 @@
+//
+// DSPKernel.hpp
+// TALD UNIA Audio System
+//
+// Shared C++ DSP kernel core used by both the macOS and iOS apps. Platform tuning
+// and SIMD backend selection live in DSPConfig.hpp.
+//
+// External Dependencies:
+// - Accelerate (macOS 13.0+ / iOS 13.0+) - SIMD-optimized DSP operations
+// - CoreAudioTypes (macOS 13.0+ / iOS 13.0+) - AudioBufferList
+
+#ifndef TALD_UNIA_DSP_KERNEL_HPP
+#define TALD_UNIA_DSP_KERNEL_HPP
+
+#include <algorithm>   // C++20
+#include <atomic>      // C++20
+#include <bit>         // C++20
+#include <cstdint>     // C++20
+#include <cstdlib>     // C++20
+#include <cstring>     // C++20
+#include <memory>      // C++20
+#include <stdexcept>   // C++20
+#include <vector>      // C++20
+#include <Accelerate/Accelerate.h> // Apple SDK
+#include <CoreAudioTypes/CoreAudioTypes.h> // Apple SDK
+#include <mach/mach_time.h> // Apple SDK
+#include "DSPConfig.hpp"
+#include "DSPBufferLayout.hpp"
+#include "DSPDenormals.hpp"
+#include "DSPFFTSetupCache.hpp"
+#include "DSPKernelState.hpp"
+#include "DSPMetrics.hpp"
+#include "DSPParameters.hpp"
+#include "DSPPrecision.hpp"
+#include "DSPScratchPool.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Allocates cache-line aligned memory for SIMD operations
+ * @param size Memory size in bytes
+ * @param alignment Required memory alignment (must be power of 2)
+ * @return Aligned memory pointer or nullptr on failure
+ */
+[[nodiscard]]
+inline void* alignedMalloc(size_t size, size_t alignment) {
+    if ((alignment & (alignment - 1)) != 0) {
+        return nullptr; // Alignment must be power of 2
+    }
+    
+    if (alignment < DSP_ALIGNMENT) {
+        alignment = DSP_ALIGNMENT;
+    }
+    
+    void* ptr = nullptr;
+    #ifdef __APPLE__
+        if (posix_memalign(&ptr, alignment, size) != 0) {
+            return nullptr;
+        }
+    #else
+        ptr = aligned_alloc(alignment, size);
+    #endif
+    
+    if (ptr) {
+        memset(ptr, 0, size);
+    }
+    return ptr;
+}
+
+/**
+ * @brief Safely frees aligned memory
+ * @param ptr Pointer to aligned memory
+ */
+inline void alignedFree(void* ptr) noexcept {
+    if (ptr) {
+        free(ptr);
+    }
+}
+
+// Shared FFT setup size: supports real transforms up to 2 * MAX_BUFFER_SIZE points
+constexpr vDSP_Length KERNEL_FFT_LOG2N = std::bit_width(MAX_BUFFER_SIZE);
+
+/**
+ * @brief One block of a DSPKernel::processBatch() call; the frame count is the views'
+ */
+struct DSPBatchItem {
+    AudioBufferView input;
+    AudioBufferView output;
+};
+
+/**
+ * @brief Abstract base class for DSP kernel implementations
+ * Provides SIMD-optimized audio processing with hardware acceleration support.
+ * Construction fully prepares the kernel; invalid configurations throw. Working
+ * memory is borrowed from the process-wide scratch pool and sized to maxFrames, so
+ * creating and destroying kernels of a configuration already seen never reaches
+ * the system allocator.
+ *
+ * Concurrency model: one kernel per render context. process() is called by one
+ * render thread at a time and is never skipped; parameters, bypass and reset come
+ * from a control thread through lock-free channels. Additional render contexts
+ * (parallel offline renders, voices) each get their own instance from fork(),
+ * which shares immutable state and so scales across cores without contention.
+ */
+class alignas(DSP_ALIGNMENT) DSPKernel {
+public:
+    /**
+     * @brief Constructs DSP kernel with audio configuration
+     * @param sampleRate Audio sample rate (Hz)
+     * @param channels Number of audio channels
+     * @param denormalMode Requested denormal handling; falls back to VectorThreshold
+     *                     when hardware flush-to-zero is unavailable
+     * @param maxFrames Largest block process() accepts; sizes all per-kernel scratch
+     * @throws std::invalid_argument if parameters are out of valid range
+     */
+    DSPKernel(double sampleRate, int channels, DenormalMode denormalMode = DenormalMode::HardwareFTZ,
+              size_t maxFrames = MAX_BUFFER_SIZE)
+        : inputBuffer(nullptr)
+        , outputBuffer(nullptr)
+        , maxFrames(maxFrames)
+        , numChannels(channels)
+        , sampleRate(sampleRate)
+        , bypass(false)
+        , resetRequested(false)
+        , fftSetup(nullptr)
+        , activeDenormalMode(resolveDenormalMode(denormalMode))
+    {
+        validateConfiguration(maxFrames, channels, sampleRate);
+
+        // Twiddle tables come from the process-wide cache and are shared by all kernels
+        sharedFFTSetup = acquireFFTSetup(KERNEL_FFT_LOG2N, kFFTRadix2);
+        fftSetup = sharedFFTSetup.get();
+        if (!fftSetup) {
+            throw std::runtime_error("Failed to initialize vDSP setup");
+        }
+
+        // Resolve the host timebase once, off the render thread
+        ticksToNanoseconds = hostTicksToNanoseconds();
+    }
+
+    virtual ~DSPKernel() = default;
+
+    /**
+     * @brief Reconfigure for a new host format, like AUAudioUnit allocateRenderResources
+     * @param maxFramesPerBlock Largest block process() will be given
+     * @param channels Number of audio channels
+     * @param sampleRate Audio sample rate (Hz)
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     *
+     * Re-sizes and re-lays out all scratch for the new limits, so a kernel run at
+     * 256-frame blocks keeps a working set that fits in cache. Control thread only,
+     * while rendering is stopped: it must not overlap process(). Signal history is
+     * cleared; bypass and parameter values are kept. On failure the kernel keeps its
+     * previous configuration.
+     */
+    void prepare(size_t maxFramesPerBlock, int channels, double sampleRate) {
+        validateConfiguration(maxFramesPerBlock, channels, sampleRate);
+        prepareResources(maxFramesPerBlock, channels, sampleRate);
+
+        maxFrames = maxFramesPerBlock;
+        numChannels = channels;
+        this->sampleRate = sampleRate;
+        resetState();
+
+        // Ramps restart at the new rate from the latest values
+        copyControlStateTo(*this);
+    }
+
+    // Prevent copying
+    DSPKernel(const DSPKernel&) = delete;
+    DSPKernel& operator=(const DSPKernel&) = delete;
+
+    /**
+     * @brief Process one block between two buffer views using SIMD operations
+     * @param input Input buffer view
+     * @param output Output buffer view (may be the same view for in-place processing)
+     *
+     * Both views must carry numChannels channels and the same frame count. Each
+     * layout pair has its own SIMD path; interleave/deinterleave is fused into the
+     * processing pass and only happens when the two layouts differ. Aligned host
+     * buffers are processed directly; the internal inputBuffer and outputBuffer are
+     * used as staging only when a pointer fails isBufferAligned(). Input and output
+     * must either be identical or not overlap. Not re-entrant: a second render
+     * context must use its own fork().
+     */
+    virtual void process(const AudioBufferView& input, const AudioBufferView& output) noexcept = 0;
+
+    /**
+     * @brief Process several blocks of one stream in a single call
+     * @param items Blocks in stream order; each obeys the same rules as process()
+     * @param count Number of blocks
+     *
+     * Equivalent to calling process() on each item in turn, including parameter
+     * events and ramps that run across block boundaries, but per-call setup (bypass
+     * check, flush-to-zero, pending reset, timing) happens once for the whole batch
+     * and the metrics record the batch as one block. Invalid items are skipped.
+     */
+    virtual void processBatch(const DSPBatchItem* items, size_t count) noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            process(items[i].input, items[i].output);
+        }
+    }
+
+    /**
+     * @brief Process contiguous planar audio (channel c starts at c * frameCount)
+     * @param input Input audio buffer
+     * @param output Output audio buffer (may equal input for in-place processing)
+     * @param frameCount Number of frames to process
+     */
+    void process(const float* input, float* output, size_t frameCount) noexcept {
+        if (!input || !output) {
+            return;
+        }
+        // Kernels never write through an input view
+        float* inputPlanes[MAX_CHANNELS];
+        float* outputPlanes[MAX_CHANNELS];
+        for (int channel = 0; channel < numChannels; ++channel) {
+            inputPlanes[channel] = const_cast<float*>(input) + channel * frameCount;
+            outputPlanes[channel] = output + channel * frameCount;
+        }
+        process(AudioBufferView::makePlanar(inputPlanes, numChannels, frameCount),
+                AudioBufferView::makePlanar(outputPlanes, numChannels, frameCount));
+    }
+
+    /**
+     * @brief Process non-interleaved audio given one pointer per channel
+     * @param inputs numChannels input channel pointers
+     * @param outputs numChannels output channel pointers
+     * @param frameCount Number of frames to process
+     */
+    void processPlanar(const float* const* inputs, float* const* outputs, size_t frameCount) noexcept {
+        process(AudioBufferView::makePlanar(const_cast<float* const*>(inputs), numChannels, frameCount),
+                AudioBufferView::makePlanar(outputs, numChannels, frameCount));
+    }
+
+    /**
+     * @brief Process interleaved audio
+     * @param input Interleaved input samples (frameCount * numChannels)
+     * @param output Interleaved output samples (may equal input)
+     * @param frameCount Number of frames to process
+     */
+    void processInterleaved(const float* input, float* output, size_t frameCount) noexcept {
+        process(AudioBufferView::makeInterleaved(const_cast<float*>(input), numChannels, frameCount),
+                AudioBufferView::makeInterleaved(output, numChannels, frameCount));
+    }
+
+    /**
+     * @brief Process an AudioUnit render buffer list in whichever layout it uses
+     * @param input Input buffer list (one interleaved buffer or one buffer per channel)
+     * @param output Output buffer list (may use a different layout than input)
+     * @param frameCount Number of frames to process
+     */
+    void process(const AudioBufferList* input, AudioBufferList* output, size_t frameCount) noexcept {
+        float* inputPlanes[MAX_CHANNELS];
+        float* outputPlanes[MAX_CHANNELS];
+        process(makeBufferView(input, inputPlanes, frameCount),
+                makeBufferView(output, outputPlanes, frameCount));
+    }
+
+    /**
+     * @brief Request that all signal state be cleared
+     *
+     * Wait-free and allocation-free, callable from any thread. The render thread
+     * clears history and parameter ramps at the start of its next block; loaded
+     * filters and configuration are kept. Blocks already in flight finish unchanged.
+     */
+    void reset() noexcept {
+        resetRequested.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Begin an unrelated stream on the render thread, at the latest parameter values
+     *
+     * Clears signal history immediately (unlike reset()) and starts the next block
+     * exactly on the current parameters, without control ramps. For renderers that
+     * push many independent streams through one kernel; must not overlap process()
+     * or run alongside a control thread scheduling parameters.
+     */
+    void restartStream() noexcept {
+        resetRequested.store(false, std::memory_order_relaxed);
+        resetState();
+        copyControlStateTo(*this);
+    }
+
+    /**
+     * @brief Whether a reset has been requested but not yet applied by the render thread
+     */
+    [[nodiscard]]
+    bool isResetPending() const noexcept {
+        return resetRequested.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Set processing parameter using the default ramp
+     * @param parameterID Parameter identifier
+     * @param value Parameter value
+     *
+     * Safe to call from a single control thread while process() runs; the update
+     * is queued lock-free and applied by the render thread at the next block.
+     */
+    virtual void setParameter(int parameterID, float value) noexcept {
+        ParameterEvent event;
+        event.parameterID = parameterID;
+        event.value = value;
+        scheduleParameter(event);
+    }
+
+    /**
+     * @brief Schedule a sample-accurate parameter change with an explicit ramp
+     * @param event Parameter event (offset, ramp length and curve)
+     */
+    void scheduleParameter(const ParameterEvent& event) noexcept {
+        if (event.parameterID >= 0 && event.parameterID < MAX_PARAMETERS) {
+            controlValues[event.parameterID] = event.value;
+            controlValueMask |= 1u << event.parameterID;
+        }
+        parameterEvents.push(event);
+    }
+
+    /**
+     * @brief Create an independent kernel for another render context (control thread)
+     *
+     * The fork has the same configuration, bypass state and latest parameter
+     * values, its own signal state, and shares immutable state (FFT setup, filter
+     * coefficients) with this kernel instead of rebuilding it. Allocates.
+     * @throws std::runtime_error if allocation fails
+     */
+    [[nodiscard]]
+    virtual std::unique_ptr<DSPKernel> fork() const = 0;
+
+    /**
+     * @brief Save configuration, bypass, latest parameters and precomputed tables (control thread)
+     *
+     * The blob rebuilds through restoreState() into a kernel that renders like a
+     * fork of this one, without redesigning coefficients or re-transforming
+     * filters. Signal history is not saved. Allocates.
+     * @throws std::invalid_argument if this kernel type has no state format
+     */
+    [[nodiscard]]
+    std::vector<uint8_t> serializeState() const;
+
+    /**
+     * @brief Build a ready-to-render kernel from serializeState() output, off the render thread
+     * @throws std::runtime_error if the blob is truncated, corrupt or of another version
+     */
+    [[nodiscard]]
+    static std::unique_ptr<DSPKernel> restoreState(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Thread-safe method to set the bypass state
+     * @param shouldBypass True to pass audio through unprocessed
+     */
+    void setBypassed(bool shouldBypass) noexcept {
+        bypass.store(shouldBypass, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    bool isBypassed() const noexcept {
+        return bypass.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    int channelCount() const noexcept {
+        return numChannels;
+    }
+
+    /**
+     * @brief Largest block process() accepts; longer blocks are ignored
+     */
+    [[nodiscard]]
+    size_t maximumFramesPerBlock() const noexcept {
+        return maxFrames;
+    }
+
+    /**
+     * @brief Whether full blocks run through loops specialized for this (channels, block size)
+     *
+     * Resolved by construction and prepare() from maxFrames; shorter blocks and
+     * split segments still take the generic path.
+     */
+    [[nodiscard]]
+    virtual bool hasFixedBlockKernel() const noexcept {
+        return false;
+    }
+
+    [[nodiscard]]
+    double currentSampleRate() const noexcept {
+        return sampleRate;
+    }
+
+    /**
+     * @brief Wall-clock time spent in the most recent process() call
+     */
+    [[nodiscard]]
+    float lastBlockLatencyMs() const noexcept {
+        return blockMetrics.lastBlockMs();
+    }
+
+    /**
+     * @brief Fraction of the most recent block's real-time budget spent processing
+     */
+    [[nodiscard]]
+    float processingLoad() const noexcept {
+        return blockMetrics.lastBlockLoad();
+    }
+
+    /**
+     * @brief Block time and load histograms, overrun and xrun counters
+     *
+     * Take snapshots and clear from a non-real-time thread; hosts report device
+     * overloads through reportXrun().
+     */
+    [[nodiscard]]
+    DSPBlockMetrics& metrics() noexcept {
+        return blockMetrics;
+    }
+
+    [[nodiscard]]
+    const DSPBlockMetrics& metrics() const noexcept {
+        return blockMetrics;
+    }
+
+    /**
+     * @brief Denormal handling strategy in effect for this kernel
+     */
+    [[nodiscard]]
+    DenormalMode denormalMode() const noexcept {
+        return activeDenormalMode;
+    }
+
+    /**
+     * @brief Arithmetic format of the signal path, fixed when the kernel is created
+     */
+    [[nodiscard]]
+    virtual ProcessingPrecision processingPrecision() const noexcept {
+        return ProcessingPrecision::Float32;
+    }
+
+protected:
+    float* inputBuffer;                    // Input staging, maxFrames * numChannels, or null
+    float* outputBuffer;                   // Output staging, maxFrames * numChannels, or null
+    size_t maxFrames;                      // Largest block process() accepts
+    int numChannels;                       // Number of audio channels
+    double sampleRate;                     // Audio sample rate
+    std::atomic<bool> bypass;              // Bypass processing flag
+    std::atomic<bool> resetRequested;      // Set by reset(), consumed by the render thread
+    SharedFFTSetup sharedFFTSetup;         // Keeps the cached setup alive
+    FFTSetup fftSetup;                     // Read-only, shared across kernels
+    ScratchBlock scratch;                  // Subclass working memory, borrowed from the pool
+    ParameterEventQueue parameterEvents;   // Control-to-render parameter channel
+    const DenormalMode activeDenormalMode; // Denormal strategy chosen at construction
+    double ticksToNanoseconds;             // Cached mach timebase conversion
+    DSPBlockMetrics blockMetrics;
+    float controlValues[MAX_PARAMETERS] = {}; // Latest value sent per parameter (control thread)
+    uint32_t controlValueMask = 0;            // Parameters present in controlValues
+
+    /**
+     * @brief Hand bypass and the latest parameter values to a freshly forked kernel
+     *
+     * Values are queued with a one-frame ramp so the fork starts on them exactly.
+     */
+    void copyControlStateTo(DSPKernel& clone) const noexcept {
+        clone.setBypassed(isBypassed());
+        uint32_t parameters = controlValueMask;
+        while (parameters) {
+            const int parameterID = std::countr_zero(parameters);
+            parameters &= parameters - 1;
+
+            ParameterEvent event;
+            event.parameterID = parameterID;
+            event.value = controlValues[parameterID];
+            event.rampFrames = 1;
+            clone.scheduleParameter(event);
+        }
+    }
+
+    /**
+     * @brief Queue an event on a kernel this one owns, bypassing its control state
+     *
+     * For wrappers that feed an inner kernel from their own render thread, which then
+     * becomes the inner kernel's only event producer. The inner kernel's latest-value
+     * record is left untouched, so forking it never races the render thread.
+     */
+    static void forwardParameterEvent(DSPKernel& target, const ParameterEvent& event) noexcept {
+        target.parameterEvents.push(event);
+    }
+
+    /**
+     * @brief State format written by serializeState(); None makes it throw
+     */
+    [[nodiscard]]
+    virtual KernelStateType stateType() const noexcept {
+        return KernelStateType::None;
+    }
+
+    /**
+     * @brief Append the type-specific payload after the common header (control thread)
+     */
+    virtual void writeState(KernelStateWriter& writer) const {
+        (void)writer;
+    }
+
+    /**
+     * @brief Allocate and lay out working memory for a new configuration (control thread)
+     * @param maxFramesPerBlock Validated largest block size
+     * @param channels Validated channel count
+     * @param sampleRate Validated sample rate (Hz), for rate-dependent tables
+     *
+     * Called by prepare() before the new limits are committed, so implementations
+     * must build everything first and only then replace their current state; it is
+     * followed by resetState(). The default has nothing to size.
+     */
+    virtual void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+        (void)maxFramesPerBlock;
+        (void)channels;
+        (void)sampleRate;
+    }
+
+    /**
+     * @brief Clear signal state (render thread only, between blocks)
+     *
+     * Must not allocate, lock or wait; called from applyPendingReset() and prepare().
+     */
+    virtual void resetState() noexcept = 0;
+
+    /**
+     * @brief Apply a reset requested since the last block (render thread, block start)
+     */
+    void applyPendingReset() noexcept {
+        if (resetRequested.load(std::memory_order_relaxed) &&
+            resetRequested.exchange(false, std::memory_order_acquire)) {
+            resetState();
+        }
+    }
+
+    /**
+     * @brief Reject configurations the kernel cannot render
+     * @throws std::invalid_argument if any value is out of valid range
+     */
+    static void validateConfiguration(size_t maxFramesPerBlock, int channels, double sampleRate) {
+        if (sampleRate < MIN_SAMPLE_RATE || sampleRate > MAX_SAMPLE_RATE) {
+            throw std::invalid_argument("Sample rate out of valid range");
+        }
+        if (channels <= 0 || channels > MAX_CHANNELS) {
+            throw std::invalid_argument("Invalid channel count");
+        }
+        if (maxFramesPerBlock == 0 || maxFramesPerBlock > MAX_BUFFER_SIZE) {
+            throw std::invalid_argument("Maximum frame count out of valid range");
+        }
+    }
+
+    /**
+     * @brief Record timing and load for a processed block (render thread, wait-free)
+     * @param startTicks mach_absolute_time() at block start
+     * @param endTicks mach_absolute_time() at block end
+     * @param frameCount Frames processed
+     */
+    void recordBlockTiming(uint64_t startTicks, uint64_t endTicks, size_t frameCount) noexcept {
+        const double elapsedNs = static_cast<double>(endTicks - startTicks) * ticksToNanoseconds;
+        const double budgetNs = static_cast<double>(frameCount) * 1.0e9 / sampleRate;
+        blockMetrics.record(static_cast<uint64_t>(elapsedNs), budgetNs);
+    }
+
+    /**
+     * @brief Copy input to output unchanged, skipping the copy when processing in place
+     */
+    void passThrough(const AudioBufferView& input, const AudioBufferView& output) const noexcept {
+        if (input.aliases(output)) {
+            return;
+        }
+        if (input.layout == output.layout) {
+            copyBufferView(input, output, input.frames);
+            return;
+        }
+        for (size_t frame = 0; frame < input.frames; ++frame) {
+            for (int channel = 0; channel < numChannels; ++channel) {
+                const float sample = (input.layout == BufferLayout::Planar)
+                    ? input.planes[channel][frame]
+                    : input.interleaved[frame * numChannels + channel];
+                if (output.layout == BufferLayout::Planar) {
+                    output.planes[channel][frame] = sample;
+                }
+                else {
+                    output.interleaved[frame * numChannels + channel] = sample;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Default parameter ramp length for the current sample rate
+     */
+    [[nodiscard]]
+    uint32_t defaultRampFrames() const noexcept {
+        return static_cast<uint32_t>(sampleRate * DEFAULT_RAMP_TIME_SECONDS);
+    }
+
+    /**
+     * @brief Apply the threshold pass when the kernel runs in VectorThreshold mode
+     * @param buffer Samples to flush in place
+     * @param count Number of samples
+     */
+    void flushDenormalsIfNeeded(float* buffer, size_t count) const noexcept {
+        if (activeDenormalMode == DenormalMode::VectorThreshold) {
+            flushDenormals(buffer, count);
+        }
+    }
+
+    /**
+     * @brief Verify buffer alignment for SIMD operations
+     * @param ptr Buffer pointer to check
+     * @return true if properly aligned
+     */
+    [[nodiscard]]
+    bool isBufferAligned(const void* ptr) const noexcept {
+        return (reinterpret_cast<std::uintptr_t>(ptr) % DSP_ALIGNMENT) == 0;
+    }
+
+    /**
+     * @brief Verify every channel pointer of a view is SIMD aligned
+     */
+    [[nodiscard]]
+    bool isBufferAligned(const AudioBufferView& view) const noexcept {
+        if (view.layout == BufferLayout::Interleaved) {
+            return isBufferAligned(view.interleaved);
+        }
+        for (int channel = 0; channel < view.channels; ++channel) {
+            if (!isBufferAligned(view.planes[channel])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief View over an internal staging buffer with the same layout as a host view
+     * @param storage Staging storage of at least frameCount * numChannels floats
+     * @param planeStorage Per-channel pointer storage used for planar views
+     */
+    [[nodiscard]]
+    AudioBufferView makeStagingView(BufferLayout layout, float* storage, float** planeStorage,
+                                    size_t frameCount) const noexcept {
+        if (layout == BufferLayout::Interleaved) {
+            return AudioBufferView::makeInterleaved(storage, numChannels, frameCount);
+        }
+        for (int channel = 0; channel < numChannels; ++channel) {
+            planeStorage[channel] = storage + channel * frameCount;
+        }
+        return AudioBufferView::makePlanar(planeStorage, numChannels, frameCount);
+    }
+
+    /**
+     * @brief Map an AudioBufferList onto a view without copying
+     */
+    [[nodiscard]]
+    AudioBufferView makeBufferView(const AudioBufferList* list, float** planeStorage,
+                                   size_t frameCount) const noexcept {
+        if (!list || list->mNumberBuffers == 0) {
+            return AudioBufferView{};
+        }
+        if (list->mNumberBuffers == 1 && list->mBuffers[0].mNumberChannels > 1) {
+            return AudioBufferView::makeInterleaved(static_cast<float*>(list->mBuffers[0].mData),
+                                                    static_cast<int>(list->mBuffers[0].mNumberChannels),
+                                                    frameCount);
+        }
+        const int channelCount = static_cast<int>(std::min<UInt32>(list->mNumberBuffers, MAX_CHANNELS));
+        for (int channel = 0; channel < channelCount; ++channel) {
+            planeStorage[channel] = static_cast<float*>(list->mBuffers[channel].mData);
+        }
+        return AudioBufferView::makePlanar(planeStorage, channelCount, frameCount);
+    }
+};
+
+/**
+ * @brief Create the default DSP kernel implementation
+ * @param sampleRate Audio sample rate (Hz)
+ * @param channels Number of audio channels
+ * @param denormalMode Requested denormal handling (see DSPKernel::denormalMode for the active one)
+ * @param maxFrames Largest block the kernel will be given; smaller values shrink its scratch
+ * @param precision Arithmetic of the gain stage; reduced formats trade accuracy for
+ *        twice the samples per vector on low-power devices
+ * @throws std::invalid_argument if parameters are out of valid range
+ *
+ * Production formats (mono/256, stereo/128-512, 5.1/512, 7.1/512) get loops
+ * compiled for that exact channel count and block size when maxFrames matches,
+ * in Float32 only. Reduced precisions quantize even at unity gain, so output
+ * does not depend on the gain path taken.
+ */
+std::unique_ptr<DSPKernel> createDSPKernel(double sampleRate, int channels,
+                                           DenormalMode denormalMode = DenormalMode::HardwareFTZ,
+                                           size_t maxFrames = MAX_BUFFER_SIZE,
+                                           ProcessingPrecision precision = ProcessingPrecision::Float32);
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_KERNEL_HPP
\ No newline at end of file
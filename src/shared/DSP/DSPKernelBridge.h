@@ -0,0 +1,300 @@
+//
+// DSPKernelBridge.h
+// TALD UNIA Audio System
+//
+// Objective-C interface to the shared C++ DSP kernel so both Swift DSPProcessor
+// implementations can drive it. Imported through each app's bridging header.
+//
+// External Dependencies:
+// - Foundation (macOS 13.0+ / iOS 13.0+)
+// - CoreAudioTypes (macOS 13.0+ / iOS 13.0+) - AudioBufferList
+
+#import <Foundation/Foundation.h>
+#import <CoreAudioTypes/CoreAudioTypes.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Error domain for kernel construction failures
+extern NSErrorDomain const TALDDSPKernelErrorDomain;
+
+/// Denormal handling resolved by the kernel at construction
+typedef NS_ENUM(NSInteger, TALDDenormalMode) {
+    TALDDenormalModeHardwareFTZ = 0,
+    TALDDenormalModeVectorThreshold = 1,
+    TALDDenormalModeOff = 2
+};
+
+/// Arithmetic of the default gain kernel; reduced formats suit low-power devices
+typedef NS_ENUM(NSInteger, TALDProcessingPrecision) {
+    TALDProcessingPrecisionFloat32 = 0,
+    TALDProcessingPrecisionFloat16 = 1,
+    TALDProcessingPrecisionQ31 = 2,
+    TALDProcessingPrecisionQ15 = 3
+};
+
+/// Block statistics since the last reset, copied without blocking the render thread.
+/// Percentiles are accurate to one histogram bucket (about 20%).
+typedef struct {
+    uint64_t blockCount;
+    uint64_t overrunCount;      ///< Blocks that took longer than their real-time budget
+    uint64_t xrunCount;         ///< Device overloads reported through -reportXrun
+    float lastBlockMs;
+    float medianBlockMs;
+    float p99BlockMs;
+    float maxBlockMs;
+    float lastLoad;             ///< Fraction of the block's real-time budget
+    float medianLoad;
+    float p99Load;
+    float maxLoad;
+} TALDDSPMetrics;
+
+/// Storage mapping of a ring buffer
+typedef NS_ENUM(NSInteger, TALDRingMapping) {
+    TALDRingMappingFlat = 0,
+    TALDRingMappingMirrored = 1     ///< Pages mapped twice so wrapping regions stay contiguous
+};
+
+/// Wait-free single-producer/single-consumer ring of interleaved Float32 frames between
+/// the HAL I/O callbacks and the render thread. One thread writes, one thread reads.
+@interface TALDAudioRingBuffer : NSObject
+
+/// Frames the ring holds, at least the size requested
+@property (nonatomic, readonly) NSInteger capacity;
+@property (nonatomic, readonly) NSInteger channelCount;
+
+/// Mapping in use; a mirrored request falls back to flat where the platform cannot map it
+@property (nonatomic, readonly) TALDRingMapping mapping;
+
+/// Frames waiting to be read; exact on the reading thread
+@property (nonatomic, readonly) NSInteger availableToRead;
+
+/// Free frames; exact on the writing thread
+@property (nonatomic, readonly) NSInteger availableToWrite;
+
+- (nullable instancetype)initWithChannels:(NSInteger)channels
+                            minimumFrames:(NSInteger)minimumFrames
+                                  mapping:(TALDRingMapping)mapping
+                                    error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Copies in up to frameCount interleaved frames; returns the frames written (writer only)
+- (NSInteger)write:(const float *)frames frameCount:(NSInteger)frameCount;
+
+/// Copies out up to frameCount interleaved frames; returns the frames read (reader only)
+- (NSInteger)read:(float *)frames frameCount:(NSInteger)frameCount;
+
+/// Empties the ring; neither side may be using it
+- (void)reset;
+
+@end
+
+@interface TALDDSPKernel : NSObject
+
+/// Kernel backend chosen for this CPU ("AVX-512", "AVX2", "NEON" or "Accelerate")
+@property (class, nonatomic, readonly) NSString *backendName;
+
+@property (nonatomic, readonly) double sampleRate;
+@property (nonatomic, readonly) NSInteger channelCount;
+@property (nonatomic, readonly) TALDDenormalMode denormalMode;
+
+/// Arithmetic chosen at construction
+@property (nonatomic, readonly) TALDProcessingPrecision precision;
+
+/// Largest block the process methods accept; longer blocks are left unprocessed
+@property (nonatomic, readonly) NSInteger maximumFramesPerBlock;
+
+/// Passes audio through untouched while set; safe to toggle during rendering
+@property (nonatomic, getter=isBypassed) BOOL bypassed;
+
+/// Duration of the most recent block in milliseconds
+@property (nonatomic, readonly) float lastBlockLatency;
+
+/// Most recent block duration as a fraction of its real-time budget
+@property (nonatomic, readonly) float processingLoad;
+
+/// Histogram-based timing statistics; read from a non-real-time thread
+@property (nonatomic, readonly) TALDDSPMetrics metrics;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                               denormalMode:(TALDDenormalMode)denormalMode
+                                  precision:(TALDProcessingPrecision)precision
+                                      error:(NSError **)error;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                               denormalMode:(TALDDenormalMode)denormalMode
+                                      error:(NSError **)error;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                      error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/// Sizes all scratch for the host's negotiated format, like allocateRenderResources.
+/// Call while rendering is stopped; parameters and bypass are kept, signal history is
+/// cleared, and on failure the previous configuration stays in effect.
+- (BOOL)prepareWithMaximumFrames:(NSInteger)maximumFrames
+                        channels:(NSInteger)channels
+                      sampleRate:(double)sampleRate
+                           error:(NSError **)error;
+
+/// Contiguous planar audio: channel c starts at c * frameCount
+- (void)processPlanar:(const float *)input output:(float *)output frameCount:(NSInteger)frameCount;
+
+/// Interleaved audio, frameCount * channelCount samples
+- (void)processInterleaved:(const float *)input output:(float *)output frameCount:(NSInteger)frameCount;
+
+/// AudioUnit buffer lists in either layout
+- (void)processBufferList:(const AudioBufferList *)input
+                   output:(AudioBufferList *)output
+               frameCount:(NSInteger)frameCount;
+
+/// Renders up to frameCount frames straight from one ring's storage into another's, with
+/// no staging copy, and returns the frames rendered (limited by what input holds and
+/// output has room for). Call from input's reader that is also output's writer.
+- (NSInteger)processFromRing:(TALDAudioRingBuffer *)input
+                      toRing:(TALDAudioRingBuffer *)output
+                  frameCount:(NSInteger)frameCount;
+
+/// Queues a parameter change; call from a single control thread
+- (void)setParameter:(NSInteger)parameterID value:(float)value;
+
+- (void)reset;
+
+/// Starts the statistics in `metrics` over from the next rendered block
+- (void)resetMetrics;
+
+/// Counts a device overload (for example from a HAL overload notification); any thread
+- (void)reportXrun;
+
+/// Independent kernel of the same class for another render thread, starting from the
+/// current parameters and sharing immutable state; nil if allocation fails.
+/// Each kernel must only be rendered from one thread at a time.
+- (nullable instancetype)fork;
+
+/// Compact binary copy of the configuration, parameters and precomputed filter tables
+/// (gain, biquad cascade, convolution and dynamics kernels); call from the control thread
+- (nullable NSData *)serializedStateWithError:(NSError **)error;
+
+/// Ready-to-render kernel rebuilt from -serializedStateWithError: output without
+/// redesigning or re-transforming filters; safe to call off the main and render threads
++ (nullable TALDDSPKernel *)kernelWithSerializedState:(NSData *)state error:(NSError **)error;
+
+@end
+
+/// Partitioned FFT convolution for room correction FIRs and per-ear HRIRs
+@interface TALDConvolutionKernel : TALDDSPKernel
+
+/// Partition size in frames; render blocks of this size cost the same every block
+@property (nonatomic, readonly) NSInteger partitionSize;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                           maxImpulseLength:(NSInteger)maxImpulseLength
+                              partitionSize:(NSInteger)partitionSize
+                                      error:(NSError **)error;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                           maxImpulseLength:(NSInteger)maxImpulseLength
+                                      error:(NSError **)error;
+
+/// One Float32 impulse response per output channel. inputChannels routes each output
+/// (nil routes every channel to itself; pass @[@0, @0] for a mono source and two HRIRs).
+/// Fails if the previous set has not been picked up by the render thread yet.
+- (BOOL)setImpulseResponses:(NSArray<NSData *> *)responses
+              inputChannels:(nullable NSArray<NSNumber *> *)inputChannels
+                      error:(NSError **)error;
+
+@end
+
+/// Streaming STFT analyzer for the spectrum visualizers. Audio passes through unchanged;
+/// the render thread publishes log-frequency spectra that one reader thread (UI or
+/// WebSocket) copies out with -copyLatestSpectrum:binCount: without blocking it.
+@interface TALDSpectrumAnalyzerKernel : TALDDSPKernel
+
+/// Log-frequency bins per spectrum
+@property (nonatomic, readonly) NSInteger binCount;
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                    fftSize:(NSInteger)fftSize
+                                    hopSize:(NSInteger)hopSize
+                                   binCount:(NSInteger)binCount
+                                publishRate:(double)publishRate
+                                      error:(NSError **)error;
+
+/// Default analysis: 2048-point frames, hop 1024, 128 bins from 20 Hz to 20 kHz, 30 spectra/s
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                      error:(NSError **)error;
+
+/// Copy the newest spectrum's levels (dBFS) into magnitudes, at most binCount values.
+/// Returns its sequence number: 0 before the first spectrum, unchanged if nothing new.
+- (uint64_t)copyLatestSpectrum:(float *)magnitudes binCount:(NSInteger)binCount;
+
+/// Lower edge of a bin in Hz; bin == binCount gives the upper edge of the last one
+- (double)frequencyOfBinEdge:(NSInteger)bin;
+
+@end
+
+/// Outcome of one buffer size update
+typedef NS_ENUM(NSInteger, TALDBufferSizeDecision) {
+    TALDBufferSizeDecisionSettling = 0,  ///< Not enough blocks at this size yet
+    TALDBufferSizeDecisionHold = 1,
+    TALDBufferSizeDecisionStepDown = 2,  ///< p99 load stayed under target; halved
+    TALDBufferSizeDecisionStepUp = 3,    ///< p99 load over target; doubled
+    TALDBufferSizeDecisionBackOff = 4    ///< Xrun reported; doubled at once
+};
+
+/// Walks the HAL I/O buffer size down toward the minimum while the kernel's p99 block
+/// load stays under target, and backs off on xruns (reported through -reportXrun).
+/// Call -update from one control thread, e.g. every 100 ms, and reconfigure the device
+/// to bufferFrameCount whenever it changes. Resets the kernel's metrics on every change.
+@interface TALDBufferSizeController : NSObject
+
+/// Buffer size the device should run at
+@property (nonatomic, readonly) NSInteger bufferFrameCount;
+
+/// Changes caused by xruns or p99 load over target
+@property (nonatomic, readonly) NSInteger backoffCount;
+
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                      initialFrameCount:(NSInteger)initialFrameCount
+                      minimumFrameCount:(NSInteger)minimumFrameCount
+                      maximumFrameCount:(NSInteger)maximumFrameCount
+                             targetLoad:(float)targetLoad
+                                  error:(NSError **)error;
+
+/// Default limits: 64 to 1024 frames, p99 load target 0.4
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                      initialFrameCount:(NSInteger)initialFrameCount
+                                  error:(NSError **)error;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (TALDBufferSizeDecision)update;
+
+@end
+
+/// Kernel slot for profile switches: a kernel prepared off the render thread (typically
+/// from +kernelWithSerializedState:error:) is picked up at the next block and crossfaded in
+@interface TALDHotSwapKernel : TALDDSPKernel
+
+/// Whether the render thread is still picking up or fading in the last swap
+@property (nonatomic, readonly, getter=isSwapInProgress) BOOL swapInProgress;
+
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                       crossfadeSeconds:(double)crossfadeSeconds
+                                  error:(NSError **)error;
+
+/// Renders through a fork of kernel, which must share this kernel's format. Fails while
+/// the previous swap is still in progress; call from a single control thread.
+- (BOOL)swapToKernel:(TALDDSPKernel *)kernel error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,570 @@
+//
+// DSPKernelBridge.mm
+// TALD UNIA Audio System
+//
+// Objective-C++ wrapper owning a shared C++ DSPKernel instance.
+//
+
+#import "DSPKernelBridge.h"
+
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
+#include "ConvolutionKernel.hpp"
+#include "DSPBackend.hpp"
+#include "DSPBufferSizeController.hpp"
+#include "DSPKernel.hpp"
+#include "DSPRingBuffer.hpp"
+#include "HotSwapKernel.hpp"
+#include "SpectrumAnalyzerKernel.hpp"
+
+using namespace tald::dsp;
+
+NSErrorDomain const TALDDSPKernelErrorDomain = @"com.tald.unia.dsp.kernel";
+
+static NSError *kernelError(NSString *description) {
+    return [NSError errorWithDomain:TALDDSPKernelErrorDomain
+                               code:-1
+                           userInfo:@{ NSLocalizedDescriptionKey: description }];
+}
+
+@interface TALDAudioRingBuffer ()
+@property (nonatomic, readonly) AudioRingBuffer *ring;
+@end
+
+@implementation TALDAudioRingBuffer {
+    std::unique_ptr<AudioRingBuffer> _ring;
+}
+
+- (nullable instancetype)initWithChannels:(NSInteger)channels
+                            minimumFrames:(NSInteger)minimumFrames
+                                  mapping:(TALDRingMapping)mapping
+                                    error:(NSError **)error {
+    if ((self = [super init])) {
+        try {
+            _ring = std::make_unique<AudioRingBuffer>(static_cast<int>(channels),
+                                                      static_cast<size_t>(std::max<NSInteger>(minimumFrames, 0)),
+                                                      static_cast<RingMapping>(mapping));
+        } catch (const std::exception& e) {
+            if (error) {
+                *error = kernelError(@(e.what()));
+            }
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (AudioRingBuffer *)ring {
+    return _ring.get();
+}
+
+- (NSInteger)capacity {
+    return static_cast<NSInteger>(_ring->capacity());
+}
+
+- (NSInteger)channelCount {
+    return _ring->channelCount();
+}
+
+- (TALDRingMapping)mapping {
+    return static_cast<TALDRingMapping>(_ring->mapping());
+}
+
+- (NSInteger)availableToRead {
+    return static_cast<NSInteger>(_ring->availableToRead());
+}
+
+- (NSInteger)availableToWrite {
+    return static_cast<NSInteger>(_ring->availableToWrite());
+}
+
+- (NSInteger)write:(const float *)frames frameCount:(NSInteger)frameCount {
+    return static_cast<NSInteger>(_ring->write(frames, static_cast<size_t>(std::max<NSInteger>(frameCount, 0))));
+}
+
+- (NSInteger)read:(float *)frames frameCount:(NSInteger)frameCount {
+    return static_cast<NSInteger>(_ring->read(frames, static_cast<size_t>(std::max<NSInteger>(frameCount, 0))));
+}
+
+- (void)reset {
+    _ring->reset();
+}
+
+@end
+
+@interface TALDDSPKernel ()
+/// Takes ownership of a kernel constructed by a subclass
+- (instancetype)initWithKernel:(DSPKernel *)kernel;
+/// The wrapped kernel, owned by this object
+@property (nonatomic, readonly) DSPKernel *nativeKernel;
+@end
+
+@implementation TALDDSPKernel {
+    std::unique_ptr<DSPKernel> _kernel;
+}
+
++ (NSString *)backendName {
+    return @(activeDSPBackend().name);
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                               denormalMode:(TALDDenormalMode)denormalMode
+                                  precision:(TALDProcessingPrecision)precision
+                                      error:(NSError **)error {
+    if ((self = [super init])) {
+        try {
+            _kernel = createDSPKernel(sampleRate, static_cast<int>(channels),
+                                      static_cast<DenormalMode>(denormalMode), MAX_BUFFER_SIZE,
+                                      static_cast<ProcessingPrecision>(precision));
+        } catch (const std::exception& e) {
+            if (error) {
+                *error = kernelError(@(e.what()));
+            }
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                               denormalMode:(TALDDenormalMode)denormalMode
+                                      error:(NSError **)error {
+    return [self initWithSampleRate:sampleRate
+                           channels:channels
+                       denormalMode:denormalMode
+                          precision:TALDProcessingPrecisionFloat32
+                              error:error];
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                      error:(NSError **)error {
+    return [self initWithSampleRate:sampleRate
+                           channels:channels
+                       denormalMode:TALDDenormalModeHardwareFTZ
+                              error:error];
+}
+
+- (instancetype)initWithKernel:(DSPKernel *)kernel {
+    if ((self = [super init])) {
+        _kernel.reset(kernel);
+    }
+    return self;
+}
+
+- (DSPKernel *)nativeKernel {
+    return _kernel.get();
+}
+
+- (double)sampleRate {
+    return _kernel->currentSampleRate();
+}
+
+- (NSInteger)channelCount {
+    return _kernel->channelCount();
+}
+
+- (TALDDenormalMode)denormalMode {
+    return static_cast<TALDDenormalMode>(_kernel->denormalMode());
+}
+
+- (TALDProcessingPrecision)precision {
+    return static_cast<TALDProcessingPrecision>(_kernel->processingPrecision());
+}
+
+- (NSInteger)maximumFramesPerBlock {
+    return static_cast<NSInteger>(_kernel->maximumFramesPerBlock());
+}
+
+- (BOOL)prepareWithMaximumFrames:(NSInteger)maximumFrames
+                        channels:(NSInteger)channels
+                      sampleRate:(double)sampleRate
+                           error:(NSError **)error {
+    if (maximumFrames <= 0) {
+        if (error) {
+            *error = kernelError(@"Maximum frame count out of valid range");
+        }
+        return NO;
+    }
+    try {
+        _kernel->prepare(static_cast<size_t>(maximumFrames), static_cast<int>(channels), sampleRate);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)isBypassed {
+    return _kernel->isBypassed();
+}
+
+- (void)setBypassed:(BOOL)bypassed {
+    _kernel->setBypassed(bypassed);
+}
+
+- (float)lastBlockLatency {
+    return _kernel->lastBlockLatencyMs();
+}
+
+- (float)processingLoad {
+    return _kernel->processingLoad();
+}
+
+- (TALDDSPMetrics)metrics {
+    TALDDSPMetrics result = {};
+    DSPMetricsSnapshot snapshot;
+    if (_kernel->metrics().snapshot(snapshot)) {
+        result.blockCount = snapshot.blocks;
+        result.overrunCount = snapshot.overruns;
+        result.xrunCount = snapshot.xruns;
+        result.lastBlockMs = snapshot.lastBlockMs;
+        result.medianBlockMs = snapshot.p50BlockMs;
+        result.p99BlockMs = snapshot.p99BlockMs;
+        result.maxBlockMs = snapshot.maxBlockMs;
+        result.lastLoad = snapshot.lastLoad;
+        result.medianLoad = snapshot.p50Load;
+        result.p99Load = snapshot.p99Load;
+        result.maxLoad = snapshot.maxLoad;
+    }
+    return result;
+}
+
+- (void)processPlanar:(const float *)input output:(float *)output frameCount:(NSInteger)frameCount {
+    _kernel->process(input, output, static_cast<size_t>(frameCount));
+}
+
+- (void)processInterleaved:(const float *)input output:(float *)output frameCount:(NSInteger)frameCount {
+    _kernel->processInterleaved(input, output, static_cast<size_t>(frameCount));
+}
+
+- (void)processBufferList:(const AudioBufferList *)input
+                   output:(AudioBufferList *)output
+               frameCount:(NSInteger)frameCount {
+    _kernel->process(input, output, static_cast<size_t>(frameCount));
+}
+
+- (NSInteger)processFromRing:(TALDAudioRingBuffer *)input
+                      toRing:(TALDAudioRingBuffer *)output
+                  frameCount:(NSInteger)frameCount {
+    return static_cast<NSInteger>(processRingBuffers(*_kernel, *input.ring, *output.ring,
+                                                     static_cast<size_t>(std::max<NSInteger>(frameCount, 0))));
+}
+
+- (void)setParameter:(NSInteger)parameterID value:(float)value {
+    _kernel->setParameter(static_cast<int>(parameterID), value);
+}
+
+- (void)reset {
+    _kernel->reset();
+}
+
+- (void)resetMetrics {
+    _kernel->metrics().clear();
+}
+
+- (void)reportXrun {
+    _kernel->metrics().reportXrun();
+}
+
+- (nullable instancetype)fork {
+    try {
+        return [[[self class] alloc] initWithKernel:_kernel->fork().release()];
+    } catch (const std::exception&) {
+        return nil;
+    }
+}
+
+- (nullable NSData *)serializedStateWithError:(NSError **)error {
+    try {
+        const std::vector<uint8_t> state = _kernel->serializeState();
+        return [NSData dataWithBytes:state.data() length:state.size()];
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return nil;
+    }
+}
+
++ (nullable TALDDSPKernel *)kernelWithSerializedState:(NSData *)state error:(NSError **)error {
+    std::unique_ptr<DSPKernel> kernel;
+    try {
+        kernel = DSPKernel::restoreState(static_cast<const uint8_t*>(state.bytes), state.length);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return nil;
+    }
+
+    // Wrap in the class that exposes the kernel's own controls
+    Class wrapper = dynamic_cast<ConvolutionKernel*>(kernel.get()) ? [TALDConvolutionKernel class]
+                                                                   : [TALDDSPKernel class];
+    return [[wrapper alloc] initWithKernel:kernel.release()];
+}
+
+@end
+
+@implementation TALDConvolutionKernel {
+    ConvolutionKernel* _convolver; // Owned by the superclass
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                           maxImpulseLength:(NSInteger)maxImpulseLength
+                              partitionSize:(NSInteger)partitionSize
+                                      error:(NSError **)error {
+    std::unique_ptr<ConvolutionKernel> kernel;
+    try {
+        kernel = std::make_unique<ConvolutionKernel>(sampleRate, static_cast<int>(channels),
+                                                     static_cast<size_t>(maxImpulseLength),
+                                                     static_cast<size_t>(partitionSize));
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return nil;
+    }
+
+    return [self initWithKernel:kernel.release()];
+}
+
+- (instancetype)initWithKernel:(DSPKernel *)kernel {
+    if ((self = [super initWithKernel:kernel])) {
+        _convolver = static_cast<ConvolutionKernel*>(kernel);
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                           maxImpulseLength:(NSInteger)maxImpulseLength
+                                      error:(NSError **)error {
+    return [self initWithSampleRate:sampleRate
+                           channels:channels
+                   maxImpulseLength:maxImpulseLength
+                      partitionSize:static_cast<NSInteger>(DEFAULT_CONVOLUTION_BLOCK_SIZE)
+                              error:error];
+}
+
+- (NSInteger)partitionSize {
+    return static_cast<NSInteger>(_convolver->partitionSize());
+}
+
+- (BOOL)setImpulseResponses:(NSArray<NSData *> *)responses
+              inputChannels:(nullable NSArray<NSNumber *> *)inputChannels
+                      error:(NSError **)error {
+    const NSUInteger count = responses.count;
+    if (count > MAX_CHANNELS || (inputChannels && inputChannels.count != count)) {
+        if (error) {
+            *error = kernelError(@"One impulse response and input channel per output channel required");
+        }
+        return NO;
+    }
+
+    ImpulseResponse filters[MAX_CHANNELS];
+    for (NSUInteger channel = 0; channel < count; ++channel) {
+        filters[channel].samples = static_cast<const float*>(responses[channel].bytes);
+        filters[channel].length = responses[channel].length / sizeof(float);
+        filters[channel].inputChannel = inputChannels ? inputChannels[channel].intValue : static_cast<int>(channel);
+    }
+
+    try {
+        if (!_convolver->setImpulseResponses(filters, static_cast<int>(count))) {
+            if (error) {
+                *error = kernelError(@"Previous impulse responses are still pending");
+            }
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return NO;
+    }
+    return YES;
+}
+
+@end
+
+@implementation TALDSpectrumAnalyzerKernel {
+    SpectrumAnalyzerKernel* _analyzer; // Owned by the superclass
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                    fftSize:(NSInteger)fftSize
+                                    hopSize:(NSInteger)hopSize
+                                   binCount:(NSInteger)binCount
+                                publishRate:(double)publishRate
+                                      error:(NSError **)error {
+    SpectrumAnalyzerConfig config;
+    config.fftSize = static_cast<size_t>(std::max<NSInteger>(fftSize, 0));
+    config.hopSize = static_cast<size_t>(std::max<NSInteger>(hopSize, 0));
+    config.binCount = static_cast<size_t>(std::max<NSInteger>(binCount, 0));
+    config.publishRate = publishRate;
+
+    std::unique_ptr<SpectrumAnalyzerKernel> kernel;
+    try {
+        kernel = std::make_unique<SpectrumAnalyzerKernel>(sampleRate, static_cast<int>(channels), config);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return nil;
+    }
+
+    return [self initWithKernel:kernel.release()];
+}
+
+- (instancetype)initWithKernel:(DSPKernel *)kernel {
+    if ((self = [super initWithKernel:kernel])) {
+        _analyzer = static_cast<SpectrumAnalyzerKernel*>(kernel);
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithSampleRate:(double)sampleRate
+                                   channels:(NSInteger)channels
+                                      error:(NSError **)error {
+    const SpectrumAnalyzerConfig defaults;
+    return [self initWithSampleRate:sampleRate
+                           channels:channels
+                            fftSize:static_cast<NSInteger>(defaults.fftSize)
+                            hopSize:static_cast<NSInteger>(defaults.hopSize)
+                           binCount:static_cast<NSInteger>(defaults.binCount)
+                        publishRate:defaults.publishRate
+                              error:error];
+}
+
+- (NSInteger)binCount {
+    return static_cast<NSInteger>(_analyzer->configuration().binCount);
+}
+
+- (uint64_t)copyLatestSpectrum:(float *)magnitudes binCount:(NSInteger)binCount {
+    const SpectrumFrame& frame = _analyzer->latestSpectrum();
+    const size_t count = std::min(frame.binCount, static_cast<size_t>(std::max<NSInteger>(binCount, 0)));
+    std::copy(frame.magnitudes, frame.magnitudes + count, magnitudes);
+    return frame.sequence;
+}
+
+- (double)frequencyOfBinEdge:(NSInteger)bin {
+    const size_t bins = _analyzer->configuration().binCount;
+    return _analyzer->binEdgeFrequency(std::min(static_cast<size_t>(std::max<NSInteger>(bin, 0)), bins));
+}
+
+@end
+
+@implementation TALDBufferSizeController {
+    TALDDSPKernel *_kernel;   // Keeps the metrics alive
+    std::unique_ptr<BufferSizeController> _controller;
+}
+
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                      initialFrameCount:(NSInteger)initialFrameCount
+                      minimumFrameCount:(NSInteger)minimumFrameCount
+                      maximumFrameCount:(NSInteger)maximumFrameCount
+                             targetLoad:(float)targetLoad
+                                  error:(NSError **)error {
+    if ((self = [super init])) {
+        BufferSizePolicy policy;
+        policy.minimumFrames = static_cast<size_t>(std::max<NSInteger>(minimumFrameCount, 0));
+        policy.maximumFrames = static_cast<size_t>(std::max<NSInteger>(maximumFrameCount, 0));
+        policy.targetLoad = targetLoad;
+        try {
+            _controller = std::make_unique<BufferSizeController>(
+                kernel.nativeKernel->metrics(), kernel.sampleRate,
+                static_cast<size_t>(std::max<NSInteger>(initialFrameCount, 0)), policy);
+        } catch (const std::exception& e) {
+            if (error) {
+                *error = kernelError(@(e.what()));
+            }
+            return nil;
+        }
+        _kernel = kernel;
+    }
+    return self;
+}
+
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                      initialFrameCount:(NSInteger)initialFrameCount
+                                  error:(NSError **)error {
+    return [self initWithKernel:kernel
+              initialFrameCount:initialFrameCount
+              minimumFrameCount:static_cast<NSInteger>(MIN_BUFFER_SIZE)
+              maximumFrameCount:static_cast<NSInteger>(DEFAULT_MAX_ADAPTIVE_BUFFER_SIZE)
+                     targetLoad:DEFAULT_TARGET_PROCESSING_LOAD
+                          error:error];
+}
+
+- (NSInteger)bufferFrameCount {
+    return static_cast<NSInteger>(_controller->bufferFrames());
+}
+
+- (NSInteger)backoffCount {
+    return static_cast<NSInteger>(_controller->backoffCount());
+}
+
+- (TALDBufferSizeDecision)update {
+    return static_cast<TALDBufferSizeDecision>(_controller->update());
+}
+
+@end
+
+@implementation TALDHotSwapKernel {
+    HotSwapKernel* _swapper; // Owned by the superclass
+}
+
+- (nullable instancetype)initWithKernel:(TALDDSPKernel *)kernel
+                       crossfadeSeconds:(double)crossfadeSeconds
+                                  error:(NSError **)error {
+    std::unique_ptr<HotSwapKernel> swapper;
+    try {
+        swapper = std::make_unique<HotSwapKernel>(kernel.nativeKernel->fork(), crossfadeSeconds);
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return nil;
+    }
+
+    return [self initWithKernel:swapper.release()];
+}
+
+- (instancetype)initWithKernel:(DSPKernel *)kernel {
+    if ((self = [super initWithKernel:kernel])) {
+        _swapper = static_cast<HotSwapKernel*>(kernel);
+    }
+    return self;
+}
+
+- (BOOL)isSwapInProgress {
+    return _swapper->isSwapInProgress();
+}
+
+- (BOOL)swapToKernel:(TALDDSPKernel *)kernel error:(NSError **)error {
+    try {
+        std::unique_ptr<DSPKernel> prepared = kernel.nativeKernel->fork();
+        if (!_swapper->swapTo(prepared)) {
+            if (error) {
+                *error = kernelError(@"The previous swap is still in progress");
+            }
+            return NO;
+        }
+    } catch (const std::exception& e) {
+        if (error) {
+            *error = kernelError(@(e.what()));
+        }
+        return NO;
+    }
+    return YES;
+}
+
+@end
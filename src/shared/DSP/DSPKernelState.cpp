@@ -0,0 +1,131 @@
+#include "DSPKernelState.hpp"
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include "BiquadCascadeKernel.hpp"
+#include "ConvolutionKernel.hpp"
+#include "DSPKernel.hpp"
+#include "DynamicsKernel.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+std::vector<uint8_t> DSPKernel::serializeState() const {
+    const KernelStateType type = stateType();
+    if (type == KernelStateType::None) {
+        throw std::invalid_argument("Kernel type has no state format");
+    }
+
+    std::vector<uint8_t> bytes;
+    KernelStateWriter writer(bytes);
+    writer.write(KERNEL_STATE_MAGIC);
+    writer.write(KERNEL_STATE_VERSION);
+    writer.write(static_cast<uint16_t>(type));
+    writer.write(sampleRate);
+    writer.write(static_cast<uint32_t>(numChannels));
+    writer.write(static_cast<uint32_t>(maxFrames));
+    writer.write(static_cast<uint8_t>(activeDenormalMode));
+    writer.write(static_cast<uint8_t>(isBypassed()));
+
+    // Only parameters that were ever set, so defaults stay defaults
+    writer.write(controlValueMask);
+    uint32_t parameters = controlValueMask;
+    while (parameters) {
+        const int parameterID = std::countr_zero(parameters);
+        parameters &= parameters - 1;
+        writer.write(controlValues[parameterID]);
+    }
+
+    writeState(writer);
+    return bytes;
+}
+
+std::unique_ptr<DSPKernel> DSPKernel::restoreState(const uint8_t* data, size_t size) {
+    if (!data) {
+        throw std::runtime_error("Kernel state required");
+    }
+    KernelStateReader reader(data, size);
+    if (reader.read<uint32_t>() != KERNEL_STATE_MAGIC) {
+        throw std::runtime_error("Not a kernel state");
+    }
+    if (reader.read<uint16_t>() != KERNEL_STATE_VERSION) {
+        throw std::runtime_error("Unsupported kernel state version");
+    }
+
+    KernelStateHeader header;
+    header.type = static_cast<KernelStateType>(reader.read<uint16_t>());
+    header.sampleRate = reader.read<double>();
+    header.channels = static_cast<int>(reader.read<uint32_t>());
+    header.maxFrames = reader.read<uint32_t>();
+    const uint8_t denormalMode = reader.read<uint8_t>();
+    if (denormalMode > static_cast<uint8_t>(DenormalMode::Off)) {
+        throw std::runtime_error("Unknown denormal mode in kernel state");
+    }
+    header.denormalMode = static_cast<DenormalMode>(denormalMode);
+    const bool bypassed = reader.read<uint8_t>() != 0;
+
+    const uint32_t parameterMask = reader.read<uint32_t>();
+    float values[MAX_PARAMETERS] = {};
+    uint32_t parameters = parameterMask;
+    while (parameters) {
+        const int parameterID = std::countr_zero(parameters);
+        parameters &= parameters - 1;
+        values[parameterID] = reader.read<float>();
+    }
+
+    std::unique_ptr<DSPKernel> kernel;
+    try {
+        validateConfiguration(header.maxFrames, header.channels, header.sampleRate);
+        switch (header.type) {
+            case KernelStateType::Gain: {
+                const uint8_t precision = reader.read<uint8_t>();
+                if (precision > static_cast<uint8_t>(ProcessingPrecision::Q15)) {
+                    throw std::runtime_error("Unknown processing precision in kernel state");
+                }
+                kernel = createDSPKernel(header.sampleRate, header.channels, header.denormalMode, header.maxFrames,
+                                         static_cast<ProcessingPrecision>(precision));
+                break;
+            }
+            case KernelStateType::BiquadCascade:
+                kernel = BiquadCascadeKernel::fromState(header, reader);
+                break;
+            case KernelStateType::Convolution:
+                kernel = ConvolutionKernel::fromState(header, reader);
+                break;
+            case KernelStateType::Dynamics:
+                kernel = DynamicsKernel::fromState(header, reader);
+                break;
+            default:
+                throw std::runtime_error("Unknown kernel state type");
+        }
+    }
+    catch (const std::invalid_argument& error) {
+        // A configuration the constructors reject can only come from a damaged blob
+        throw std::runtime_error(std::string("Invalid kernel state: ") + error.what());
+    }
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Trailing data after kernel state");
+    }
+
+    // Like a fork, the kernel starts exactly on the saved values
+    kernel->setBypassed(bypassed);
+    parameters = parameterMask;
+    while (parameters) {
+        const int parameterID = std::countr_zero(parameters);
+        parameters &= parameters - 1;
+
+        ParameterEvent event;
+        event.parameterID = parameterID;
+        event.value = values[parameterID];
+        event.rampFrames = 1;
+        kernel->scheduleParameter(event);
+    }
+    return kernel;
+}
+
+} // namespace dsp
+} // namespace tald
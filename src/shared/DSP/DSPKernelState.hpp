@@ -0,0 +1,142 @@
+//
+// DSPKernelState.hpp
+// TALD UNIA Audio System
+//
+// Compact binary kernel state: configuration, bypass, latest parameter values and
+// the kernel's precomputed tables, so a saved profile restores without redesigning
+// filters or re-transforming impulse responses.
+//
+
+#ifndef TALD_UNIA_DSP_KERNEL_STATE_HPP
+#define TALD_UNIA_DSP_KERNEL_STATE_HPP
+
+#include <bit>         // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <cstring>     // C++20
+#include <stdexcept>   // C++20
+#include <type_traits> // C++20
+#include <vector>      // C++20
+#include "DSPDenormals.hpp"
+
+// First four bytes of every state blob, "TKST" in file order
+constexpr uint32_t KERNEL_STATE_MAGIC = 0x54534B54;
+
+// Format revision; blobs of another version are rejected rather than guessed at
+constexpr uint16_t KERNEL_STATE_VERSION = 1;
+
+namespace tald {
+namespace dsp {
+
+// Blobs are written in host order and every supported target is little-endian
+static_assert(std::endian::native == std::endian::little, "Kernel state assumes a little-endian host");
+
+/**
+ * @brief Kernel family recorded in a state blob; 0 marks kernels without a format
+ */
+enum class KernelStateType : uint16_t {
+    None = 0,
+    Gain = 1,           // createDSPKernel()
+    BiquadCascade = 2,
+    Convolution = 3,
+    Dynamics = 4
+};
+
+/**
+ * @brief Base configuration every blob starts with, after the magic and version
+ */
+struct KernelStateHeader {
+    KernelStateType type = KernelStateType::None;
+    double sampleRate = 0.0;
+    int channels = 0;
+    size_t maxFrames = 0;
+    DenormalMode denormalMode = DenormalMode::HardwareFTZ;
+};
+
+/**
+ * @brief Appends fixed-size values to a growing blob (control thread, allocates)
+ */
+class KernelStateWriter {
+public:
+    explicit KernelStateWriter(std::vector<uint8_t>& bytes) noexcept : bytes(bytes) {}
+
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+        writeBytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void writeArray(const T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+        writeBytes(values, count * sizeof(T));
+    }
+
+private:
+    std::vector<uint8_t>& bytes;
+
+    void writeBytes(const void* source, size_t count) {
+        const size_t offset = bytes.size();
+        bytes.resize(offset + count);
+        if (count > 0) {
+            std::memcpy(bytes.data() + offset, source, count);
+        }
+    }
+};
+
+/**
+ * @brief Bounds-checked cursor over a blob; values may sit at any alignment
+ */
+class KernelStateReader {
+public:
+    KernelStateReader(const uint8_t* data, size_t size) noexcept : data(data), size(size), offset(0) {}
+
+    /**
+     * @throws std::runtime_error if the blob ends first
+     */
+    template<typename T>
+    T read() {
+        static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    /**
+     * @throws std::runtime_error if the blob ends first
+     */
+    template<typename T>
+    void readArray(T* values, size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "State values must be trivially copyable");
+        if (count > remaining() / sizeof(T)) {
+            throw std::runtime_error("Truncated kernel state");
+        }
+        if (count > 0) {
+            std::memcpy(values, take(count * sizeof(T)), count * sizeof(T));
+        }
+    }
+
+    [[nodiscard]]
+    size_t remaining() const noexcept {
+        return size - offset;
+    }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    size_t offset;
+
+    const uint8_t* take(size_t count) {
+        if (count > remaining()) {
+            throw std::runtime_error("Truncated kernel state");
+        }
+        const uint8_t* position = data + offset;
+        offset += count;
+        return position;
+    }
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_KERNEL_STATE_HPP
@@ -0,0 +1,262 @@
+#ifndef TALD_UNIA_DSP_METRICS_HPP
+#define TALD_UNIA_DSP_METRICS_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <mach/mach_time.h> // Apple SDK
+#include "DSPConfig.hpp"
+
+// Buckets per histogram: block time in quarter octaves from 1 us, load in 1/32 steps to 2x
+constexpr int METRICS_HISTOGRAM_BUCKETS = 64;
+
+// Reader retries before a snapshot gives up on a writer that keeps publishing
+constexpr int METRICS_SNAPSHOT_ATTEMPTS = 1024;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Nanoseconds per mach_absolute_time() tick, resolved once per process
+ *
+ * The first call queries the timebase; make it off the render thread (kernel
+ * construction does).
+ */
+[[nodiscard]]
+inline double hostTicksToNanoseconds() noexcept {
+    static const double nanosecondsPerTick = [] {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        return static_cast<double>(timebase.numer) / static_cast<double>(timebase.denom);
+    }();
+    return nanosecondsPerTick;
+}
+
+/**
+ * @brief Conversion factor from mach_absolute_time() ticks to milliseconds
+ */
+[[nodiscard]]
+inline double hostTicksToMilliseconds() noexcept {
+    return hostTicksToNanoseconds() / 1.0e6;
+}
+
+/**
+ * @brief Consistent copy of a kernel's block statistics since the last clear
+ *
+ * Percentiles are bucket upper edges capped at the observed maximum, so they are
+ * within one histogram bucket (about a fifth of the value) of the true figure.
+ */
+struct DSPMetricsSnapshot {
+    uint64_t blocks = 0;      // Blocks recorded
+    uint64_t overruns = 0;    // Blocks that took longer than their real-time budget
+    uint64_t xruns = 0;       // Host-reported I/O overloads
+    uint32_t generation = 0;  // Clears applied so far; tells statistics before and after a clear() apart
+    float lastBlockMs = 0.0f;
+    float p50BlockMs = 0.0f;
+    float p99BlockMs = 0.0f;
+    float maxBlockMs = 0.0f;
+    float lastLoad = 0.0f;    // Fraction of the block's budget
+    float p50Load = 0.0f;
+    float p99Load = 0.0f;
+    float maxLoad = 0.0f;
+};
+
+/**
+ * @brief Lock-free block time and load statistics for one kernel
+ *
+ * The render thread is the only writer and never waits: each record() updates
+ * fixed histograms inside a sequence lock. Any other thread takes snapshots, retrying
+ * while a block is being recorded. Host xruns may be reported from any thread.
+ * Nothing logs, allocates or queries the system on the render thread.
+ */
+class DSPBlockMetrics {
+public:
+    /**
+     * @brief Record one processed block (render thread)
+     * @param elapsedNanoseconds Time spent processing
+     * @param budgetNanoseconds Real-time duration of the block
+     */
+    void record(uint64_t elapsedNanoseconds, double budgetNanoseconds) noexcept {
+        const float load = budgetNanoseconds > 0.0
+            ? static_cast<float>(static_cast<double>(elapsedNanoseconds) / budgetNanoseconds)
+            : 0.0f;
+
+        const uint32_t sequence = writeSequence.load(std::memory_order_relaxed);
+        writeSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        if (clearRequested.load(std::memory_order_relaxed) &&
+            clearRequested.exchange(false, std::memory_order_acquire)) {
+            clearHistograms();
+        }
+
+        increment(blocks);
+        if (load > 1.0f) {
+            increment(overruns);
+        }
+        increment(timeBuckets[timeBucket(elapsedNanoseconds)]);
+        increment(loadBuckets[loadBucket(load)]);
+        if (elapsedNanoseconds > maxNanoseconds.load(std::memory_order_relaxed)) {
+            maxNanoseconds.store(elapsedNanoseconds, std::memory_order_relaxed);
+        }
+        if (load > maxLoad.load(std::memory_order_relaxed)) {
+            maxLoad.store(load, std::memory_order_relaxed);
+        }
+        lastNanoseconds.store(elapsedNanoseconds, std::memory_order_relaxed);
+        lastLoad.store(load, std::memory_order_relaxed);
+
+        writeSequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy consistent statistics (any thread except the render thread)
+     * @return false if every attempt overlapped a record(); out is then unchanged
+     */
+    bool snapshot(DSPMetricsSnapshot& out) const noexcept {
+        uint32_t times[METRICS_HISTOGRAM_BUCKETS];
+        uint32_t loads[METRICS_HISTOGRAM_BUCKETS];
+
+        for (int attempt = 0; attempt < METRICS_SNAPSHOT_ATTEMPTS; ++attempt) {
+            const uint32_t before = writeSequence.load(std::memory_order_acquire);
+            if (before & 1u) {
+                continue;
+            }
+
+            DSPMetricsSnapshot copy;
+            copy.blocks = blocks.load(std::memory_order_relaxed);
+            copy.overruns = overruns.load(std::memory_order_relaxed);
+            copy.generation = generation.load(std::memory_order_relaxed);
+            const uint64_t maxNs = maxNanoseconds.load(std::memory_order_relaxed);
+            const uint64_t lastNs = lastNanoseconds.load(std::memory_order_relaxed);
+            copy.maxLoad = maxLoad.load(std::memory_order_relaxed);
+            copy.lastLoad = lastLoad.load(std::memory_order_relaxed);
+            for (int bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; ++bucket) {
+                times[bucket] = timeBuckets[bucket].load(std::memory_order_relaxed);
+                loads[bucket] = loadBuckets[bucket].load(std::memory_order_relaxed);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (writeSequence.load(std::memory_order_relaxed) != before) {
+                continue;
+            }
+
+            copy.xruns = xruns.load(std::memory_order_relaxed);
+            copy.lastBlockMs = static_cast<float>(lastNs) / 1.0e6f;
+            copy.maxBlockMs = static_cast<float>(maxNs) / 1.0e6f;
+            copy.p50BlockMs = std::min(timePercentileMs(times, copy.blocks, 0.50), copy.maxBlockMs);
+            copy.p99BlockMs = std::min(timePercentileMs(times, copy.blocks, 0.99), copy.maxBlockMs);
+            copy.p50Load = std::min(loadPercentile(loads, copy.blocks, 0.50), copy.maxLoad);
+            copy.p99Load = std::min(loadPercentile(loads, copy.blocks, 0.99), copy.maxLoad);
+            out = copy;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Start the statistics over; applied by the render thread at its next block
+     */
+    void clear() noexcept {
+        xruns.store(0, std::memory_order_relaxed);
+        clearRequested.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Count an overload reported by the host (any thread)
+     */
+    void reportXrun() noexcept {
+        xruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    float lastBlockMs() const noexcept {
+        return static_cast<float>(lastNanoseconds.load(std::memory_order_relaxed)) / 1.0e6f;
+    }
+
+    [[nodiscard]]
+    float lastBlockLoad() const noexcept {
+        return lastLoad.load(std::memory_order_relaxed);
+    }
+
+private:
+    // Single writer, so plain load/store is enough and avoids locked RMW instructions
+    template <typename T>
+    static void increment(std::atomic<T>& counter) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Quarter-octave buckets: 4 per power of two from 1024 ns
+    static int timeBucket(uint64_t nanoseconds) noexcept {
+        if (nanoseconds < 1024) {
+            return 0;
+        }
+        const int exponent = static_cast<int>(std::bit_width(nanoseconds)) - 1;
+        const int quarter = static_cast<int>((nanoseconds >> (exponent - 2)) & 3u);
+        return std::min((exponent - 10) * 4 + quarter, METRICS_HISTOGRAM_BUCKETS - 1);
+    }
+
+    static float timeBucketUpperMs(int bucket) noexcept {
+        const int exponent = bucket / 4 + 10;
+        const uint64_t upper = static_cast<uint64_t>(5 + bucket % 4) << (exponent - 2);
+        return static_cast<float>(upper) / 1.0e6f;
+    }
+
+    static int loadBucket(float load) noexcept {
+        return std::clamp(static_cast<int>(load * 32.0f), 0, METRICS_HISTOGRAM_BUCKETS - 1);
+    }
+
+    static int percentileBucket(const uint32_t* buckets, uint64_t total, double fraction) noexcept {
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * static_cast<double>(total) + 0.5));
+        uint64_t cumulative = 0;
+        for (int bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; ++bucket) {
+            cumulative += buckets[bucket];
+            if (cumulative >= rank) {
+                return bucket;
+            }
+        }
+        return METRICS_HISTOGRAM_BUCKETS - 1;
+    }
+
+    static float timePercentileMs(const uint32_t* buckets, uint64_t total, double fraction) noexcept {
+        return total ? timeBucketUpperMs(percentileBucket(buckets, total, fraction)) : 0.0f;
+    }
+
+    static float loadPercentile(const uint32_t* buckets, uint64_t total, double fraction) noexcept {
+        return total ? static_cast<float>(percentileBucket(buckets, total, fraction) + 1) / 32.0f : 0.0f;
+    }
+
+    void clearHistograms() noexcept {
+        increment(generation);
+        blocks.store(0, std::memory_order_relaxed);
+        overruns.store(0, std::memory_order_relaxed);
+        maxNanoseconds.store(0, std::memory_order_relaxed);
+        maxLoad.store(0.0f, std::memory_order_relaxed);
+        for (int bucket = 0; bucket < METRICS_HISTOGRAM_BUCKETS; ++bucket) {
+            timeBuckets[bucket].store(0, std::memory_order_relaxed);
+            loadBuckets[bucket].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Written by the render thread under writeSequence
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> writeSequence{0};
+    std::atomic<uint64_t> blocks{0};
+    std::atomic<uint64_t> overruns{0};
+    std::atomic<uint32_t> generation{0};
+    std::atomic<uint64_t> maxNanoseconds{0};
+    std::atomic<uint64_t> lastNanoseconds{0};
+    std::atomic<float> maxLoad{0.0f};
+    std::atomic<float> lastLoad{0.0f};
+    std::atomic<uint32_t> timeBuckets[METRICS_HISTOGRAM_BUCKETS] = {};
+    std::atomic<uint32_t> loadBuckets[METRICS_HISTOGRAM_BUCKETS] = {};
+
+    // Written by other threads
+    alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> xruns{0};
+    std::atomic<bool> clearRequested{false};
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_METRICS_HPP
@@ -0,0 +1,473 @@
+#include "DSPOfflineRender.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Version comments for external dependencies
+// POSIX mmap: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    constexpr uint16_t kWaveFormatPCM = 0x0001;
+    constexpr uint16_t kWaveFormatFloat = 0x0003;
+    constexpr uint16_t kWaveFormatExtensible = 0xFFFE;
+
+    // Written files pad the header with a JUNK chunk so samples start on a cache line
+    constexpr size_t kWrittenHeaderBytes = 64;
+
+    // The RIFF size fields are 32-bit
+    constexpr uint64_t kMaxWaveDataBytes = 0xFFFFFFFFull - kWrittenHeaderBytes;
+
+    // WAV fields are little-endian, as are all supported hosts
+    uint16_t readLE16(const uint8_t* bytes) noexcept {
+        uint16_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    uint32_t readLE32(const uint8_t* bytes) noexcept {
+        uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    void writeLE16(uint8_t* bytes, uint16_t value) noexcept {
+        std::memcpy(bytes, &value, sizeof(value));
+    }
+
+    void writeLE32(uint8_t* bytes, uint32_t value) noexcept {
+        std::memcpy(bytes, &value, sizeof(value));
+    }
+
+    size_t bytesPerSample(AudioSampleFormat format) noexcept {
+        switch (format) {
+            case AudioSampleFormat::PCM16: return 2;
+            case AudioSampleFormat::PCM24: return 3;
+            case AudioSampleFormat::PCM32: return 4;
+            case AudioSampleFormat::Float32: return 4;
+        }
+        return 4;
+    }
+
+    void convertSamples(const uint8_t* source, AudioSampleFormat format, size_t count, float* destination) noexcept {
+        switch (format) {
+            case AudioSampleFormat::PCM16:
+                for (size_t i = 0; i < count; ++i) {
+                    destination[i] = static_cast<float>(static_cast<int16_t>(readLE16(source + 2 * i))) * (1.0f / 32768.0f);
+                }
+                return;
+            case AudioSampleFormat::PCM24:
+                for (size_t i = 0; i < count; ++i) {
+                    const uint8_t* sample = source + 3 * i;
+                    // Assemble in the top three bytes so the shift back sign-extends
+                    const int32_t value = static_cast<int32_t>((static_cast<uint32_t>(sample[0]) << 8) |
+                                                               (static_cast<uint32_t>(sample[1]) << 16) |
+                                                               (static_cast<uint32_t>(sample[2]) << 24)) >> 8;
+                    destination[i] = static_cast<float>(value) * (1.0f / 8388608.0f);
+                }
+                return;
+            case AudioSampleFormat::PCM32:
+                for (size_t i = 0; i < count; ++i) {
+                    destination[i] = static_cast<float>(static_cast<int32_t>(readLE32(source + 4 * i))) *
+                                     (1.0f / 2147483648.0f);
+                }
+                return;
+            case AudioSampleFormat::Float32:
+                std::memcpy(destination, source, count * sizeof(float));
+                return;
+        }
+    }
+
+    const DSPKernel& firstStage(const DSPKernel* const* stages, size_t stageCount) {
+        if (!stages || stageCount == 0 || !stages[0]) {
+            throw std::invalid_argument("Offline render needs at least one stage");
+        }
+        return *stages[0];
+    }
+}
+
+// MARK: - MappedAudioFile
+
+MappedAudioFile::MappedAudioFile(const std::string& path) {
+    descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        throw std::runtime_error("Failed to open audio file");
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || status.st_size < 12) {
+        close();
+        throw std::runtime_error("Audio file too short");
+    }
+
+    mappingBytes = static_cast<size_t>(status.st_size);
+    mapping = ::mmap(nullptr, mappingBytes, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        close();
+        throw std::runtime_error("Failed to map audio file");
+    }
+    // Blocks are read front to back; let the system read ahead and drop pages behind
+    ::madvise(mapping, mappingBytes, MADV_SEQUENTIAL);
+
+    try {
+        parseHeader();
+    } catch (...) {
+        close();
+        throw;
+    }
+}
+
+MappedAudioFile::MappedAudioFile(const std::string& path, int channelCount, double sampleRate, size_t frameCount) {
+    if (channelCount <= 0 || channelCount > MAX_CHANNELS) {
+        throw std::invalid_argument("Invalid channel count");
+    }
+    if (sampleRate < MIN_SAMPLE_RATE || sampleRate > MAX_SAMPLE_RATE) {
+        throw std::invalid_argument("Sample rate out of valid range");
+    }
+    const uint64_t dataBytes = static_cast<uint64_t>(frameCount) * static_cast<uint64_t>(channelCount) * sizeof(float);
+    if (dataBytes > kMaxWaveDataBytes) {
+        throw std::invalid_argument("Audio file too long for WAV");
+    }
+
+    descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (descriptor < 0) {
+        throw std::runtime_error("Failed to create audio file");
+    }
+    mappingBytes = kWrittenHeaderBytes + static_cast<size_t>(dataBytes);
+    if (::ftruncate(descriptor, static_cast<off_t>(mappingBytes)) != 0) {
+        close();
+        throw std::runtime_error("Failed to size audio file");
+    }
+    mapping = ::mmap(nullptr, mappingBytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        close();
+        throw std::runtime_error("Failed to map audio file");
+    }
+
+    uint8_t* header = static_cast<uint8_t*>(mapping);
+    const uint32_t frameBytes = static_cast<uint32_t>(channelCount) * sizeof(float);
+    std::memcpy(header, "RIFF", 4);
+    writeLE32(header + 4, static_cast<uint32_t>(mappingBytes - 8));
+    std::memcpy(header + 8, "WAVE", 4);
+    std::memcpy(header + 12, "fmt ", 4);
+    writeLE32(header + 16, 16);
+    writeLE16(header + 20, kWaveFormatFloat);
+    writeLE16(header + 22, static_cast<uint16_t>(channelCount));
+    writeLE32(header + 24, static_cast<uint32_t>(std::lround(sampleRate)));
+    writeLE32(header + 28, static_cast<uint32_t>(std::lround(sampleRate)) * frameBytes);
+    writeLE16(header + 32, static_cast<uint16_t>(frameBytes));
+    writeLE16(header + 34, 32);
+    std::memcpy(header + 36, "JUNK", 4);
+    writeLE32(header + 40, static_cast<uint32_t>(kWrittenHeaderBytes - 52));
+    std::memset(header + 44, 0, kWrittenHeaderBytes - 52);
+    std::memcpy(header + kWrittenHeaderBytes - 8, "data", 4);
+    writeLE32(header + kWrittenHeaderBytes - 4, static_cast<uint32_t>(dataBytes));
+
+    samples = header + kWrittenHeaderBytes;
+    writable = true;
+    channels = channelCount;
+    rate = sampleRate;
+    frames = frameCount;
+    sampleFormat = AudioSampleFormat::Float32;
+}
+
+MappedAudioFile::~MappedAudioFile() {
+    close();
+}
+
+void MappedAudioFile::parseHeader() {
+    const uint8_t* bytes = static_cast<const uint8_t*>(mapping);
+    if (std::memcmp(bytes, "RIFF", 4) != 0 || std::memcmp(bytes + 8, "WAVE", 4) != 0) {
+        throw std::runtime_error("Not a RIFF/WAVE file");
+    }
+
+    bool hasFormat = false;
+    uint16_t formatTag = 0;
+    uint16_t bitsPerSample = 0;
+    size_t offset = 12;
+    while (offset + 8 <= mappingBytes) {
+        const uint8_t* chunk = bytes + offset;
+        const size_t chunkBytes = readLE32(chunk + 4);
+        const size_t body = offset + 8;
+
+        if (std::memcmp(chunk, "fmt ", 4) == 0) {
+            if (chunkBytes < 16 || body + 16 > mappingBytes) {
+                throw std::runtime_error("Truncated WAV format chunk");
+            }
+            formatTag = readLE16(bytes + body);
+            channels = readLE16(bytes + body + 2);
+            rate = static_cast<double>(readLE32(bytes + body + 4));
+            bitsPerSample = readLE16(bytes + body + 14);
+            // Extensible headers carry the real format in the sub-format GUID's first two bytes
+            if (formatTag == kWaveFormatExtensible && chunkBytes >= 26 && body + 26 <= mappingBytes) {
+                formatTag = readLE16(bytes + body + 24);
+            }
+            hasFormat = true;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0) {
+            if (!hasFormat) {
+                throw std::runtime_error("WAV data before format chunk");
+            }
+            if (formatTag == kWaveFormatPCM && bitsPerSample == 16) {
+                sampleFormat = AudioSampleFormat::PCM16;
+            } else if (formatTag == kWaveFormatPCM && bitsPerSample == 24) {
+                sampleFormat = AudioSampleFormat::PCM24;
+            } else if (formatTag == kWaveFormatPCM && bitsPerSample == 32) {
+                sampleFormat = AudioSampleFormat::PCM32;
+            } else if (formatTag == kWaveFormatFloat && bitsPerSample == 32) {
+                sampleFormat = AudioSampleFormat::Float32;
+            } else {
+                throw std::runtime_error("Unsupported WAV sample format");
+            }
+            if (channels <= 0 || channels > MAX_CHANNELS || rate <= 0.0) {
+                throw std::runtime_error("Unsupported WAV channel count or sample rate");
+            }
+
+            // Streamed files may leave the size unset; trust the file length instead
+            const size_t dataBytes = std::min(chunkBytes, mappingBytes - body);
+            samples = bytes + body;
+            frames = dataBytes / (static_cast<size_t>(channels) * bytesPerSample(sampleFormat));
+            return;
+        }
+
+        if (chunkBytes > mappingBytes - body) {
+            break;
+        }
+        offset = body + chunkBytes + (chunkBytes & 1);   // Chunks are padded to even sizes
+    }
+    throw std::runtime_error("WAV file has no data chunk");
+}
+
+void MappedAudioFile::readFrames(size_t first, size_t count, float* destination) const noexcept {
+    const size_t available = first < frames ? std::min(count, frames - first) : 0;
+    const size_t channelCount = static_cast<size_t>(channels);
+    const size_t frameBytes = channelCount * bytesPerSample(sampleFormat);
+    convertSamples(samples + first * frameBytes, sampleFormat, available * channelCount, destination);
+    std::fill(destination + available * channelCount, destination + count * channelCount, 0.0f);
+}
+
+bool MappedAudioFile::flush() noexcept {
+    if (!writable) {
+        return true;
+    }
+    return ::msync(mapping, mappingBytes, MS_SYNC) == 0;
+}
+
+void MappedAudioFile::close() noexcept {
+    if (mapping) {
+        ::munmap(mapping, mappingBytes);
+        mapping = nullptr;
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+        descriptor = -1;
+    }
+}
+
+// MARK: - OfflineRenderer
+
+/**
+ * @brief One task per chunk of the file
+ */
+class OfflineRenderer::Tasks final : public DSPTaskSet {
+public:
+    explicit Tasks(OfflineRenderer& owner) noexcept
+        : renderer(owner) {}
+
+    void runTask(uint32_t task, DSPWorkerContext& context) noexcept override {
+        renderChunk(context.participant(), taskBase + task);
+    }
+
+    void renderChunk(int participant, size_t chunk) noexcept {
+        std::vector<std::unique_ptr<DSPKernel>>& chain = renderer.chains[static_cast<size_t>(participant)];
+        for (std::unique_ptr<DSPKernel>& stage : chain) {
+            stage->restartStream();
+        }
+
+        const size_t batchFrames = renderer.blockSize * OFFLINE_BATCH_BLOCKS;
+        const size_t channels = static_cast<size_t>(renderer.channels);
+        const size_t begin = chunk * chunkFrames;
+        const size_t end = std::min(begin + chunkFrames, frameCount);
+
+        // Warm up on the preceding audio; the first chunk starts from silence like a single pass
+        size_t position = begin - std::min(begin, warmupFrames);
+        float* scratch = position < begin ? renderer.warmupBuffers[static_cast<size_t>(participant)].data() : nullptr;
+        while (position < begin) {
+            const size_t count = std::min(batchFrames, begin - position);
+            read(position, count, scratch);
+            renderSpan(chain, scratch, count);
+            position += count;
+        }
+
+        // Then render the chunk in place in the output
+        while (position < end) {
+            const size_t count = std::min(batchFrames, end - position);
+            float* destination = output + position * channels;
+            read(position, count, destination);
+            renderSpan(chain, destination, count);
+            position += count;
+        }
+    }
+
+    // Either the file or the sample pointer is set for one render
+    const MappedAudioFile* file = nullptr;
+    const float* inputSamples = nullptr;
+    float* output = nullptr;
+    size_t frameCount = 0;
+    size_t chunkFrames = 0;
+    size_t warmupFrames = 0;
+    size_t taskBase = 0;
+
+private:
+    OfflineRenderer& renderer;
+
+    void read(size_t first, size_t count, float* destination) const noexcept {
+        if (file) {
+            file->readFrames(first, count, destination);
+            return;
+        }
+        const size_t channels = static_cast<size_t>(renderer.channels);
+        const float* source = inputSamples + first * channels;
+        if (source != destination) {
+            std::memcpy(destination, source, count * channels * sizeof(float));
+        }
+    }
+
+    void renderSpan(std::vector<std::unique_ptr<DSPKernel>>& chain, float* samples, size_t count) const noexcept {
+        const int channels = renderer.channels;
+        DSPBatchItem items[OFFLINE_BATCH_BLOCKS];
+        size_t itemCount = 0;
+        for (size_t frame = 0; frame < count; frame += renderer.blockSize, ++itemCount) {
+            const size_t frames = std::min(renderer.blockSize, count - frame);
+            const AudioBufferView view = AudioBufferView::makeInterleaved(
+                samples + frame * static_cast<size_t>(channels), channels, frames);
+            items[itemCount].input = view;
+            items[itemCount].output = view;
+        }
+        for (std::unique_ptr<DSPKernel>& stage : chain) {
+            stage->processBatch(items, itemCount);
+        }
+    }
+};
+
+OfflineRenderer::OfflineRenderer(const DSPKernel* const* stages, size_t stageCount, DSPWorkerPool* workerPool,
+                                 const OfflineRenderOptions& renderOptions)
+    : pool(workerPool)
+    , options(renderOptions)
+    , channels(firstStage(stages, stageCount).channelCount())
+    , sampleRate(stages[0]->currentSampleRate())
+    , blockSize(stages[0]->maximumFramesPerBlock())
+{
+    for (size_t stage = 0; stage < stageCount; ++stage) {
+        if (!stages[stage] || stages[stage]->channelCount() != channels ||
+            stages[stage]->currentSampleRate() != sampleRate) {
+            throw std::invalid_argument("Offline render stages must share channel count and sample rate");
+        }
+        blockSize = std::min(blockSize, stages[stage]->maximumFramesPerBlock());
+    }
+
+    const int participants = pool ? pool->workerCount() + 1 : 1;
+    chains.resize(static_cast<size_t>(participants));
+    for (std::vector<std::unique_ptr<DSPKernel>>& chain : chains) {
+        chain.reserve(stageCount);
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            std::unique_ptr<DSPKernel> kernel = stages[stage]->fork();
+            if (!kernel) {
+                throw std::runtime_error("Failed to fork offline render stage");
+            }
+            chain.push_back(std::move(kernel));
+        }
+    }
+    if (options.parallel && options.warmupFrames > 0 && participants > 1) {
+        warmupBuffers.assign(static_cast<size_t>(participants),
+                             std::vector<float>(blockSize * OFFLINE_BATCH_BLOCKS * static_cast<size_t>(channels)));
+    }
+
+    tasks = std::make_unique<Tasks>(*this);
+    for (size_t task = 0; task < MAX_DSP_TASKS; ++task) {
+        roots[task] = static_cast<uint32_t>(task);
+    }
+}
+
+OfflineRenderer::~OfflineRenderer() = default;
+
+OfflineRenderReport OfflineRenderer::render(const float* input, float* output, size_t frameCount) noexcept {
+    if (!input || !output || frameCount == 0) {
+        return OfflineRenderReport{};
+    }
+    tasks->file = nullptr;
+    tasks->inputSamples = input;
+    tasks->output = output;
+    // A chunk's warm-up would read input an earlier chunk has already overwritten
+    return dispatch(frameCount, input == output);
+}
+
+OfflineRenderReport OfflineRenderer::render(const MappedAudioFile& input, MappedAudioFile& output) {
+    if (input.channelCount() != channels || input.sampleRate() != sampleRate) {
+        throw std::invalid_argument("Input file format differs from the render chain");
+    }
+    if (!output.writableSamples() || output.channelCount() != channels || output.frameCount() != input.frameCount()) {
+        throw std::invalid_argument("Output file must be writable with the input's length and channels");
+    }
+    if (input.frameCount() == 0) {
+        return OfflineRenderReport{};
+    }
+    tasks->file = &input;
+    tasks->inputSamples = nullptr;
+    tasks->output = output.writableSamples();
+    return dispatch(input.frameCount(), &input == &output);
+}
+
+OfflineRenderReport OfflineRenderer::dispatch(size_t frameCount, bool inPlace) noexcept {
+    const auto start = std::chrono::steady_clock::now();
+    const bool chunked = options.parallel && pool && pool->workerCount() > 0 && !inPlace;
+
+    OfflineRenderReport report;
+    report.frames = frameCount;
+    tasks->frameCount = frameCount;
+    if (!chunked) {
+        tasks->chunkFrames = frameCount;
+        tasks->warmupFrames = 0;
+        tasks->taskBase = 0;
+        tasks->renderChunk(0, 0);
+        report.chunks = 1;
+        report.participants = 1;
+    } else {
+        // Whole batches per chunk, several chunks per participant so the tail balances
+        const size_t participants = static_cast<size_t>(participantCount());
+        const size_t batchFrames = blockSize * OFFLINE_BATCH_BLOCKS;
+        size_t chunkFrames = options.chunkFrames;
+        if (chunkFrames == 0) {
+            const size_t target = (frameCount + participants * OFFLINE_CHUNKS_PER_PARTICIPANT - 1) /
+                                  (participants * OFFLINE_CHUNKS_PER_PARTICIPANT);
+            chunkFrames = (target + batchFrames - 1) / batchFrames * batchFrames;
+        }
+        tasks->chunkFrames = chunkFrames;
+        tasks->warmupFrames = options.warmupFrames;
+
+        report.chunks = (frameCount + chunkFrames - 1) / chunkFrames;
+        for (size_t base = 0; base < report.chunks; base += MAX_DSP_TASKS) {
+            tasks->taskBase = base;
+            pool->run(*tasks, roots, std::min(MAX_DSP_TASKS, report.chunks - base));
+        }
+        report.participants = static_cast<int>(std::min(participants, report.chunks));
+    }
+
+    report.audioSeconds = static_cast<double>(frameCount) / sampleRate;
+    report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.realtimeFactor = report.wallSeconds > 0.0 ? report.audioSeconds / report.wallSeconds : 0.0;
+    return report;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,238 @@
+//
+// DSPOfflineRender.hpp
+// TALD UNIA Audio System
+//
+// Faster-than-real-time rendering of whole files through a kernel chain: memory-mapped
+// WAV input and output, large batched blocks, and overlapping chunks rendered on
+// every core of a DSPWorkerPool.
+//
+
+#ifndef TALD_UNIA_DSP_OFFLINE_RENDER_HPP
+#define TALD_UNIA_DSP_OFFLINE_RENDER_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include <string>      // C++20
+#include <vector>      // C++20
+#include "DSPKernel.hpp"
+#include "DSPWorkerPool.hpp"
+
+// Blocks handed to each stage's processBatch() at once
+constexpr size_t OFFLINE_BATCH_BLOCKS = 16;
+
+// Frames rendered and discarded before each parallel chunk so stage history settles
+constexpr size_t DEFAULT_OFFLINE_WARMUP_FRAMES = 24000;
+
+// Chunks per participant when the chunk size is chosen automatically, for load balance
+constexpr size_t OFFLINE_CHUNKS_PER_PARTICIPANT = 4;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Sample encoding of a mapped WAV file
+ */
+enum class AudioSampleFormat : uint8_t {
+    PCM16,
+    PCM24,
+    PCM32,
+    Float32
+};
+
+/**
+ * @brief Interleaved WAV file mapped into memory
+ *
+ * Reading maps the file read-only and converts blocks straight out of the mapping,
+ * so the page cache streams it from disk without another copy. Writing creates a
+ * Float32 WAV of known length, maps it shared and exposes the samples for kernels
+ * to render into in place. PCM and IEEE float data, plain and extensible headers,
+ * are accepted.
+ */
+class MappedAudioFile {
+public:
+    /**
+     * @brief Map an existing WAV file for reading
+     * @throws std::runtime_error if the file cannot be opened, mapped or parsed
+     */
+    explicit MappedAudioFile(const std::string& path);
+
+    /**
+     * @brief Create (or replace) a Float32 WAV file of frames frames and map it for writing
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if the file cannot be created or mapped
+     */
+    MappedAudioFile(const std::string& path, int channels, double sampleRate, size_t frames);
+
+    ~MappedAudioFile();
+
+    MappedAudioFile(const MappedAudioFile&) = delete;
+    MappedAudioFile& operator=(const MappedAudioFile&) = delete;
+
+    /**
+     * @brief Convert count frames starting at first to interleaved floats
+     *
+     * Frames past the end read as silence.
+     */
+    void readFrames(size_t first, size_t count, float* destination) const noexcept;
+
+    /**
+     * @brief Interleaved samples of a file created for writing, or null
+     */
+    [[nodiscard]]
+    float* writableSamples() noexcept {
+        return writable ? reinterpret_cast<float*>(const_cast<uint8_t*>(samples)) : nullptr;
+    }
+
+    /**
+     * @brief Write dirty pages back to the file (writable files)
+     * @return false if the system reported an error
+     */
+    bool flush() noexcept;
+
+    [[nodiscard]]
+    int channelCount() const noexcept {
+        return channels;
+    }
+
+    [[nodiscard]]
+    double sampleRate() const noexcept {
+        return rate;
+    }
+
+    [[nodiscard]]
+    size_t frameCount() const noexcept {
+        return frames;
+    }
+
+    [[nodiscard]]
+    AudioSampleFormat format() const noexcept {
+        return sampleFormat;
+    }
+
+private:
+    int descriptor = -1;
+    void* mapping = nullptr;
+    size_t mappingBytes = 0;
+    const uint8_t* samples = nullptr;   // First byte of the data chunk
+    bool writable = false;
+
+    int channels = 0;
+    double rate = 0.0;
+    size_t frames = 0;
+    AudioSampleFormat sampleFormat = AudioSampleFormat::Float32;
+
+    void parseHeader();
+    void close() noexcept;
+};
+
+/**
+ * @brief How OfflineRenderer splits a file
+ */
+struct OfflineRenderOptions {
+    // Frames per parallel chunk; 0 spreads the file over OFFLINE_CHUNKS_PER_PARTICIPANT
+    // chunks per participant
+    size_t chunkFrames = 0;
+
+    // Frames rendered before each chunk but the first and thrown away; must cover the
+    // longest history (filter tail, envelope) of any stage for chunked output to match
+    size_t warmupFrames = DEFAULT_OFFLINE_WARMUP_FRAMES;
+
+    // Split into chunks across the pool; false renders the whole file as one stream
+    bool parallel = true;
+};
+
+/**
+ * @brief Outcome of one offline render
+ */
+struct OfflineRenderReport {
+    size_t frames = 0;
+    size_t chunks = 0;
+    int participants = 0;        // Threads that rendered, the caller included
+    double audioSeconds = 0.0;
+    double wallSeconds = 0.0;
+    double realtimeFactor = 0.0; // Audio time rendered per second of wall time
+};
+
+/**
+ * @brief Renders a whole file through a chain of kernels as fast as the machine allows
+ *
+ * Every participant of the pool owns a fork of each stage, created up front, so
+ * render() neither allocates nor locks. Stages run in place on batches of
+ * OFFLINE_BATCH_BLOCKS blocks of the largest size every stage accepts, so per-call
+ * setup is paid once per batch rather than once per device buffer. With parallel
+ * set, the file is cut into chunks rendered independently on all cores: each chunk
+ * restarts the chain and first renders warmupFrames of the preceding audio into
+ * scratch, so stages whose history is shorter than the warm-up (stateless ones,
+ * FIR filters, short envelopes) give the same output as a single pass. Stages with
+ * longer memory should be rendered with parallel off. Stage latency is not
+ * compensated.
+ */
+class OfflineRenderer {
+public:
+    /**
+     * @param stages Prototype kernels in processing order; their current parameters are used
+     * @param stageCount Number of stages, at least one
+     * @param pool Worker pool to spread chunks across, or null to render on the calling thread
+     * @param options Chunking and warm-up
+     * @throws std::invalid_argument if stages differ in channel count or sample rate
+     * @throws std::runtime_error if a fork cannot be created
+     */
+    OfflineRenderer(const DSPKernel* const* stages, size_t stageCount, DSPWorkerPool* pool = nullptr,
+                    const OfflineRenderOptions& options = OfflineRenderOptions{});
+    ~OfflineRenderer();
+
+    OfflineRenderer(const OfflineRenderer&) = delete;
+    OfflineRenderer& operator=(const OfflineRenderer&) = delete;
+
+    /**
+     * @brief Render interleaved frames from memory
+     *
+     * input may equal output; an in-place render runs as a single stream, since a
+     * chunk's warm-up would read audio an earlier chunk has already overwritten.
+     */
+    OfflineRenderReport render(const float* input, float* output, size_t frameCount) noexcept;
+
+    /**
+     * @brief Render a mapped file into a writable file of the same length and channels
+     * @throws std::invalid_argument if the files do not match the chain
+     */
+    OfflineRenderReport render(const MappedAudioFile& input, MappedAudioFile& output);
+
+    /**
+     * @brief Threads that render at once, the caller included
+     */
+    [[nodiscard]]
+    int participantCount() const noexcept {
+        return static_cast<int>(chains.size());
+    }
+
+    /**
+     * @brief Frames per block given to the stages
+     */
+    [[nodiscard]]
+    size_t blockFrames() const noexcept {
+        return blockSize;
+    }
+
+private:
+    class Tasks;
+
+    DSPWorkerPool* pool;
+    const OfflineRenderOptions options;
+    const int channels;
+    const double sampleRate;
+    size_t blockSize;
+
+    std::vector<std::vector<std::unique_ptr<DSPKernel>>> chains;   // [participant][stage]
+    std::vector<std::vector<float>> warmupBuffers;                 // Per participant
+    std::unique_ptr<Tasks> tasks;
+    uint32_t roots[MAX_DSP_TASKS];
+
+    OfflineRenderReport dispatch(size_t frameCount, bool inPlace) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_OFFLINE_RENDER_HPP
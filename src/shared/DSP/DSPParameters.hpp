@@ -0,0 +1,270 @@
+#ifndef TALD_UNIA_DSP_PARAMETERS_HPP
+#define TALD_UNIA_DSP_PARAMETERS_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <Accelerate/Accelerate.h> // macOS SDK
+
+// Parameter subsystem configuration
+constexpr size_t PARAMETER_QUEUE_CAPACITY = 1024;
+constexpr int MAX_PARAMETERS = 32;
+constexpr double DEFAULT_RAMP_TIME_SECONDS = 0.010;
+constexpr size_t PARAMETER_CACHE_LINE_SIZE = 64;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Parameter identifiers understood by the built-in kernels
+ */
+enum ParameterID : int {
+    kParameterGain = 0,
+    kParameterThreshold,   // Dynamics threshold (dB)
+    kParameterRatio,       // Dynamics ratio (x:1)
+    kParameterAttack,      // Dynamics attack time (seconds)
+    kParameterRelease,     // Dynamics release time (seconds)
+    kParameterKnee,        // Dynamics soft-knee width (dB)
+    kParameterCount
+};
+
+/**
+ * @brief Interpolation curve used when a parameter moves to a new target
+ */
+enum class RampShape : uint8_t {
+    Linear,      // Constant increment per sample
+    Exponential  // Constant ratio per sample (linear in dB), requires non-zero endpoints
+};
+
+/**
+ * @brief Parameter change scheduled from a control thread
+ *
+ * sampleOffset is relative to the start of the next block rendered after the
+ * event is drained; events beyond that block carry over to subsequent blocks.
+ * A rampFrames value of zero selects the kernel default ramp length.
+ */
+struct ParameterEvent {
+    int32_t parameterID = 0;
+    float value = 0.0f;
+    uint32_t sampleOffset = 0;
+    uint32_t rampFrames = 0;
+    RampShape shape = RampShape::Linear;
+};
+
+/**
+ * @brief Wait-free single-producer/single-consumer queue of trivially copyable items
+ * @tparam T Item type
+ * @tparam Capacity Queue capacity (must be power of 2)
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be power of 2");
+
+public:
+    /**
+     * @brief Enqueue an item (producer thread only)
+     * @return false if the queue is full
+     */
+    bool push(const T& item) noexcept {
+        const size_t tail = writeIndex.load(std::memory_order_relaxed);
+        if (tail - cachedReadIndex >= Capacity) {
+            cachedReadIndex = readIndex.load(std::memory_order_acquire);
+            if (tail - cachedReadIndex >= Capacity) {
+                return false;
+            }
+        }
+        slots[tail & (Capacity - 1)] = item;
+        writeIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue an item (consumer thread only)
+     * @return false if the queue is empty
+     */
+    bool pop(T& item) noexcept {
+        const size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == cachedWriteIndex) {
+            cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+            if (head == cachedWriteIndex) {
+                return false;
+            }
+        }
+        item = slots[head & (Capacity - 1)];
+        readIndex.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(PARAMETER_CACHE_LINE_SIZE) std::atomic<size_t> writeIndex{0};
+    size_t cachedReadIndex = 0;
+    alignas(PARAMETER_CACHE_LINE_SIZE) std::atomic<size_t> readIndex{0};
+    size_t cachedWriteIndex = 0;
+    alignas(PARAMETER_CACHE_LINE_SIZE) std::array<T, Capacity> slots{};
+};
+
+/**
+ * @brief Lock-free parameter event channel between one control thread and the render thread
+ *
+ * Events are queued in order. If the queue is full the update is coalesced into a
+ * per-parameter overflow slot instead of being dropped, and all further updates are
+ * routed there until the render thread has drained it, so ordering is preserved and
+ * the most recent value always reaches the kernel.
+ */
+class ParameterEventQueue {
+public:
+    ParameterEventQueue() noexcept {
+        for (auto& value : overflowValues) {
+            value.store(0.0f, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Schedule a parameter change (control thread only, never blocks)
+     * @param event Parameter event to deliver
+     */
+    void push(const ParameterEvent& event) noexcept {
+        if (event.parameterID < 0 || event.parameterID >= MAX_PARAMETERS) {
+            return;
+        }
+
+        if (overflowMask.load(std::memory_order_acquire) == 0 && events.push(event)) {
+            return;
+        }
+
+        // Queue full or overflow pending: coalesce into the latest-value slot
+        overflowValues[event.parameterID].store(event.value, std::memory_order_relaxed);
+        overflowMask.fetch_or(1u << event.parameterID, std::memory_order_release);
+    }
+
+    /**
+     * @brief Dequeue the next ordered event (render thread only)
+     * @return false when no queued or coalesced events remain
+     */
+    bool pop(ParameterEvent& event) noexcept {
+        if (events.pop(event)) {
+            return true;
+        }
+
+        // Coalesced updates are always newer than anything left in the queue
+        if (pendingOverflow == 0) {
+            pendingOverflow = overflowMask.exchange(0, std::memory_order_acq_rel);
+            if (pendingOverflow == 0) {
+                return false;
+            }
+        }
+
+        const int parameterID = __builtin_ctz(pendingOverflow);
+        pendingOverflow &= pendingOverflow - 1;
+
+        event = ParameterEvent{};
+        event.parameterID = parameterID;
+        event.value = overflowValues[parameterID].load(std::memory_order_relaxed);
+        return true;
+    }
+
+private:
+    SPSCQueue<ParameterEvent, PARAMETER_QUEUE_CAPACITY> events;
+    std::array<std::atomic<float>, MAX_PARAMETERS> overflowValues;
+    alignas(PARAMETER_CACHE_LINE_SIZE) std::atomic<uint32_t> overflowMask{0};
+    uint32_t pendingOverflow = 0; // Render thread only
+};
+
+/**
+ * @brief Per-parameter ramp state advanced on the render thread
+ */
+class SmoothedParameter {
+public:
+    explicit SmoothedParameter(float initialValue = 0.0f) noexcept
+        : current(initialValue)
+        , target(initialValue)
+        , step(0.0f)
+        , remainingFrames(0)
+        , shape(RampShape::Linear) {
+    }
+
+    /**
+     * @brief Start a ramp from the current value to a new target
+     * @param newTarget Target value
+     * @param rampFrames Ramp length in frames (0 jumps immediately)
+     * @param rampShape Interpolation curve
+     */
+    void setTarget(float newTarget, uint32_t rampFrames, RampShape rampShape) noexcept {
+        target = newTarget;
+        shape = rampShape;
+
+        if (rampFrames == 0 || newTarget == current) {
+            jumpTo(newTarget);
+            return;
+        }
+
+        if (shape == RampShape::Exponential && (current <= 0.0f || newTarget <= 0.0f)) {
+            shape = RampShape::Linear;
+        }
+
+        remainingFrames = rampFrames;
+        step = (shape == RampShape::Linear)
+            ? (target - current) / static_cast<float>(rampFrames)
+            : (std::log(target) - std::log(current)) / static_cast<float>(rampFrames);
+    }
+
+    void jumpTo(float value) noexcept {
+        current = value;
+        target = value;
+        step = 0.0f;
+        remainingFrames = 0;
+    }
+
+    [[nodiscard]] bool isRamping() const noexcept { return remainingFrames > 0; }
+    [[nodiscard]] float value() const noexcept { return current; }
+    [[nodiscard]] float targetValue() const noexcept { return target; }
+
+    /**
+     * @brief Write the next frameCount parameter values and advance the ramp
+     * @param destination Output buffer of at least frameCount floats
+     * @param frameCount Number of values to generate
+     */
+    void render(float* destination, size_t frameCount) noexcept {
+        const size_t rampCount = std::min(frameCount, static_cast<size_t>(remainingFrames));
+
+        if (rampCount > 0) {
+            if (shape == RampShape::Linear) {
+                float start = current + step;
+                vDSP_vramp(&start, &step, destination, 1, rampCount);
+            }
+            else {
+                // Linear ramp in the log domain, then exponentiate
+                float start = std::log(current) + step;
+                vDSP_vramp(&start, &step, destination, 1, rampCount);
+                const int count = static_cast<int>(rampCount);
+                vvexpf(destination, destination, &count);
+            }
+
+            remainingFrames -= static_cast<uint32_t>(rampCount);
+            current = (remainingFrames == 0) ? target : destination[rampCount - 1];
+            if (remainingFrames == 0) {
+                destination[rampCount - 1] = target;
+            }
+        }
+
+        if (rampCount < frameCount) {
+            vDSP_vfill(&current, destination + rampCount, 1, frameCount - rampCount);
+        }
+    }
+
+private:
+    float current;
+    float target;
+    float step;
+    uint32_t remainingFrames;
+    RampShape shape;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_PARAMETERS_HPP
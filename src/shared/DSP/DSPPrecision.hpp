@@ -0,0 +1,153 @@
+//
+// DSPPrecision.hpp
+// TALD UNIA Audio System
+//
+// Reduced-precision sample formats for low-power rendering, and the scalar
+// conversions and multiplies that define their results on every instruction set.
+//
+
+#ifndef TALD_UNIA_DSP_PRECISION_HPP
+#define TALD_UNIA_DSP_PRECISION_HPP
+
+#include <algorithm>   // C++20
+#include <cmath>       // C++20
+#include <cstdint>     // C++20
+#include <limits>      // C++20
+
+// Largest finite FP16 value and the smallest normal one
+constexpr float FLOAT16_MAX = 65504.0f;
+constexpr float FLOAT16_MIN_NORMAL = 6.103515625e-05f;
+
+// Integer bits above the binary point in fixed-point gains, so gains up to +12 dB fit
+constexpr int FIXED_POINT_GAIN_HEADROOM_BITS = 2;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Arithmetic format of a kernel's signal path, chosen when it is created
+ *
+ * Samples stay binary32 at the kernel's edges; reduced formats convert on load and
+ * store, fused into the processing pass. The 16-bit formats fit eight samples in a
+ * 128-bit vector instead of four. Q formats saturate at full scale (+/-1.0)
+ * instead of keeping float headroom.
+ */
+enum class ProcessingPrecision : uint8_t {
+    Float32,   // Reference path
+    Float16,   // IEEE binary16: about 11 significant bits, range to 65504
+    Q31,       // 32-bit fixed point, gains in Q2.29
+    Q15        // 16-bit fixed point, gains in Q2.13
+};
+
+/**
+ * @brief Human-readable name of a processing precision
+ */
+[[nodiscard]]
+constexpr const char* processingPrecisionName(ProcessingPrecision precision) noexcept {
+    switch (precision) {
+        case ProcessingPrecision::Float32: return "Float32";
+        case ProcessingPrecision::Float16: return "Float16";
+        case ProcessingPrecision::Q31: return "Q31";
+        case ProcessingPrecision::Q15: return "Q15";
+    }
+    return "Unknown";
+}
+
+// MARK: - Reference conversions
+//
+// Vector backends must reproduce these bit for bit: round to nearest even on every
+// conversion into a reduced format, rounding right shifts and saturation for fixed
+// point products, and NaN converting to fixed-point zero.
+
+/**
+ * @brief Value of the binary16 number nearest to value, as binary32
+ */
+[[nodiscard]]
+inline float roundToFloat16(float value) noexcept {
+    const float magnitude = std::fabs(value);
+    if (magnitude != magnitude) {
+        return value;
+    }
+    // 65520 is halfway to the next power of two and rounds up to infinity
+    if (magnitude >= 65520.0f) {
+        return std::copysign(std::numeric_limits<float>::infinity(), value);
+    }
+    if (magnitude < FLOAT16_MIN_NORMAL) {
+        // Subnormal spacing is 2^-24; the scaling is exact
+        return std::nearbyint(value * 16777216.0f) * (1.0f / 16777216.0f);
+    }
+    int exponent = 0;
+    std::frexp(magnitude, &exponent);
+    const float quantum = std::ldexp(1.0f, exponent - 11);
+    return std::nearbyint(value / quantum) * quantum;
+}
+
+/**
+ * @brief Binary16 product of a sample and a gain already rounded to binary16
+ *
+ * The binary32 product of two binary16 values is exact, so one rounding gives the
+ * correctly rounded binary16 result.
+ */
+[[nodiscard]]
+inline float multiplyFloat16(float sample, float gain16) noexcept {
+    return roundToFloat16(roundToFloat16(sample) * gain16);
+}
+
+[[nodiscard]]
+inline int16_t toQ15(float value, int fractionBits = 15) noexcept {
+    const float scaled = value * static_cast<float>(1 << fractionBits);
+    if (scaled != scaled) {
+        return 0;
+    }
+    return static_cast<int16_t>(std::nearbyint(std::clamp(scaled, -32768.0f, 32767.0f)));
+}
+
+[[nodiscard]]
+inline int16_t q15Gain(float gain) noexcept {
+    return toQ15(gain, 15 - FIXED_POINT_GAIN_HEADROOM_BITS);
+}
+
+[[nodiscard]]
+inline int16_t multiplyQ15(int16_t sample, int16_t gain) noexcept {
+    constexpr int shift = 15 - FIXED_POINT_GAIN_HEADROOM_BITS;
+    const int32_t product = static_cast<int32_t>(sample) * gain;
+    const int32_t rounded = (product + (1 << (shift - 1))) >> shift;
+    return static_cast<int16_t>(std::clamp<int32_t>(rounded, INT16_MIN, INT16_MAX));
+}
+
+[[nodiscard]]
+inline float fromQ15(int16_t value) noexcept {
+    return static_cast<float>(value) * (1.0f / 32768.0f);
+}
+
+[[nodiscard]]
+inline int32_t toQ31(float value, int fractionBits = 31) noexcept {
+    const double scaled = static_cast<double>(value) * std::ldexp(1.0, fractionBits);
+    if (scaled != scaled) {
+        return 0;
+    }
+    return static_cast<int32_t>(std::nearbyint(std::clamp(scaled, -2147483648.0, 2147483647.0)));
+}
+
+[[nodiscard]]
+inline int32_t q31Gain(float gain) noexcept {
+    return toQ31(gain, 31 - FIXED_POINT_GAIN_HEADROOM_BITS);
+}
+
+[[nodiscard]]
+inline int32_t multiplyQ31(int32_t sample, int32_t gain) noexcept {
+    constexpr int shift = 31 - FIXED_POINT_GAIN_HEADROOM_BITS;
+    const int64_t product = static_cast<int64_t>(sample) * gain;
+    const int64_t rounded = (product + (int64_t{1} << (shift - 1))) >> shift;
+    return static_cast<int32_t>(std::clamp<int64_t>(rounded, INT32_MIN, INT32_MAX));
+}
+
+[[nodiscard]]
+inline float fromQ31(int32_t value) noexcept {
+    return static_cast<float>(value) * (1.0f / 2147483648.0f);
+}
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_PRECISION_HPP
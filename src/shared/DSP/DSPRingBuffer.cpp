@@ -0,0 +1,227 @@
+#include "DSPRingBuffer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include "DSPKernel.hpp"
+
+#if defined(__APPLE__)
+    #include <mach/mach.h>
+#elif defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+// Version comments for external dependencies
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+AudioRingBuffer::AudioRingBuffer(int channels, size_t minimumFrames, RingMapping requestedMapping)
+    : channels(channels)
+{
+    if (channels <= 0 || channels > MAX_CHANNELS) {
+        throw std::invalid_argument("Channel count out of valid range");
+    }
+    if (minimumFrames == 0 || minimumFrames > MAX_RING_BUFFER_FRAMES) {
+        throw std::invalid_argument("Ring buffer size out of valid range");
+    }
+
+    const size_t frameBytes = static_cast<size_t>(channels) * sizeof(float);
+    capacityFrames = std::bit_ceil(minimumFrames);
+    if (requestedMapping == RingMapping::Mirrored) {
+        // Both copies must start on a page boundary
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        while ((capacityFrames * frameBytes) % pageSize != 0) {
+            capacityFrames *= 2;
+        }
+    }
+    storageBytes = capacityFrames * frameBytes;
+
+    if (requestedMapping == RingMapping::Mirrored && mapMirrored()) {
+        storageMapping = RingMapping::Mirrored;
+        return;
+    }
+    storage = static_cast<float*>(alignedMalloc(storageBytes, CACHE_LINE_SIZE));
+    if (!storage) {
+        throw std::runtime_error("Failed to allocate ring buffer");
+    }
+}
+
+AudioRingBuffer::~AudioRingBuffer() {
+    unmap();
+}
+
+bool AudioRingBuffer::mapMirrored() noexcept {
+#if defined(__APPLE__)
+    const vm_map_t task = mach_task_self();
+    // Another thread can claim the freed upper half between the calls; retry elsewhere
+    for (int attempt = 0; attempt < 3; ++attempt) {
+        vm_address_t base = 0;
+        if (vm_allocate(task, &base, 2 * storageBytes, VM_FLAGS_ANYWHERE) != KERN_SUCCESS) {
+            return false;
+        }
+        if (vm_deallocate(task, base + storageBytes, storageBytes) != KERN_SUCCESS) {
+            vm_deallocate(task, base, 2 * storageBytes);
+            return false;
+        }
+        vm_address_t mirror = base + storageBytes;
+        vm_prot_t currentProtection = VM_PROT_NONE;
+        vm_prot_t maximumProtection = VM_PROT_NONE;
+        const kern_return_t result = vm_remap(task, &mirror, storageBytes, 0, VM_FLAGS_FIXED, task, base,
+                                              FALSE, &currentProtection, &maximumProtection, VM_INHERIT_DEFAULT);
+        if (result == KERN_SUCCESS && mirror == base + storageBytes) {
+            storage = reinterpret_cast<float*>(base);
+            return true;
+        }
+        if (result == KERN_SUCCESS) {
+            vm_deallocate(task, mirror, storageBytes);
+        }
+        vm_deallocate(task, base, storageBytes);
+    }
+    return false;
+#elif defined(__linux__)
+    const int descriptor = memfd_create("tald-audio-ring", MFD_CLOEXEC);
+    if (descriptor < 0) {
+        return false;
+    }
+    bool mapped = false;
+    if (ftruncate(descriptor, static_cast<off_t>(storageBytes)) == 0) {
+        // Reserve both halves, then map the same pages over each
+        void* reserved = mmap(nullptr, 2 * storageBytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (reserved != MAP_FAILED) {
+            char* base = static_cast<char*>(reserved);
+            mapped = mmap(base, storageBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                          descriptor, 0) == base &&
+                     mmap(base + storageBytes, storageBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                          descriptor, 0) == base + storageBytes;
+            if (mapped) {
+                storage = reinterpret_cast<float*>(base);
+            } else {
+                munmap(reserved, 2 * storageBytes);
+            }
+        }
+    }
+    close(descriptor);
+    return mapped;
+#else
+    return false;
+#endif
+}
+
+void AudioRingBuffer::unmap() noexcept {
+    if (!storage) {
+        return;
+    }
+    if (storageMapping == RingMapping::Flat) {
+        alignedFree(storage);
+    } else {
+#if defined(__APPLE__)
+        vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(storage), 2 * storageBytes);
+#elif defined(__linux__)
+        munmap(storage, 2 * storageBytes);
+#endif
+    }
+    storage = nullptr;
+}
+
+size_t AudioRingBuffer::contiguousFrames(size_t index, size_t frames) const noexcept {
+    if (storageMapping == RingMapping::Mirrored) {
+        return frames;
+    }
+    return std::min(frames, capacityFrames - (index & (capacityFrames - 1)));
+}
+
+// MARK: - Producer
+
+AudioBufferView AudioRingBuffer::acquireWrite(size_t maxFrames) noexcept {
+    const size_t tail = writeIndex.load(std::memory_order_relaxed);
+    size_t space = capacityFrames - (tail - cachedReadIndex);
+    if (space < maxFrames) {
+        cachedReadIndex = readIndex.load(std::memory_order_acquire);
+        space = capacityFrames - (tail - cachedReadIndex);
+    }
+    return AudioBufferView::makeInterleaved(frameAt(tail), channels,
+                                            contiguousFrames(tail, std::min(space, maxFrames)));
+}
+
+size_t AudioRingBuffer::write(const float* source, size_t frames) noexcept {
+    size_t written = 0;
+    while (written < frames) {
+        const AudioBufferView region = acquireWrite(frames - written);
+        if (region.frames == 0) {
+            break;
+        }
+        std::memcpy(region.interleaved, source + written * static_cast<size_t>(channels),
+                    region.frames * static_cast<size_t>(channels) * sizeof(float));
+        commitWrite(region.frames);
+        written += region.frames;
+    }
+    return written;
+}
+
+// MARK: - Consumer
+
+AudioBufferView AudioRingBuffer::acquireRead(size_t maxFrames) noexcept {
+    const size_t head = readIndex.load(std::memory_order_relaxed);
+    size_t ready = cachedWriteIndex - head;
+    if (ready < maxFrames) {
+        cachedWriteIndex = writeIndex.load(std::memory_order_acquire);
+        ready = cachedWriteIndex - head;
+    }
+    return AudioBufferView::makeInterleaved(frameAt(head), channels,
+                                            contiguousFrames(head, std::min(ready, maxFrames)));
+}
+
+size_t AudioRingBuffer::read(float* destination, size_t frames) noexcept {
+    size_t done = 0;
+    while (done < frames) {
+        const AudioBufferView region = acquireRead(frames - done);
+        if (region.frames == 0) {
+            break;
+        }
+        std::memcpy(destination + done * static_cast<size_t>(channels), region.interleaved,
+                    region.frames * static_cast<size_t>(channels) * sizeof(float));
+        commitRead(region.frames);
+        done += region.frames;
+    }
+    return done;
+}
+
+void AudioRingBuffer::reset() noexcept {
+    writeIndex.store(0, std::memory_order_relaxed);
+    readIndex.store(0, std::memory_order_relaxed);
+    cachedReadIndex = 0;
+    cachedWriteIndex = 0;
+}
+
+// MARK: - Kernel Handoff
+
+size_t processRingBuffers(DSPKernel& kernel, AudioRingBuffer& input, AudioRingBuffer& output,
+                          size_t frames) noexcept {
+    if (input.channelCount() != kernel.channelCount() || output.channelCount() != kernel.channelCount()) {
+        return 0;
+    }
+
+    size_t processed = 0;
+    while (processed < frames) {
+        const size_t block = std::min(frames - processed, kernel.maximumFramesPerBlock());
+        AudioBufferView source = input.acquireRead(block);
+        AudioBufferView destination = output.acquireWrite(source.frames);
+        const size_t count = std::min(source.frames, destination.frames);
+        if (count == 0) {
+            break;
+        }
+        source.frames = count;
+        destination.frames = count;
+        kernel.process(source, destination);
+        input.commitRead(count);
+        output.commitWrite(count);
+        processed += count;
+    }
+    return processed;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,192 @@
+//
+// DSPRingBuffer.hpp
+// TALD UNIA Audio System
+//
+// Wait-free single-producer/single-consumer ring of interleaved audio frames for
+// the HAL I/O path, with in-place spans kernels can process directly.
+//
+
+#ifndef TALD_UNIA_DSP_RING_BUFFER_HPP
+#define TALD_UNIA_DSP_RING_BUFFER_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include "DSPBufferLayout.hpp"
+#include "DSPConfig.hpp"
+
+// Largest ring accepted, about 22 s of audio at 48 kHz
+constexpr size_t MAX_RING_BUFFER_FRAMES = size_t(1) << 20;
+
+namespace tald {
+namespace dsp {
+
+class DSPKernel;
+
+/**
+ * @brief Storage mapping of an AudioRingBuffer
+ */
+enum class RingMapping : uint8_t {
+    Flat,       // One allocation; regions crossing the end come back in two parts
+    Mirrored    // Storage mapped twice back to back, so every region is contiguous
+};
+
+/**
+ * @brief Wait-free SPSC ring of interleaved frames
+ *
+ * The producer (e.g. the HAL input callback, or a kernel rendering output) takes a
+ * writable region with acquireWrite(), fills it in place and publishes it with
+ * commitWrite(); the consumer mirrors that with acquireRead() / commitRead(). The
+ * regions are AudioBufferViews, so DSPKernel::process() can read straight out of
+ * one ring and write straight into another with no staging copy. Indices are
+ * free-running counters on their own cache lines, each side caching the other's
+ * index as SPSCQueue does, so the steady state touches one shared line per commit.
+ *
+ * With RingMapping::Mirrored the storage pages are mapped a second time right after
+ * themselves, so a region that wraps is still one contiguous view. Where the
+ * mapping is unavailable the ring falls back to Flat; mapping() reports which
+ * one is in use. Construction allocates; everything else neither allocates nor locks.
+ */
+class AudioRingBuffer {
+public:
+    /**
+     * @param channels Interleaved channels per frame, 1...MAX_CHANNELS
+     * @param minimumFrames Frames the ring must hold; rounded up to a power of two,
+     *                      and for a mirrored mapping to whole pages
+     * @param requestedMapping Flat, or Mirrored where the platform supports it
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    AudioRingBuffer(int channels, size_t minimumFrames, RingMapping requestedMapping = RingMapping::Flat);
+    ~AudioRingBuffer();
+
+    AudioRingBuffer(const AudioRingBuffer&) = delete;
+    AudioRingBuffer& operator=(const AudioRingBuffer&) = delete;
+
+    // MARK: Producer
+
+    /**
+     * @brief Contiguous writable region of up to maxFrames (producer only)
+     * @return An empty view (frames == 0) when the ring is full
+     *
+     * A flat ring stops at the end of its storage; call again after committing to
+     * get the part that wrapped.
+     */
+    [[nodiscard]]
+    AudioBufferView acquireWrite(size_t maxFrames) noexcept;
+
+    /**
+     * @brief Publish frames written into the last acquired region (producer only)
+     */
+    void commitWrite(size_t frames) noexcept {
+        writeIndex.store(writeIndex.load(std::memory_order_relaxed) + frames, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy in up to frames interleaved frames (producer only)
+     * @return Frames written; fewer than requested when the ring fills
+     */
+    size_t write(const float* source, size_t frames) noexcept;
+
+    // MARK: Consumer
+
+    /**
+     * @brief Contiguous readable region of up to maxFrames (consumer only)
+     * @return An empty view (frames == 0) when the ring is empty
+     */
+    [[nodiscard]]
+    AudioBufferView acquireRead(size_t maxFrames) noexcept;
+
+    /**
+     * @brief Release frames read from the last acquired region (consumer only)
+     */
+    void commitRead(size_t frames) noexcept {
+        readIndex.store(readIndex.load(std::memory_order_relaxed) + frames, std::memory_order_release);
+    }
+
+    /**
+     * @brief Copy out up to frames interleaved frames (consumer only)
+     * @return Frames read; fewer than requested when the ring runs dry
+     */
+    size_t read(float* destination, size_t frames) noexcept;
+
+    // MARK: Either Side
+
+    /**
+     * @brief Frames waiting to be read; exact on the consumer, a lower bound elsewhere
+     */
+    [[nodiscard]]
+    size_t availableToRead() const noexcept {
+        // Read index first: a later write index can only be larger, so this never underflows
+        const size_t head = readIndex.load(std::memory_order_acquire);
+        return writeIndex.load(std::memory_order_acquire) - head;
+    }
+
+    /**
+     * @brief Free frames; exact on the producer, a lower bound elsewhere
+     */
+    [[nodiscard]]
+    size_t availableToWrite() const noexcept {
+        return capacityFrames - availableToRead();
+    }
+
+    /**
+     * @brief Empty the ring; neither side may be using it
+     */
+    void reset() noexcept;
+
+    [[nodiscard]]
+    size_t capacity() const noexcept {
+        return capacityFrames;
+    }
+
+    [[nodiscard]]
+    int channelCount() const noexcept {
+        return channels;
+    }
+
+    [[nodiscard]]
+    RingMapping mapping() const noexcept {
+        return storageMapping;
+    }
+
+private:
+    const int channels;
+    size_t capacityFrames = 0;    // Power of two
+    size_t storageBytes = 0;      // One copy of the storage
+    RingMapping storageMapping = RingMapping::Flat;
+    float* storage = nullptr;
+
+    // Producer and consumer indices live on separate cache lines to avoid false sharing
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> writeIndex{0};
+    size_t cachedReadIndex = 0;   // Producer only
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> readIndex{0};
+    size_t cachedWriteIndex = 0;  // Consumer only
+
+    [[nodiscard]]
+    float* frameAt(size_t index) const noexcept {
+        return storage + (index & (capacityFrames - 1)) * static_cast<size_t>(channels);
+    }
+
+    [[nodiscard]]
+    size_t contiguousFrames(size_t index, size_t frames) const noexcept;
+
+    bool mapMirrored() noexcept;
+    void unmap() noexcept;
+};
+
+/**
+ * @brief Render up to frames frames from one ring straight into another
+ * @return Frames processed: limited by what input holds and output has room for
+ *
+ * Runs the kernel on the rings' own storage, one contiguous region (at most
+ * maximumFramesPerBlock()) at a time. The caller must be input's consumer and
+ * output's producer. Returns 0 if either ring's channel count differs from the
+ * kernel's.
+ */
+size_t processRingBuffers(DSPKernel& kernel, AudioRingBuffer& input, AudioRingBuffer& output,
+                          size_t frames) noexcept;
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_RING_BUFFER_HPP
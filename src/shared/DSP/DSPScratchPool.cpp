@@ -0,0 +1,189 @@
+#include "DSPScratchPool.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <mutex>
+#include <stdexcept>
+#include "DSPKernel.hpp"
+
+// Version comments for external dependencies
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Quarter-octave classes from SCRATCH_MIN_BLOCK_FLOATS (2^6) up to 2^40 floats
+    constexpr int kMinClassExponent = 6;
+    constexpr int kMaxClassExponent = 40;
+    constexpr int kSizeClasses = (kMaxClassExponent - kMinClassExponent + 1) * 4;
+
+    static_assert(SCRATCH_MIN_BLOCK_FLOATS == (size_t{1} << kMinClassExponent),
+                  "Smallest class must match SCRATCH_MIN_BLOCK_FLOATS");
+
+    [[nodiscard]]
+    size_t classCapacity(int sizeClass) noexcept {
+        return static_cast<size_t>(4 + sizeClass % 4) << (sizeClass / 4 + kMinClassExponent - 2);
+    }
+
+    [[nodiscard]]
+    int sizeClassFor(size_t floatCount) noexcept {
+        const size_t count = std::max(floatCount, SCRATCH_MIN_BLOCK_FLOATS);
+        int exponent = static_cast<int>(std::bit_width(count)) - 1;
+        const size_t quarter = size_t{1} << (exponent - 2);
+        int step = static_cast<int>((count + quarter - 1) / quarter) - 4;
+        if (step == 4) {
+            ++exponent;
+            step = 0;
+        }
+        return (exponent - kMinClassExponent) * 4 + step;
+    }
+
+    // Free blocks are linked through their own first bytes, so releasing never allocates
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct ScratchPool {
+        std::mutex mutex;
+        std::array<FreeBlock*, kSizeClasses> freeLists = {};
+        size_t cachedBlocks = 0;
+        size_t cachedBytes = 0;
+        uint64_t systemAllocations = 0;
+
+        // Caller holds the lock
+        void push(float* memory, int sizeClass) noexcept {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(memory);
+            block->next = freeLists[sizeClass];
+            freeLists[sizeClass] = block;
+            ++cachedBlocks;
+            cachedBytes += classCapacity(sizeClass) * sizeof(float);
+        }
+
+        float* pop(int sizeClass) noexcept {
+            FreeBlock* block = freeLists[sizeClass];
+            if (!block) {
+                return nullptr;
+            }
+            freeLists[sizeClass] = block->next;
+            --cachedBlocks;
+            cachedBytes -= classCapacity(sizeClass) * sizeof(float);
+            return reinterpret_cast<float*>(block);
+        }
+
+        float* allocate(int sizeClass) {
+            float* memory = static_cast<float*>(alignedMalloc(classCapacity(sizeClass) * sizeof(float),
+                                                              CACHE_LINE_SIZE));
+            if (!memory) {
+                throw std::runtime_error("Failed to allocate scratch memory");
+            }
+            ++systemAllocations;
+            return memory;
+        }
+    };
+
+    // Never destroyed, so kernels released during static destruction can still return blocks
+    ScratchPool& pool() {
+        static ScratchPool* instance = new ScratchPool();
+        return *instance;
+    }
+
+    void releaseToPool(float* memory, int sizeClass) noexcept {
+        ScratchPool& shared = pool();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        shared.push(memory, sizeClass);
+    }
+
+    int checkedSizeClass(size_t floatCount) {
+        if (floatCount > (size_t{1} << kMaxClassExponent)) {
+            throw std::runtime_error("Scratch request exceeds the largest pool class");
+        }
+        return sizeClassFor(floatCount);
+    }
+}
+
+ScratchBlock::~ScratchBlock() {
+    reset();
+}
+
+ScratchBlock::ScratchBlock(ScratchBlock&& other) noexcept
+    : memory(other.memory)
+    , sizeClass(other.sizeClass)
+{
+    other.memory = nullptr;
+    other.sizeClass = -1;
+}
+
+ScratchBlock& ScratchBlock::operator=(ScratchBlock&& other) noexcept {
+    if (this != &other) {
+        reset();
+        memory = other.memory;
+        sizeClass = other.sizeClass;
+        other.memory = nullptr;
+        other.sizeClass = -1;
+    }
+    return *this;
+}
+
+size_t ScratchBlock::capacity() const noexcept {
+    return memory ? classCapacity(sizeClass) : 0;
+}
+
+void ScratchBlock::reset() noexcept {
+    if (memory) {
+        releaseToPool(memory, sizeClass);
+        memory = nullptr;
+        sizeClass = -1;
+    }
+}
+
+ScratchBlock acquireScratch(size_t floatCount) {
+    const int sizeClass = checkedSizeClass(floatCount);
+    ScratchPool& shared = pool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    float* memory = shared.pop(sizeClass);
+    if (!memory) {
+        memory = shared.allocate(sizeClass);
+    }
+    return ScratchBlock(memory, sizeClass);
+}
+
+void reserveScratch(size_t floatCount, size_t blockCount) {
+    const int sizeClass = checkedSizeClass(floatCount);
+    ScratchPool& shared = pool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    size_t available = 0;
+    for (FreeBlock* block = shared.freeLists[sizeClass]; block && available < blockCount; block = block->next) {
+        ++available;
+    }
+    for (; available < blockCount; ++available) {
+        shared.push(shared.allocate(sizeClass), sizeClass);
+    }
+}
+
+void trimScratchPool() noexcept {
+    ScratchPool& shared = pool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    for (int sizeClass = 0; sizeClass < kSizeClasses; ++sizeClass) {
+        while (float* memory = shared.pop(sizeClass)) {
+            alignedFree(memory);
+        }
+    }
+}
+
+ScratchPoolStats scratchPoolStats() noexcept {
+    ScratchPool& shared = pool();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+
+    ScratchPoolStats stats;
+    stats.cachedBlocks = shared.cachedBlocks;
+    stats.cachedBytes = shared.cachedBytes;
+    stats.systemAllocations = shared.systemAllocations;
+    return stats;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,105 @@
+#ifndef TALD_UNIA_DSP_SCRATCH_POOL_HPP
+#define TALD_UNIA_DSP_SCRATCH_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "DSPConfig.hpp"
+
+// Smallest pooled block. Size classes step by quarters of a power of two (64, 80,
+// 96, 112, 128, ...), so every capacity is a multiple of 16 floats, one cache line,
+// and regions carved at capacity boundaries stay cache-line aligned
+constexpr size_t SCRATCH_MIN_BLOCK_FLOATS = 64;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Cache-line aligned float storage borrowed from the process-wide scratch pool
+ *
+ * Move-only; the memory goes back to the pool, not the system, when the handle is
+ * destroyed or reset. Contents are unspecified on acquisition: a block may be
+ * recycled from another kernel, so owners initialize what they read.
+ */
+class ScratchBlock {
+public:
+    ScratchBlock() noexcept = default;
+    ~ScratchBlock();
+
+    ScratchBlock(ScratchBlock&& other) noexcept;
+    ScratchBlock& operator=(ScratchBlock&& other) noexcept;
+    ScratchBlock(const ScratchBlock&) = delete;
+    ScratchBlock& operator=(const ScratchBlock&) = delete;
+
+    [[nodiscard]]
+    float* data() const noexcept {
+        return memory;
+    }
+
+    /**
+     * @brief Usable floats, at least the count requested
+     */
+    [[nodiscard]]
+    size_t capacity() const noexcept;
+
+    [[nodiscard]]
+    explicit operator bool() const noexcept {
+        return memory != nullptr;
+    }
+
+    /**
+     * @brief Return the block to the pool now
+     */
+    void reset() noexcept;
+
+private:
+    friend ScratchBlock acquireScratch(size_t floatCount);
+
+    ScratchBlock(float* memory, int sizeClass) noexcept
+        : memory(memory), sizeClass(sizeClass) {}
+
+    float* memory = nullptr;
+    int sizeClass = -1;
+};
+
+/**
+ * @brief Pool activity since process start
+ */
+struct ScratchPoolStats {
+    size_t cachedBlocks = 0;        // Free blocks waiting for reuse
+    size_t cachedBytes = 0;
+    uint64_t systemAllocations = 0; // Blocks that had to come from the system allocator
+};
+
+/**
+ * @brief Borrow a block of at least floatCount floats
+ * @throws std::runtime_error if the pool is empty for that size and the system allocation fails
+ *
+ * Sizes are rounded up to quarter-octave classes, each with its own free list, so
+ * kernels created and destroyed with the same configuration reuse the same blocks:
+ * after warm-up this is a lock and a pointer pop. Thread-safe; takes a lock, so
+ * call it while constructing or preparing a kernel, never from the render thread.
+ */
+[[nodiscard]]
+ScratchBlock acquireScratch(size_t floatCount);
+
+/**
+ * @brief Make sure blockCount free blocks of floatCount floats are pooled
+ *
+ * Lets a host pay for the system allocations up front, e.g. for the most spatial
+ * sources it will ever render, so later kernel creation never reaches malloc.
+ * @throws std::runtime_error if allocation fails
+ */
+void reserveScratch(size_t floatCount, size_t blockCount);
+
+/**
+ * @brief Give every free pooled block back to the system
+ */
+void trimScratchPool() noexcept;
+
+[[nodiscard]]
+ScratchPoolStats scratchPoolStats() noexcept;
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_SCRATCH_POOL_HPP
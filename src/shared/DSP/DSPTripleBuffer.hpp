@@ -0,0 +1,92 @@
+//
+// DSPTripleBuffer.hpp
+// TALD UNIA Audio System
+//
+// Wait-free latest-value handoff from the render thread to one reader thread.
+//
+
+#ifndef TALD_UNIA_DSP_TRIPLE_BUFFER_HPP
+#define TALD_UNIA_DSP_TRIPLE_BUFFER_HPP
+
+#include <atomic>      // C++20
+#include <cstdint>     // C++20
+#include "DSPConfig.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Three slots passed between one writer and one reader, newest value wins
+ * @tparam T Slot type, written and read in place
+ *
+ * The writer fills writeBuffer() and publish()es it; the reader calls update() and
+ * reads readBuffer(). Each side owns one slot outright and the third sits in the
+ * middle, exchanged with a single atomic swap, so neither side ever waits for the
+ * other and the reader never sees a half-written slot. Unread values are
+ * overwritten: a slow reader skips to the newest one rather than queueing.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() noexcept = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Slot to fill before the next publish() (writer only)
+     */
+    [[nodiscard]]
+    T& writeBuffer() noexcept {
+        return slots[writeSlot].value;
+    }
+
+    /**
+     * @brief Hand the filled slot to the reader and take the middle one back (writer only)
+     */
+    void publish() noexcept {
+        const uint8_t previous = middle.exchange(writeSlot | kFreshBit, std::memory_order_acq_rel);
+        writeSlot = previous & kSlotMask;
+    }
+
+    /**
+     * @brief Swap in the newest published slot, if any (reader only)
+     * @return true if readBuffer() changed
+     */
+    bool update() noexcept {
+        if (!(middle.load(std::memory_order_relaxed) & kFreshBit)) {
+            return false;
+        }
+        const uint8_t previous = middle.exchange(readSlot, std::memory_order_acq_rel);
+        readSlot = previous & kSlotMask;
+        return true;
+    }
+
+    /**
+     * @brief Newest slot taken by update() (reader only)
+     */
+    [[nodiscard]]
+    const T& readBuffer() const noexcept {
+        return slots[readSlot].value;
+    }
+
+private:
+    static constexpr uint8_t kSlotMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;   // Middle slot published and not yet taken
+
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        T value{};
+    };
+
+    Slot slots[3];
+
+    // Each side's own index stays on its own line; only the middle one is shared
+    alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle{1};
+    alignas(CACHE_LINE_SIZE) uint8_t writeSlot = 0;   // Writer only
+    alignas(CACHE_LINE_SIZE) uint8_t readSlot = 2;    // Reader only
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_TRIPLE_BUFFER_HPP
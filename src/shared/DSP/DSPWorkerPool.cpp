@@ -0,0 +1,167 @@
+#include "DSPWorkerPool.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <mach/mach.h>
+#include <mach/mach_time.h>
+#include <mach/thread_policy.h>
+#include <pthread.h>
+
+// Version comments for external dependencies
+// os_workgroup: macOS 11.0+ / iOS 14.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    inline void cpuRelax() noexcept {
+#if defined(__aarch64__) || defined(__arm64__)
+        __asm__ __volatile__("yield");
+#elif defined(__x86_64__)
+        __builtin_ia32_pause();
+#endif
+    }
+
+    /**
+     * @brief Give the calling thread the same kind of time-constraint policy as the render thread
+     *
+     * Workgroup membership tells the scheduler about the deadline, but only real-time
+     * threads are scheduled against it.
+     */
+    void setRealtimePolicy(double periodSeconds) noexcept {
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        const double ticksPerSecond = 1.0e9 * static_cast<double>(timebase.denom) /
+            static_cast<double>(timebase.numer);
+        const uint32_t period = static_cast<uint32_t>(periodSeconds * ticksPerSecond);
+
+        thread_time_constraint_policy_data_t policy;
+        policy.period = period;
+        policy.computation = period / 2;
+        policy.constraint = period;
+        policy.preemptible = true;
+        thread_policy_set(pthread_mach_thread_np(pthread_self()), THREAD_TIME_CONSTRAINT_POLICY,
+                          reinterpret_cast<thread_policy_t>(&policy), THREAD_TIME_CONSTRAINT_POLICY_COUNT);
+    }
+}
+
+DSPWorkerPool::DSPWorkerPool(int workerCount, os_workgroup_t workgroup, double blockPeriodSeconds)
+    : workgroup(workgroup)
+    , blockPeriodSeconds(blockPeriodSeconds)
+{
+    if (workerCount < 0 || workerCount > MAX_DSP_WORKERS) {
+        throw std::invalid_argument("Worker count out of valid range");
+    }
+
+    threads.reserve(static_cast<size_t>(workerCount));
+    try {
+        for (int participant = 1; participant <= workerCount; ++participant) {
+            threads.emplace_back(&DSPWorkerPool::workerMain, this, participant);
+        }
+    } catch (...) {
+        stopping.store(true, std::memory_order_release);
+        epoch.fetch_add(1, std::memory_order_release);
+        epoch.notify_all();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+}
+
+DSPWorkerPool::~DSPWorkerPool() {
+    stopping.store(true, std::memory_order_release);
+    epoch.fetch_add(1, std::memory_order_release);
+    epoch.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+int DSPWorkerPool::recommendedWorkerCount(os_workgroup_t workgroup) noexcept {
+    int available = static_cast<int>(std::thread::hardware_concurrency());
+    if (workgroup) {
+        available = os_workgroup_max_parallel_threads(workgroup, nullptr);
+    }
+    return std::clamp(available - 1, 0, MAX_DSP_WORKERS);
+}
+
+void DSPWorkerPool::run(DSPTaskSet& taskSet, const uint32_t* roots, size_t rootCount) noexcept {
+    if (rootCount == 0) {
+        return;
+    }
+
+    // Published to thieves by the deque's release store
+    currentSet.store(&taskSet, std::memory_order_relaxed);
+    outstanding.store(rootCount, std::memory_order_relaxed);
+    for (size_t i = 0; i < rootCount; ++i) {
+        deques[0].push(roots[i]);
+    }
+
+    if (!threads.empty()) {
+        epoch.fetch_add(1, std::memory_order_release);
+        epoch.notify_all();
+    }
+
+    // The render thread works too and returns once the last task has finished
+    drain(0);
+}
+
+void DSPWorkerPool::workerMain(int participant) noexcept {
+    setRealtimePolicy(blockPeriodSeconds);
+
+    os_workgroup_join_token_s joinToken{};
+    const bool joined = workgroup && os_workgroup_join(workgroup, &joinToken) == 0;
+
+    uint32_t seen = epoch.load(std::memory_order_acquire);
+    for (;;) {
+        epoch.wait(seen, std::memory_order_acquire);
+        seen = epoch.load(std::memory_order_acquire);
+        if (stopping.load(std::memory_order_acquire)) {
+            break;
+        }
+        drain(participant);
+    }
+
+    if (joined) {
+        os_workgroup_leave(workgroup, &joinToken);
+    }
+}
+
+void DSPWorkerPool::drain(int participant) noexcept {
+    DSPWorkerContext context(*this, participant);
+    while (outstanding.load(std::memory_order_acquire) != 0) {
+        uint32_t task;
+        if (!findTask(participant, task)) {
+            // Remaining tasks are running elsewhere and may still spawn more
+            cpuRelax();
+            continue;
+        }
+        currentSet.load(std::memory_order_relaxed)->runTask(task, context);
+        outstanding.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+bool DSPWorkerPool::findTask(int participant, uint32_t& task) noexcept {
+    if (deques[participant].take(task)) {
+        return true;
+    }
+
+    // Steal round-robin from the next participant on, so thieves spread out
+    const int participants = workerCount() + 1;
+    for (int offset = 1; offset < participants; ++offset) {
+        if (deques[(participant + offset) % participants].steal(task)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DSPWorkerPool::push(int participant, uint32_t task) noexcept {
+    // Counted before the spawning task finishes, so the set cannot look complete early
+    outstanding.fetch_add(1, std::memory_order_relaxed);
+    deques[participant].push(task);
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,207 @@
+//
+// DSPWorkerPool.hpp
+// TALD UNIA Audio System
+//
+// Fixed pool of real-time worker threads joined to the audio device's os_workgroup,
+// running render-time task sets with per-thread work-stealing deques.
+//
+// External Dependencies:
+// - os_workgroup (macOS 11.0+ / iOS 14.0+) - deadline-aware scheduling of helper threads
+
+#ifndef TALD_UNIA_DSP_WORKER_POOL_HPP
+#define TALD_UNIA_DSP_WORKER_POOL_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include <thread>      // C++20
+#include <vector>      // C++20
+#include <os/workgroup.h> // Apple SDK
+#include "DSPConfig.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Worker threads besides the render thread, which always takes part
+constexpr int MAX_DSP_WORKERS = 15;
+
+// Tasks one participant can hold at once; a task set never has more in flight
+constexpr size_t MAX_DSP_TASKS = 256;
+
+class DSPWorkerPool;
+
+/**
+ * @brief Handle a running task uses to make further tasks ready
+ */
+class DSPWorkerContext {
+public:
+    /**
+     * @brief Queue a task on the calling thread's deque, where idle threads can steal it
+     */
+    void spawn(uint32_t task) noexcept;
+
+    /**
+     * @brief 0 for the render thread, 1...workerCount() for pool threads
+     */
+    [[nodiscard]]
+    int participant() const noexcept {
+        return index;
+    }
+
+private:
+    friend class DSPWorkerPool;
+
+    DSPWorkerContext(DSPWorkerPool& owner, int participantIndex) noexcept
+        : pool(owner), index(participantIndex) {}
+
+    DSPWorkerPool& pool;
+    const int index;
+};
+
+/**
+ * @brief Work the pool runs for one render block
+ *
+ * runTask() is called exactly once per task that was passed to run() or spawned,
+ * possibly on different threads at the same time, and must be real-time safe.
+ */
+class DSPTaskSet {
+public:
+    virtual ~DSPTaskSet() = default;
+    virtual void runTask(uint32_t task, DSPWorkerContext& context) noexcept = 0;
+};
+
+/**
+ * @brief Fixed-capacity Chase-Lev deque of task indices
+ *
+ * The owning thread pushes and takes at the bottom; any other thread steals from
+ * the top. Indices only grow, so the deque never needs resetting between blocks.
+ */
+class WorkStealingDeque {
+public:
+    // Owner only; callers keep at most MAX_DSP_TASKS tasks queued
+    void push(uint32_t task) noexcept {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        slots[static_cast<size_t>(b) & kMask].store(task, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_release); // Publishes the task and what it reads
+    }
+
+    // Owner only: most recently pushed task
+    bool take(uint32_t& task) noexcept {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        task = slots[static_cast<size_t>(b) & kMask].load(std::memory_order_relaxed);
+        if (t == b) {
+            // Last entry: race any thief for it
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread: oldest task
+    bool steal(uint32_t& task) noexcept {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        task = slots[static_cast<size_t>(t) & kMask].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t kMask = MAX_DSP_TASKS - 1;
+    static_assert((MAX_DSP_TASKS & kMask) == 0, "Deque capacity must be a power of two");
+
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> top{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<int64_t> bottom{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> slots[MAX_DSP_TASKS] = {};
+};
+
+/**
+ * @brief Real-time worker threads that help the render thread finish a block
+ *
+ * Threads are created once, given real-time scheduling and joined to the audio
+ * device's workgroup, so the system sees them as part of the render deadline. Each
+ * block, run() wakes them; they steal ready tasks until the set is finished and then
+ * sleep again. Nothing allocates or locks after construction. A workgroup change
+ * (new output device) is handled by constructing a new pool.
+ */
+class DSPWorkerPool {
+public:
+    /**
+     * @brief Starts the worker threads
+     * @param workerCount Threads in addition to the render thread, 0...MAX_DSP_WORKERS
+     * @param workgroup Audio device workgroup to join, or null
+     * @param blockPeriodSeconds Nominal render period used for the real-time policy
+     * @throws std::invalid_argument if workerCount is out of range
+     */
+    explicit DSPWorkerPool(int workerCount, os_workgroup_t workgroup = nullptr,
+                           double blockPeriodSeconds = 256.0 / DEFAULT_SAMPLE_RATE);
+
+    ~DSPWorkerPool();
+
+    DSPWorkerPool(const DSPWorkerPool&) = delete;
+    DSPWorkerPool& operator=(const DSPWorkerPool&) = delete;
+
+    /**
+     * @brief Worker threads worth starting for a workgroup (or the machine)
+     *
+     * Excludes the render thread itself.
+     */
+    [[nodiscard]]
+    static int recommendedWorkerCount(os_workgroup_t workgroup = nullptr) noexcept;
+
+    /**
+     * @brief Run roots and everything they spawn; returns when all tasks are done
+     *
+     * Called from the render thread, which works on the set itself, and never
+     * concurrently. The set must outlive the call.
+     */
+    void run(DSPTaskSet& taskSet, const uint32_t* roots, size_t rootCount) noexcept;
+
+    [[nodiscard]]
+    int workerCount() const noexcept {
+        return static_cast<int>(threads.size());
+    }
+
+private:
+    friend class DSPWorkerContext;
+
+    os_workgroup_t workgroup;
+    const double blockPeriodSeconds;
+
+    WorkStealingDeque deques[MAX_DSP_WORKERS + 1];    // Index 0 belongs to the render thread
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch{0};   // Bumped once per run()
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> outstanding{0}; // Tasks queued or running
+    std::atomic<DSPTaskSet*> currentSet{nullptr};
+    std::atomic<bool> stopping{false};
+
+    std::vector<std::thread> threads;
+
+    void workerMain(int participant) noexcept;
+    void drain(int participant) noexcept;
+    bool findTask(int participant, uint32_t& task) noexcept;
+    void push(int participant, uint32_t task) noexcept;
+};
+
+inline void DSPWorkerContext::spawn(uint32_t task) noexcept {
+    pool.push(index, task);
+}
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DSP_WORKER_POOL_HPP
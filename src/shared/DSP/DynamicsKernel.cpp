@@ -0,0 +1,397 @@
+#include "DynamicsKernel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    typedef float Float4 __attribute__((vector_size(4 * sizeof(float))));
+    typedef int32_t Int4 __attribute__((vector_size(4 * sizeof(int32_t))));
+
+    constexpr size_t kVectorLanes = 4;
+
+    // Levels below this (about -200 dB) are treated as silence
+    constexpr float kLevelFloor = 1.0e-10f;
+
+    // dB per unit of log2, for magnitudes and for powers
+    constexpr float kDecibelsPerLog2 = 6.0205999f;
+    constexpr float kPowerDecibelsPerLog2 = 3.0103f;
+    constexpr float kLog2PerDecibel = 0.16609640f;
+
+    // Controls are clamped to these ranges
+    constexpr float kMinThresholdDB = -80.0f;
+    constexpr float kMaxKneeDB = 24.0f;
+    constexpr float kMinAttackSeconds = 0.0001f;
+    constexpr float kMaxAttackSeconds = 1.0f;
+    constexpr float kMinReleaseSeconds = 0.001f;
+    constexpr float kMaxReleaseSeconds = 5.0f;
+
+    inline Float4 broadcast(float value) noexcept {
+        return Float4{ value, value, value, value };
+    }
+
+    inline Float4 loadVector(const float* source) noexcept {
+        Float4 value;
+        std::memcpy(&value, source, sizeof(value));
+        return value;
+    }
+
+    inline void storeVector(float* destination, Float4 value) noexcept {
+        std::memcpy(destination, &value, sizeof(value));
+    }
+
+    /**
+     * @brief log2 of positive normal floats, within 1.5e-5 (about 1e-4 dB)
+     *
+     * Splits off the exponent and fits log2(1 + m) on the mantissa with a
+     * degree-5 polynomial.
+     */
+    inline Float4 approximateLog2(Float4 x) noexcept {
+        const Int4 bits = std::bit_cast<Int4>(x);
+        const Float4 exponent = __builtin_convertvector(((bits >> 23) & 0xff) - 127, Float4);
+        const Int4 mantissaBits = (bits & 0x007fffff) | 0x3f800000;
+        const Float4 m = std::bit_cast<Float4>(mantissaBits) - 1.0f;
+
+        Float4 p = broadcast(0.0439286288f);
+        p = p * m - 0.189832449f;
+        p = p * m + 0.411561485f;
+        p = p * m - 0.707253434f;
+        p = p * m + 1.44159208f;
+        p = p * m + 1.43909272e-05f;
+        return exponent + p;
+    }
+
+    /**
+     * @brief 2^x for x in [-126, 126], within 4e-6 relative
+     *
+     * Builds the integer part in the exponent field and fits 2^f on the fraction
+     * with a degree-4 polynomial.
+     */
+    inline Float4 approximateExp2(Float4 x) noexcept {
+        x = (x < -126.0f) ? broadcast(-126.0f) : x;
+        x = (x > 126.0f) ? broadcast(126.0f) : x;
+        Int4 whole = __builtin_convertvector(x, Int4);
+        // Truncation rounds negative values up; step back to the floor
+        whole += (__builtin_convertvector(whole, Float4) > x);
+        const Float4 f = x - __builtin_convertvector(whole, Float4);
+
+        Float4 p = broadcast(0.013683983f);
+        p = p * f + 0.0517177353f;
+        p = p * f + 0.241621323f;
+        p = p * f + 0.692969551f;
+        p = p * f + 1.0000036f;
+        return std::bit_cast<Float4>(std::bit_cast<Int4>(p) + (whole << 23));
+    }
+
+    // Sidechain buffers round segments up to whole vectors
+    size_t paddedFrames(size_t frames) noexcept {
+        constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+        return (frames + kVectorLanes + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    }
+
+    size_t lookAheadFramesFor(double seconds, double sampleRate) noexcept {
+        return static_cast<size_t>(std::lround(seconds * sampleRate));
+    }
+
+    float smoothingCoefficient(double seconds, double sampleRate) noexcept {
+        return static_cast<float>(std::exp(-1.0 / (seconds * sampleRate)));
+    }
+}
+
+DynamicsKernel::DynamicsKernel(double sampleRate, int channels, DynamicsDetector detector,
+                               double lookAheadSeconds, DenormalMode denormalMode, size_t maxFrames)
+    : DSPKernel(sampleRate, channels, denormalMode, maxFrames)
+    , detector(detector)
+    , lookAheadSeconds(lookAheadSeconds)
+    , lookAheadFrames(0)
+    , thresholdDB(DEFAULT_DYNAMICS_THRESHOLD_DB)
+    , ratio(DEFAULT_DYNAMICS_RATIO)
+    , attackSeconds(DEFAULT_DYNAMICS_ATTACK_SECONDS)
+    , releaseSeconds(DEFAULT_DYNAMICS_RELEASE_SECONDS)
+    , kneeDB(DEFAULT_DYNAMICS_KNEE_DB)
+    , slope(1.0f - 1.0f / DEFAULT_DYNAMICS_RATIO)
+    , attackCoefficient(0.0f)
+    , releaseCoefficient(0.0f)
+    , rmsCoefficient(0.0f)
+    , makeupDB(0.0f)
+    , envelopeDB(0.0f)
+    , meanSquare(0.0f)
+    , hasPendingEvent(false)
+    , levels(nullptr)
+    , makeupValues(nullptr)
+{
+    if (!(lookAheadSeconds >= 0.0 && lookAheadSeconds <= MAX_DYNAMICS_LOOKAHEAD_SECONDS)) {
+        throw std::invalid_argument("Invalid dynamics look-ahead");
+    }
+    prepareResources(maxFrames, channels, sampleRate);
+    resetState();
+}
+
+void DynamicsKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    const size_t delay = lookAheadFramesFor(lookAheadSeconds, sampleRate);
+    const size_t stride = paddedFrames(delay + maxFramesPerBlock);
+    const size_t sidechainFrames = paddedFrames(maxFramesPerBlock);
+    ScratchBlock newScratch = acquireScratch(static_cast<size_t>(channels) * stride + 2 * sidechainFrames);
+
+    // Nothing below throws
+    scratch = std::move(newScratch);
+    for (int channel = 0; channel < channels; ++channel) {
+        delayLines[channel] = scratch.data() + static_cast<size_t>(channel) * stride;
+    }
+    levels = scratch.data() + static_cast<size_t>(channels) * stride;
+    makeupValues = levels + sidechainFrames;
+    // Padding lanes are read by the vector loops, so they must hold finite values
+    std::fill(levels, levels + 2 * sidechainFrames, 0.0f);
+    lookAheadFrames = delay;
+    updateTimeConstants(sampleRate);
+}
+
+void DynamicsKernel::resetState() noexcept {
+    for (int channel = 0; channel < numChannels; ++channel) {
+        std::memset(delayLines[channel], 0, lookAheadFrames * sizeof(float));
+    }
+    envelopeDB = 0.0f;
+    meanSquare = 0.0f;
+    reductionMeter.store(0.0f, std::memory_order_relaxed);
+
+    // Controls survive a reset; a change waiting for its offset takes effect now
+    if (hasPendingEvent) {
+        applyParameterEvent(pendingEvent);
+        hasPendingEvent = false;
+    }
+    makeupDB.jumpTo(makeupDB.targetValue());
+}
+
+void DynamicsKernel::updateTimeConstants(double rate) noexcept {
+    attackCoefficient = smoothingCoefficient(attackSeconds, rate);
+    releaseCoefficient = smoothingCoefficient(releaseSeconds, rate);
+    rmsCoefficient = smoothingCoefficient(DYNAMICS_RMS_SECONDS, rate);
+}
+
+void DynamicsKernel::applyDueParameterEvents(size_t position) noexcept {
+    // Bounded by queue capacity; never waits on the control thread
+    for (;;) {
+        if (!hasPendingEvent) {
+            if (!parameterEvents.pop(pendingEvent)) {
+                return;
+            }
+            hasPendingEvent = true;
+        }
+
+        if (pendingEvent.sampleOffset > position) {
+            return;
+        }
+
+        applyParameterEvent(pendingEvent);
+        hasPendingEvent = false;
+    }
+}
+
+void DynamicsKernel::applyParameterEvent(const ParameterEvent& event) noexcept {
+    // Level controls feed the gain computer, whose output the follower already smooths
+    switch (event.parameterID) {
+        case kParameterGain:
+            makeupDB.setTarget(event.value, (event.rampFrames == 0) ? defaultRampFrames() : event.rampFrames,
+                               RampShape::Linear);
+            break;
+        case kParameterThreshold:
+            thresholdDB = std::clamp(event.value, kMinThresholdDB, 0.0f);
+            break;
+        case kParameterRatio:
+            ratio = std::clamp(event.value, 1.0f, MAX_DYNAMICS_RATIO);
+            slope = (ratio >= MAX_DYNAMICS_RATIO) ? 1.0f : 1.0f - 1.0f / ratio;
+            break;
+        case kParameterAttack:
+            attackSeconds = std::clamp(event.value, kMinAttackSeconds, kMaxAttackSeconds);
+            attackCoefficient = smoothingCoefficient(attackSeconds, sampleRate);
+            break;
+        case kParameterRelease:
+            releaseSeconds = std::clamp(event.value, kMinReleaseSeconds, kMaxReleaseSeconds);
+            releaseCoefficient = smoothingCoefficient(releaseSeconds, sampleRate);
+            break;
+        case kParameterKnee:
+            kneeDB = std::clamp(event.value, 0.0f, kMaxKneeDB);
+            break;
+        default:
+            break;
+    }
+}
+
+float DynamicsKernel::processSegment(const AudioBufferView& input, const AudioBufferView& output,
+                                     size_t start, size_t length) noexcept {
+    const size_t delay = lookAheadFrames;
+    const size_t vectorFrames = (length + kVectorLanes - 1) / kVectorLanes * kVectorLanes;
+
+    // New audio goes behind the look-ahead history
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* destination = delayLines[channel] + delay;
+        if (input.layout == BufferLayout::Planar) {
+            std::memcpy(destination, input.planes[channel] + start, length * sizeof(float));
+        }
+        else {
+            const float* source = input.interleaved + start * static_cast<size_t>(numChannels) + channel;
+            for (size_t frame = 0; frame < length; ++frame) {
+                destination[frame] = source[frame * static_cast<size_t>(numChannels)];
+            }
+        }
+    }
+
+    // Linked detector: one level per frame across all channels
+    const float* first = delayLines[0] + delay;
+    if (detector == DynamicsDetector::Peak) {
+        for (size_t frame = 0; frame < length; ++frame) {
+            levels[frame] = std::fabs(first[frame]);
+        }
+        for (int channel = 1; channel < numChannels; ++channel) {
+            const float* samples = delayLines[channel] + delay;
+            for (size_t frame = 0; frame < length; ++frame) {
+                levels[frame] = std::max(levels[frame], std::fabs(samples[frame]));
+            }
+        }
+    }
+    else {
+        const float channelScale = 1.0f / static_cast<float>(numChannels);
+        for (size_t frame = 0; frame < length; ++frame) {
+            levels[frame] = first[frame] * first[frame] * channelScale;
+        }
+        for (int channel = 1; channel < numChannels; ++channel) {
+            const float* samples = delayLines[channel] + delay;
+            for (size_t frame = 0; frame < length; ++frame) {
+                levels[frame] += samples[frame] * samples[frame] * channelScale;
+            }
+        }
+        const float average = 1.0f - rmsCoefficient;
+        float state = meanSquare;
+        for (size_t frame = 0; frame < length; ++frame) {
+            state += average * (levels[frame] - state);
+            levels[frame] = state;
+        }
+        meanSquare = (state < DENORMAL_THRESHOLD) ? 0.0f : state;
+    }
+
+    // Level in dB, then the soft-knee gain computer's reduction
+    const float decibelsPerLog2 = (detector == DynamicsDetector::Peak) ? kDecibelsPerLog2 : kPowerDecibelsPerLog2;
+    const float threshold = thresholdDB;
+    const float halfKnee = 0.5f * kneeDB;
+    const float kneeScale = (kneeDB > 0.0f) ? slope / (2.0f * kneeDB) : 0.0f;
+    const float fullSlope = slope;
+    for (size_t frame = 0; frame < vectorFrames; frame += kVectorLanes) {
+        Float4 level = loadVector(levels + frame);
+        level = (level > kLevelFloor) ? level : broadcast(kLevelFloor);
+        const Float4 over = approximateLog2(level) * decibelsPerLog2 - threshold;
+        const Float4 inKnee = over + halfKnee;
+        Float4 reduction = (over >= halfKnee) ? over * fullSlope : inKnee * inKnee * kneeScale;
+        reduction = (over <= -halfKnee) ? Float4{} : reduction;
+        storeVector(levels + frame, reduction);
+    }
+
+    // The follower is the one sequential stage: attack while the reduction grows
+    makeupDB.render(makeupValues, length);
+    float envelope = envelopeDB;
+    float largest = 0.0f;
+    const float attack = attackCoefficient;
+    const float release = releaseCoefficient;
+    for (size_t frame = 0; frame < length; ++frame) {
+        const float reduction = levels[frame];
+        const float coefficient = (reduction > envelope) ? attack : release;
+        envelope = reduction + coefficient * (envelope - reduction);
+        largest = std::max(largest, envelope);
+        levels[frame] = makeupValues[frame] - envelope;
+    }
+    envelopeDB = (envelope < DENORMAL_THRESHOLD) ? 0.0f : envelope;
+
+    for (size_t frame = 0; frame < vectorFrames; frame += kVectorLanes) {
+        storeVector(levels + frame, approximateExp2(loadVector(levels + frame) * kLog2PerDecibel));
+    }
+
+    // Delayed audio times the gain, then the line slides forward by one segment
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* line = delayLines[channel];
+        for (size_t frame = 0; frame < length; ++frame) {
+            line[frame] *= levels[frame];
+        }
+        if (activeDenormalMode == DenormalMode::VectorThreshold) {
+            flushDenormals(line, length);
+        }
+        if (output.layout == BufferLayout::Planar) {
+            std::memcpy(output.planes[channel] + start, line, length * sizeof(float));
+        }
+        else {
+            float* destination = output.interleaved + start * static_cast<size_t>(numChannels) + channel;
+            for (size_t frame = 0; frame < length; ++frame) {
+                destination[frame * static_cast<size_t>(numChannels)] = line[frame];
+            }
+        }
+        std::memmove(line, line + length, delay * sizeof(float));
+    }
+    return largest;
+}
+
+void DynamicsKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    if (!input.isValid() || !output.isValid() || output.frames != input.frames ||
+        input.channels != numChannels || output.channels != numChannels || input.frames > maxFrames) {
+        return;
+    }
+    if (isBypassed()) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+
+    // Split at parameter event offsets; each segment runs the whole sidechain
+    const size_t frameCount = input.frames;
+    float largest = 0.0f;
+    size_t position = 0;
+    while (position < frameCount) {
+        applyDueParameterEvents(position);
+        const size_t segmentEnd = hasPendingEvent
+            ? std::min(static_cast<size_t>(pendingEvent.sampleOffset), frameCount)
+            : frameCount;
+        largest = std::max(largest, processSegment(input, output, position, segmentEnd - position));
+        position = segmentEnd;
+    }
+    if (hasPendingEvent) {
+        pendingEvent.sampleOffset -= static_cast<uint32_t>(frameCount);
+    }
+    reductionMeter.store(largest, std::memory_order_relaxed);
+
+    recordBlockTiming(startTicks, mach_absolute_time(), frameCount);
+}
+
+std::unique_ptr<DSPKernel> DynamicsKernel::fork() const {
+    auto clone = std::make_unique<DynamicsKernel>(sampleRate, numChannels, detector, lookAheadSeconds,
+                                                  activeDenormalMode, maxFrames);
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+void DynamicsKernel::writeState(KernelStateWriter& writer) const {
+    writer.write(static_cast<uint8_t>(detector));
+    writer.write(lookAheadSeconds);
+}
+
+std::unique_ptr<DSPKernel> DynamicsKernel::fromState(const KernelStateHeader& header, KernelStateReader& reader) {
+    const uint8_t detector = reader.read<uint8_t>();
+    if (detector > static_cast<uint8_t>(DynamicsDetector::RMS)) {
+        throw std::runtime_error("Unknown dynamics detector in kernel state");
+    }
+    const double lookAhead = reader.read<double>();
+    return std::make_unique<DynamicsKernel>(header.sampleRate, header.channels,
+                                            static_cast<DynamicsDetector>(detector), lookAhead,
+                                            header.denormalMode, header.maxFrames);
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,165 @@
+//
+// DynamicsKernel.hpp
+// TALD UNIA Audio System
+//
+// Look-ahead compressor and limiter with a linked multi-channel sidechain, working
+// on whole blocks with the gain computed in the log domain.
+//
+
+#ifndef TALD_UNIA_DYNAMICS_KERNEL_HPP
+#define TALD_UNIA_DYNAMICS_KERNEL_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Look-ahead range; the delay is fixed per kernel because hosts compensate for it
+constexpr double DEFAULT_DYNAMICS_LOOKAHEAD_SECONDS = 0.005;
+constexpr double MAX_DYNAMICS_LOOKAHEAD_SECONDS = 0.020;
+
+// Parameter defaults, matching the Swift compressor
+constexpr float DEFAULT_DYNAMICS_THRESHOLD_DB = -20.0f;
+constexpr float DEFAULT_DYNAMICS_RATIO = 4.0f;
+constexpr float DEFAULT_DYNAMICS_ATTACK_SECONDS = 0.005f;
+constexpr float DEFAULT_DYNAMICS_RELEASE_SECONDS = 0.050f;
+constexpr float DEFAULT_DYNAMICS_KNEE_DB = 6.0f;
+
+// Ratios at or above this limit instead of compressing
+constexpr float MAX_DYNAMICS_RATIO = 100.0f;
+
+// Averaging time of the RMS detector
+constexpr double DYNAMICS_RMS_SECONDS = 0.010;
+
+/**
+ * @brief Level the sidechain reacts to
+ */
+enum class DynamicsDetector : uint8_t {
+    Peak,  // Largest magnitude across channels, sample by sample
+    RMS    // Mean square across channels, averaged over DYNAMICS_RMS_SECONDS
+};
+
+/**
+ * @brief Feed-forward compressor/limiter with a look-ahead delay line
+ *
+ * All channels share one sidechain: each frame's level is the peak (or mean square)
+ * across channels, so stereo and surround images keep their balance under gain
+ * reduction. Per block, the level is converted to dB with a polynomial log2, run
+ * through a soft-knee gain computer and a branching attack/release follower on the
+ * gain reduction, and turned back into linear gain with a polynomial exp2. Only
+ * the follower is sequential; every other stage is a straight vector loop. The
+ * audio path is delayed by latencyFrames(), so the gain starts moving before a
+ * transient arrives; with an attack well inside the look-ahead, a ratio of
+ * MAX_DYNAMICS_RATIO limits peaks to the threshold.
+ *
+ * Controls arrive as parameter events (kParameterThreshold, kParameterRatio,
+ * kParameterAttack, kParameterRelease, kParameterKnee) and apply at their sample
+ * offsets; kParameterGain is the makeup gain in dB and ramps linearly in dB.
+ */
+class DynamicsKernel final : public DSPKernel {
+public:
+    /**
+     * @param sampleRate Audio sample rate (Hz)
+     * @param channels Number of audio channels
+     * @param detector Sidechain level detector
+     * @param lookAheadSeconds Audio delay ahead of the sidechain, up to MAX_DYNAMICS_LOOKAHEAD_SECONDS
+     * @param denormalMode Requested denormal handling
+     * @param maxFrames Largest block process() accepts
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    DynamicsKernel(double sampleRate, int channels,
+                   DynamicsDetector detector = DynamicsDetector::Peak,
+                   double lookAheadSeconds = DEFAULT_DYNAMICS_LOOKAHEAD_SECONDS,
+                   DenormalMode denormalMode = DenormalMode::HardwareFTZ,
+                   size_t maxFrames = MAX_BUFFER_SIZE);
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief Audio delay in frames at the current sample rate
+     */
+    [[nodiscard]]
+    size_t latencyFrames() const noexcept {
+        return lookAheadFrames;
+    }
+
+    /**
+     * @brief Largest gain reduction applied in the most recent block (dB, positive)
+     *
+     * For meters; safe to read from any thread.
+     */
+    [[nodiscard]]
+    float gainReductionDB() const noexcept {
+        return reductionMeter.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    DynamicsDetector detectorMode() const noexcept {
+        return detector;
+    }
+
+    /**
+     * @brief New kernel with the same detector, look-ahead and parameters
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+private:
+    const DynamicsDetector detector;
+    const double lookAheadSeconds;
+    size_t lookAheadFrames;
+
+    // Render thread controls and the coefficients derived from them
+    float thresholdDB;
+    float ratio;
+    float attackSeconds;
+    float releaseSeconds;
+    float kneeDB;
+    float slope;                 // Fraction of the overshoot removed, 1 - 1 / ratio
+    float attackCoefficient;
+    float releaseCoefficient;
+    float rmsCoefficient;
+    SmoothedParameter makeupDB;
+
+    // Sidechain state
+    float envelopeDB;            // Smoothed gain reduction, positive
+    float meanSquare;            // RMS detector state
+
+    ParameterEvent pendingEvent;
+    bool hasPendingEvent;
+    std::atomic<float> reductionMeter{0.0f};
+
+    // Carved from the base class scratch block
+    float* delayLines[MAX_CHANNELS];   // lookAheadFrames of history, then the current segment
+    float* levels;                     // Sidechain level, then gain, per frame of a segment
+    float* makeupValues;               // Makeup gain per frame of a segment
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+
+    // State format: detector and look-ahead; the controls travel as parameter values
+    friend class DSPKernel;
+    KernelStateType stateType() const noexcept override {
+        return KernelStateType::Dynamics;
+    }
+    void writeState(KernelStateWriter& writer) const override;
+    static std::unique_ptr<DSPKernel> fromState(const KernelStateHeader& header, KernelStateReader& reader);
+
+    void updateTimeConstants(double rate) noexcept;
+    void applyDueParameterEvents(size_t position) noexcept;
+    void applyParameterEvent(const ParameterEvent& event) noexcept;
+    float processSegment(const AudioBufferView& input, const AudioBufferView& output,
+                         size_t start, size_t length) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_DYNAMICS_KERNEL_HPP
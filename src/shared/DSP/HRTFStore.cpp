@@ -0,0 +1,184 @@
+#include "HRTFStore.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    constexpr int kEars = 2;
+
+    // Degrees in [0, 360)
+    float wrapAzimuth(float degrees) noexcept {
+        const float wrapped = std::fmod(degrees, 360.0f);
+        return (wrapped < 0.0f) ? wrapped + 360.0f : wrapped;
+    }
+
+    // Checked before any derived member divides by it
+    float validatedResolution(float degrees) {
+        if (!(degrees >= 0.01f && degrees <= 45.0f)) {
+            throw std::invalid_argument("Invalid HRTF cache configuration");
+        }
+        return degrees;
+    }
+}
+
+// MARK: - HRTFStore
+
+std::shared_ptr<const HRTFStore> HRTFStore::create(size_t blockSize, const HRTFGrid& grid,
+                                                   const float* hrirs, size_t irLength) {
+    if (blockSize < MIN_BUFFER_SIZE || blockSize > MAX_BUFFER_SIZE || !std::has_single_bit(blockSize)) {
+        throw std::invalid_argument("HRTF block size must be a power of two within buffer limits");
+    }
+    if (grid.azimuthCount <= 0 || grid.elevationCount <= 0 ||
+        !(grid.minElevationDegrees >= -90.0f && grid.maxElevationDegrees <= 90.0f &&
+          grid.minElevationDegrees <= grid.maxElevationDegrees) ||
+        (grid.elevationCount > 1 && grid.minElevationDegrees == grid.maxElevationDegrees)) {
+        throw std::invalid_argument("Invalid HRTF grid");
+    }
+    if (!hrirs || irLength == 0 || irLength > MAX_IMPULSE_LENGTH) {
+        throw std::invalid_argument("Invalid HRIR data");
+    }
+
+    std::shared_ptr<HRTFStore> store(new HRTFStore());
+    store->fftSetup = acquireFFTSetup(KERNEL_FFT_LOG2N, kFFTRadix2);
+    if (!store->fftSetup) {
+        throw std::runtime_error("Failed to create FFT setup");
+    }
+    store->layout = grid;
+    store->blockSize = blockSize;
+    store->partitions = (irLength + blockSize - 1) / blockSize;
+
+    const size_t fftSize = 2 * blockSize;
+    const size_t earFloats = store->partitions * fftSize;
+    store->measurementFloats = kEars * earFloats;
+    const size_t measurements = static_cast<size_t>(grid.azimuthCount) * static_cast<size_t>(grid.elevationCount);
+    store->storage = static_cast<float*>(alignedMalloc(measurements * store->measurementFloats * sizeof(float),
+                                                       CACHE_LINE_SIZE));
+    if (!store->storage) {
+        throw std::runtime_error("Failed to allocate HRTF store");
+    }
+
+    std::vector<float> time(fftSize);
+    for (size_t m = 0; m < measurements; ++m) {
+        for (int ear = 0; ear < kEars; ++ear) {
+            const float* taps = hrirs + (m * kEars + static_cast<size_t>(ear)) * irLength;
+            float* destination = store->storage + m * store->measurementFloats + static_cast<size_t>(ear) * earFloats;
+            PartitionedFilter::transformPartitions(store->fftSetup.get(), blockSize, taps, irLength,
+                                                   time.data(), destination);
+        }
+    }
+    return store;
+}
+
+HRTFStore::~HRTFStore() {
+    alignedFree(storage);
+}
+
+std::shared_ptr<const PartitionedFilter> HRTFStore::interpolate(float azimuthDegrees, float elevationDegrees) const {
+    // Azimuth columns wrap around the circle
+    const float column = wrapAzimuth(azimuthDegrees) * static_cast<float>(layout.azimuthCount) / 360.0f;
+    const int azimuth0 = std::min(static_cast<int>(column), layout.azimuthCount - 1);
+    const int azimuth1 = (azimuth0 + 1) % layout.azimuthCount;
+    const float azimuthWeight = std::clamp(column - static_cast<float>(azimuth0), 0.0f, 1.0f);
+
+    // Elevation rows clamp at the top and bottom of the grid
+    int elevation0 = 0;
+    float elevationWeight = 0.0f;
+    if (layout.elevationCount > 1) {
+        const float span = layout.maxElevationDegrees - layout.minElevationDegrees;
+        const float row = (std::clamp(elevationDegrees, layout.minElevationDegrees, layout.maxElevationDegrees)
+                           - layout.minElevationDegrees) / span * static_cast<float>(layout.elevationCount - 1);
+        elevation0 = std::min(static_cast<int>(row), layout.elevationCount - 2);
+        elevationWeight = row - static_cast<float>(elevation0);
+    }
+    const int elevation1 = std::min(elevation0 + 1, layout.elevationCount - 1);
+
+    const struct {
+        const float* spectra;
+        float weight;
+    } corners[] = {
+        { measurement(elevation0, azimuth0), (1.0f - azimuthWeight) * (1.0f - elevationWeight) },
+        { measurement(elevation0, azimuth1), azimuthWeight * (1.0f - elevationWeight) },
+        { measurement(elevation1, azimuth0), (1.0f - azimuthWeight) * elevationWeight },
+        { measurement(elevation1, azimuth1), azimuthWeight * elevationWeight },
+    };
+
+    std::shared_ptr<PartitionedFilter> filter(new PartitionedFilter());
+    filter->blockSize = blockSize;
+    filter->channels = kEars;
+    filter->storage = static_cast<float*>(alignedMalloc(measurementFloats * sizeof(float), CACHE_LINE_SIZE));
+    if (!filter->storage) {
+        throw std::runtime_error("Failed to allocate interpolated HRTF");
+    }
+    for (int ear = 0; ear < kEars; ++ear) {
+        filter->spectra[ear] = filter->storage + static_cast<size_t>(ear) * (measurementFloats / kEars);
+        filter->partitions[ear] = partitions;
+        filter->inputs[ear] = 0;
+    }
+    filter->mask = 1u;
+
+    // Spectra are linear in the taps, so blending them blends the HRIRs
+    vDSP_vclr(filter->storage, 1, measurementFloats);
+    for (const auto& corner : corners) {
+        if (corner.weight > 0.0f) {
+            vDSP_vsma(corner.spectra, 1, &corner.weight, filter->storage, 1, filter->storage, 1, measurementFloats);
+        }
+    }
+    return filter;
+}
+
+// MARK: - HRTFFilterCache
+
+HRTFFilterCache::HRTFFilterCache(std::shared_ptr<const HRTFStore> store, size_t capacity, float resolutionDegrees)
+    : hrtfs(std::move(store))
+    , maxEntries(capacity)
+    , resolution(validatedResolution(resolutionDegrees))
+    , azimuthSteps(static_cast<int>(std::lround(360.0f / resolution)))
+{
+    if (!hrtfs || capacity == 0) {
+        throw std::invalid_argument("Invalid HRTF cache configuration");
+    }
+    index.reserve(capacity);
+}
+
+std::shared_ptr<const PartitionedFilter> HRTFFilterCache::filterFor(float azimuthDegrees, float elevationDegrees) {
+    const int azimuthStep = static_cast<int>(std::lround(wrapAzimuth(azimuthDegrees) / resolution)) % azimuthSteps;
+    const int elevationStep = static_cast<int>(std::lround((std::clamp(elevationDegrees, -90.0f, 90.0f) + 90.0f)
+                                                          / resolution));
+    const uint32_t key = (static_cast<uint32_t>(elevationStep) << 16) | static_cast<uint32_t>(azimuthStep);
+
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        ++hitCount;
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->filter;
+    }
+
+    ++missCount;
+    std::shared_ptr<const PartitionedFilter> filter = hrtfs->interpolate(
+        static_cast<float>(azimuthStep) * resolution,
+        static_cast<float>(elevationStep) * resolution - 90.0f);
+    if (entries.size() >= maxEntries) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    entries.push_front(Entry{ key, filter });
+    index.emplace(key, entries.begin());
+    return filter;
+}
+
+void HRTFFilterCache::clear() noexcept {
+    entries.clear();
+    index.clear();
+}
+
+} // namespace dsp
+} // namespace tald
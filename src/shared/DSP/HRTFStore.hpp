@@ -0,0 +1,195 @@
+//
+// HRTFStore.hpp
+// TALD UNIA Audio System
+//
+// Measured HRIR pairs held as partitioned spectra, interpolated per source direction
+// into filter sets for ConvolutionKernel, with an LRU cache of recent directions.
+//
+// External Dependencies:
+// - Accelerate (macOS 13.0+ / iOS 13.0+) - vDSP real FFT and vector multiply-add
+
+#ifndef TALD_UNIA_HRTF_STORE_HPP
+#define TALD_UNIA_HRTF_STORE_HPP
+
+#include <cstddef>         // C++20
+#include <cstdint>         // C++20
+#include <list>            // C++20
+#include <memory>          // C++20
+#include <unordered_map>   // C++20
+#include "ConvolutionKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Direction quantization step of cached filters, matching the Swift spatial processor
+constexpr float DEFAULT_HRTF_RESOLUTION_DEGREES = 1.0f;
+
+// Interpolated filter sets kept per cache
+constexpr size_t DEFAULT_HRTF_CACHE_CAPACITY = 512;
+
+/**
+ * @brief Measurement directions of an HRIR set
+ *
+ * Azimuths are in degrees, 0 straight ahead and increasing toward the right, as
+ * SpatialProcessor computes them. Columns are evenly spaced around the full circle
+ * starting at 0; rows are evenly spaced from minElevation to maxElevation inclusive.
+ */
+struct HRTFGrid {
+    int azimuthCount = 0;
+    int elevationCount = 0;
+    float minElevationDegrees = 0.0f;
+    float maxElevationDegrees = 0.0f;
+};
+
+/**
+ * @brief Immutable store of every measured HRIR pair, transformed once at load time
+ *
+ * All spectra sit in one cache-aligned allocation, measurement after measurement,
+ * each as left then right ear partitions in the split (real block, imaginary block)
+ * layout vDSP multiplies in place. Interpolating a direction is then a weighted sum
+ * of up to four contiguous measurement blocks, with no transforms.
+ */
+class HRTFStore {
+public:
+    /**
+     * @brief Transform a grid of HRIR pairs
+     * @param blockSize Partition size of the convolution kernels that will use the filters
+     * @param grid Measurement directions
+     * @param hrirs elevationCount * azimuthCount pairs, row by row, left ear first,
+     *              each ear irLength taps
+     * @param irLength Taps per ear
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     *
+     * Allocates; call from a control or loading thread.
+     */
+    static std::shared_ptr<const HRTFStore> create(size_t blockSize, const HRTFGrid& grid,
+                                                   const float* hrirs, size_t irLength);
+
+    ~HRTFStore();
+
+    HRTFStore(const HRTFStore&) = delete;
+    HRTFStore& operator=(const HRTFStore&) = delete;
+
+    /**
+     * @brief Filter set for a direction, bilinear between the four nearest measurements
+     * @return Two outputs (left, right), both reading input channel 0
+     * @throws std::runtime_error if allocation fails
+     *
+     * Azimuth wraps around the circle; elevation is clamped to the grid. Allocates.
+     */
+    [[nodiscard]]
+    std::shared_ptr<const PartitionedFilter> interpolate(float azimuthDegrees, float elevationDegrees) const;
+
+    [[nodiscard]]
+    const HRTFGrid& grid() const noexcept {
+        return layout;
+    }
+
+    [[nodiscard]]
+    size_t partitionSize() const noexcept {
+        return blockSize;
+    }
+
+    [[nodiscard]]
+    size_t partitionCount() const noexcept {
+        return partitions;
+    }
+
+private:
+    HRTFStore() = default;
+
+    // Both ears of one measurement
+    [[nodiscard]]
+    const float* measurement(int elevation, int azimuth) const noexcept {
+        return storage + (static_cast<size_t>(elevation) * layout.azimuthCount + azimuth) * measurementFloats;
+    }
+
+    HRTFGrid layout;
+    size_t blockSize = 0;
+    size_t partitions = 0;
+    size_t measurementFloats = 0;   // 2 ears * partitions * 2 * blockSize
+    float* storage = nullptr;
+    SharedFFTSetup fftSetup;
+};
+
+/**
+ * @brief Least-recently-used cache of interpolated filter sets by quantized direction
+ *
+ * Directions are rounded to the resolution before interpolating, so every source
+ * passing through the same cell shares one filter set, and a source that moves
+ * less than a cell between blocks costs a lookup. Evicted sets stay alive for as
+ * long as a kernel still holds them. Not thread-safe: use one cache per control
+ * thread.
+ */
+class HRTFFilterCache {
+public:
+    /**
+     * @param store HRTF measurements to interpolate
+     * @param capacity Most filter sets kept
+     * @param resolutionDegrees Quantization step in azimuth and elevation, up to 45
+     * @throws std::invalid_argument if parameters are out of valid range
+     */
+    explicit HRTFFilterCache(std::shared_ptr<const HRTFStore> store,
+                             size_t capacity = DEFAULT_HRTF_CACHE_CAPACITY,
+                             float resolutionDegrees = DEFAULT_HRTF_RESOLUTION_DEGREES);
+
+    /**
+     * @brief Filter set for the cell containing a direction, interpolated on a miss
+     * @throws std::runtime_error if allocation fails
+     */
+    [[nodiscard]]
+    std::shared_ptr<const PartitionedFilter> filterFor(float azimuthDegrees, float elevationDegrees);
+
+    void clear() noexcept;
+
+    [[nodiscard]]
+    size_t size() const noexcept {
+        return entries.size();
+    }
+
+    [[nodiscard]]
+    size_t capacity() const noexcept {
+        return maxEntries;
+    }
+
+    [[nodiscard]]
+    uint64_t hits() const noexcept {
+        return hitCount;
+    }
+
+    [[nodiscard]]
+    uint64_t misses() const noexcept {
+        return missCount;
+    }
+
+    /**
+     * @brief Fraction of lookups served from the cache (0 before any lookup)
+     */
+    [[nodiscard]]
+    double hitRate() const noexcept {
+        const uint64_t lookups = hitCount + missCount;
+        return (lookups == 0) ? 0.0 : static_cast<double>(hitCount) / static_cast<double>(lookups);
+    }
+
+private:
+    struct Entry {
+        uint32_t key;
+        std::shared_ptr<const PartitionedFilter> filter;
+    };
+
+    const std::shared_ptr<const HRTFStore> hrtfs;
+    const size_t maxEntries;
+    const float resolution;
+    const int azimuthSteps;
+
+    std::list<Entry> entries;   // Most recently used first
+    std::unordered_map<uint32_t, std::list<Entry>::iterator> index;
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_HRTF_STORE_HPP
@@ -0,0 +1,222 @@
+#include "HotSwapKernel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    const DSPKernel& requireKernel(const std::unique_ptr<DSPKernel>& kernel) {
+        if (!kernel) {
+            throw std::invalid_argument("Hot swap requires an initial kernel");
+        }
+        return *kernel;
+    }
+
+    double validatedFade(double seconds) {
+        if (!(seconds >= 0.0 && seconds <= MAX_KERNEL_SWAP_CROSSFADE_SECONDS)) {
+            throw std::invalid_argument("Swap crossfade out of valid range");
+        }
+        return seconds;
+    }
+
+    // Regions are carved on cache-line boundaries
+    size_t paddedFloats(size_t count) noexcept {
+        constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+        return (count + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    }
+
+    size_t scratchFloats(size_t maxFramesPerBlock, int channels) noexcept {
+        return 2 * paddedFloats(maxFramesPerBlock * static_cast<size_t>(channels)) +
+               paddedFloats(maxFramesPerBlock);
+    }
+}
+
+HotSwapKernel::HotSwapKernel(std::unique_ptr<DSPKernel> initial, double crossfadeSeconds)
+    : DSPKernel(requireKernel(initial).currentSampleRate(), requireKernel(initial).channelCount(),
+                requireKernel(initial).denormalMode(), requireKernel(initial).maximumFramesPerBlock())
+    , fadeSeconds(validatedFade(crossfadeSeconds))
+    , currentKernel(std::move(initial))
+    , pendingKernel(nullptr)
+    , fadingKernel(nullptr)
+    , renderKernel(nullptr)
+    , fadeKernel(nullptr)
+    , fadeFrames(0)
+    , fadePosition(0)
+    , hasRendered(false)
+    , outgoing(nullptr)
+    , incoming(nullptr)
+    , ramp(nullptr)
+{
+    // The initial kernel arrives prepared for this format
+    layOut(acquireScratch(scratchFloats(maxFrames, numChannels)), maxFrames, numChannels, sampleRate);
+    resetState();
+}
+
+void HotSwapKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    ScratchBlock newScratch = acquireScratch(scratchFloats(maxFramesPerBlock, channels));
+    currentKernel->prepare(maxFramesPerBlock, channels, sampleRate);
+
+    // Nothing below throws
+    layOut(std::move(newScratch), maxFramesPerBlock, channels, sampleRate);
+}
+
+void HotSwapKernel::layOut(ScratchBlock newScratch, size_t maxFramesPerBlock, int channels,
+                           double sampleRate) noexcept {
+    scratch = std::move(newScratch);
+    const size_t blockFloats = paddedFloats(maxFramesPerBlock * static_cast<size_t>(channels));
+    outgoing = scratch.data();
+    incoming = outgoing + blockFloats;
+    ramp = incoming + blockFloats;
+    fadeFrames = static_cast<size_t>(std::lround(fadeSeconds * sampleRate));
+
+    // Rendering is stopped, so whatever was swapped out can go and only the latest stays
+    retiredKernel.reset();
+    pendingKernel.store(nullptr, std::memory_order_relaxed);
+    fadingKernel.store(nullptr, std::memory_order_relaxed);
+    renderKernel = currentKernel.get();
+    fadeKernel = nullptr;
+}
+
+void HotSwapKernel::resetState() noexcept {
+    renderKernel->reset();
+    if (fadeKernel) {
+        finishFade();
+    }
+    fadePosition = 0;
+    hasRendered = false;
+}
+
+bool HotSwapKernel::swapTo(std::unique_ptr<DSPKernel>& prepared) {
+    if (!prepared) {
+        throw std::invalid_argument("Replacement kernel required");
+    }
+    if (prepared->currentSampleRate() != sampleRate || prepared->channelCount() != numChannels ||
+        prepared->maximumFramesPerBlock() != maxFrames) {
+        throw std::invalid_argument("Replacement kernel does not match the wrapper's format");
+    }
+    if (isSwapInProgress()) {
+        return false;
+    }
+
+    // Nothing pending or fading: the render thread has let go of the retired kernel
+    retiredKernel = std::move(currentKernel);
+    currentKernel = std::move(prepared);
+
+    // The incoming kernel brings its own parameters; forks must not replay the old ones
+    controlValueMask = 0;
+    pendingKernel.store(currentKernel.get(), std::memory_order_release);
+    return true;
+}
+
+void HotSwapKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    if (!input.isValid() || !output.isValid() || output.frames != input.frames ||
+        input.channels != numChannels || output.channels != numChannels || input.frames > maxFrames) {
+        return;
+    }
+    if (isBypassed()) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+    forwardParameterEvents();
+
+    // A swap is one pointer exchange at the block boundary
+    DSPKernel* const next = pendingKernel.load(std::memory_order_acquire);
+    if (next) {
+        if (hasRendered && fadeFrames > 0) {
+            fadeKernel = renderKernel;
+            fadePosition = 0;
+            // Published before pendingKernel clears, so swapTo() never sees neither
+            fadingKernel.store(fadeKernel, std::memory_order_relaxed);
+        }
+        renderKernel = next;
+        pendingKernel.store(nullptr, std::memory_order_release);
+    }
+
+    if (fadeKernel) {
+        crossfade(input, output);
+    }
+    else {
+        renderKernel->process(input, output);
+    }
+    hasRendered = true;
+
+    recordBlockTiming(startTicks, mach_absolute_time(), input.frames);
+}
+
+void HotSwapKernel::forwardParameterEvents() noexcept {
+    ParameterEvent event;
+    while (parameterEvents.pop(event)) {
+        forwardParameterEvent(*renderKernel, event);
+        if (fadeKernel) {
+            forwardParameterEvent(*fadeKernel, event);
+        }
+    }
+}
+
+void HotSwapKernel::finishFade() noexcept {
+    fadeKernel = nullptr;
+    fadingKernel.store(nullptr, std::memory_order_release);
+}
+
+void HotSwapKernel::crossfade(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    const size_t frames = input.frames;
+    const vDSP_Stride stride = numChannels;
+
+    // Both kernels read input before output is written, so in-place processing holds
+    fadeKernel->process(input, AudioBufferView::makeInterleaved(outgoing, numChannels, frames));
+    renderKernel->process(input, AudioBufferView::makeInterleaved(incoming, numChannels, frames));
+
+    // Midpoint weights, held at 1 once the fade completes inside this block
+    const float step = 1.0f / static_cast<float>(fadeFrames);
+    const float start = (static_cast<float>(fadePosition) + 0.5f) * step;
+    const float low = 0.0f;
+    const float high = 1.0f;
+    vDSP_vramp(&start, &step, ramp, 1, frames);
+    vDSP_vclip(ramp, 1, &low, &high, ramp, 1, frames);
+
+    for (int channel = 0; channel < numChannels; ++channel) {
+        float* destination;
+        vDSP_Stride destinationStride;
+        if (output.layout == BufferLayout::Planar) {
+            destination = output.planes[channel];
+            destinationStride = 1;
+        }
+        else {
+            destination = output.interleaved + channel;
+            destinationStride = stride;
+        }
+        // incoming - outgoing, in place, then weighted back onto outgoing
+        vDSP_vsub(outgoing + channel, stride, incoming + channel, stride, incoming + channel, stride, frames);
+        vDSP_vma(incoming + channel, stride, ramp, 1, outgoing + channel, stride, destination, destinationStride,
+                 frames);
+    }
+
+    fadePosition += frames;
+    if (fadePosition >= fadeFrames) {
+        finishFade();
+    }
+}
+
+std::unique_ptr<DSPKernel> HotSwapKernel::fork() const {
+    std::unique_ptr<DSPKernel> innerFork = currentKernel->fork();
+    if (!innerFork) {
+        throw std::runtime_error("Failed to fork swapped kernel");
+    }
+    auto clone = std::make_unique<HotSwapKernel>(std::move(innerFork), fadeSeconds);
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+} // namespace dsp
+} // namespace tald
@@ -0,0 +1,125 @@
+//
+// HotSwapKernel.hpp
+// TALD UNIA Audio System
+//
+// Double-buffered kernel slot: a complete replacement kernel (a new profile, often
+// restored with DSPKernel::restoreState) is built off the render thread and swapped
+// in at a block boundary with a short crossfade.
+//
+
+#ifndef TALD_UNIA_HOT_SWAP_KERNEL_HPP
+#define TALD_UNIA_HOT_SWAP_KERNEL_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+// Crossfade from the outgoing to the incoming kernel when none is requested
+constexpr double DEFAULT_KERNEL_SWAP_CROSSFADE_SECONDS = 0.02;
+
+// Longest crossfade accepted
+constexpr double MAX_KERNEL_SWAP_CROSSFADE_SECONDS = 1.0;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Renders through one inner kernel and replaces it atomically
+ *
+ * The control thread hands over a fully prepared kernel with swapTo(); all
+ * construction, coefficient design and allocation has already happened, so the
+ * render thread only picks up a pointer at its next block. Once audio has been
+ * rendered, the outgoing and incoming kernels then both run on each block for
+ * crossfadeSeconds and the output fades linearly between them, so a profile
+ * change never clicks; the outgoing kernel stays owned by the control thread and is
+ * released by the next swapTo() or prepare(), never on the render thread.
+ *
+ * Parameters and reset sent to the wrapper reach whichever kernels are rendering
+ * when they arrive; an incoming kernel otherwise starts on its own parameters.
+ */
+class HotSwapKernel final : public DSPKernel {
+public:
+    /**
+     * @param initial Kernel to render first; its format becomes the wrapper's
+     * @param crossfadeSeconds Fade length of each swap, 0 for a hard cut at the block boundary
+     * @throws std::invalid_argument if initial is null or the fade is out of range
+     * @throws std::runtime_error if allocation fails
+     */
+    explicit HotSwapKernel(std::unique_ptr<DSPKernel> initial,
+                           double crossfadeSeconds = DEFAULT_KERNEL_SWAP_CROSSFADE_SECONDS);
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief Switch to a kernel prepared elsewhere (single control thread)
+     * @param prepared Replacement; ownership is taken only when true is returned
+     * @return false while the previous swap has not been picked up or finished fading
+     * @throws std::invalid_argument if prepared is null or its sample rate, channel
+     *         count or largest block does not fit this wrapper
+     */
+    bool swapTo(std::unique_ptr<DSPKernel>& prepared);
+
+    /**
+     * @brief Whether the render thread is still picking up or fading in the last swap
+     */
+    [[nodiscard]]
+    bool isSwapInProgress() const noexcept {
+        return pendingKernel.load(std::memory_order_acquire) != nullptr ||
+               fadingKernel.load(std::memory_order_acquire) != nullptr;
+    }
+
+    /**
+     * @brief Kernel most recently handed over (control thread), for inspection
+     */
+    [[nodiscard]]
+    const DSPKernel& activeKernel() const noexcept {
+        return *currentKernel;
+    }
+
+    [[nodiscard]]
+    double crossfadeSeconds() const noexcept {
+        return fadeSeconds;
+    }
+
+    /**
+     * @brief New wrapper around a fork of the active kernel
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+private:
+    const double fadeSeconds;
+
+    // Control thread ownership of kernels the render thread may be running
+    std::unique_ptr<DSPKernel> currentKernel;   // Latest handed over
+    std::unique_ptr<DSPKernel> retiredKernel;   // Previous one, until the render thread lets go
+    std::atomic<DSPKernel*> pendingKernel;      // Handed over and not yet picked up, or null
+    std::atomic<DSPKernel*> fadingKernel;       // Outgoing kernel still rendering, or null
+    DSPKernel* renderKernel;                    // Render thread only
+    DSPKernel* fadeKernel;                      // Render thread: outgoing kernel, or null
+
+    size_t fadeFrames;                          // Fade length at the current rate
+    size_t fadePosition;                        // Frames of the current fade rendered
+    bool hasRendered;                           // Output rendered since the last reset
+
+    // Carved from the base class scratch block
+    float* outgoing;                            // Outgoing kernel's block, interleaved
+    float* incoming;                            // Incoming kernel's block, interleaved
+    float* ramp;                                // Incoming weight per frame
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+    void layOut(ScratchBlock newScratch, size_t maxFramesPerBlock, int channels, double sampleRate) noexcept;
+
+    void forwardParameterEvents() noexcept;
+    void finishFade() noexcept;
+    void crossfade(const AudioBufferView& input, const AudioBufferView& output) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_HOT_SWAP_KERNEL_HPP
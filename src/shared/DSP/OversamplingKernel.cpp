@@ -0,0 +1,329 @@
+#include "OversamplingKernel.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <stdexcept>
+#include "DSPFilterDesign.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Nonzero off-centre taps per stage, nearest the host rate first. A half-band
+    // filter of 2 * taps - 1 points has only these plus the 0.5 centre tap.
+    constexpr std::array<size_t, MAX_OVERSAMPLING_STAGES> kStageTaps = { 32, 16, 12 };
+    constexpr std::array<double, MAX_OVERSAMPLING_STAGES> kStageKaiserBeta = { 10.0, 9.0, 8.0 };
+
+    using Upsample = void (*)(const float* coefficients, const float* line, float* out, size_t frames) noexcept;
+    using Downsample = void (*)(const float* coefficients, const float* even, const float* odd, float* out,
+                                size_t frames) noexcept;
+
+    struct HalfbandStage {
+        const float* coefficients;
+        size_t taps;
+        Upsample up;
+        Downsample down;
+    };
+
+    /**
+     * @brief Double the rate of line[Taps - 1, Taps - 1 + frames), line starting with history
+     *
+     * Even outputs are the filtered phase (gain 2 restores the zero-stuffed level),
+     * odd outputs fall on the centre tap and are the input delayed by Taps / 2.
+     */
+    template <size_t Taps>
+    void upsampleHalfband(const float* coefficients, const float* line, float* out, size_t frames) noexcept {
+        for (size_t frame = 0; frame < frames; ++frame) {
+            out[2 * frame] = 2.0f * dotProduct<Taps>(coefficients, line + frame);
+            out[2 * frame + 1] = line[frame + Taps / 2];
+        }
+    }
+
+    /**
+     * @brief Halve the rate of a stream split into even and odd samples, each after its history
+     */
+    template <size_t Taps>
+    void downsampleHalfband(const float* coefficients, const float* even, const float* odd, float* out,
+                            size_t frames) noexcept {
+        for (size_t frame = 0; frame < frames; ++frame) {
+            out[frame] = dotProduct<Taps>(coefficients, even + frame) + 0.5f * odd[frame];
+        }
+    }
+
+    template <size_t Taps>
+    HalfbandStage makeStage(const float* coefficients) noexcept {
+        return { coefficients, Taps, &upsampleHalfband<Taps>, &downsampleHalfband<Taps> };
+    }
+
+    // Off-centre taps with the window spanning the full filter, normalized to unity DC gain
+    void designHalfband(float* coefficients, size_t taps, double kaiserBeta) noexcept {
+        const double halfWidth = static_cast<double>(taps);
+        const double windowScale = 1.0 / besselI0(kaiserBeta);
+        double sum = 0.0;
+        double designed[kStageTaps[0]];
+        for (size_t i = 0; i < taps; ++i) {
+            const double n = 2.0 * static_cast<double>(i) + 1.0 - halfWidth;
+            const double ratio = n / halfWidth;
+            const double window = besselI0(kaiserBeta * std::sqrt(1.0 - ratio * ratio)) * windowScale;
+            const double argument = 0.5 * std::numbers::pi * n;
+            designed[i] = 0.5 * std::sin(argument) / argument * window;
+            sum += designed[i];
+        }
+        for (size_t i = 0; i < taps; ++i) {
+            coefficients[i] = static_cast<float>(0.5 * designed[i] / sum);
+        }
+    }
+
+    // Designed once per process and shared by every wrapper and fork
+    struct HalfbandStages {
+        alignas(CACHE_LINE_SIZE) float coefficients[MAX_OVERSAMPLING_STAGES][kStageTaps[0]];
+        std::array<HalfbandStage, MAX_OVERSAMPLING_STAGES> stages;
+
+        HalfbandStages() noexcept {
+            for (size_t stage = 0; stage < MAX_OVERSAMPLING_STAGES; ++stage) {
+                designHalfband(coefficients[stage], kStageTaps[stage], kStageKaiserBeta[stage]);
+            }
+            stages = { makeStage<kStageTaps[0]>(coefficients[0]),
+                       makeStage<kStageTaps[1]>(coefficients[1]),
+                       makeStage<kStageTaps[2]>(coefficients[2]) };
+        }
+    };
+
+    const std::array<HalfbandStage, MAX_OVERSAMPLING_STAGES>& halfbandStages() noexcept {
+        static const HalfbandStages instance;
+        return instance.stages;
+    }
+
+    size_t paddedLength(size_t samples) noexcept {
+        constexpr size_t lineFloats = CACHE_LINE_SIZE / sizeof(float);
+        return (samples + lineFloats - 1) / lineFloats * lineFloats;
+    }
+
+    /**
+     * @brief Round-trip filter delay at the high rate before alignment
+     *
+     * Each half-band stage delays by taps - 1 samples of its own high rate in each
+     * direction, which is 2 * (taps - 1) samples of the stage's high rate overall.
+     */
+    size_t filterDelay(size_t stageCount) noexcept {
+        size_t delay = 0;
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            delay += (2 * (kStageTaps[stage] - 1)) << (stageCount - 1 - stage);
+        }
+        return delay;
+    }
+
+    const DSPKernel& requireKernel(const std::unique_ptr<DSPKernel>& kernel) {
+        if (!kernel) {
+            throw std::invalid_argument("Oversampling requires an inner kernel");
+        }
+        return *kernel;
+    }
+}
+
+OversamplingKernel::OversamplingKernel(double sampleRate, std::unique_ptr<DSPKernel> wrapped,
+                                       OversamplingFactor factor, size_t maxFrames, DenormalMode denormalMode)
+    : DSPKernel(sampleRate, requireKernel(wrapped).channelCount(), denormalMode, maxFrames)
+    , inner(std::move(wrapped))
+    , oversampling(factor)
+    , stageCount(static_cast<size_t>(std::countr_zero(static_cast<unsigned>(factor))))
+    , alignmentFrames(0)
+    , chunkFrames(0)
+{
+    prepareResources(maxFrames, numChannels, sampleRate);
+    resetState();
+}
+
+void OversamplingKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    const size_t factor = static_cast<size_t>(oversampling);
+    if (sampleRate * static_cast<double>(factor) > MAX_SAMPLE_RATE) {
+        throw std::invalid_argument("Oversampled rate out of valid range");
+    }
+    const auto& stages = halfbandStages();
+    const size_t chunk = std::min(maxFramesPerBlock, MAX_BUFFER_SIZE / factor);
+    const size_t delay = filterDelay(stageCount);
+    const size_t alignment = (factor - delay % factor) % factor;
+
+    size_t channelFloats = paddedLength(alignment + chunk * factor) + paddedLength(chunk * factor / 2);
+    for (size_t stage = 0; stage < stageCount; ++stage) {
+        const size_t frames = chunk << stage;
+        channelFloats += 2 * paddedLength(stages[stage].taps - 1 + frames) +
+                         paddedLength(stages[stage].taps / 2 + frames);
+    }
+    ScratchBlock newScratch = acquireScratch(static_cast<size_t>(channels) * channelFloats);
+    inner->prepare(chunk * factor, channels, sampleRate * static_cast<double>(factor));
+
+    // Nothing below throws
+    scratch = std::move(newScratch);
+    float* cursor = scratch.data();
+    const auto carve = [&cursor](size_t samples) {
+        float* line = cursor;
+        cursor += paddedLength(samples);
+        return line;
+    };
+    for (int channel = 0; channel < channels; ++channel) {
+        ChannelLines& channelLines = lines[channel];
+        channelLines.top = carve(alignment + chunk * factor);
+        channelLines.decimated = carve(chunk * factor / 2);
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            const size_t frames = chunk << stage;
+            channelLines.stages[stage].up = carve(stages[stage].taps - 1 + frames);
+            channelLines.stages[stage].even = carve(stages[stage].taps - 1 + frames);
+            channelLines.stages[stage].odd = carve(stages[stage].taps / 2 + frames);
+        }
+    }
+    alignmentFrames = alignment;
+    chunkFrames = chunk;
+}
+
+void OversamplingKernel::resetState() noexcept {
+    const auto& stages = halfbandStages();
+    for (int channel = 0; channel < numChannels; ++channel) {
+        ChannelLines& channelLines = lines[channel];
+        std::memset(channelLines.top, 0, alignmentFrames * sizeof(float));
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            const size_t taps = stages[stage].taps;
+            std::memset(channelLines.stages[stage].up, 0, (taps - 1) * sizeof(float));
+            std::memset(channelLines.stages[stage].even, 0, (taps - 1) * sizeof(float));
+            std::memset(channelLines.stages[stage].odd, 0, (taps / 2) * sizeof(float));
+        }
+    }
+    inner->reset();
+}
+
+size_t OversamplingKernel::latencyFrames() const noexcept {
+    return (filterDelay(stageCount) + alignmentFrames) / static_cast<size_t>(oversampling);
+}
+
+void OversamplingKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    if (!input.isValid() || !output.isValid() || output.frames != input.frames ||
+        input.channels != numChannels || output.channels != numChannels || input.frames > maxFrames) {
+        return;
+    }
+    if (isBypassed()) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+    forwardParameterEvents();
+
+    for (size_t offset = 0; offset < input.frames; offset += chunkFrames) {
+        processChunk(input, output, offset, std::min(chunkFrames, input.frames - offset));
+    }
+
+    recordBlockTiming(startTicks, mach_absolute_time(), input.frames);
+}
+
+void OversamplingKernel::forwardParameterEvents() noexcept {
+    const uint32_t factor = static_cast<uint32_t>(oversampling);
+    ParameterEvent event;
+    while (parameterEvents.pop(event)) {
+        event.sampleOffset *= factor;
+        event.rampFrames *= factor;
+        forwardParameterEvent(*inner, event);
+    }
+}
+
+void OversamplingKernel::processChunk(const AudioBufferView& input, const AudioBufferView& output,
+                                      size_t offset, size_t frames) noexcept {
+    const auto& stages = halfbandStages();
+    const size_t factor = static_cast<size_t>(oversampling);
+    const size_t highFrames = frames * factor;
+
+    // Up: host input lands after the first stage's history; each stage writes
+    // straight behind the next stage's history, the last behind the alignment delay
+    float* topPlanes[MAX_CHANNELS];
+    for (int channel = 0; channel < numChannels; ++channel) {
+        ChannelLines& channelLines = lines[channel];
+        float* first = channelLines.stages[0].up + stages[0].taps - 1;
+        if (input.layout == BufferLayout::Planar) {
+            std::memcpy(first, input.planes[channel] + offset, frames * sizeof(float));
+        }
+        else {
+            const float* source = input.interleaved + offset * static_cast<size_t>(numChannels) + channel;
+            for (size_t frame = 0; frame < frames; ++frame) {
+                first[frame] = source[frame * static_cast<size_t>(numChannels)];
+            }
+        }
+
+        size_t stageFrames = frames;
+        for (size_t stage = 0; stage < stageCount; ++stage) {
+            const HalfbandStage& filter = stages[stage];
+            float* line = channelLines.stages[stage].up;
+            float* target = (stage + 1 < stageCount)
+                ? channelLines.stages[stage + 1].up + stages[stage + 1].taps - 1
+                : channelLines.top + alignmentFrames;
+            filter.up(filter.coefficients, line, target, stageFrames);
+            std::memmove(line, line + stageFrames, (filter.taps - 1) * sizeof(float));
+            stageFrames *= 2;
+        }
+        topPlanes[channel] = channelLines.top;
+    }
+
+    const AudioBufferView top = AudioBufferView::makePlanar(topPlanes, numChannels, highFrames);
+    inner->process(top, top);
+
+    // Down: each stage splits its input into even and odd lines, then decimates
+    const bool flush = activeDenormalMode == DenormalMode::VectorThreshold;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        ChannelLines& channelLines = lines[channel];
+        const float* source = channelLines.top;
+        for (size_t stage = stageCount; stage-- > 0;) {
+            const HalfbandStage& filter = stages[stage];
+            StageLines& stageLines = channelLines.stages[stage];
+            const size_t stageFrames = frames << stage;
+            float* even = stageLines.even + filter.taps - 1;
+            float* odd = stageLines.odd + filter.taps / 2;
+            for (size_t frame = 0; frame < stageFrames; ++frame) {
+                even[frame] = source[2 * frame];
+                odd[frame] = source[2 * frame + 1];
+            }
+            filter.down(filter.coefficients, stageLines.even, stageLines.odd, channelLines.decimated,
+                        stageFrames);
+            std::memmove(stageLines.even, stageLines.even + stageFrames, (filter.taps - 1) * sizeof(float));
+            std::memmove(stageLines.odd, stageLines.odd + stageFrames, (filter.taps / 2) * sizeof(float));
+            source = channelLines.decimated;
+        }
+        if (alignmentFrames > 0) {
+            std::memmove(channelLines.top, channelLines.top + highFrames, alignmentFrames * sizeof(float));
+        }
+
+        const float* decimated = channelLines.decimated;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            float sample = decimated[frame];
+            if (flush) {
+                sample = (std::fabs(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+            }
+            if (output.layout == BufferLayout::Planar) {
+                output.planes[channel][offset + frame] = sample;
+            }
+            else {
+                output.interleaved[(offset + frame) * static_cast<size_t>(numChannels) + channel] = sample;
+            }
+        }
+    }
+}
+
+std::unique_ptr<DSPKernel> OversamplingKernel::fork() const {
+    std::unique_ptr<DSPKernel> innerFork = inner->fork();
+    if (!innerFork) {
+        throw std::runtime_error("Failed to fork oversampled kernel");
+    }
+    auto clone = std::make_unique<OversamplingKernel>(sampleRate, std::move(innerFork), oversampling, maxFrames,
+                                                      activeDenormalMode);
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+} // namespace dsp
+} // namespace tald
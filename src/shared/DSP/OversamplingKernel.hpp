@@ -0,0 +1,129 @@
+//
+// OversamplingKernel.hpp
+// TALD UNIA Audio System
+//
+// Runs a nonlinear kernel (saturation, clipping, fast-attack dynamics) at 2x, 4x or
+// 8x the host rate behind cascaded half-band polyphase filters, so the harmonics it
+// generates above the host Nyquist frequency are removed instead of aliasing back
+// into the audio band.
+//
+
+#ifndef TALD_UNIA_OVERSAMPLING_KERNEL_HPP
+#define TALD_UNIA_OVERSAMPLING_KERNEL_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief Oversampling ratio; each doubling adds one half-band stage per direction
+ */
+enum class OversamplingFactor : uint8_t {
+    Two = 2,
+    Four = 4,
+    Eight = 8
+};
+
+// Half-band stages per direction for the highest factor
+constexpr size_t MAX_OVERSAMPLING_STAGES = 3;
+
+/**
+ * @brief Wraps any kernel so it processes at a multiple of the host sample rate
+ *
+ * Each block is upsampled through one half-band FIR stage per doubling, handed to
+ * the inner kernel as planar audio at factor times the rate, then filtered back
+ * down. The first stage next to the host rate carries the steep filter; later
+ * stages only have to reject images far above the audio band and are much
+ * shorter. Half-band filters have every other tap zero, so each stage costs one
+ * dot product per output pair in either direction, over coefficients that are
+ * designed once and shared by every instance.
+ *
+ * Only the inner kernel runs at the high rate; linear stages around it should stay
+ * outside the wrapper. Parameters and reset sent to the wrapper reach the inner
+ * kernel with offsets and ramps scaled to the high rate. The filters delay the
+ * signal by latencyFrames() host frames, always a whole number; the inner kernel's
+ * own latency comes on top. Long host blocks are run through the inner kernel in
+ * several chunks when factor times maxFrames exceeds MAX_BUFFER_SIZE.
+ */
+class OversamplingKernel final : public DSPKernel {
+public:
+    /**
+     * @param sampleRate Host sample rate (Hz); the inner kernel runs at factor times this
+     * @param inner Kernel to oversample; re-prepared for the high rate, channels kept
+     * @param factor Oversampling ratio
+     * @param maxFrames Largest host block process() accepts
+     * @param denormalMode Requested denormal handling for the filters
+     * @throws std::invalid_argument if inner is null or the high rate exceeds MAX_SAMPLE_RATE
+     * @throws std::runtime_error if allocation fails
+     */
+    OversamplingKernel(double sampleRate, std::unique_ptr<DSPKernel> inner, OversamplingFactor factor,
+                       size_t maxFrames = MAX_BUFFER_SIZE,
+                       DenormalMode denormalMode = DenormalMode::HardwareFTZ);
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    [[nodiscard]]
+    OversamplingFactor factor() const noexcept {
+        return oversampling;
+    }
+
+    /**
+     * @brief Round-trip delay of the up and down filters in host frames
+     */
+    [[nodiscard]]
+    size_t latencyFrames() const noexcept;
+
+    /**
+     * @brief The wrapped kernel, for inspection; control it through the wrapper
+     */
+    [[nodiscard]]
+    const DSPKernel& innerKernel() const noexcept {
+        return *inner;
+    }
+
+    /**
+     * @brief New wrapper around a fork of the inner kernel, sharing the filter coefficients
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+private:
+    struct StageLines {
+        float* up;        // Input history at the lower rate, then the block
+        float* even;      // Even high-rate samples awaiting decimation
+        float* odd;       // Odd high-rate samples, delayed to the filter centre
+    };
+
+    struct ChannelLines {
+        StageLines stages[MAX_OVERSAMPLING_STAGES];
+        float* top;       // Alignment delay, then the block at the high rate
+        float* decimated; // Output of each down stage, input to the next
+    };
+
+    std::unique_ptr<DSPKernel> inner;
+    const OversamplingFactor oversampling;
+    size_t stageCount;
+    size_t alignmentFrames;  // High-rate delay that rounds the latency to whole host frames
+    size_t chunkFrames;      // Host frames per inner kernel call
+
+    // Carved from the base class scratch block
+    ChannelLines lines[MAX_CHANNELS];
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+
+    void forwardParameterEvents() noexcept;
+    void processChunk(const AudioBufferView& input, const AudioBufferView& output, size_t offset,
+                      size_t frames) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_OVERSAMPLING_KERNEL_HPP
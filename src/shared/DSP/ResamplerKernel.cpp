@@ -0,0 +1,339 @@
+#include "ResamplerKernel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+#include "DSPFilterDesign.hpp"
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    struct QualityPreset {
+        size_t taps;
+        double passband;     // Cutoff as a fraction of the lower Nyquist frequency
+        double kaiserBeta;
+    };
+
+    constexpr QualityPreset presetFor(ResamplerQuality quality) noexcept {
+        switch (quality) {
+            case ResamplerQuality::LowLatency:
+                return { 16, 0.80, 6.0 };
+            case ResamplerQuality::Standard:
+                return { 32, 0.90, 8.5 };
+            case ResamplerQuality::Mastering:
+                return { 64, 0.94, 11.0 };
+        }
+        return { 32, 0.90, 8.5 };
+    }
+
+    struct BankKey {
+        uint32_t up;
+        uint32_t down;
+        ResamplerQuality quality;
+
+        bool operator==(const BankKey&) const = default;
+    };
+
+    struct BankEntry {
+        BankKey key;
+        std::weak_ptr<const PolyphaseFilterBank> bank;
+    };
+
+    // A few conversions are live at once, so a flat list beats a map
+    struct BankCache {
+        std::mutex mutex;
+        std::vector<BankEntry> entries;
+    };
+
+    BankCache& bankCache() {
+        static BankCache instance;
+        return instance;
+    }
+
+    uint32_t integerRate(double rate) {
+        return static_cast<uint32_t>(std::llround(rate));
+    }
+
+    void validateRate(double rate) {
+        if (!(rate >= MIN_SAMPLE_RATE && rate <= MAX_SAMPLE_RATE)) {
+            throw std::invalid_argument("Resampler rate out of valid range");
+        }
+    }
+
+    inline float readSample(const AudioBufferView& view, int channel, size_t frame) noexcept {
+        return (view.layout == BufferLayout::Planar)
+            ? view.planes[channel][frame]
+            : view.interleaved[frame * static_cast<size_t>(view.channels) + channel];
+    }
+
+    inline void writeSample(const AudioBufferView& view, int channel, size_t frame, float sample) noexcept {
+        if (view.layout == BufferLayout::Planar) {
+            view.planes[channel][frame] = sample;
+        }
+        else {
+            view.interleaved[frame * static_cast<size_t>(view.channels) + channel] = sample;
+        }
+    }
+}
+
+// MARK: - PolyphaseFilterBank
+
+std::shared_ptr<const PolyphaseFilterBank> PolyphaseFilterBank::acquire(double inputRate, double outputRate,
+                                                                       ResamplerQuality quality) {
+    const uint32_t inputHz = integerRate(inputRate);
+    const uint32_t outputHz = integerRate(outputRate);
+    const uint32_t divisor = std::gcd(inputHz, outputHz);
+    const BankKey key{ outputHz / divisor, inputHz / divisor, quality };
+
+    BankCache& cache = bankCache();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+
+    std::erase_if(cache.entries, [](const BankEntry& entry) { return entry.bank.expired(); });
+    for (const BankEntry& entry : cache.entries) {
+        if (entry.key == key) {
+            if (auto existing = entry.bank.lock()) {
+                return existing;
+            }
+        }
+    }
+
+    const QualityPreset preset = presetFor(quality);
+    std::shared_ptr<PolyphaseFilterBank> bank(new PolyphaseFilterBank());
+    bank->taps = preset.taps;
+    bank->up = key.up;
+    bank->down = key.down;
+    bank->preset = quality;
+    bank->interpolated = key.up > MAX_RESAMPLER_PHASES;
+
+    // An interpolated bank carries one extra row so phase P blends toward the next sample
+    const size_t phases = bank->interpolated ? INTERPOLATED_RESAMPLER_PHASES : key.up;
+    const size_t rows = bank->interpolated ? phases + 1 : phases;
+    bank->coefficients = static_cast<float*>(alignedMalloc(rows * preset.taps * sizeof(float), CACHE_LINE_SIZE));
+    if (!bank->coefficients) {
+        throw std::runtime_error("Failed to allocate resampler filter bank");
+    }
+
+    // Windowed sinc at the lower of the two Nyquist frequencies, in input-sample time.
+    // Row p, tap k weighs input s + k for the output at s + taps/2 - 1 + p/phases.
+    const double cutoff = preset.passband * std::min(1.0, static_cast<double>(key.up) / key.down);
+    const double halfWidth = 0.5 * static_cast<double>(preset.taps);
+    const double windowScale = 1.0 / besselI0(preset.kaiserBeta);
+    std::vector<double> row(preset.taps);
+    for (size_t p = 0; p < rows; ++p) {
+        const double fraction = static_cast<double>(p) / static_cast<double>(phases);
+        double sum = 0.0;
+        for (size_t k = 0; k < preset.taps; ++k) {
+            const double x = halfWidth - 1.0 + fraction - static_cast<double>(k);
+            const double ratio = x / halfWidth;
+            const double window = (std::fabs(ratio) < 1.0)
+                ? besselI0(preset.kaiserBeta * std::sqrt(1.0 - ratio * ratio)) * windowScale
+                : 0.0;
+            const double argument = std::numbers::pi * cutoff * x;
+            const double sinc = (std::fabs(argument) < 1.0e-12) ? 1.0 : std::sin(argument) / argument;
+            row[k] = cutoff * sinc * window;
+            sum += row[k];
+        }
+        // Unity DC gain for every phase, so a constant input never ripples
+        float* out = bank->coefficients + p * preset.taps;
+        for (size_t k = 0; k < preset.taps; ++k) {
+            out[k] = static_cast<float>(row[k] / sum);
+        }
+    }
+
+    std::erase_if(cache.entries, [&](const BankEntry& entry) { return entry.key == key; });
+    cache.entries.push_back(BankEntry{ key, bank });
+    return bank;
+}
+
+PolyphaseFilterBank::~PolyphaseFilterBank() {
+    alignedFree(coefficients);
+}
+
+// MARK: - ResamplerKernel
+
+ResamplerKernel::ResamplerKernel(double inputRate, double outputRate, int channels, ResamplerQuality quality,
+                                 size_t maxInputFrames, DenormalMode denormalMode)
+    : DSPKernel(inputRate, channels, denormalMode, maxInputFrames)
+    , outputRate(outputRate)
+    , quality(quality)
+    , dot(nullptr)
+    , blendedRow(nullptr)
+    , historyCapacity(0)
+    , historyFrames(0)
+    , phase(0)
+{
+    validateRate(outputRate);
+    prepareResources(maxFrames, channels, inputRate);
+    resetState();
+}
+
+void ResamplerKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    validateRate(sampleRate);
+    std::shared_ptr<const PolyphaseFilterBank> newBank = PolyphaseFilterBank::acquire(sampleRate, outputRate,
+                                                                                     quality);
+    const size_t taps = newBank->tapCount();
+
+    // History never holds more than a window plus one output step beyond a block
+    const size_t capacity = maxFramesPerBlock + 2 * taps + newBank->downFactor() / newBank->upFactor() + 1;
+    const size_t stride = (capacity + CACHE_LINE_SIZE / sizeof(float) - 1)
+        / (CACHE_LINE_SIZE / sizeof(float)) * (CACHE_LINE_SIZE / sizeof(float));
+    ScratchBlock newScratch = acquireScratch(static_cast<size_t>(channels) * stride + taps);
+
+    // Nothing below throws
+    scratch = std::move(newScratch);
+    for (int channel = 0; channel < channels; ++channel) {
+        history[channel] = scratch.data() + static_cast<size_t>(channel) * stride;
+    }
+    blendedRow = scratch.data() + static_cast<size_t>(channels) * stride;
+    historyCapacity = capacity;
+    bank = std::move(newBank);
+    switch (taps) {
+        case 16:
+            dot = &dotProduct<16>;
+            break;
+        case 32:
+            dot = &dotProduct<32>;
+            break;
+        default:
+            dot = &dotProduct<64>;
+            break;
+    }
+}
+
+void ResamplerKernel::resetState() noexcept {
+    // A full window of silence: output starts at once, delayed by latencyFrames()
+    historyFrames = bank->tapCount() - 1;
+    for (int channel = 0; channel < numChannels; ++channel) {
+        std::memset(history[channel], 0, historyFrames * sizeof(float));
+    }
+    phase = 0;
+}
+
+size_t ResamplerKernel::outputFramesFor(size_t inputFrames) const noexcept {
+    // Window k starts at floor((phase + k * down) / up) and needs tapCount() frames
+    const size_t available = historyFrames + inputFrames;
+    const size_t taps = bank->tapCount();
+    if (available < taps) {
+        return 0;
+    }
+    const uint64_t limit = static_cast<uint64_t>(available - taps + 1) * bank->upFactor();
+    if (limit <= phase) {
+        return 0;
+    }
+    const uint64_t down = bank->downFactor();
+    return static_cast<size_t>((limit - phase + down - 1) / down);
+}
+
+size_t ResamplerKernel::inputFramesFor(size_t outputFrames) const noexcept {
+    if (outputFrames == 0) {
+        return 0;
+    }
+    const uint64_t lastStart = (phase + static_cast<uint64_t>(outputFrames - 1) * bank->downFactor())
+        / bank->upFactor();
+    const uint64_t needed = lastStart + bank->tapCount();
+    return (needed > historyFrames) ? static_cast<size_t>(needed - historyFrames) : 0;
+}
+
+void ResamplerKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    resample(input, output);
+}
+
+size_t ResamplerKernel::resample(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    const size_t inputFrames = input.frames;
+    const bool hasInput = inputFrames > 0;
+    if ((hasInput && (!input.isValid() || input.channels != numChannels)) ||
+        !output.isValid() || output.channels != numChannels ||
+        inputFrames > maxFrames || historyFrames + inputFrames > historyCapacity) {
+        return 0;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+
+    for (int channel = 0; hasInput && channel < numChannels; ++channel) {
+        float* destination = history[channel] + historyFrames;
+        if (input.layout == BufferLayout::Planar) {
+            std::memcpy(destination, input.planes[channel], inputFrames * sizeof(float));
+        }
+        else {
+            for (size_t frame = 0; frame < inputFrames; ++frame) {
+                destination[frame] = readSample(input, channel, frame);
+            }
+        }
+    }
+    const size_t available = historyFrames + inputFrames;
+
+    const PolyphaseFilterBank& filters = *bank;
+    const size_t taps = filters.tapCount();
+    const uint32_t up = filters.upFactor();
+    const uint32_t down = filters.downFactor();
+    const bool flush = activeDenormalMode == DenormalMode::VectorThreshold;
+
+    size_t start = 0;
+    size_t produced = 0;
+    while (produced < output.frames && start + taps <= available) {
+        const float* coefficients;
+        if (filters.isInterpolated()) {
+            // Blend the two nearest rows once, then reuse them for every channel
+            const uint64_t scaled = static_cast<uint64_t>(phase) * INTERPOLATED_RESAMPLER_PHASES;
+            const size_t index = static_cast<size_t>(scaled / up);
+            const float fraction = static_cast<float>(scaled % up) / static_cast<float>(up);
+            const float* lower = filters.row(index);
+            const float* upper = filters.row(index + 1);
+            for (size_t k = 0; k < taps; ++k) {
+                blendedRow[k] = lower[k] + fraction * (upper[k] - lower[k]);
+            }
+            coefficients = blendedRow;
+        }
+        else {
+            coefficients = filters.row(phase);
+        }
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            float sample = dot(coefficients, history[channel] + start);
+            if (flush) {
+                sample = (std::fabs(sample) < DENORMAL_THRESHOLD) ? 0.0f : sample;
+            }
+            writeSample(output, channel, produced, sample);
+        }
+        ++produced;
+
+        phase += down;
+        start += phase / up;
+        phase %= up;
+    }
+
+    // Keep what later windows still need at the front of each history
+    historyFrames = available - start;
+    if (start > 0) {
+        for (int channel = 0; channel < numChannels; ++channel) {
+            std::memmove(history[channel], history[channel] + start, historyFrames * sizeof(float));
+        }
+    }
+
+    if (hasInput) {
+        recordBlockTiming(startTicks, mach_absolute_time(), inputFrames);
+    }
+    return produced;
+}
+
+std::unique_ptr<DSPKernel> ResamplerKernel::fork() const {
+    auto clone = std::make_unique<ResamplerKernel>(sampleRate, outputRate, numChannels, quality, maxFrames,
+                                                   activeDenormalMode);
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+} // namespace dsp
+} // namespace tald
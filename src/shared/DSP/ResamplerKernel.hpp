@@ -0,0 +1,212 @@
+//
+// ResamplerKernel.hpp
+// TALD UNIA Audio System
+//
+// Polyphase windowed-sinc sample-rate conversion between any two supported rates,
+// so sources at 44.1 kHz can feed a 192 kHz graph without a trip through
+// AVAudioConverter.
+//
+
+#ifndef TALD_UNIA_RESAMPLER_KERNEL_HPP
+#define TALD_UNIA_RESAMPLER_KERNEL_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include "DSPKernel.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Reduced ratios up to this many output phases per input sample get one exact
+// coefficient row per phase; the standard audio rates qualify, up to 44.1k<->384k
+// (147:1280), while ratios such as 44100:96001 use the interpolated bank
+constexpr size_t MAX_RESAMPLER_PHASES = 2048;
+
+// Phase rows of the interpolated bank used for ratios beyond MAX_RESAMPLER_PHASES
+constexpr size_t INTERPOLATED_RESAMPLER_PHASES = 512;
+
+/**
+ * @brief Filter length and bandwidth presets, trading delay and CPU for stopband
+ */
+enum class ResamplerQuality : uint8_t {
+    LowLatency,  // 16 taps: 8 input frames of delay, about 60 dB stopband
+    Standard,    // 32 taps: about 90 dB stopband
+    Mastering    // 64 taps: about 120 dB stopband, narrowest transition band
+};
+
+/**
+ * @brief Immutable polyphase coefficient rows for one conversion ratio and preset
+ *
+ * Row p holds the taps that produce output sample phase p / upFactor between two
+ * input samples, contiguous and padded so dot products run as whole vectors. Banks
+ * are cached process-wide, so every kernel converting the same ratio at the same
+ * quality (forks, per-voice resamplers) shares one copy.
+ */
+class PolyphaseFilterBank {
+public:
+    /**
+     * @brief Cached bank for a conversion, designed on first use
+     * @throws std::runtime_error if allocation fails
+     *
+     * Thread-safe; takes a lock and may allocate, so never call it on the render thread.
+     */
+    static std::shared_ptr<const PolyphaseFilterBank> acquire(double inputRate, double outputRate,
+                                                              ResamplerQuality quality);
+
+    ~PolyphaseFilterBank();
+
+    PolyphaseFilterBank(const PolyphaseFilterBank&) = delete;
+    PolyphaseFilterBank& operator=(const PolyphaseFilterBank&) = delete;
+
+    [[nodiscard]]
+    const float* row(size_t index) const noexcept {
+        return coefficients + index * taps;
+    }
+
+    [[nodiscard]]
+    size_t tapCount() const noexcept {
+        return taps;
+    }
+
+    // Output steps by downFactor / upFactor input samples, in lowest terms
+    [[nodiscard]]
+    uint32_t upFactor() const noexcept {
+        return up;
+    }
+
+    [[nodiscard]]
+    uint32_t downFactor() const noexcept {
+        return down;
+    }
+
+    /**
+     * @brief Whether rows are blended between INTERPOLATED_RESAMPLER_PHASES entries
+     *
+     * False for every rational ratio with at most MAX_RESAMPLER_PHASES phases, where
+     * each output is one dot product against its exact row.
+     */
+    [[nodiscard]]
+    bool isInterpolated() const noexcept {
+        return interpolated;
+    }
+
+    [[nodiscard]]
+    ResamplerQuality quality() const noexcept {
+        return preset;
+    }
+
+private:
+    PolyphaseFilterBank() = default;
+
+    float* coefficients = nullptr;   // rowCount * taps, one aligned allocation
+    size_t taps = 0;
+    uint32_t up = 1;
+    uint32_t down = 1;
+    bool interpolated = false;
+    ResamplerQuality preset = ResamplerQuality::Standard;
+};
+
+/**
+ * @brief Streaming polyphase sample-rate converter
+ *
+ * The kernel's sampleRate is the input rate. Each call appends its input to a short
+ * per-channel history and emits every output sample whose filter window is complete,
+ * so input and output block lengths differ and follow the conversion ratio: push
+ * mode passes any input and sizes the output with outputFramesFor(); pull mode asks
+ * inputFramesFor() how much input the next output block needs. Output is time
+ * aligned with the input delayed by latencyFrames(). Parameters and bypass do not
+ * apply. Input and output must not overlap.
+ */
+class ResamplerKernel final : public DSPKernel {
+public:
+    /**
+     * @param inputRate Input sample rate (Hz)
+     * @param outputRate Output sample rate (Hz)
+     * @param channels Number of input and output channels
+     * @param quality Filter preset
+     * @param maxInputFrames Largest input block a call will be given
+     * @param denormalMode Requested denormal handling
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    ResamplerKernel(double inputRate, double outputRate, int channels,
+                    ResamplerQuality quality = ResamplerQuality::Standard,
+                    size_t maxInputFrames = MAX_BUFFER_SIZE,
+                    DenormalMode denormalMode = DenormalMode::HardwareFTZ);
+
+    /**
+     * @brief Same as resample(); the views' frame counts follow the ratio
+     */
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief Consume all of input and write the output samples it completes
+     * @param input Up to maximumFramesPerBlock() frames; may be empty
+     * @param output Room for at least the frames wanted
+     * @return Frames written, min(outputFramesFor(input.frames), output.frames)
+     *
+     * Input past what fits in output stays buffered for the next call. A call whose
+     * input would overflow that buffer is rejected with 0.
+     */
+    size_t resample(const AudioBufferView& input, const AudioBufferView& output) noexcept;
+
+    /**
+     * @brief Output frames the next resample() of inputFrames frames can produce
+     */
+    [[nodiscard]]
+    size_t outputFramesFor(size_t inputFrames) const noexcept;
+
+    /**
+     * @brief Fewest input frames that let the next resample() produce outputFrames frames
+     */
+    [[nodiscard]]
+    size_t inputFramesFor(size_t outputFrames) const noexcept;
+
+    [[nodiscard]]
+    double outputSampleRate() const noexcept {
+        return outputRate;
+    }
+
+    /**
+     * @brief Group delay in input frames
+     */
+    [[nodiscard]]
+    size_t latencyFrames() const noexcept {
+        return bank->tapCount() / 2;
+    }
+
+    [[nodiscard]]
+    const std::shared_ptr<const PolyphaseFilterBank>& filterBank() const noexcept {
+        return bank;
+    }
+
+    /**
+     * @brief New converter for the same rates and preset, sharing the filter bank
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+private:
+    using DotProduct = float (*)(const float* coefficients, const float* samples) noexcept;
+
+    const double outputRate;
+    const ResamplerQuality quality;
+    std::shared_ptr<const PolyphaseFilterBank> bank;
+    DotProduct dot;
+
+    // Signal state below is carved from the base class scratch block
+    float* history[MAX_CHANNELS];    // Buffered input, oldest first
+    float* blendedRow;               // Interpolated coefficients for the current output
+    size_t historyCapacity;
+    size_t historyFrames;            // Valid frames in every history[]
+    uint32_t phase;                  // Output phase in 1/upFactor input samples, < upFactor
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_RESAMPLER_KERNEL_HPP
@@ -0,0 +1,508 @@
+#include "RoomReflectionEngine.hpp"
+#include <Accelerate/Accelerate.h>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    typedef float LaneVector8 __attribute__((vector_size(ROOM_FDN_LINES * sizeof(float))));
+    typedef int32_t LaneMask8 __attribute__((vector_size(ROOM_FDN_LINES * sizeof(int32_t))));
+
+    // Slot layout: delays, left gains, right gains, then count and send
+    constexpr int kDelays = 0;
+    constexpr int kGainsLeft = MAX_SOURCE_REFLECTIONS;
+    constexpr int kGainsRight = 2 * MAX_SOURCE_REFLECTIONS;
+    constexpr int kCount = 3 * MAX_SOURCE_REFLECTIONS;
+    constexpr int kSend = kCount + 1;
+
+    // Floats per cache line; every carved region starts on one
+    constexpr size_t kLineFloats = CACHE_LINE_SIZE / sizeof(float);
+
+    // Nominal late tail line lengths (ms), each rounded up to a distinct prime
+    constexpr double kFDNLengthsMs[ROOM_FDN_LINES] = { 31.7, 37.9, 41.3, 47.9, 53.3, 59.1, 67.7, 73.1 };
+
+    size_t roundUpToLine(size_t floats) noexcept {
+        return (floats + kLineFloats - 1) / kLineFloats * kLineFloats;
+    }
+
+    bool isPrime(uint32_t value) noexcept {
+        if (value < 2) {
+            return false;
+        }
+        for (uint32_t divisor = 2; divisor * divisor <= value; ++divisor) {
+            if (value % divisor == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    LaneVector8 broadcast(float value) noexcept {
+        return LaneVector8{ value, value, value, value, value, value, value, value };
+    }
+
+    // Sylvester Hadamard entry, +/-1
+    float hadamard(int row, int column) noexcept {
+        return (std::popcount(static_cast<unsigned>(row & column)) & 1) ? -1.0f : 1.0f;
+    }
+
+    LaneVector8 hadamardRow(int row, float scale) noexcept {
+        LaneVector8 result;
+        for (int lane = 0; lane < ROOM_FDN_LINES; ++lane) {
+            result[lane] = scale * hadamard(row, lane);
+        }
+        return result;
+    }
+
+    float sumLanes(LaneVector8 value) noexcept {
+        return ((value[0] + value[1]) + (value[2] + value[3])) + ((value[4] + value[5]) + (value[6] + value[7]));
+    }
+}
+
+// MARK: - Image Sources
+
+void computeShoeboxReflections(const float roomSize[3], const float listener[3], const float source[3],
+                               float absorption, SourceReflections& result) noexcept {
+    const float reflection = std::sqrt(std::clamp(1.0f - absorption, 0.0f, 1.0f));
+    constexpr float kHalfPi = 1.5707963267948966f;
+
+    // Walls at 0 and at the room size on each axis
+    int tap = 0;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (int side = 0; side < 2; ++side) {
+            float image[3] = { source[0], source[1], source[2] };
+            image[axis] = (side == 0) ? -source[axis] : 2.0f * roomSize[axis] - source[axis];
+
+            const float dx = image[0] - listener[0];
+            const float dy = image[1] - listener[1];
+            const float dz = image[2] - listener[2];
+            const float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+            const float gain = reflection / std::max(distance, 1.0f);
+
+            // Equal-power pan on the lateral component of the arrival direction
+            const float horizontal = std::sqrt(dx * dx + dz * dz);
+            const float lateral = (horizontal > 0.0f) ? dx / horizontal : 0.0f;
+            const float position = 0.5f * (1.0f + lateral);
+
+            ReflectionTap& entry = result.taps[tap++];
+            entry.delaySeconds = std::min(distance / ROOM_SPEED_OF_SOUND,
+                                          static_cast<float>(MAX_REFLECTION_DELAY_SECONDS));
+            entry.gainLeft = gain * std::cos(position * kHalfPi);
+            entry.gainRight = gain * std::sin(position * kHalfPi);
+        }
+    }
+    result.tapCount = tap;
+}
+
+// MARK: - Construction
+
+RoomReflectionEngine::RoomReflectionEngine(double sampleRate, int maxSources, size_t maxFrames,
+                                           DenormalMode denormalMode)
+    : sampleRate(sampleRate)
+    , maxSources(maxSources)
+    , maxFrames(maxFrames)
+    , denormalMode(resolveDenormalMode(denormalMode))
+    , maxDelayFrames(static_cast<uint32_t>(std::ceil(MAX_REFLECTION_DELAY_SECONDS * sampleRate)))
+    , fadeFrames(std::max<uint32_t>(1, static_cast<uint32_t>(std::lround(REFLECTION_FADE_SECONDS * sampleRate))))
+    , lineLength(std::bit_ceil(static_cast<size_t>(maxDelayFrames) + maxFrames + 4))
+    , lineGuard(roundUpToLine(maxFrames + 4))
+    , lineStride(roundUpToLine(lineLength + lineGuard))
+    , linePosition(0)
+    , fdnRingLength(0)
+    , fdnPosition(0)
+    , lateLevel(DEFAULT_ROOM_LATE_LEVEL)
+    , lateVersionSeen(0)
+    , pendingSources(0)
+    , decayTarget(DEFAULT_ROOM_DECAY_SECONDS)
+    , highDecayTarget(DEFAULT_ROOM_HIGH_DECAY_RATIO)
+    , levelTarget(DEFAULT_ROOM_LATE_LEVEL)
+    , lateVersion(1)
+    , renderedTaps(0)
+{
+    if (sampleRate < MIN_SAMPLE_RATE || sampleRate > MAX_SAMPLE_RATE) {
+        throw std::invalid_argument("Sample rate out of valid range");
+    }
+    if (maxSources <= 0 || maxSources > MAX_ROOM_SOURCES) {
+        throw std::invalid_argument("Room source count out of valid range");
+    }
+    if (maxFrames == 0 || maxFrames > MAX_BUFFER_SIZE) {
+        throw std::invalid_argument("Maximum frame count out of valid range");
+    }
+
+    // Distinct primes are mutually prime, so the lines' echoes never line up
+    uint32_t longest = 0;
+    for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+        uint32_t length = static_cast<uint32_t>(std::lround(kFDNLengthsMs[i] * 0.001 * sampleRate));
+        while (!isPrime(length) || (i > 0 && length <= fdnLength[i - 1])) {
+            ++length;
+        }
+        fdnLength[i] = length;
+        longest = std::max(longest, length);
+    }
+    fdnRingLength = std::bit_ceil(static_cast<size_t>(longest) + 1);
+
+    lineStorage = acquireScratch(static_cast<size_t>(maxSources) * lineStride);
+
+    const size_t frameFloats = roundUpToLine(maxFrames);
+    fdnStorage = acquireScratch(ROOM_FDN_LINES * fdnRingLength + 4 * frameFloats +
+                                ROOM_FDN_LINES * frameFloats);
+    float* carve = fdnStorage.data();
+    for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+        fdnRing[i] = carve;
+        carve += fdnRingLength;
+    }
+    tapBuffer = carve;
+    rampIn = tapBuffer + frameFloats;
+    rampOut = rampIn + frameFloats;
+    sendBuffer = rampOut + frameFloats;
+    lateFrames = sendBuffer + frameFloats;
+
+    for (int source = 0; source < MAX_ROOM_SOURCES; ++source) {
+        current[source] = TapSet{};
+        incoming[source] = TapSet{};
+        fadePosition[source] = fadeFrames;
+        for (auto& value : slots[source].values) {
+            value.store(0.0f, std::memory_order_relaxed);
+        }
+    }
+    reset();
+    updateLateTail();
+}
+
+// MARK: - Control Thread
+
+bool RoomReflectionEngine::setReflections(int source, const SourceReflections& reflections) noexcept {
+    if (source < 0 || source >= maxSources || reflections.tapCount < 0 ||
+        reflections.tapCount > MAX_SOURCE_REFLECTIONS ||
+        !(reflections.reverbSend >= 0.0f && std::isfinite(reflections.reverbSend))) {
+        return false;
+    }
+    for (int k = 0; k < reflections.tapCount; ++k) {
+        const ReflectionTap& tap = reflections.taps[k];
+        if (!(tap.delaySeconds >= 0.0f && tap.delaySeconds <= MAX_REFLECTION_DELAY_SECONDS) ||
+            !std::isfinite(tap.gainLeft) || !std::isfinite(tap.gainRight)) {
+            return false;
+        }
+    }
+
+    ReflectionSlot& slot = slots[source];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int k = 0; k < MAX_SOURCE_REFLECTIONS; ++k) {
+        const bool active = k < reflections.tapCount;
+        slot.values[kDelays + k].store(active ? reflections.taps[k].delaySeconds : 0.0f, std::memory_order_relaxed);
+        slot.values[kGainsLeft + k].store(active ? reflections.taps[k].gainLeft : 0.0f, std::memory_order_relaxed);
+        slot.values[kGainsRight + k].store(active ? reflections.taps[k].gainRight : 0.0f, std::memory_order_relaxed);
+    }
+    slot.values[kCount].store(static_cast<float>(reflections.tapCount), std::memory_order_relaxed);
+    slot.values[kSend].store(reflections.reverbSend, std::memory_order_relaxed);
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    pendingSources.fetch_or(1u << source, std::memory_order_release);
+    return true;
+}
+
+bool RoomReflectionEngine::setLateReverb(float decaySeconds, float highDecayRatio, float level) noexcept {
+    if (!(decaySeconds >= 0.1f && decaySeconds <= 20.0f) ||
+        !(highDecayRatio >= 0.05f && highDecayRatio <= 1.0f) ||
+        !(level >= 0.0f && std::isfinite(level))) {
+        return false;
+    }
+    // Fields may be seen from different calls for one block; each is valid on its own
+    decayTarget.store(decaySeconds, std::memory_order_relaxed);
+    highDecayTarget.store(highDecayRatio, std::memory_order_relaxed);
+    levelTarget.store(level, std::memory_order_relaxed);
+    lateVersion.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+// MARK: - Render Thread
+
+void RoomReflectionEngine::makeTapSet(const float* values, TapSet& set) const noexcept {
+    set.count = static_cast<int>(values[kCount]);
+    set.send = values[kSend];
+    for (int k = 0; k < MAX_SOURCE_REFLECTIONS; ++k) {
+        // One frame is the shortest delay the block-at-once read can serve
+        double delay = std::clamp(static_cast<double>(values[kDelays + k]) * sampleRate,
+                                  1.0, static_cast<double>(maxDelayFrames));
+
+        // Whole-frame delays stored as float seconds come back a rounding error short
+        if (std::fabs(delay - std::round(delay)) < 1.0e-3) {
+            delay = std::round(delay);
+        }
+        const uint32_t whole = static_cast<uint32_t>(delay);
+        const float d = static_cast<float>(delay - whole) + 1.0f;
+
+        // Third-order Lagrange weights for x[m - d] from x[m] ... x[m - 3], m = n - whole + 1
+        set.offset[k] = whole + 2;
+        set.coefficients[k][3] = -(d - 1.0f) * (d - 2.0f) * (d - 3.0f) / 6.0f;
+        set.coefficients[k][2] = d * (d - 2.0f) * (d - 3.0f) / 2.0f;
+        set.coefficients[k][1] = -d * (d - 1.0f) * (d - 3.0f) / 2.0f;
+        set.coefficients[k][0] = d * (d - 1.0f) * (d - 2.0f) / 6.0f;
+        set.gainLeft[k] = values[kGainsLeft + k];
+        set.gainRight[k] = values[kGainsRight + k];
+    }
+}
+
+void RoomReflectionEngine::pullReflectionUpdates() noexcept {
+    uint32_t pending = pendingSources.exchange(0, std::memory_order_acquire);
+    uint32_t retry = 0;
+    while (pending) {
+        const int source = std::countr_zero(pending);
+        pending &= pending - 1;
+
+        // A source still fading, or a slot caught mid-write, is taken at a later block
+        if (fadePosition[source] < fadeFrames) {
+            retry |= 1u << source;
+            continue;
+        }
+        const ReflectionSlot& slot = slots[source];
+        const uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        float values[kSlotValues];
+        for (int k = 0; k < kSlotValues; ++k) {
+            values[k] = slot.values[k].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((before & 1u) || slot.sequence.load(std::memory_order_relaxed) != before) {
+            retry |= 1u << source;
+            continue;
+        }
+        makeTapSet(values, incoming[source]);
+        fadePosition[source] = 0;
+    }
+    if (retry) {
+        pendingSources.fetch_or(retry, std::memory_order_relaxed);
+    }
+}
+
+void RoomReflectionEngine::updateLateTail() noexcept {
+    const uint32_t version = lateVersion.load(std::memory_order_acquire);
+    if (version == lateVersionSeen) {
+        return;
+    }
+    lateVersionSeen = version;
+
+    const double decay = decayTarget.load(std::memory_order_relaxed);
+    const double highDecay = decay * highDecayTarget.load(std::memory_order_relaxed);
+    lateLevel = levelTarget.load(std::memory_order_relaxed);
+    for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+        // -60 dB after decay seconds: one trip round line i loses 60 * length / (decay * rate) dB
+        const double gain = std::pow(10.0, -3.0 * fdnLength[i] / (decay * sampleRate));
+        const double highGain = std::pow(10.0, -3.0 * fdnLength[i] / (highDecay * sampleRate));
+
+        // One-pole lowpass with unity DC gain and highGain / gain at Nyquist
+        const double ratio = highGain / gain;
+        fdnGain[i] = static_cast<float>(gain);
+        fdnDamping[i] = static_cast<float>((1.0 - ratio) / (1.0 + ratio));
+    }
+}
+
+void RoomReflectionEngine::writeLines(const float* const* sources, int sourceCount, size_t frames) noexcept {
+    const size_t first = std::min(frames, lineLength - linePosition);
+    for (int source = 0; source < maxSources; ++source) {
+        float* history = line(source);
+        const float* samples = (source < sourceCount) ? sources[source] : nullptr;
+
+        // Write [begin, begin + count) and its mirror in the guard
+        auto store = [&](size_t begin, size_t count, const float* data) {
+            if (data) {
+                std::memcpy(history + begin, data, count * sizeof(float));
+            } else {
+                std::memset(history + begin, 0, count * sizeof(float));
+            }
+            if (begin < lineGuard) {
+                const size_t mirrored = std::min(count, lineGuard - begin);
+                std::memcpy(history + lineLength + begin, history + begin, mirrored * sizeof(float));
+            }
+        };
+        store(linePosition, first, samples);
+        if (first < frames) {
+            store(0, frames - first, samples ? samples + first : nullptr);
+        }
+    }
+}
+
+void RoomReflectionEngine::renderTapSet(const TapSet& set, const float* history, const float* weight,
+                                        size_t frames, float* left, float* right) noexcept {
+    const vDSP_Length length = static_cast<vDSP_Length>(frames);
+    const size_t mask = lineLength - 1;
+    for (int k = 0; k < set.count; ++k) {
+        // The window starts at the oldest sample the first frame interpolates from
+        const float* window = history + ((linePosition + lineLength - set.offset[k]) & mask);
+        vDSP_conv(window, 1, set.coefficients[k], 1, tapBuffer, 1, length, 4);
+        if (weight) {
+            vDSP_vmul(tapBuffer, 1, weight, 1, tapBuffer, 1, length);
+        }
+        vDSP_vsma(tapBuffer, 1, &set.gainLeft[k], left, 1, left, 1, length);
+        vDSP_vsma(tapBuffer, 1, &set.gainRight[k], right, 1, right, 1, length);
+    }
+
+    // The block just written is contiguous too, thanks to the guard
+    if (set.send != 0.0f) {
+        const float* block = history + linePosition;
+        if (weight) {
+            vDSP_vmul(block, 1, weight, 1, tapBuffer, 1, length);
+            block = tapBuffer;
+        }
+        vDSP_vsma(block, 1, &set.send, sendBuffer, 1, sendBuffer, 1, length);
+    }
+}
+
+void RoomReflectionEngine::renderSource(int source, size_t frames, float* left, float* right) noexcept {
+    const float* history = line(source);
+    int taps = current[source].count;
+    if (fadePosition[source] >= fadeFrames) {
+        renderTapSet(current[source], history, nullptr, frames, left, right);
+    } else {
+        // Linear crossfade, reaching the new taps fadeFrames after it started
+        const float scale = 1.0f / static_cast<float>(fadeFrames);
+        for (size_t f = 0; f < frames; ++f) {
+            rampIn[f] = std::min(1.0f, static_cast<float>(fadePosition[source] + f + 1) * scale);
+            rampOut[f] = 1.0f - rampIn[f];
+        }
+
+        renderTapSet(current[source], history, rampOut, frames, left, right);
+        renderTapSet(incoming[source], history, rampIn, frames, left, right);
+        taps += incoming[source].count;
+
+        fadePosition[source] += static_cast<uint32_t>(std::min<size_t>(frames, fadeFrames));
+        if (fadePosition[source] >= fadeFrames) {
+            current[source] = incoming[source];
+            fadePosition[source] = fadeFrames;
+        }
+    }
+    renderedTaps.fetch_add(taps, std::memory_order_relaxed);
+}
+
+void RoomReflectionEngine::renderLateTail(size_t frames, float* left, float* right) noexcept {
+    const size_t mask = fdnRingLength - 1;
+    const LaneVector8 gain = { fdnGain[0], fdnGain[1], fdnGain[2], fdnGain[3],
+                               fdnGain[4], fdnGain[5], fdnGain[6], fdnGain[7] };
+    const LaneVector8 damping = { fdnDamping[0], fdnDamping[1], fdnDamping[2], fdnDamping[3],
+                                  fdnDamping[4], fdnDamping[5], fdnDamping[6], fdnDamping[7] };
+
+    // Orthonormal feedback matrix columns; the ears and the input use distinct rows
+    const float normalize = 1.0f / std::sqrt(static_cast<float>(ROOM_FDN_LINES));
+    LaneVector8 columns[ROOM_FDN_LINES];
+    for (int column = 0; column < ROOM_FDN_LINES; ++column) {
+        columns[column] = hadamardRow(column, normalize);   // Symmetric: rows are columns
+    }
+    const LaneVector8 inputGains = hadamardRow(3, normalize);
+    const LaneVector8 leftTaps = hadamardRow(1, lateLevel * normalize);
+    const LaneVector8 rightTaps = hadamardRow(2, lateLevel * normalize);
+    const int32_t thresholdBits = std::bit_cast<int32_t>(DENORMAL_THRESHOLD);
+    const LaneMask8 threshold = { thresholdBits, thresholdBits, thresholdBits, thresholdBits,
+                                  thresholdBits, thresholdBits, thresholdBits, thresholdBits };
+    const bool flush = denormalMode == DenormalMode::VectorThreshold;
+
+    LaneVector8 state;
+    std::memcpy(&state, fdnState, sizeof(state));
+
+    // Chunks no longer than the shortest line read only samples written before the chunk
+    for (size_t offset = 0; offset < frames; ) {
+        const size_t chunk = std::min<size_t>(frames - offset, fdnLength[0]);
+
+        // Gather the lines' outputs frame-major, one vector per frame
+        for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+            const float* ring = fdnRing[i];
+            const size_t start = fdnPosition + fdnRingLength - fdnLength[i];
+            for (size_t f = 0; f < chunk; ++f) {
+                lateFrames[f * ROOM_FDN_LINES + i] = ring[(start + f) & mask];
+            }
+        }
+
+        for (size_t f = 0; f < chunk; ++f) {
+            LaneVector8 lines;
+            std::memcpy(&lines, lateFrames + f * ROOM_FDN_LINES, sizeof(lines));
+            state = lines + damping * (state - lines);
+            const LaneVector8 decayed = gain * state;
+
+            left[offset + f] += sumLanes(decayed * leftTaps);
+            right[offset + f] += sumLanes(decayed * rightTaps);
+
+            LaneVector8 feedback = broadcast(sendBuffer[offset + f]) * inputGains;
+            for (int column = 0; column < ROOM_FDN_LINES; ++column) {
+                feedback += broadcast(decayed[column]) * columns[column];
+            }
+            if (flush) {
+                // Positive floats order like their bit patterns
+                const LaneMask8 bits = std::bit_cast<LaneMask8>(feedback);
+                const LaneMask8 keep = (bits & 0x7fffffff) >= threshold;
+                feedback = std::bit_cast<LaneVector8>(bits & keep);
+            }
+            std::memcpy(lateFrames + f * ROOM_FDN_LINES, &feedback, sizeof(feedback));
+        }
+
+        for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+            float* ring = fdnRing[i];
+            for (size_t f = 0; f < chunk; ++f) {
+                ring[(fdnPosition + f) & mask] = lateFrames[f * ROOM_FDN_LINES + i];
+            }
+        }
+        fdnPosition = static_cast<uint32_t>((fdnPosition + chunk) & mask);
+        offset += chunk;
+    }
+
+    if (flush) {
+        for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+            state[i] = (std::fabs(state[i]) < DENORMAL_THRESHOLD) ? 0.0f : state[i];
+        }
+    }
+    std::memcpy(fdnState, &state, sizeof(state));
+}
+
+void RoomReflectionEngine::processBlock(const float* const* sources, int sourceCount, size_t offset,
+                                        size_t frames, float* left, float* right) noexcept {
+    const float* blockSources[MAX_ROOM_SOURCES];
+    const int count = std::clamp(sourceCount, 0, maxSources);
+    for (int source = 0; source < count; ++source) {
+        blockSources[source] = sources[source] ? sources[source] + offset : nullptr;
+    }
+    writeLines(blockSources, count, frames);
+    renderedTaps.store(0, std::memory_order_relaxed);
+
+    std::memset(left, 0, frames * sizeof(float));
+    std::memset(right, 0, frames * sizeof(float));
+    std::memset(sendBuffer, 0, frames * sizeof(float));
+    for (int source = 0; source < maxSources; ++source) {
+        renderSource(source, frames, left, right);
+    }
+    renderLateTail(frames, left, right);
+
+    linePosition = static_cast<uint32_t>((linePosition + frames) & (lineLength - 1));
+}
+
+void RoomReflectionEngine::process(const float* const* sources, int sourceCount, float* left, float* right,
+                                   size_t frames) noexcept {
+    ScopedFlushToZero flushToZero(denormalMode == DenormalMode::HardwareFTZ);
+    pullReflectionUpdates();
+    updateLateTail();
+
+    for (size_t offset = 0; offset < frames; offset += maxFrames) {
+        const size_t block = std::min(maxFrames, frames - offset);
+        processBlock(sources, sources ? sourceCount : 0, offset, block, left + offset, right + offset);
+    }
+}
+
+void RoomReflectionEngine::reset() noexcept {
+    std::memset(lineStorage.data(), 0, static_cast<size_t>(maxSources) * lineStride * sizeof(float));
+    for (int i = 0; i < ROOM_FDN_LINES; ++i) {
+        std::memset(fdnRing[i], 0, fdnRingLength * sizeof(float));
+        fdnState[i] = 0.0f;
+    }
+    linePosition = 0;
+    fdnPosition = 0;
+}
+
+} // namespace dsp
+} // namespace tald
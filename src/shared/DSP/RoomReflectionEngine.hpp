@@ -0,0 +1,254 @@
+//
+// RoomReflectionEngine.hpp
+// TALD UNIA Audio System
+//
+// Early reflections of every spatial source in a room rendered as one table of
+// fractional delay taps, plus one shared feedback-delay-network late tail.
+//
+
+#ifndef TALD_UNIA_ROOM_REFLECTION_ENGINE_HPP
+#define TALD_UNIA_ROOM_REFLECTION_ENGINE_HPP
+
+#include <atomic>      // C++20
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include "DSPConfig.hpp"
+#include "DSPDenormals.hpp"
+#include "DSPScratchPool.hpp"
+
+namespace tald {
+namespace dsp {
+
+// Sources and image sources per source, matching SpatialProcessor
+constexpr int MAX_ROOM_SOURCES = 32;
+constexpr int MAX_SOURCE_REFLECTIONS = 8;
+
+// Longest reflection path accepted, about 34 m
+constexpr double MAX_REFLECTION_DELAY_SECONDS = 0.100;
+
+// Length of the crossfade between an old and a new set of taps
+constexpr double REFLECTION_FADE_SECONDS = 0.005;
+
+// Feedback delay lines in the late tail
+constexpr int ROOM_FDN_LINES = 8;
+
+// Late tail defaults: broadband RT60, high-frequency RT60 as a fraction of it, output level
+constexpr float DEFAULT_ROOM_DECAY_SECONDS = 1.2f;
+constexpr float DEFAULT_ROOM_HIGH_DECAY_RATIO = 0.5f;
+constexpr float DEFAULT_ROOM_LATE_LEVEL = 0.25f;
+
+// Speed of sound used for reflection delays (m/s)
+constexpr float ROOM_SPEED_OF_SOUND = 343.0f;
+
+/**
+ * @brief One image source as heard by the listener
+ */
+struct ReflectionTap {
+    float delaySeconds = 0.0f;   // Path length / speed of sound; fractional frames are interpolated
+    float gainLeft = 0.0f;
+    float gainRight = 0.0f;
+};
+
+/**
+ * @brief Reflection taps and late-tail send of one source
+ */
+struct SourceReflections {
+    ReflectionTap taps[MAX_SOURCE_REFLECTIONS];
+    int tapCount = 0;
+    float reverbSend = 0.0f;     // Linear gain into the shared late tail
+};
+
+/**
+ * @brief First-order image sources of a shoebox room
+ * @param roomSize Width (x), height (y) and depth (z) in metres
+ * @param listener Listener position inside the room, metres from the origin corner
+ * @param source Source position inside the room
+ * @param absorption Energy absorbed per wall bounce, 0...1
+ * @param result Receives one tap per wall; tapCount is set to 6, reverbSend is left alone
+ *
+ * Gains fall off as 1/distance (clamped at 1 m) and are panned by the azimuth of
+ * the image, 0 straight ahead along -z and increasing toward +x, as
+ * SpatialProcessor measures it.
+ */
+void computeShoeboxReflections(const float roomSize[3], const float listener[3], const float source[3],
+                               float absorption, SourceReflections& result) noexcept;
+
+/**
+ * @brief Reflections and late reverberation of every source in one room
+ *
+ * Each mono source is written once per block into its own delay line (all lines
+ * share one pooled allocation, each followed by a mirrored copy of its start so any
+ * tap window is contiguous). Every source's image sources then live in one flat
+ * tap table, and each active tap is rendered as a four-point Lagrange fractional
+ * read whose coefficients are computed once per tap change: the inner loop over
+ * frames is four multiply-adds into a tap buffer and two into the ears, with no
+ * per-sample branching or index arithmetic. New taps are published by the control
+ * thread through a per-source sequence lock and crossfaded in over
+ * REFLECTION_FADE_SECONDS, so moving sources never click.
+ *
+ * The late tail is one eight-line feedback delay network for the whole room, fed by
+ * the sum of the sources' sends: its cost depends on the room, not on the number of
+ * sources. The lines run side by side in one vector per frame, with per-line
+ * RT60-derived gains, one-pole high-frequency damping and a Hadamard feedback
+ * matrix; the ears tap the lines with different sign patterns for decorrelation.
+ *
+ * Construction is control-thread work; process() neither allocates nor locks.
+ */
+class RoomReflectionEngine {
+public:
+    /**
+     * @param sampleRate Audio sample rate (Hz)
+     * @param maxSources Most sources rendered, up to MAX_ROOM_SOURCES
+     * @param maxFrames Longest block process() will be given
+     * @param denormalMode Requested denormal handling
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    RoomReflectionEngine(double sampleRate, int maxSources = MAX_ROOM_SOURCES,
+                         size_t maxFrames = MAX_BUFFER_SIZE,
+                         DenormalMode denormalMode = DenormalMode::HardwareFTZ);
+
+    RoomReflectionEngine(const RoomReflectionEngine&) = delete;
+    RoomReflectionEngine& operator=(const RoomReflectionEngine&) = delete;
+
+    /**
+     * @brief Publish a source's taps and send (control thread)
+     * @return false for a bad source index, tap count or delay
+     *
+     * Wait-free; the render thread crossfades to the new taps at its next block, or
+     * once a fade in progress for this source has finished. Calls must come from a
+     * single control thread.
+     */
+    bool setReflections(int source, const SourceReflections& reflections) noexcept;
+
+    /**
+     * @brief Late tail decay and level (control thread)
+     * @param decaySeconds Broadband RT60, 0.1...20 s
+     * @param highDecayRatio RT60 at Nyquist as a fraction of decaySeconds, 0.05...1
+     * @param level Output gain of the tail
+     * @return false if a value is out of range
+     */
+    bool setLateReverb(float decaySeconds, float highDecayRatio, float level) noexcept;
+
+    /**
+     * @brief Render the reflections and late tail of every source
+     * @param sources sourceCount mono blocks; a null entry is silence
+     * @param sourceCount Up to maxSources; sources beyond it are silent
+     * @param left Receives the left ear (overwritten)
+     * @param right Receives the right ear (overwritten)
+     * @param frames Up to maxFrames
+     */
+    void process(const float* const* sources, int sourceCount, float* left, float* right,
+                 size_t frames) noexcept;
+
+    /**
+     * @brief Clear every delay line and the late tail, keeping taps and settings
+     *
+     * Not safe to call concurrently with process().
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Taps rendered in the last block, fading ones counted twice
+     */
+    [[nodiscard]]
+    int activeTapCount() const noexcept {
+        return renderedTaps.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    int sourceCapacity() const noexcept {
+        return maxSources;
+    }
+
+    [[nodiscard]]
+    size_t maxFramesPerBlock() const noexcept {
+        return maxFrames;
+    }
+
+private:
+    // Taps of one source as the render thread uses them
+    struct TapSet {
+        uint32_t offset[MAX_SOURCE_REFLECTIONS];        // Frames back from the block start to the oldest interpolated sample
+        float coefficients[MAX_SOURCE_REFLECTIONS][4];  // Lagrange weights, oldest sample first
+        float gainLeft[MAX_SOURCE_REFLECTIONS];
+        float gainRight[MAX_SOURCE_REFLECTIONS];
+        int count;
+        float send;
+    };
+
+    // One published tap set, guarded by a sequence lock
+    static constexpr int kSlotValues = 3 * MAX_SOURCE_REFLECTIONS + 2;
+    struct ReflectionSlot {
+        std::atomic<uint32_t> sequence{0};
+        std::atomic<float> values[kSlotValues];
+    };
+
+    const double sampleRate;
+    const int maxSources;
+    const size_t maxFrames;
+    const DenormalMode denormalMode;
+    const uint32_t maxDelayFrames;
+    const uint32_t fadeFrames;
+
+    // Source delay lines: lineLength samples each, then lineGuard mirrored samples
+    const size_t lineLength;                // Power of two
+    const size_t lineGuard;
+    const size_t lineStride;                // Floats between consecutive lines, cache-line multiple
+    uint32_t linePosition;                  // Where the next block is written, shared by all lines
+
+    // Late tail state
+    uint32_t fdnLength[ROOM_FDN_LINES];
+    size_t fdnRingLength;                   // Power of two
+    uint32_t fdnPosition;
+    float fdnGain[ROOM_FDN_LINES];          // Render thread: broadband feedback gain per line
+    float fdnDamping[ROOM_FDN_LINES];       // Render thread: one-pole pole per line
+    float fdnState[ROOM_FDN_LINES];         // Render thread: damping filter memory
+    float lateLevel;
+    uint32_t lateVersionSeen;
+
+    // Control to render publication
+    ReflectionSlot slots[MAX_ROOM_SOURCES];
+    std::atomic<uint32_t> pendingSources;
+    std::atomic<float> decayTarget;
+    std::atomic<float> highDecayTarget;
+    std::atomic<float> levelTarget;
+    std::atomic<uint32_t> lateVersion;
+    std::atomic<int> renderedTaps;
+
+    // Render thread tap state
+    TapSet current[MAX_ROOM_SOURCES];
+    TapSet incoming[MAX_ROOM_SOURCES];
+    uint32_t fadePosition[MAX_ROOM_SOURCES];   // Frames into the fade, fadeFrames when idle
+
+    // Pooled storage
+    ScratchBlock lineStorage;               // maxSources delay lines
+    ScratchBlock fdnStorage;                // ROOM_FDN_LINES rings, then render scratch
+    float* fdnRing[ROOM_FDN_LINES];
+    float* tapBuffer;                       // maxFrames, one tap's interpolated output
+    float* rampIn;                          // maxFrames, weight of the incoming taps
+    float* rampOut;                         // maxFrames, weight of the outgoing taps
+    float* sendBuffer;                      // maxFrames, sum of the late tail sends
+    float* lateFrames;                      // maxFrames * ROOM_FDN_LINES, frame-major
+
+    [[nodiscard]]
+    float* line(int source) const noexcept {
+        return lineStorage.data() + static_cast<size_t>(source) * lineStride;
+    }
+
+    void makeTapSet(const float* values, TapSet& set) const noexcept;
+    void pullReflectionUpdates() noexcept;
+    void processBlock(const float* const* sources, int sourceCount, size_t offset, size_t frames,
+                      float* left, float* right) noexcept;
+    void updateLateTail() noexcept;
+    void writeLines(const float* const* sources, int sourceCount, size_t frames) noexcept;
+    void renderTapSet(const TapSet& set, const float* history, const float* weight, size_t frames,
+                      float* left, float* right) noexcept;
+    void renderSource(int source, size_t frames, float* left, float* right) noexcept;
+    void renderLateTail(size_t frames, float* left, float* right) noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_ROOM_REFLECTION_ENGINE_HPP
@@ -0,0 +1,269 @@
+#include "SpectrumAnalyzerKernel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <stdexcept>
+
+// Version comments for external dependencies
+// Accelerate Framework: macOS 13.0+ / iOS 13.0+ SDK
+// C++20 STL: Apple Clang 15.0+
+
+namespace tald {
+namespace dsp {
+
+namespace {
+    // Power of SPECTRUM_FLOOR_DB; silent bins are clamped to it before the dB conversion
+    const float kFloorPower = std::pow(10.0f, SPECTRUM_FLOOR_DB / 10.0f);
+
+    const SpectrumAnalyzerConfig& validatedConfig(const SpectrumAnalyzerConfig& config) {
+        if (!std::has_single_bit(config.fftSize) || config.fftSize < MIN_ANALYSIS_FFT_SIZE ||
+            config.fftSize > MAX_ANALYSIS_FFT_SIZE) {
+            throw std::invalid_argument("Analysis FFT size must be a power of two within limits");
+        }
+        if (config.hopSize == 0 || config.hopSize > config.fftSize) {
+            throw std::invalid_argument("Hop size out of valid range");
+        }
+        if (config.binCount == 0 || config.binCount > MAX_SPECTRUM_BINS) {
+            throw std::invalid_argument("Spectrum bin count out of valid range");
+        }
+        // The lower edge must stay under Nyquist at every supported rate
+        if (!(config.minFrequency > 0.0 && config.minFrequency < MIN_SAMPLE_RATE / 2.0) ||
+            !(config.maxFrequency > config.minFrequency) || !std::isfinite(config.maxFrequency)) {
+            throw std::invalid_argument("Invalid spectrum frequency range");
+        }
+        if (!(config.publishRate > 0.0 && std::isfinite(config.publishRate))) {
+            throw std::invalid_argument("Invalid spectrum publish rate");
+        }
+        return config;
+    }
+
+    // Regions are carved on cache-line boundaries
+    size_t paddedFloats(size_t count) noexcept {
+        constexpr size_t floatsPerLine = CACHE_LINE_SIZE / sizeof(float);
+        return (count + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+    }
+}
+
+SpectrumAnalyzerKernel::SpectrumAnalyzerKernel(double sampleRate, int channels, const SpectrumAnalyzerConfig& config,
+                                               DenormalMode denormalMode, size_t maxFrames)
+    : DSPKernel(sampleRate, channels, denormalMode, maxFrames)
+    , config(validatedConfig(config))
+    , log2FFTSize(static_cast<vDSP_Length>(std::countr_zero(config.fftSize)))
+    , upperFrequency(0.0)
+    , publishInterval(1)
+    , history(nullptr)
+    , window(nullptr)
+    , windowed(nullptr)
+    , spectrum(nullptr)
+    , power(nullptr)
+    , accumulated(nullptr)
+    , mono(nullptr)
+    , historyHead(0)
+    , hopRemaining(0)
+    , framesSincePublish(0)
+    , accumulatedFrames(0)
+    , streamPosition(0)
+    , publishedCount(0)
+{
+    prepareResources(maxFrames, channels, sampleRate);
+    resetState();
+}
+
+void SpectrumAnalyzerKernel::prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) {
+    (void)channels;
+    const size_t fftSize = config.fftSize;
+    const size_t accumulatorFloats = paddedFloats(config.binCount);
+    ScratchBlock newScratch = acquireScratch(5 * fftSize + fftSize / 2 + accumulatorFloats +
+                                             paddedFloats(maxFramesPerBlock));
+
+    // Nothing below throws
+    scratch = std::move(newScratch);
+    history = scratch.data();
+    window = history + 2 * fftSize;
+    windowed = window + fftSize;
+    spectrum = windowed + fftSize;
+    power = spectrum + fftSize;
+    accumulated = power + fftSize / 2;
+    mono = accumulated + accumulatorFloats;
+
+    // Periodic Hann scaled by 2 / N: with zrip's factor of two a sine of amplitude A
+    // centred on a bin comes out with magnitude A
+    const double step = 2.0 * std::numbers::pi / static_cast<double>(fftSize);
+    const double scale = 2.0 / static_cast<double>(fftSize);
+    for (size_t n = 0; n < fftSize; ++n) {
+        window[n] = static_cast<float>(scale * 0.5 * (1.0 - std::cos(step * static_cast<double>(n))));
+    }
+
+    buildBands(sampleRate);
+    publishInterval = std::max<size_t>(1, static_cast<size_t>(std::lround(sampleRate / config.publishRate)));
+}
+
+void SpectrumAnalyzerKernel::buildBands(double rate) noexcept {
+    upperFrequency = std::min(config.maxFrequency, rate / 2.0);
+
+    // Nyquist is packed into the DC bin's imaginary part and not analysed
+    const size_t lastBin = config.fftSize / 2 - 1;
+    const double binsPerHz = static_cast<double>(config.fftSize) / rate;
+    for (size_t band = 0; band < config.binCount; ++band) {
+        const double low = binEdgeFrequency(band);
+        const double high = binEdgeFrequency(band + 1);
+        const size_t first = static_cast<size_t>(std::ceil(low * binsPerHz));
+        const size_t end = std::min(static_cast<size_t>(std::ceil(high * binsPerHz)), lastBin + 1);
+        if (end > first) {
+            bandFirst[band] = static_cast<uint32_t>(first);
+            bandEnd[band] = static_cast<uint32_t>(end);
+            bandFraction[band] = -1.0f;
+            continue;
+        }
+
+        // No FFT bin centre inside: interpolate at the band's geometric centre
+        const double position = std::sqrt(low * high) * binsPerHz;
+        const size_t below = std::min(static_cast<size_t>(position), lastBin - 1);
+        bandFirst[band] = static_cast<uint32_t>(below);
+        bandEnd[band] = static_cast<uint32_t>(below + 1);
+        bandFraction[band] = static_cast<float>(std::clamp(position - static_cast<double>(below), 0.0, 1.0));
+    }
+}
+
+double SpectrumAnalyzerKernel::binEdgeFrequency(size_t bin) const noexcept {
+    const double ratio = upperFrequency / config.minFrequency;
+    return config.minFrequency * std::pow(ratio, static_cast<double>(bin) / static_cast<double>(config.binCount));
+}
+
+void SpectrumAnalyzerKernel::resetState() noexcept {
+    vDSP_vclr(history, 1, 2 * config.fftSize);
+    vDSP_vclr(accumulated, 1, config.binCount);
+    historyHead = 0;
+    hopRemaining = config.fftSize;
+    framesSincePublish = 0;
+    accumulatedFrames = 0;
+    streamPosition = 0;
+    // publishedCount keeps counting so the reader can still tell new spectra apart
+}
+
+void SpectrumAnalyzerKernel::mixToMono(const AudioBufferView& input) noexcept {
+    const float gain = 1.0f / static_cast<float>(numChannels);
+    const vDSP_Length frames = input.frames;
+    if (input.layout == BufferLayout::Interleaved) {
+        vDSP_vsmul(input.interleaved, numChannels, &gain, mono, 1, frames);
+        for (int channel = 1; channel < numChannels; ++channel) {
+            vDSP_vsma(input.interleaved + channel, numChannels, &gain, mono, 1, mono, 1, frames);
+        }
+        return;
+    }
+    vDSP_vsmul(input.planes[0], 1, &gain, mono, 1, frames);
+    for (int channel = 1; channel < numChannels; ++channel) {
+        vDSP_vsma(input.planes[channel], 1, &gain, mono, 1, mono, 1, frames);
+    }
+}
+
+void SpectrumAnalyzerKernel::appendHistory(const float* samples, size_t frames) noexcept {
+    const size_t fftSize = config.fftSize;
+    while (frames > 0) {
+        const size_t chunk = std::min(frames, fftSize - historyHead);
+        std::memcpy(history + historyHead, samples, chunk * sizeof(float));
+        std::memcpy(history + historyHead + fftSize, samples, chunk * sizeof(float));
+        historyHead = (historyHead + chunk) & (fftSize - 1);
+        samples += chunk;
+        frames -= chunk;
+    }
+}
+
+void SpectrumAnalyzerKernel::analyzeFrame() noexcept {
+    const size_t fftSize = config.fftSize;
+    const size_t halfSize = fftSize / 2;
+
+    // The newest fftSize frames start at the write position of the doubled history
+    vDSP_vmul(history + historyHead, 1, window, 1, windowed, 1, fftSize);
+    DSPSplitComplex split{ spectrum, spectrum + halfSize };
+    vDSP_ctoz(reinterpret_cast<const DSPComplex*>(windowed), 2, &split, 1, halfSize);
+    vDSP_fft_zrip(fftSetup, &split, 1, log2FFTSize, kFFTDirection_Forward);
+    vDSP_zvmags(&split, 1, power, 1, halfSize);
+    // DC is purely real, and twice a sine's scale
+    power[0] = 0.25f * split.realp[0] * split.realp[0];
+
+    for (size_t band = 0; band < config.binCount; ++band) {
+        float value;
+        if (bandFraction[band] < 0.0f) {
+            vDSP_maxv(power + bandFirst[band], 1, &value, bandEnd[band] - bandFirst[band]);
+        } else {
+            const float fraction = bandFraction[band];
+            value = power[bandFirst[band]] + fraction * (power[bandFirst[band] + 1] - power[bandFirst[band]]);
+        }
+        accumulated[band] += value;
+    }
+    ++accumulatedFrames;
+}
+
+void SpectrumAnalyzerKernel::publishSpectrum() noexcept {
+    SpectrumFrame& frame = spectra.writeBuffer();
+    const vDSP_Length bins = config.binCount;
+    const float scale = 1.0f / static_cast<float>(accumulatedFrames);
+    const float reference = 1.0f;
+    vDSP_vsmul(accumulated, 1, &scale, frame.magnitudes, 1, bins);
+    vDSP_vthr(frame.magnitudes, 1, &kFloorPower, frame.magnitudes, 1, bins);
+    vDSP_vdbcon(frame.magnitudes, 1, &reference, frame.magnitudes, 1, bins, 0);
+    frame.binCount = config.binCount;
+    frame.sequence = ++publishedCount;
+    frame.streamPosition = streamPosition;
+    frame.analysisFrames = accumulatedFrames;
+    spectra.publish();
+
+    vDSP_vclr(accumulated, 1, bins);
+    accumulatedFrames = 0;
+}
+
+void SpectrumAnalyzerKernel::process(const AudioBufferView& input, const AudioBufferView& output) noexcept {
+    if (!input.isValid() || !output.isValid() || output.frames != input.frames ||
+        input.channels != numChannels || output.channels != numChannels || input.frames > maxFrames) {
+        return;
+    }
+    if (isBypassed()) {
+        passThrough(input, output);
+        return;
+    }
+
+    const ScopedFlushToZero flushToZero(activeDenormalMode == DenormalMode::HardwareFTZ);
+    const uint64_t startTicks = mach_absolute_time();
+
+    applyPendingReset();
+
+    // Mix before passing through, since output may alias input
+    mixToMono(input);
+    const size_t frameCount = input.frames;
+    size_t position = 0;
+    while (position < frameCount) {
+        const size_t take = std::min(frameCount - position, hopRemaining);
+        appendHistory(mono + position, take);
+        position += take;
+        hopRemaining -= take;
+        framesSincePublish += take;
+        streamPosition += take;
+        if (hopRemaining > 0) {
+            continue;
+        }
+
+        hopRemaining = config.hopSize;
+        analyzeFrame();
+        if (framesSincePublish >= publishInterval) {
+            publishSpectrum();
+            // Keep the schedule's phase; a hop longer than the interval publishes every frame
+            framesSincePublish %= publishInterval;
+        }
+    }
+    passThrough(input, output);
+
+    recordBlockTiming(startTicks, mach_absolute_time(), frameCount);
+}
+
+std::unique_ptr<DSPKernel> SpectrumAnalyzerKernel::fork() const {
+    auto clone = std::make_unique<SpectrumAnalyzerKernel>(sampleRate, numChannels, config, activeDenormalMode,
+                                                          maxFrames);
+    copyControlStateTo(*clone);
+    return clone;
+}
+
+} // namespace dsp
+} // namespace tald
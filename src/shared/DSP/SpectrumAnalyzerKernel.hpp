@@ -0,0 +1,173 @@
+//
+// SpectrumAnalyzerKernel.hpp
+// TALD UNIA Audio System
+//
+// Streaming STFT analysis on the render thread, reduced to log-frequency bins and
+// published to the UI / WebSocket thread through a triple buffer.
+//
+
+#ifndef TALD_UNIA_SPECTRUM_ANALYZER_KERNEL_HPP
+#define TALD_UNIA_SPECTRUM_ANALYZER_KERNEL_HPP
+
+#include <cstddef>     // C++20
+#include <cstdint>     // C++20
+#include <memory>      // C++20
+#include "DSPConfig.hpp"
+#include "DSPKernel.hpp"
+#include "DSPTripleBuffer.hpp"
+
+// Analysis frame sizes (points); defaults as in FFTProcessor
+constexpr size_t DEFAULT_ANALYSIS_FFT_SIZE = 2048;
+constexpr size_t MIN_ANALYSIS_FFT_SIZE = 256;
+constexpr size_t MAX_ANALYSIS_FFT_SIZE = 2 * MAX_BUFFER_SIZE;    // Largest the shared FFT setup supports
+
+// Log-frequency bins per published spectrum
+constexpr size_t DEFAULT_SPECTRUM_BINS = 128;
+constexpr size_t MAX_SPECTRUM_BINS = 512;
+
+constexpr double DEFAULT_SPECTRUM_MIN_FREQUENCY = 20.0;
+constexpr double DEFAULT_SPECTRUM_MAX_FREQUENCY = 20000.0;
+
+// Spectra handed to the reader per second, independent of the hop
+constexpr double DEFAULT_SPECTRUM_PUBLISH_RATE = 30.0;
+
+// Level reported for silent bins (dBFS)
+constexpr float SPECTRUM_FLOOR_DB = -120.0f;
+
+namespace tald {
+namespace dsp {
+
+/**
+ * @brief STFT and bin layout of a SpectrumAnalyzerKernel
+ */
+struct SpectrumAnalyzerConfig {
+    size_t fftSize = DEFAULT_ANALYSIS_FFT_SIZE;      // Power of two
+    size_t hopSize = DEFAULT_ANALYSIS_FFT_SIZE / 2;  // Frames between analysis frames, 1...fftSize
+    size_t binCount = DEFAULT_SPECTRUM_BINS;
+    double minFrequency = DEFAULT_SPECTRUM_MIN_FREQUENCY;
+    double maxFrequency = DEFAULT_SPECTRUM_MAX_FREQUENCY; // Limited to Nyquist
+    double publishRate = DEFAULT_SPECTRUM_PUBLISH_RATE;   // Hz
+};
+
+/**
+ * @brief One published spectrum
+ *
+ * magnitudes[k] is the level of log-spaced bin k in dBFS: a full-scale sine
+ * reads 0 dB in the bin holding its frequency, whatever the bin's width.
+ */
+struct SpectrumFrame {
+    float magnitudes[MAX_SPECTRUM_BINS] = {};
+    size_t binCount = 0;
+    uint64_t sequence = 0;       // Spectra published before and including this one; 0 for none yet
+    uint64_t streamPosition = 0; // Frames rendered up to the end of the newest analysis frame
+    uint32_t analysisFrames = 0; // STFT frames averaged into this spectrum
+};
+
+/**
+ * @brief Render-thread spectrum analyzer for the visualizers
+ *
+ * Audio passes through unchanged. The channels are mixed to mono into a history of
+ * fftSize frames (written twice, so every window is contiguous); every hopSize
+ * frames the newest fftSize frames are Hann windowed, transformed with the shared
+ * packed real FFT and reduced to power per log-frequency bin. Bins spanning several
+ * FFT bins take the strongest, so tones keep their level at every width; bins
+ * narrower than one FFT bin interpolate between neighbours. Frames are averaged
+ * until the publish schedule, which runs on rendered time rather than hop count,
+ * and then converted to dB and published. The reader takes the newest spectrum
+ * with latestSpectrum() without ever blocking the render thread; a slow reader
+ * only skips spectra. All state is one pooled scratch block sized at
+ * construction; process() neither allocates nor locks.
+ */
+class SpectrumAnalyzerKernel final : public DSPKernel {
+public:
+    /**
+     * @param sampleRate Audio sample rate (Hz)
+     * @param channels Number of input and output channels
+     * @param config STFT size, hop, bin layout and publish rate
+     * @param denormalMode Requested denormal handling
+     * @param maxFrames Largest block process() accepts
+     * @throws std::invalid_argument if parameters are out of valid range
+     * @throws std::runtime_error if allocation fails
+     */
+    SpectrumAnalyzerKernel(double sampleRate, int channels,
+                           const SpectrumAnalyzerConfig& config = SpectrumAnalyzerConfig{},
+                           DenormalMode denormalMode = DenormalMode::HardwareFTZ,
+                           size_t maxFrames = MAX_BUFFER_SIZE);
+
+    using DSPKernel::process;
+
+    void process(const AudioBufferView& input, const AudioBufferView& output) noexcept override;
+
+    /**
+     * @brief New analyzer with the same configuration and its own published spectra
+     */
+    [[nodiscard]]
+    std::unique_ptr<DSPKernel> fork() const override;
+
+    /**
+     * @brief Newest published spectrum (one reader thread, e.g. the UI or WebSocket)
+     *
+     * Wait-free. The reference stays valid and unchanged until the next call;
+     * sequence tells whether anything new arrived since then.
+     */
+    [[nodiscard]]
+    const SpectrumFrame& latestSpectrum() noexcept {
+        spectra.update();
+        return spectra.readBuffer();
+    }
+
+    [[nodiscard]]
+    const SpectrumAnalyzerConfig& configuration() const noexcept {
+        return config;
+    }
+
+    /**
+     * @brief Lower edge of bin k, and upper edge of the last bin for k == binCount (Hz)
+     */
+    [[nodiscard]]
+    double binEdgeFrequency(size_t bin) const noexcept;
+
+private:
+    const SpectrumAnalyzerConfig config;
+    const vDSP_Length log2FFTSize;
+
+    TripleBuffer<SpectrumFrame> spectra;
+
+    // Bin reduction tables, rebuilt for each sample rate
+    uint32_t bandFirst[MAX_SPECTRUM_BINS]; // First FFT bin of each log bin
+    uint32_t bandEnd[MAX_SPECTRUM_BINS];   // One past the last
+    float bandFraction[MAX_SPECTRUM_BINS]; // Weight of bandFirst + 1 for bins narrower than an FFT bin, else -1
+    double upperFrequency;                 // maxFrequency limited to Nyquist
+    size_t publishInterval;                // Frames between spectra, from the publish rate
+
+    // Carved from the base class scratch block
+    float* history;                         // Mono input, 2 * fftSize: each frame stored twice
+    float* window;                          // Hann window with the amplitude scale folded in
+    float* windowed;                        // Newest fftSize frames times the window
+    float* spectrum;                        // Packed split spectrum of windowed
+    float* power;                           // Power per FFT bin, fftSize / 2
+    float* accumulated;                     // Summed power per log bin since the last publish
+    float* mono;                            // Channel mix of one block
+
+    // Render thread state
+    size_t historyHead;                     // Next write position, 0...fftSize - 1
+    size_t hopRemaining;                    // Frames until the next analysis frame; the first waits for fftSize
+    size_t framesSincePublish;
+    uint32_t accumulatedFrames;
+    uint64_t streamPosition;
+    uint64_t publishedCount;
+
+    void prepareResources(size_t maxFramesPerBlock, int channels, double sampleRate) override;
+    void resetState() noexcept override;
+
+    void buildBands(double rate) noexcept;
+    void mixToMono(const AudioBufferView& input) noexcept;
+    void appendHistory(const float* samples, size_t frames) noexcept;
+    void analyzeFrame() noexcept;
+    void publishSpectrum() noexcept;
+};
+
+} // namespace dsp
+} // namespace tald
+
+#endif // TALD_UNIA_SPECTRUM_ANALYZER_KERNEL_HPP